@@ -29,8 +29,21 @@
 # - ``MATMUL_ALIGNED_MALLOC`` {ON, OFF}
 # - ``MATMUL_SEQ_BLOCK_FACTOR`` {0<MATMUL_SEQ_BLOCK_FACTOR}
 # - ``MATMUL_SEQ_COMPLETE_OPT_NO_BLOCK_CUT_OFF`` {0<MATMUL_SEQ_COMPLETE_OPT_NO_BLOCK_CUT_OFF}
+# - ``MATMUL_RECURSIVE_CUT_OFF`` {0<MATMUL_RECURSIVE_CUT_OFF}
+# - ``MATMUL_PACKED_MR`` {0<MATMUL_PACKED_MR}
+# - ``MATMUL_PACKED_NR`` {0<MATMUL_PACKED_NR}
+# - ``MATMUL_PACKED_MC`` {0<MATMUL_PACKED_MC}
+# - ``MATMUL_PACKED_KC`` {0<MATMUL_PACKED_KC}
+# - ``MATMUL_PACKED_NC`` {0<MATMUL_PACKED_NC}
+# - ``MATMUL_JIT_MAX_SIZE`` {0<MATMUL_JIT_MAX_SIZE}
+# - ``MATMUL_JIT_CACHE_SIZE`` {0<MATMUL_JIT_CACHE_SIZE}
+# - ``MATMUL_COMPLEX_3M_MIN_SIZE`` {0<MATMUL_COMPLEX_3M_MIN_SIZE}
+# - ``MATMUL_GROUPED_TILE_SIZE`` {0<MATMUL_GROUPED_TILE_SIZE}
+# - ``MATMUL_TILED_TILE_SIZE`` {0<MATMUL_TILED_TILE_SIZE}
 # - ``MATMUL_STRASSEN_CUT_OFF`` {0<MATMUL_STRASSEN_CUT_OFF}
 # - ``MATMUL_STRASSEN_OMP_CUT_OFF`` {0<MATMUL_STRASSEN_OMP_CUT_OFF}
+# - ``MATMUL_STRASSEN_OMP_TASK_DEPTH`` {0<=MATMUL_STRASSEN_OMP_TASK_DEPTH}
+# - ``MATMUL_GEMM_PRINT_DECISION`` {ON, OFF}
 # - ``MATMUL_OMP_PRINT_NUM_CORES`` {ON, OFF}
 # - ``MATMUL_OPENACC_GANG_SIZE`` {0<MATMUL_OPENACC_GANG_SIZE}
 # - ``MATMUL_OPENACC_VECTOR_SIZE`` {0<MATMUL_OPENACC_VECTOR_SIZE}
@@ -45,10 +58,22 @@
 # - ``MATMUL_BUILD_SEQ_SINGLE_OPTS`` {ON, OFF}
 # - ``MATMUL_BUILD_SEQ_MULTIPLE_OPTS`` {ON, OFF}
 # - ``MATMUL_BUILD_SEQ_STRASSEN`` {ON, OFF}
+# - ``MATMUL_BUILD_SEQ_RECURSIVE`` {ON, OFF}
+# - ``MATMUL_BUILD_SEQ_SMALL`` {ON, OFF}
+# - ``MATMUL_BUILD_SEQ_PACKED`` {ON, OFF}
+# - ``MATMUL_BUILD_SEQ_INT8`` {ON, OFF}
+# - ``MATMUL_BUILD_SEQ_COMPLEX`` {ON, OFF}
+# - ``MATMUL_BUILD_SEQ_AUTOTUNE`` {ON, OFF}
+# - ``MATMUL_BUILD_SEQ_JIT`` {ON, OFF}
 # - ``MATMUL_BUILD_PAR_OMP2`` {ON, OFF}
 # - ``MATMUL_BUILD_PAR_OMP3`` {ON, OFF}
 # - ``MATMUL_BUILD_PAR_OMP4`` {ON, OFF}
 # - ``MATMUL_BUILD_PAR_STRASSEN_OMP2`` {ON, OFF}
+# - ``MATMUL_BUILD_PAR_STRASSEN_OMP3`` {ON, OFF}
+# - ``MATMUL_BUILD_PAR_BATCHED`` {ON, OFF}
+# - ``MATMUL_BUILD_PAR_TILED`` {ON, OFF}
+# - ``MATMUL_BUILD_PAR_PACKED_OMP2`` {ON, OFF}
+# - ``MATMUL_BUILD_DISPATCH`` {ON, OFF}
 # - ``MATMUL_BUILD_PAR_OPENACC`` {ON, OFF}
 # - ``MATMUL_BUILD_PAR_CUDA_MEMCPY_FIXED_BLOCK_SIZE`` {ON, OFF}
 # - ``MATMUL_BUILD_PAR_CUDA_MEMCPY_DYN_BLOCK_SIZE`` {ON, OFF}
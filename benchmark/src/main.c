@@ -19,8 +19,8 @@
 #include <stdlib.h>                 // malloc, free
 #include <stdbool.h>                // bool, true, false
 #include <time.h>                   // time()
-#include <float.h>                  // DBL_MAX
-#include <math.h>                   // pow
+#include <float.h>                  // DBL_MAX, FLT_EPSILON
+#include <math.h>                   // pow, fabs
 
 #ifdef _MSC_VER
     #include <Windows.h>
@@ -75,12 +75,168 @@ typedef struct SMatMulAlgo
     double const fExponentOmega;
 } SMatMulAlgo;
 
+#ifdef BENCHMARK_SEQ_COMPLEX
+    //-----------------------------------------------------------------------------
+    //! A struct holding the complex algorithms to benchmark.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulComplexAlgo
+    {
+        void(*pMatMul)(TIdx const, TIdx const, TIdx const, TMatMulComplex const, TMatMulComplex const * const, TIdx const, TMatMulComplex const * const, TIdx const, TMatMulComplex const, TMatMulComplex * const, TIdx const);
+        char const * pszName;
+        double const fExponentOmega;
+    } SMatMulComplexAlgo;
+#endif
+
 #ifdef BENCHMARK_CUDA_NO_COPY
     #include <cuda_runtime.h>
 
     #define MATMUL_CUDA_RT_CHECK(cmd) {cudaError_t error = cmd; if(error!=cudaSuccess){printf("<%s>:%i ",__FILE__,__LINE__); printf("[CUDA] Error: %s\n", cudaGetErrorString(error));}}
 #endif
 
+#ifdef BENCHMARK_SEQ_COMPLEX
+    //-----------------------------------------------------------------------------
+    //! \return The time in milliseconds required to multiply 2 random complex matrices of the given size
+    //! \param n The matrix dimension.
+    //-----------------------------------------------------------------------------
+    double measureRandomComplexMatMul(
+        SMatMulComplexAlgo const * const algo,
+        TIdx const m, TIdx const n, TIdx const k,
+        TIdx const uiRepeatCount
+    #ifdef BENCHMARK_VERIFY_RESULT
+        ,bool * pbResultsCorrect
+    #endif
+        )
+    {
+        TElem const minVal = MATMUL_EPSILON;
+        TElem const maxVal = (TElem)10;
+
+        // Generate random complex alpha and beta.
+        TMatMulComplex alpha;
+        alpha.re = matmul_gen_rand_val(minVal, maxVal);
+        alpha.im = matmul_gen_rand_val(minVal, maxVal);
+        TMatMulComplex beta;
+        beta.re = matmul_gen_rand_val(minVal, maxVal);
+        beta.im = matmul_gen_rand_val(minVal, maxVal);
+
+        // The interleaved complex matrices are allocated as real arrays with twice the number of elements.
+        TIdx const uiNumElements = 2 * n * n;
+        TMatMulComplex const * const A = (TMatMulComplex const *)matmul_arr_alloc_fill_rand(uiNumElements, minVal, maxVal);
+        TMatMulComplex const * const B = (TMatMulComplex const *)matmul_arr_alloc_fill_rand(uiNumElements, minVal, maxVal);
+        TMatMulComplex * const C = (TMatMulComplex *)matmul_arr_alloc(uiNumElements);
+    #ifdef BENCHMARK_VERIFY_RESULT
+        TMatMulComplex * const D = (TMatMulComplex *)matmul_arr_alloc(uiNumElements);
+    #endif
+
+        // Initialize the measurement result.
+    #ifdef BENCHMARK_REPEAT_TAKE_MINIMUM
+        double fTimeMeasuredSec = DBL_MAX;
+    #else
+        double fTimeMeasuredSec = 0.0;
+    #endif
+
+        // Iterate.
+        for(TIdx i = 0; i < uiRepeatCount; ++i)
+        {
+            matmul_arr_fill_rand((TElem *)C, uiNumElements, minVal, maxVal);
+    #ifdef BENCHMARK_VERIFY_RESULT
+            matmul_mat_copy(n, 2 * n, (TElem const *)C, 2 * n, (TElem *)D, 2 * n);
+    #endif
+
+    #ifdef BENCHMARK_PRINT_ITERATIONS
+            // If there are multiple repetitions, print the iteration we are at now.
+            if(uiRepeatCount!=1)
+            {
+                if(i>0)
+                {
+                    printf("; ");
+                }
+                printf("\ti=%"MATMUL_PRINTF_SIZE_T, (size_t)i);
+            }
+    #endif
+
+            double const fTimeStart = getTimeSec();
+
+            // Matrix multiplication.
+            (algo->pMatMul)(n, n, n, alpha, A, n, B, n, beta, C, n);
+
+            double const fTimeEnd = getTimeSec();
+            double const fTimeElapsed = fTimeEnd - fTimeStart;
+
+    #ifdef BENCHMARK_VERIFY_RESULT
+            matmul_gemm_seq_complex_basic(n, n, n, alpha, A, n, B, n, beta, D, n);
+
+            // The threshold difference from where the value is considered to be a real error.
+            // Each complex element is the sum of twice as many products as a real one which themselves are scaled by a complex alpha.
+            TElem const fErrorThreshold = (TElem)(4 * MATMUL_EPSILON * ((TElem)m) * maxVal * ((TElem)n) * maxVal * ((TElem)k) * maxVal);
+            bool const bResultCorrect = matmul_mat_cmp(n, 2 * n, (TElem const *)C, 2 * n, (TElem const *)D, 2 * n, fErrorThreshold);
+            if(!bResultCorrect)
+            {
+                printf("%s iteration %"MATMUL_PRINTF_SIZE_T" result incorrect!", algo->pszName, (size_t)i);
+            }
+            *pbResultsCorrect = (*pbResultsCorrect) && bResultCorrect;
+    #endif
+
+    #ifdef BENCHMARK_REPEAT_TAKE_MINIMUM
+            fTimeMeasuredSec = (fTimeElapsed<fTimeMeasuredSec) ? fTimeElapsed : fTimeMeasuredSec;
+    #else
+            fTimeMeasuredSec += fTimeElapsed * (1.0/double(BENCHMARK_REPEAT_COUNT));
+    #endif
+        }
+
+    #ifndef BENCHMARK_PRINT_GFLOPS
+        // Print the time needed for the calculation.
+        printf("\t%12.8lf", fTimeMeasuredSec);
+    #else
+        // Print the GFLOPS. A complex multiply-add are 8 real operations independent of the method used.
+        double const fOperations = 8.0*pow((double)n, algo->fExponentOmega);
+        double const fFLOPS = (fTimeMeasuredSec!=0) ? (fOperations/fTimeMeasuredSec) : 0.0;
+        printf("\t%12.8lf", fFLOPS*1.0e-9);
+    #endif
+
+        matmul_arr_free((TElem * const)A);
+        matmul_arr_free((TElem * const)B);
+        matmul_arr_free((TElem * const)C);
+    #ifdef BENCHMARK_VERIFY_RESULT
+        matmul_arr_free((TElem * const)D);
+    #endif
+
+        return fTimeMeasuredSec;
+    }
+#endif
+
+#ifdef BENCHMARK_VERIFY_RESULT
+    //-----------------------------------------------------------------------------
+    //! \return The threshold difference from where a value of the result of the given algorithm is considered to be a real error.
+    //! \param alpha The scale of the product.
+    //! \param maxVal The maximum absolute value of the elements of A and B.
+    //-----------------------------------------------------------------------------
+    TElem getErrorThreshold(
+        SMatMulAlgo const * const algo,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const maxVal)
+    {
+    #ifdef BENCHMARK_SEQ_INT8
+        // The 8 bit integer GEMM rounds each element of A to half of its quantization step of at most maxVal/255 and each element of B to half of maxVal/127.
+        // |a*b - a'*b'| <= |a|*|b-b'| + |b|*|a-a'| + |a-a'|*|b-b'| is summed up k times.
+        // The integer accumulation is exact, only the final conversion to float adds its rounding error.
+        if(algo->pMatMul == matmul_gemm_seq_int8)
+        {
+            double const fErrorA = 0.5 * (double)maxVal / 255.0;
+            double const fErrorB = 0.5 * (double)maxVal / 127.0;
+            double const fAlpha = fabs((double)alpha);
+            double const fErrorProduct = fAlpha * (double)k * ((double)maxVal * fErrorB + (double)maxVal * fErrorA + fErrorA * fErrorB);
+            double const fErrorConversion = fAlpha * (double)k * (double)maxVal * (double)maxVal * FLT_EPSILON;
+            return (TElem)(fErrorProduct + fErrorConversion);
+        }
+    #else
+        (void)algo;
+        (void)alpha;
+    #endif
+        return (TElem)(MATMUL_EPSILON * ((TElem)m) * maxVal * ((TElem)n) * maxVal * ((TElem)k) * maxVal);
+    }
+#endif
+
 //-----------------------------------------------------------------------------
 //! \return The time in milliseconds required to multiply 2 random matrices of the given type and size
 //! \param n The matrix dimension.
@@ -258,8 +414,7 @@ double measureRandomMatMul(
             matmul_mat_print_simple(n, n, D, n);
     #endif
 
-            // The threshold difference from where the value is considered to be a real error.
-            TElem const fErrorThreshold = (TElem)(MATMUL_EPSILON * ((TElem)m) * maxVal * ((TElem)n) * maxVal * ((TElem)k) * maxVal);
+            TElem const fErrorThreshold = getErrorThreshold(algo, m, n, k, alpha, maxVal);
             bool const bResultCorrect = matmul_mat_cmp(n, n, C, n, D, n, fErrorThreshold);
             if(!bResultCorrect)
             {
@@ -450,6 +605,72 @@ measureRandomMatMuls(
 #endif
 }
 
+#ifdef BENCHMARK_SEQ_COMPLEX
+    //-----------------------------------------------------------------------------
+    //! Measures the complex algorithms like measureRandomMatMuls in a table of their own.
+    //! \return True, if all results are correct.
+    //-----------------------------------------------------------------------------
+    #ifdef BENCHMARK_VERIFY_RESULT
+        bool
+    #else
+        void
+    #endif
+    measureRandomComplexMatMuls(
+        SMatMulComplexAlgo const * const pMatMulAlgos,
+        TIdx const uiNumAlgos,
+        SMatMulSizes const * const pSizes,
+        TIdx const uiRepeatCount)
+    {
+    #ifndef BENCHMARK_PRINT_GFLOPS
+        printf("\n#time in s");
+    #else
+        printf("\n#GFLOPS");
+    #endif
+        printf("\nm=n=k");
+        // Table heading
+        for(TIdx uiAlgoIdx = 0; uiAlgoIdx < uiNumAlgos; ++uiAlgoIdx)
+        {
+            printf(" \t%s", pMatMulAlgos[uiAlgoIdx].pszName);
+        }
+
+    #ifdef BENCHMARK_VERIFY_RESULT
+        bool bAllResultsCorrect = true;
+    #endif
+        for(TIdx uiSizeIdx = 0; uiSizeIdx < pSizes->uiNumSizes; ++uiSizeIdx)
+        {
+            TIdx const n = pSizes->puiSizes[uiSizeIdx];
+            // Print the operation
+            printf("\n%"MATMUL_PRINTF_SIZE_T, (size_t)n);
+
+            for(TIdx uiAlgoIdx = 0; uiAlgoIdx < uiNumAlgos; ++uiAlgoIdx)
+            {
+    #ifdef BENCHMARK_VERIFY_RESULT
+                bool bResultsCorrectAlgo = true;
+    #endif
+                // Execute the operation and measure the time taken.
+                measureRandomComplexMatMul(
+                    &pMatMulAlgos[uiAlgoIdx],
+                    n,
+                    n,
+                    n,
+                    uiRepeatCount
+    #ifdef BENCHMARK_VERIFY_RESULT
+                    , &bResultsCorrectAlgo
+    #endif
+                    );
+
+    #ifdef BENCHMARK_VERIFY_RESULT
+                bAllResultsCorrect &= bResultsCorrectAlgo;
+    #endif
+            }
+        }
+
+    #ifdef BENCHMARK_VERIFY_RESULT
+        return bAllResultsCorrect;
+    #endif
+    }
+#endif
+
 #define MATMUL_STRINGIFY(s) MATMUL_STRINGIFY_INTERNAL(s)
 #define MATMUL_STRINGIFY_INTERNAL(s) #s
 
@@ -474,6 +695,8 @@ void main_print_startup(
     printf(" float");
 #endif
     printf("; index type: %s", MATMUL_STRINGIFY(MATMUL_INDEX_TYPE));
+    SMatMulCpuCacheSizes const * const pCacheSizes = matmul_cpu_get_cache_sizes();
+    printf("; caches: L1d=%"MATMUL_PRINTF_SIZE_T"K L2=%"MATMUL_PRINTF_SIZE_T"K L3=%"MATMUL_PRINTF_SIZE_T"K", pCacheSizes->uiL1d/1024, pCacheSizes->uiL2/1024, pCacheSizes->uiL3/1024);
     printf("; MIN_N=%"MATMUL_PRINTF_SIZE_T, (size_t)uiNMin);
     printf("; MAX_N=%"MATMUL_PRINTF_SIZE_T, (size_t)uiNMax);
     printf("; STEP_N=%"MATMUL_PRINTF_SIZE_T, (size_t)uiNStep);
@@ -497,6 +720,12 @@ void main_print_startup(
 #ifdef BENCHMARK_PRINT_ITERATIONS
     printf("; BENCHMARK_PRINT_ITERATIONS");
 #endif
+#ifdef BENCHMARK_AUTOTUNE
+    printf("; BENCHMARK_AUTOTUNE");
+#endif
+#ifdef BENCHMARK_DISPATCH
+    printf("; BENCHMARK_DISPATCH");
+#endif
 #ifdef MATMUL_MPI
     printf("; MATMUL_MPI");
 #endif
@@ -597,6 +826,22 @@ int main(
     #endif
     #ifdef BENCHMARK_SEQ_STRASSEN
         {matmul_gemm_seq_strassen, "gemm_seq_strassen", 2.80735},   // 2.80735 = log(7.0) / log(2.0)
+        {matmul_gemm_seq_strassen_winograd, "gemm_seq_strassen_winograd", 2.80735},
+    #endif
+    #ifdef BENCHMARK_SEQ_RECURSIVE
+        {matmul_gemm_seq_recursive, "gemm_seq_recursive", 3.0},
+    #endif
+    #ifdef BENCHMARK_SEQ_SMALL
+        {matmul_gemm_seq_small, "gemm_seq_small", 3.0},
+    #endif
+    #ifdef BENCHMARK_SEQ_PACKED
+        {matmul_gemm_seq_packed, "gemm_seq_packed", 3.0},
+    #endif
+    #ifdef BENCHMARK_SEQ_INT8
+        {matmul_gemm_seq_int8, "gemm_seq_int8", 3.0},
+    #endif
+    #ifdef BENCHMARK_SEQ_JIT
+        {matmul_gemm_seq_jit, "gemm_seq_jit", 3.0},
     #endif
     #ifdef BENCHMARK_PAR_OMP2
         #if _OPENMP >= 200203   // OpenMP 2.0
@@ -635,6 +880,22 @@ int main(
         {matmul_gemm_par_strassen_omp2, "gemm_par_strassen_omp", 2.80735},   // 2.80735 = log(7.0) / log(2.0)
         #endif
     #endif
+    #ifdef BENCHMARK_PAR_STRASSEN_OMP3
+        #if _OPENMP >= 200805   // OpenMP 3.0
+        {matmul_gemm_par_strassen_omp3, "gemm_par_strassen_omp3", 2.80735},
+        #endif
+    #endif
+    #ifdef BENCHMARK_PAR_TILED
+        {matmul_gemm_par_tiled_row_major, "gemm_par_tiled", 3.0},
+    #endif
+    #ifdef BENCHMARK_PAR_PACKED_OMP2
+        #if _OPENMP >= 200203   // OpenMP 2.0
+        {matmul_gemm_par_packed_omp2, "gemm_par_packed_omp2", 3.0},
+        #endif
+    #endif
+    #ifdef BENCHMARK_DISPATCH
+        {matmul_gemm, "gemm", 3.0},
+    #endif
     #ifdef BENCHMARK_PAR_ALPAKA_ACC_CPU_B_OMP2_T_SEQ
         {matmul_gemm_par_alpaka_cpu_b_omp2_t_seq, "gemm_par_alpaka_cpu_b_omp2_t_seq", 3.0},
     #endif
@@ -706,13 +967,65 @@ int main(
     #endif
     };
 
+#ifdef BENCHMARK_SEQ_COMPLEX
+    static SMatMulComplexAlgo const complexAlgos[] = {
+        {matmul_gemm_seq_complex_4m, "gemm_seq_complex_4m", 3.0},
+        {matmul_gemm_seq_complex_3m, "gemm_seq_complex_3m", 3.0},
+        {matmul_gemm_seq_complex, "gemm_seq_complex", 3.0},
+    };
+#endif
+
     SMatMulSizes const sizes = buildSizes(
         uiNMin,
         uiNMax,
         uiNStep);
 
+#ifdef BENCHMARK_AUTOTUNE
+    // Tune the parameters for each size before the measurement so that the algorithms use them.
+    for(TIdx uiSizeIdx = 0; uiSizeIdx < sizes.uiNumSizes; ++uiSizeIdx)
+    {
+        TIdx const n = sizes.puiSizes[uiSizeIdx];
+        SMatMulTuneParams const params = matmul_autotune_seq(n, n, n, BENCHMARK_REPEAT_COUNT);
+        printf("\n#tuned %"MATMUL_PRINTF_SIZE_T": block mc=%"MATMUL_PRINTF_SIZE_T"; block kc=%"MATMUL_PRINTF_SIZE_T"; block nc=%"MATMUL_PRINTF_SIZE_T"; strassen cut-off=%"MATMUL_PRINTF_SIZE_T"; strassen omp cut-off=%"MATMUL_PRINTF_SIZE_T"; mc=%"MATMUL_PRINTF_SIZE_T"; kc=%"MATMUL_PRINTF_SIZE_T"; nc=%"MATMUL_PRINTF_SIZE_T"; micro-kernel=%s",
+            (size_t)n,
+            (size_t)params.uiSeqBlockMC,
+            (size_t)params.uiSeqBlockKC,
+            (size_t)params.uiSeqBlockNC,
+            (size_t)params.uiStrassenCutOff,
+            (size_t)params.uiStrassenOmpCutOff,
+            (size_t)params.uiPackedMC,
+            (size_t)params.uiPackedKC,
+            (size_t)params.uiPackedNC,
+            (params.szMicroKernel[0] != '\0') ? params.szMicroKernel : "auto");
+    }
+    char const * const pszTuneDb = getenv("MATMUL_TUNE_DB");
+    if(pszTuneDb)
+    {
+        matmul_tune_db_save(pszTuneDb);
+    }
+#endif
+
+#ifdef BENCHMARK_DISPATCH
+    // Calibrate the cost model of the dispatcher up to the biggest size measured.
+    matmul_gemm_calibrate(uiNMax, BENCHMARK_REPEAT_COUNT);
+    for(TIdx uiSizeIdx = 0; uiSizeIdx < sizes.uiNumSizes; ++uiSizeIdx)
+    {
+        TIdx const n = sizes.puiSizes[uiSizeIdx];
+        SMatMulGemmDecision decision;
+        if(matmul_gemm_decide(n, n, n, 1, &decision))
+        {
+            printf("\n#dispatch %"MATMUL_PRINTF_SIZE_T": %s; predicted=%g s", (size_t)n, decision.pszImpl, decision.fPredictedSec);
+        }
+    }
+    char const * const pszGemmModel = getenv("MATMUL_GEMM_MODEL");
+    if(pszGemmModel)
+    {
+        matmul_gemm_model_save(pszGemmModel);
+    }
+#endif
+
 #ifdef BENCHMARK_VERIFY_RESULT
-    bool const bAllResultsCorrect =
+    bool bAllResultsCorrect =
 #endif
     measureRandomMatMuls(
         algos,
@@ -720,6 +1033,18 @@ int main(
         &sizes,
         BENCHMARK_REPEAT_COUNT);
 
+#ifdef BENCHMARK_SEQ_COMPLEX
+    // The complex algorithms are measured in a table of their own.
+    #ifdef BENCHMARK_VERIFY_RESULT
+    bAllResultsCorrect &=
+    #endif
+    measureRandomComplexMatMuls(
+        complexAlgos,
+        sizeof(complexAlgos)/sizeof(complexAlgos[0]),
+        &sizes,
+        BENCHMARK_REPEAT_COUNT);
+#endif
+
     free(sizes.puiSizes);
 
 #ifdef MATMUL_MPI
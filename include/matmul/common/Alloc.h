@@ -28,6 +28,22 @@
 TElem * matmul_arr_alloc(
     TIdx const uiNumBytes);
 
+//-----------------------------------------------------------------------------
+//! Tries to allocate the memory on 64 Byte boundary if the operating system allows this.
+//! This is used for buffers of element types other than TElem.
+//! \return The uninitialized memory. It has to be freed with matmul_arr_aligned_free_internal.
+//! \param uiNumBytes The number of bytes to allocate.
+//-----------------------------------------------------------------------------
+void * matmul_arr_aligned_alloc_internal(
+    TIdx const uiNumBytes);
+
+//-----------------------------------------------------------------------------
+//! Frees memory allocated by matmul_arr_aligned_alloc_internal.
+//! \param ptr The memory to free.
+//-----------------------------------------------------------------------------
+void matmul_arr_aligned_free_internal(
+    void * const MATMUL_RESTRICT ptr);
+
 //-----------------------------------------------------------------------------
 //! \return A array of random values of the given type.
 //! \param uiNumElements The number of elements in the matrix.
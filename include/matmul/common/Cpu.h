@@ -0,0 +1,103 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+#include <stdbool.h>                // bool
+#include <stddef.h>                 // size_t
+
+//-----------------------------------------------------------------------------
+// Architecture Settings.
+//-----------------------------------------------------------------------------
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define MATMUL_ARCH_X86
+#endif
+
+#ifdef __cplusplus
+    extern "C"
+    {
+#endif
+    //-----------------------------------------------------------------------------
+    //! The instruction set extensions of the CPU the process is running on.
+    //! A feature is only reported as available if the operating system also saves the corresponding register state.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulCpuFeatures
+    {
+        bool bSse2;
+        bool bSse42;
+        bool bAvx;
+        bool bAvx2;
+        bool bFma;
+        bool bF16c;
+        bool bAvx512f;
+        bool bAvx512bw;
+        bool bAvx512Vnni;
+        bool bAvx512Bf16;
+    } SMatMulCpuFeatures;
+
+    //-----------------------------------------------------------------------------
+    //! The features are queried via cpuid on the first call and cached for all following calls. Concurrent first calls wait for a single query.
+    //!
+    //! \return The instruction set extensions of the current CPU.
+    //-----------------------------------------------------------------------------
+    SMatMulCpuFeatures const * matmul_cpu_get_features(void);
+
+    //-----------------------------------------------------------------------------
+    //! The model is queried via cpuid on the first call and cached for all following calls. Concurrent first calls wait for a single query.
+    //!
+    //! \return The brand string of the current CPU without leading and trailing spaces or "unknown" if it is not available.
+    //-----------------------------------------------------------------------------
+    char const * matmul_cpu_get_model(void);
+
+    //-----------------------------------------------------------------------------
+    //! The data cache sizes of one core of the CPU the process is running on in bytes. Zero if a level is unknown or not present.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulCpuCacheSizes
+    {
+        size_t uiL1d;       //!< The level 1 data cache.
+        size_t uiL2;        //!< The level 2 (data or unified) cache.
+        size_t uiL3;        //!< The level 3 (data or unified) cache. This is usually shared by multiple cores.
+    } SMatMulCpuCacheSizes;
+
+    //-----------------------------------------------------------------------------
+    //! The sizes are read from /sys/devices/system/cpu/cpu0/cache on Linux and from cpuid (leaf 4 or 0x8000001D) for the levels still unknown.
+    //! They are detected on the first call and cached for all following calls unless they are overridden by matmul_cpu_set_cache_sizes.
+    //! Concurrent first calls wait for a single detection.
+    //!
+    //! \return The data cache sizes of the current CPU.
+    //-----------------------------------------------------------------------------
+    SMatMulCpuCacheSizes const * matmul_cpu_get_cache_sizes(void);
+
+    //-----------------------------------------------------------------------------
+    //! \return A value greater than zero which changes on each call of matmul_cpu_set_cache_sizes so that settings derived from the cache sizes can be recomputed.
+    //-----------------------------------------------------------------------------
+    long matmul_cpu_get_cache_sizes_generation(void);
+
+    //-----------------------------------------------------------------------------
+    //! Overrides the detected cache sizes, e.g. to use only a part of a shared cache or if the detection is wrong.
+    //! The cache aware blocking of the following GEMM calls is derived from the new sizes.
+    //! This is not thread safe with respect to concurrent GEMM calls.
+    //!
+    //! \param pCacheSizes The cache sizes to use. If it is null, the sizes are detected again on the next call of matmul_cpu_get_cache_sizes.
+    //-----------------------------------------------------------------------------
+    void matmul_cpu_set_cache_sizes(SMatMulCpuCacheSizes const * const pCacheSizes);
+
+    //-----------------------------------------------------------------------------
+    //! \return A monotonically increasing wall clock time in seconds used to time GEMMs at runtime.
+    //-----------------------------------------------------------------------------
+    double matmul_cpu_get_time_sec(void);
+#ifdef __cplusplus
+    }
+#endif
@@ -0,0 +1,157 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_DISPATCH
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+
+    #include <stdbool.h>                // bool
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! The implementations matmul_gemm can choose from. Only the ones which are built are considered.
+    //-----------------------------------------------------------------------------
+    typedef enum EMatMulGemmImpl
+    {
+        EMatMulGemmImplSeqSmall,                //!< matmul_gemm_seq_small (MATMUL_BUILD_SEQ_SMALL). Only for the sizes of the fixed-size kernels.
+        EMatMulGemmImplSeqPacked,               //!< matmul_gemm_seq_packed (MATMUL_BUILD_SEQ_PACKED).
+        EMatMulGemmImplSeqMultipleOptsBlock,    //!< matmul_gemm_seq_multiple_opts_block (MATMUL_BUILD_SEQ_MULTIPLE_OPTS_BLOCK).
+        EMatMulGemmImplSeqRecursive,            //!< matmul_gemm_seq_recursive (MATMUL_BUILD_SEQ_RECURSIVE).
+        EMatMulGemmImplSeqStrassen,             //!< matmul_gemm_seq_strassen (MATMUL_BUILD_SEQ_STRASSEN).
+        EMatMulGemmImplParOmp2,                 //!< matmul_gemm_par_omp2_guided_schedule (MATMUL_BUILD_PAR_OMP2).
+        EMatMulGemmImplParStrassenOmp2,         //!< matmul_gemm_par_strassen_omp2 (MATMUL_BUILD_PAR_STRASSEN_OMP2).
+        EMatMulGemmImplParTiled,                //!< matmul_gemm_par_tiled_row_major (MATMUL_BUILD_PAR_TILED).
+        EMatMulGemmImplParPackedOmp2,           //!< matmul_gemm_par_packed_omp2 (MATMUL_BUILD_PAR_PACKED_OMP2).
+        EMatMulGemmImplParBatched,              //!< matmul_gemm_strided_batched (MATMUL_BUILD_PAR_BATCHED). Only for batches, the problems are distributed across the threads.
+        EMatMulGemmImplCount
+    } EMatMulGemmImpl;
+
+    //-----------------------------------------------------------------------------
+    //! The decision of the dispatcher for one problem.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulGemmDecision
+    {
+        EMatMulGemmImpl eImpl;          //!< The chosen implementation.
+        char const * pszImpl;           //!< The name of the chosen implementation.
+        double fPredictedSec;           //!< The predicted time of the whole problem (all problems of a batch) in seconds.
+        bool bCalibrated;               //!< If the prediction is based on a calibrated model instead of the built-in defaults.
+        int iNumThreads;                //!< The number of threads the prediction assumes for the parallel implementations.
+    } SMatMulGemmDecision;
+
+    //-----------------------------------------------------------------------------
+    //! \return The name of the implementation.
+    //-----------------------------------------------------------------------------
+    char const * matmul_gemm_impl_name(
+        EMatMulGemmImpl const eImpl);
+
+    //-----------------------------------------------------------------------------
+    //! Chooses the implementation with the lowest predicted time for the given problem.
+    //!
+    //! The time of each implementation is modelled as t = c0 + c1 * (m*k + k*n + m*n) + c2 * m*n*k, the call overhead, the memory traffic and the arithmetic.
+    //! The coefficients are the ones of matmul_gemm_calibrate or matmul_gemm_model_load, built-in estimates for the implementations which have not been calibrated.
+    //! The memory and arithmetic terms of the parallel implementations are scaled by the ratio of the calibrated to the current number of OpenMP threads.
+    //! The parameters of the chosen implementation (block sizes, micro-kernel, cut-offs) are the ones of the tuning database (matmul_tune_get).
+    //! The model is loaded from the file given by the environment variable MATMUL_GEMM_MODEL on the first call. Concurrent first calls wait for a single load.
+    //!
+    //! \param m The number of rows of A and C.
+    //! \param n The number of columns of B and C.
+    //! \param k The number of columns of A and rows of B.
+    //! \param batchCount The number of independent problems of this size. 1 for matmul_gemm.
+    //! \param pDecision The decision.
+    //! \return If any implementation is built.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_decide(
+        TIdx const m, TIdx const n, TIdx const k,
+        TIdx const batchCount,
+        SMatMulGemmDecision * const pDecision);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C computed by the implementation chosen by matmul_gemm_decide.
+    //! If MATMUL_GEMM_PRINT_DECISION is defined, each call prints the decision.
+    //!
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A Array, size lda-by-k. The leading m-by-k part of the array must contain the matrix A.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param B Array, size ldb-by-n. The leading k-by-n part of the array must contain the matrix B.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Strided batched (S/D)GEMM matrix-matrix products C + i*strideC = alpha * (A + i*strideA) * (B + i*strideB) + beta * (C + i*strideC) for i in [0, batchCount).
+    //! The problems are either distributed across the threads by matmul_gemm_strided_batched or computed one after the other by the implementation chosen for a single problem, whichever is predicted to be faster.
+    //! The parameters are the ones of matmul_gemm_strided_batched.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_strided_batched_auto(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const A, TIdx const lda, TIdx const strideA,
+        TElem const * const B, TIdx const ldb, TIdx const strideB,
+        TElem const beta,
+        TElem * const C, TIdx const ldc, TIdx const strideC,
+        TIdx const batchCount);
+
+    //-----------------------------------------------------------------------------
+    //! Calibrates the cost model of all built implementations on the current machine with the current number of OpenMP threads.
+    //!
+    //! Each implementation is timed on random square matrices with the powers of two from 4 up to uiMaxSize and on the three skinny shapes with one dimension of 16 and the others uiMaxSize.
+    //! The fastest of the repetitions counts. The coefficients are fitted by a least squares fit of the relative errors and replace the ones in memory.
+    //! matmul_gemm_model_save persists the results.
+    //!
+    //! \param uiMaxSize The biggest dimension timed. Problems bigger than this are extrapolated.
+    //! \param uiRepeatCount The number of times each shape is timed.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_calibrate(
+        TIdx const uiMaxSize,
+        TIdx const uiRepeatCount);
+
+    //-----------------------------------------------------------------------------
+    //! Replaces the model in memory with the entries of the given file which belong to the current CPU and element type.
+    //!
+    //! \param pszPath The path of the model file.
+    //! \return If the file could be read.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_model_load(char const * const pszPath);
+
+    //-----------------------------------------------------------------------------
+    //! Writes the calibrated entries of the model in memory to the given file.
+    //!
+    //! The file is a text file with one entry per line:
+    //! <cpu model>;<s|d>;<threads>;<implementation>;<c0>;<c1>;<c2>
+    //!
+    //! \param pszPath The path of the model file.
+    //! \return If the file could be written.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_model_save(char const * const pszPath);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
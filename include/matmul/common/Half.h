@@ -0,0 +1,58 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include <matmul/common/Config.h>   // TIdx
+
+#include <stdint.h>                 // uint16_t
+
+#ifdef __cplusplus
+    extern "C"
+    {
+#endif
+    //-----------------------------------------------------------------------------
+    //! The 16 bit floating point storage types. There is no arithmetic on them, they are converted to float for computing.
+    //!
+    //! TMatMulBf16: bfloat16 (1 sign, 8 exponent, 7 mantissa bits), the upper half of a float.
+    //! TMatMulFp16: IEEE 754 binary16 (1 sign, 5 exponent, 10 mantissa bits).
+    //-----------------------------------------------------------------------------
+    typedef uint16_t TMatMulBf16;
+    typedef uint16_t TMatMulFp16;
+
+    //-----------------------------------------------------------------------------
+    //! Converts a single value. The conversions to 16 bit round to nearest even and keep NaN a NaN.
+    //-----------------------------------------------------------------------------
+    float matmul_bf16_to_float(TMatMulBf16 const val);
+    TMatMulBf16 matmul_float_to_bf16(float const val);
+    float matmul_fp16_to_float(TMatMulFp16 const val);
+    TMatMulFp16 matmul_float_to_fp16(float const val);
+
+    //-----------------------------------------------------------------------------
+    //! Converts n consecutive values.
+    //! The instructions of the current CPU are used where available: AVX-512 BF16 for float to bfloat16 and F16C for both directions of IEEE half precision.
+    //! bfloat16 to float is only a shift and does not need special instructions.
+    //! Unlike the software conversion, the AVX-512 BF16 conversion flushes denormal floats to zero.
+    //!
+    //! \param n The number of values.
+    //! \param pSrc The values to convert.
+    //! \param pDst The destination. It must not overlap pSrc.
+    //-----------------------------------------------------------------------------
+    void matmul_arr_bf16_to_float(TIdx const n, TMatMulBf16 const * const MATMUL_RESTRICT pSrc, float * const MATMUL_RESTRICT pDst);
+    void matmul_arr_float_to_bf16(TIdx const n, float const * const MATMUL_RESTRICT pSrc, TMatMulBf16 * const MATMUL_RESTRICT pDst);
+    void matmul_arr_fp16_to_float(TIdx const n, TMatMulFp16 const * const MATMUL_RESTRICT pSrc, float * const MATMUL_RESTRICT pDst);
+    void matmul_arr_float_to_fp16(TIdx const n, float const * const MATMUL_RESTRICT pSrc, TMatMulFp16 * const MATMUL_RESTRICT pDst);
+#ifdef __cplusplus
+    }
+#endif
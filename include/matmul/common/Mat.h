@@ -22,6 +22,16 @@
     extern "C"
     {
 #endif
+    //-----------------------------------------------------------------------------
+    //! The memory layout of a matrix.
+    //! A column major m-by-n matrix with leading dimension ld is the same memory as the row major n-by-m transpose with leading dimension ld.
+    //-----------------------------------------------------------------------------
+    typedef enum EMatMulLayout
+    {
+        EMatMulLayoutRowMajor,  //!< Element (i, j) is stored at i*ld + j.
+        EMatMulLayoutColMajor,  //!< Element (i, j) is stored at j*ld + i.
+    } EMatMulLayout;
+
     //-----------------------------------------------------------------------------
     //! Square matrix comparison.
     //!
@@ -90,6 +100,17 @@
         TElem const alpha,
         TElem const beta);
 
+    //-----------------------------------------------------------------------------
+    //! Parses a BLAS style operation character.
+    //!
+    //! \param op 'N' or 'n' for op(X) = X, 'T', 't', 'C' or 'c' for op(X) = X^T.
+    //! \param pbTrans Receives if the operand is transposed.
+    //! \return If op is a valid operation character.
+    //-----------------------------------------------------------------------------
+    bool matmul_mat_parse_op(
+        char const op,
+        bool * const pbTrans);
+
     //-----------------------------------------------------------------------------
     //! Copy a block of the given size from the location given by sr and sc in pSrcMat to the location given by dr and dc in pDstMat.
     //!
@@ -114,6 +135,31 @@
         TIdx const dr,
         TIdx const dc);
 
+    //-----------------------------------------------------------------------------
+    //! Copy the transpose of the m-by-n block at the location given by sr and sc in pSrcMat to the n-by-m block at the location given by dr and dc in pDstMat.
+    //! The block is transposed in cache sized tiles so that both matrices are accessed in short unit stride runs.
+    //!
+    //! \param m The number of rows of the source block.
+    //! \param n The number of columns of the source block.
+    //! \param pSrcMat Row major source matrix.
+    //! \param lds The leading dimension of the source matrix.
+    //! \param sr The row in the source matrix the block to copy begins.
+    //! \param sc The column in the source matrix the block to copy begins.
+    //! \param pDstMat Row major destination matrix.
+    //! \param ldd The leading dimension of the destination matrix.
+    //! \param dr The row in the destination matrix the block to copy begins.
+    //! \param dc The column in the destination matrix the block to copy begins.
+    //-----------------------------------------------------------------------------
+    void matmul_mat_copy_block_transposed(
+        TIdx const m,
+        TIdx const n,
+        TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds,
+        TIdx const sr,
+        TIdx const sc,
+        TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd,
+        TIdx const dr,
+        TIdx const dc);
+
     //-----------------------------------------------------------------------------
     //! Copy the matrix pSrcMat to the pDstMat.
     //!
@@ -130,6 +176,25 @@
         TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds,
         TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd);
 
+    //-----------------------------------------------------------------------------
+    //! Copy the matrix pSrcMat to the pDstMat converting between the layouts.
+    //! Matching layouts are copied line by line, differing layouts are transposed in cache sized tiles.
+    //!
+    //! \param m The number of rows.
+    //! \param n The number of columns.
+    //! \param pSrcMat The source matrix.
+    //! \param lds The leading dimension of the source matrix.
+    //! \param eSrcLayout The layout of the source matrix.
+    //! \param pDstMat The destination matrix.
+    //! \param ldd The leading dimension of the destination matrix.
+    //! \param eDstLayout The layout of the destination matrix.
+    //-----------------------------------------------------------------------------
+    void matmul_mat_copy_layout(
+        TIdx const m,
+        TIdx const n,
+        TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds, EMatMulLayout const eSrcLayout,
+        TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd, EMatMulLayout const eDstLayout);
+
     //-----------------------------------------------------------------------------
     //! Rearrange the matrix so that blocks are continous for scatter.
     //!
@@ -143,15 +208,18 @@
     //! \param m The number of rows of the source matrix.
     //! \param n The number of columns of the source matrix.
     //! \param lds The leading dimension of the source matrix.
+    //! \param eSrcLayout The layout of the source matrix. The blocks are always stored row major.
     //! \param pBlockMajorMat 1D array containing the blocks of pSrcMat sequentialized row or column major depending on bColumnFirst.
     //! \param b The block size.
     //! \param bColumnFirst    If bColumnFirst is true the matrix is stored as:    1  2  5  6  3  4  7  8  9 10 13 14 11 12 15 16.
     //!                        If bColumnFirst is false the matrix is stored as:    1  2  5  6  9 10 13 14 3  4  7  8  11 12 15 16.
+    //! \param bTransposed If bTransposed is true the blocks of the transpose of pSrcMat are stored.
     //-----------------------------------------------------------------------------
     void matmul_mat_row_major_to_mat_x_block_major(
-        TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const m, TIdx const n, TIdx const lds,
+        TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const m, TIdx const n, TIdx const lds, EMatMulLayout const eSrcLayout,
         TElem * MATMUL_RESTRICT pBlockMajorMat, TIdx const b,
-        bool const bColumnFirst);
+        bool const bColumnFirst,
+        bool const bTransposed);
 
     //-----------------------------------------------------------------------------
     // Rearrange the matrix so that blocks are continous for scatter.
@@ -168,39 +236,44 @@
     //! \param m The number of rows of the destination matrix.
     //! \param n The number of columns of the destination matrix.
     //! \param ldd The leading dimension of the destination matrix.
+    //! \param eDstLayout The layout of the destination matrix. The blocks are always stored row major.
     //! \param bColumnFirst    If bColumnFirst is true the matrix is stored as:    1  2  5  6  3  4  7  8  9 10 13 14 11 12 15 16.
     //!                        If bColumnFirst is false the matrix is stored as:    1  2  5  6  9 10 13 14 3  4  7  8  11 12 15 16.
     //-----------------------------------------------------------------------------
     void matmul_mat_x_block_major_to_mat_row_major(
         TElem const * MATMUL_RESTRICT pBlockMajorMat, TIdx const b,
-        TElem * const MATMUL_RESTRICT pDstMat, TIdx const m, TIdx const n, TIdx const ldd,
+        TElem * const MATMUL_RESTRICT pDstMat, TIdx const m, TIdx const n, TIdx const ldd, EMatMulLayout const eDstLayout,
         bool const bColumnFirst);
 
     //-----------------------------------------------------------------------------
     //! \param pSrcMat The block to copy.
     //! \param lds The leading destination of the source matrix (pSrcMat).
+    //! \param eSrcLayout The layout of the source matrix (pSrcMat). The block is always stored row major.
     //! \param uiBlockIdxHorizontal The horizontal destination block index inside source matrix.
     //! \param uiBlockIdxVertical The vertical destination block index inside source matrix.
     //! \param pDstBlock The destination matrix to copy into.
     //! \param b The block size. This is the size of pDstBlock.
+    //! \param bTransposed If bTransposed is true the block is taken from the transpose of pSrcMat without forming it.
     //-----------------------------------------------------------------------------
     void matmul_mat_get_block(
-        TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds,
+        TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds, EMatMulLayout const eSrcLayout,
         TIdx const uiBlockIdxHorizontal,
         TIdx const uiBlockIdxVertical,
-        TElem * const MATMUL_RESTRICT pDstBlock, TIdx const b);
+        TElem * const MATMUL_RESTRICT pDstBlock, TIdx const b,
+        bool const bTransposed);
 
     //-----------------------------------------------------------------------------
     //! \param pSrcBlock The block to copy.
     //! \param b The block size. This is the size of pSrcBlock.
     //! \param pDstBlock The destination matrix to copy into.
     //! \param ldd The leading destination of the destination matrix (pDstBlock).
+    //! \param eDstLayout The layout of the destination matrix (pDstBlock). The block is always stored row major.
     //! \param uiBlockIdxHorizontal The horizontal destination block index inside destination matrix.
     //! \param uiBlockIdxVertical The vertical destination block index inside destination matrix.
     //-----------------------------------------------------------------------------
     void matmul_mat_set_block(
         TElem const * const MATMUL_RESTRICT pSrcBlock, TIdx const b,
-        TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd,
+        TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd, EMatMulLayout const eDstLayout,
         TIdx const uiBlockIdxHorizontal,
         TIdx const uiBlockIdxVertical);
 #ifdef __cplusplus
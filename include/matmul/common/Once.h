@@ -0,0 +1,50 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+    extern "C"
+    {
+#endif
+    //-----------------------------------------------------------------------------
+    //! A guard running an initialization exactly once per generation even if it is reached by multiple threads at the same time.
+    //! It has to be statically initialized with MATMUL_ONCE_INIT.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulOnce
+    {
+        long volatile iGeneration;      //!< The generation the initialization has been completed for. 0 if none.
+        long volatile iLock;            //!< 1 while a thread runs the initialization.
+    } SMatMulOnce;
+
+    #define MATMUL_ONCE_INIT {0, 0}
+
+    //-----------------------------------------------------------------------------
+    //! Runs pInit if it has not been completed for the given generation yet. Concurrent callers wait until it is completed.
+    //! All writes of pInit are visible to the callers after the return.
+    //!
+    //! \param pOnce The guard.
+    //! \param iGeneration A value greater than zero. If it differs from the one of the last call, pInit is run again, e.g. because its inputs have changed.
+    //! \param pInit The initialization.
+    //! \param pArg The argument of pInit, usually the state it initializes.
+    //-----------------------------------------------------------------------------
+    void matmul_once(
+        SMatMulOnce * const pOnce,
+        long const iGeneration,
+        void(*pInit)(void *),
+        void * const pArg);
+#ifdef __cplusplus
+    }
+#endif
@@ -0,0 +1,111 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include <matmul/common/Config.h>   // TElem, TIdx
+
+#include <stdbool.h>                // bool
+
+#ifdef __cplusplus
+    extern "C"
+    {
+#endif
+    //-----------------------------------------------------------------------------
+    //! The algorithms a plan can be created for.
+    //-----------------------------------------------------------------------------
+    typedef enum EMatMulPlanAlgo
+    {
+        EMatMulPlanAlgoSeqPacked,           //!< matmul_gemm_seq_packed (MATMUL_BUILD_SEQ_PACKED).
+        EMatMulPlanAlgoSeqStrassen,         //!< matmul_gemm_seq_strassen (MATMUL_BUILD_SEQ_STRASSEN).
+        EMatMulPlanAlgoParMpiCannon,        //!< matmul_gemm_par_mpi_cannon_block and matmul_gemm_par_mpi_cannon_nonblock (MATMUL_BUILD_PAR_MPI_CANNON_STD).
+        EMatMulPlanAlgoParMpiDns,           //!< matmul_gemm_par_mpi_dns (MATMUL_BUILD_PAR_MPI_DNS).
+    } EMatMulPlanAlgo;
+
+    //-----------------------------------------------------------------------------
+    //! The options of a plan. Zero initialized options select the defaults.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulPlanOptions
+    {
+        TIdx uiStrassenCutOff;              //!< The cut-off of the Strassen GEMM. 0 for the tuned one of matmul_tune_get.
+        bool bMpiNonBlockingComm;           //!< If the Cannon GEMM should use non-blocking MPI communication.
+    } SMatMulPlanOptions;
+
+    //-----------------------------------------------------------------------------
+    //! A GEMM of a fixed algorithm, shape and leading dimensions with its setup hoisted out of the calls.
+    //!
+    //! The handle is opaque. It keeps the workspaces, the MPI communicators and the tuned parameters of the algorithm so that matmul_plan_execute neither allocates memory nor sets up a topology.
+    //! The OpenMP runtime keeps its threads between parallel regions by itself so there is no thread state stored in the plan.
+    //! One plan must not be executed by multiple threads at the same time because they would share the workspaces.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulPlan SMatMulPlan;
+
+    //-----------------------------------------------------------------------------
+    //! Creates a plan. For the MPI algorithms this is a collective operation on MATMUL_MPI_COMM.
+    //!
+    //! \param eAlgo The algorithm.
+    //! \param m The number of rows of the matrix A and of the matrix C.
+    //! \param n The number of columns of the matrix B and of the matrix C.
+    //! \param k The number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param lda The leading dimension of A.
+    //! \param ldb The leading dimension of B.
+    //! \param ldc The leading dimension of C.
+    //! \param pOptions The options. May be 0 for the defaults.
+    //! \return The plan or 0 if the algorithm has not been built, does not support the shape or the setup failed.
+    //-----------------------------------------------------------------------------
+    SMatMulPlan * matmul_plan_create(
+        EMatMulPlanAlgo const eAlgo,
+        TIdx const m, TIdx const n, TIdx const k,
+        TIdx const lda, TIdx const ldb, TIdx const ldc,
+        SMatMulPlanOptions const * const pOptions);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C with the algorithm, the shape and the setup of the plan.
+    //! For the MPI algorithms this is a collective operation on MATMUL_MPI_COMM and all processes except root will ignore the matrices.
+    //!
+    //! \param pPlan The plan.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A The matrix A with the size and the leading dimension given at the creation of the plan.
+    //! \param B The matrix B with the size and the leading dimension given at the creation of the plan.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C The matrix C with the size and the leading dimension given at the creation of the plan.
+    //-----------------------------------------------------------------------------
+    void matmul_plan_execute(
+        SMatMulPlan * const pPlan,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A,
+        TElem const * const MATMUL_RESTRICT B,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C);
+
+    //-----------------------------------------------------------------------------
+    //! Checks the shape for the algorithms which only support square matrices (MPI Cannon and MPI DNS) and prints an error otherwise.
+    //!
+    //! \param pszAlgo The name of the algorithm used in the error message.
+    //! \return If m, n and k are equal.
+    //-----------------------------------------------------------------------------
+    bool matmul_plan_is_square(
+        TIdx const m, TIdx const n, TIdx const k,
+        char const * const pszAlgo);
+
+    //-----------------------------------------------------------------------------
+    //! Frees a plan created by matmul_plan_create. For the MPI algorithms this is a collective operation on MATMUL_MPI_COMM.
+    //!
+    //! \param pPlan The plan. May be 0.
+    //-----------------------------------------------------------------------------
+    void matmul_plan_destroy(
+        SMatMulPlan * const pPlan);
+#ifdef __cplusplus
+    }
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include <matmul/common/Config.h>   // TElem, TIdx
+
+#include <stdbool.h>                // bool
+
+//-----------------------------------------------------------------------------
+//! The maximum length of the micro-kernel name stored in the tuning parameters.
+//-----------------------------------------------------------------------------
+#define MATMUL_TUNE_MICRO_KERNEL_NAME_SIZE 16
+//-----------------------------------------------------------------------------
+//! The maximum number of entries of the tuning database including the ones of other CPU models.
+//-----------------------------------------------------------------------------
+#define MATMUL_TUNE_DB_SIZE 256
+
+#ifdef __cplusplus
+    extern "C"
+    {
+#endif
+    //-----------------------------------------------------------------------------
+    //! The parameters of the GEMM implementations which can be tuned at runtime.
+    //! The defaults of the blocked sequential GEMMs are derived from the cache sizes of matmul_cpu_get_cache_sizes (MATMUL_SEQ_BLOCK_FACTOR for all three if they are unknown).
+    //! The other defaults are the compile time settings (MATMUL_STRASSEN_CUT_OFF, MATMUL_STRASSEN_OMP_CUT_OFF, MATMUL_PACKED_MC, MATMUL_PACKED_KC, MATMUL_PACKED_NC).
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulTuneParams
+    {
+        TIdx uiSeqBlockMC;          //!< The number of rows of the blocks of A and C of the blocked sequential GEMMs (level 3 cache).
+        TIdx uiSeqBlockKC;          //!< The number of rows of the block of B of the blocked sequential GEMMs (level 2 cache).
+        TIdx uiSeqBlockNC;          //!< The number of columns of the blocks of B and C of the blocked sequential GEMMs (level 1 cache).
+        TIdx uiStrassenCutOff;      //!< The size up to which the sequential Strassen GEMM uses the conventional algorithm.
+        TIdx uiStrassenOmpCutOff;   //!< The size up to which the OpenMP Strassen GEMM uses the conventional algorithm.
+        TIdx uiPackedMC;            //!< The number of rows of the packed block of A.
+        TIdx uiPackedKC;            //!< The depth of the packed panels of A and B.
+        TIdx uiPackedNC;            //!< The number of columns of the packed panel of B.
+        char szMicroKernel[MATMUL_TUNE_MICRO_KERNEL_NAME_SIZE];    //!< The name of the micro-kernel of the packed GEMM. Empty for the automatic selection.
+    } SMatMulTuneParams;
+
+    //-----------------------------------------------------------------------------
+    //! The blocking of the blocked sequential GEMMs is recomputed on the first call after matmul_cpu_set_cache_sizes.
+    //!
+    //! \return The parameters used for shape classes which have not been tuned.
+    //-----------------------------------------------------------------------------
+    SMatMulTuneParams const * matmul_tune_get_defaults(void);
+
+    //-----------------------------------------------------------------------------
+    //! Looks up the tuned parameters for the shape class of the given problem on the current CPU.
+    //!
+    //! The shape class consists of the floor(log2) of each of the dimensions, the element type (s: float, d: double) and the CPU model.
+    //! The tuning database is loaded from the file given by the environment variable MATMUL_TUNE_DB on the first call. Concurrent first calls wait for a single load.
+    //! The entries of the current CPU are looked up in a hash index instead of searching the whole database.
+    //! There is one function per element type, matmul_tune_get is the one for TElem.
+    //!
+    //! \param m The number of rows of A and C.
+    //! \param n The number of columns of B and C.
+    //! \param k The number of columns of A and rows of B.
+    //! \return The tuned parameters or the defaults if the shape class has not been tuned.
+    //-----------------------------------------------------------------------------
+    SMatMulTuneParams const * matmul_tune_get_s(TIdx const m, TIdx const n, TIdx const k);
+    SMatMulTuneParams const * matmul_tune_get_d(TIdx const m, TIdx const n, TIdx const k);
+    SMatMulTuneParams const * matmul_tune_get(TIdx const m, TIdx const n, TIdx const k);
+
+    //-----------------------------------------------------------------------------
+    //! Stores the parameters for the shape class of the given problem on the current CPU for the element type TElem.
+    //! An existing entry is replaced. This is not thread safe with respect to concurrent GEMM calls.
+    //!
+    //! \param m The number of rows of A and C.
+    //! \param n The number of columns of B and C.
+    //! \param k The number of columns of A and rows of B.
+    //! \param pParams The parameters to use.
+    //-----------------------------------------------------------------------------
+    void matmul_tune_set(TIdx const m, TIdx const n, TIdx const k, SMatMulTuneParams const * const pParams);
+
+    //-----------------------------------------------------------------------------
+    //! Replaces the tuning database in memory with the contents of the given file.
+    //! The entries of all CPU models are kept so that saving the database does not lose them.
+    //!
+    //! \param pszPath The path of the tuning database.
+    //! \return If the file could be read.
+    //-----------------------------------------------------------------------------
+    bool matmul_tune_db_load(char const * const pszPath);
+
+    //-----------------------------------------------------------------------------
+    //! Writes the tuning database in memory to the given file.
+    //!
+    //! The file is a text file with one entry per line:
+    //! <cpu model>;<s|d>;<log2 m>;<log2 n>;<log2 k>;<block mc>;<block kc>;<block nc>;<strassen cut-off>;<strassen omp cut-off>;<mc>;<kc>;<nc>;<micro-kernel>
+    //!
+    //! \param pszPath The path of the tuning database.
+    //! \return If the file could be written.
+    //-----------------------------------------------------------------------------
+    bool matmul_tune_db_save(char const * const pszPath);
+#ifdef __cplusplus
+    }
+#endif
@@ -18,6 +18,16 @@
 #include <matmul/seq/SingleOpts.h>
 #include <matmul/seq/MultipleOpts.h>
 #include <matmul/seq/Strassen.h>
+#include <matmul/seq/Recursive.h>
+#include <matmul/seq/Small.h>
+#include <matmul/seq/Packed.h>
+#include <matmul/seq/MicroKernel.h>
+#include <matmul/seq/Epilogue.h>
+#include <matmul/seq/Prologue.h>
+#include <matmul/seq/Int8.h>
+#include <matmul/seq/Complex.h>
+#include <matmul/seq/Autotune.h>
+#include <matmul/seq/Jit.h>
 #include <matmul/par/Alpaka.h>
 #include <matmul/par/BlasCublas.h>
 #include <matmul/par/BlasMkl.h>
@@ -27,10 +37,20 @@
 #include <matmul/par/OpenAcc.h>
 #include <matmul/par/Omp.h>
 #include <matmul/par/StrassenOmp2.h>
+#include <matmul/par/StrassenOmp3.h>
+#include <matmul/par/PackedOmp2.h>
+#include <matmul/par/Batched.h>
+#include <matmul/par/Tiled.h>
 #include <matmul/par/PhiOffOmp.h>
 #include <matmul/par/PhiOffBlasMkl.h>
 
 #include <matmul/common/Alloc.h>
 #include <matmul/common/Array.h>
 #include <matmul/common/Config.h>
+#include <matmul/common/Cpu.h>
+#include <matmul/common/Dispatch.h>
+#include <matmul/common/Half.h>
 #include <matmul/common/Mat.h>
+#include <matmul/common/Once.h>
+#include <matmul/common/Plan.h>
+#include <matmul/common/Tune.h>
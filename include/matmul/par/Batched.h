@@ -0,0 +1,143 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_PAR_BATCHED
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! The sequential GEMM used for a single problem of a batch.
+    //! Problems below the size of the biggest fixed-size kernel are computed without packing, all others with matmul_gemm_seq_packed.
+    //!
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A Array, size lda-by-k. The leading m-by-k part of the array must contain the matrix A.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param B Array, size ldb-by-n. The leading k-by-n part of the array must contain the matrix B.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_batched_seq(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Batched (S/D)GEMM matrix-matrix products C[i] = alpha * A[i] * B[i] + beta * C[i] for i in [0, batchCount).
+    //!
+    //! The problems are distributed across the OpenMP threads, each problem is computed sequentially by matmul_gemm_batched_seq.
+    //! There is only a single fork/join for the whole batch.
+    //!
+    //! \param m Specifies the number of rows of the matrices A[i] and of the matrices C[i].
+    //! \param n Specifies the number of columns of the matrices B[i] and the number of columns of the matrices C[i].
+    //! \param k Specifies the number of columns of the matrices A[i] and the number of rows of the matrices B[i].
+    //! \param alpha Scalar value used to scale the products of the matrices A[i] and B[i].
+    //! \param A Array of batchCount pointers to the matrices A[i], each of size lda-by-k.
+    //! \param lda Specifies the leading dimension of the matrices A[i].
+    //! \param B Array of batchCount pointers to the matrices B[i], each of size ldb-by-n.
+    //! \param ldb Specifies the leading dimension of the matrices B[i].
+    //! \param beta Scalar value used to scale the matrices C[i].
+    //! \param C Array of batchCount pointers to the matrices C[i], each of size ldc-by-n. The matrices must not overlap.
+    //! \param ldc Specifies the leading dimension of the matrices C[i].
+    //! \param batchCount The number of problems.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_batched(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const * const A, TIdx const lda,
+        TElem const * const * const B, TIdx const ldb,
+        TElem const beta,
+        TElem * const * const C, TIdx const ldc,
+        TIdx const batchCount);
+
+    //-----------------------------------------------------------------------------
+    //! Strided batched (S/D)GEMM matrix-matrix products C + i*strideC = alpha * (A + i*strideA) * (B + i*strideB) + beta * (C + i*strideC) for i in [0, batchCount).
+    //!
+    //! The problems are distributed across the OpenMP threads, each problem is computed sequentially by matmul_gemm_batched_seq.
+    //! A stride of zero can be used to multiply all problems with the same A or B.
+    //!
+    //! \param m Specifies the number of rows of the matrices A[i] and of the matrices C[i].
+    //! \param n Specifies the number of columns of the matrices B[i] and the number of columns of the matrices C[i].
+    //! \param k Specifies the number of columns of the matrices A[i] and the number of rows of the matrices B[i].
+    //! \param alpha Scalar value used to scale the products of the matrices A[i] and B[i].
+    //! \param A Pointer to the first matrix A[0].
+    //! \param lda Specifies the leading dimension of the matrices A[i].
+    //! \param strideA The number of elements between the begin of A[i] and A[i+1].
+    //! \param B Pointer to the first matrix B[0].
+    //! \param ldb Specifies the leading dimension of the matrices B[i].
+    //! \param strideB The number of elements between the begin of B[i] and B[i+1].
+    //! \param beta Scalar value used to scale the matrices C[i].
+    //! \param C Pointer to the first matrix C[0]. The matrices must not overlap.
+    //! \param ldc Specifies the leading dimension of the matrices C[i].
+    //! \param strideC The number of elements between the begin of C[i] and C[i+1].
+    //! \param batchCount The number of problems.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_strided_batched(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const A, TIdx const lda, TIdx const strideA,
+        TElem const * const B, TIdx const ldb, TIdx const strideB,
+        TElem const beta,
+        TElem * const C, TIdx const ldc, TIdx const strideC,
+        TIdx const batchCount);
+
+    //-----------------------------------------------------------------------------
+    //! One problem C = alpha * A * B + beta * C of a grouped GEMM.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulGemmProblem
+    {
+        TIdx m;
+        TIdx n;
+        TIdx k;
+        TElem alpha;
+        TElem const * A;
+        TIdx lda;
+        TElem const * B;
+        TIdx ldb;
+        TElem beta;
+        TElem * C;
+        TIdx ldc;
+    } SMatMulGemmProblem;
+
+    //-----------------------------------------------------------------------------
+    //! Grouped (S/D)GEMM matrix-matrix products for problems with individual shapes, leading dimensions and scalars.
+    //!
+    //! The C matrices of all problems are split into MATMUL_GROUPED_TILE_SIZE-by-MATMUL_GROUPED_TILE_SIZE tiles forming a single pool.
+    //! The tiles are dynamically scheduled across the OpenMP threads, so the runtime depends on the total work rather than on the biggest problem.
+    //! The tiles of the problems with the biggest k, and therefore the most expensive tiles, are scheduled first.
+    //! Each tile is computed sequentially by matmul_gemm_batched_seq.
+    //!
+    //! \param pProblems Array of problemCount problems. The C matrices must not overlap.
+    //! \param problemCount The number of problems.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_grouped(
+        SMatMulGemmProblem const * const pProblems,
+        TIdx const problemCount);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
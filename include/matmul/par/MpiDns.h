@@ -17,11 +17,17 @@
 #ifdef MATMUL_BUILD_PAR_MPI_DNS
 
     #include <matmul/common/Config.h>   // TElem, TIdx
+    #include <matmul/common/Mat.h>      // EMatMulLayout
 
     #ifdef __cplusplus
         extern "C"
         {
     #endif
+    //-----------------------------------------------------------------------------
+    //! The 3D mesh, its planes and rings and the local block buffers of the DNS algorithm for one matrix size.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulMpiDnsPlan SMatMulMpiDnsPlan;
+
     //-----------------------------------------------------------------------------
     //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the DNS algorithm with MPI communication and the basic optimized sequential GEMM for local computation.
     //!
@@ -49,6 +55,105 @@
         TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
         TElem const beta,
         TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * op(A) * op(B) + beta * C with op(X) = X or op(X) = X^T using the DNS algorithm with MPI communication and the basic optimized sequential GEMM for local computation.
+    //! The root transposes the blocks of transposed operands while scattering them, the full transposes are never formed.
+    //!
+    //! \param transA 'N' if op(A) = A, 'T' or 'C' if op(A) = A^T.
+    //! \param transB 'N' if op(B) = B, 'T' or 'C' if op(B) = B^T.
+    //! \param m Specifies the number of rows of the matrix op(A) and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix op(B) and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix op(A) and the number of rows of the matrix op(B).
+    //! \param alpha Scalar value used to scale the product of matrices op(A) and op(B).
+    //! \param A The matrix A. All processes except root will ignore the value.
+    //! \param lda Specifies the leading dimension of A. All processes except root will ignore the value.
+    //! \param B The matrix B. All processes except root will ignore the value.
+    //! \param ldb Specifies the leading dimension of B. All processes except root will ignore the value.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C. All processes except root will ignore the value.
+    //! \param ldc Specifies the leading dimension of C. All processes except root will ignore the value.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_dns_trans(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * op(A) * op(B) + beta * C with a row or column major layout per matrix using the DNS algorithm with MPI communication and the basic optimized sequential GEMM for local computation.
+    //! The root converts the blocks of column major and transposed matrices while scattering and gathering them, the matrices are never converted as a whole.
+    //!
+    //! \param eLayoutA The layout of A. All processes except root will ignore the value.
+    //! \param transA 'N' if op(A) = A, 'T' or 'C' if op(A) = A^T.
+    //! \param eLayoutB The layout of B. All processes except root will ignore the value.
+    //! \param transB 'N' if op(B) = B, 'T' or 'C' if op(B) = B^T.
+    //! \param eLayoutC The layout of C. All processes except root will ignore the value.
+    //! \param m Specifies the number of rows of the matrix op(A) and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix op(B) and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix op(A) and the number of rows of the matrix op(B).
+    //! \param alpha Scalar value used to scale the product of matrices op(A) and op(B).
+    //! \param A The matrix A. All processes except root will ignore the value.
+    //! \param lda Specifies the leading dimension of A. All processes except root will ignore the value.
+    //! \param B The matrix B. All processes except root will ignore the value.
+    //! \param ldb Specifies the leading dimension of B. All processes except root will ignore the value.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C The matrix C. All processes except root will ignore the value.
+    //! \param ldc Specifies the leading dimension of C. All processes except root will ignore the value.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_dns_layout(
+        EMatMulLayout const eLayoutA, char const transA,
+        EMatMulLayout const eLayoutB, char const transB,
+        EMatMulLayout const eLayoutC,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Creates the 3D mesh topology with its planes and rings and the local buffers of the DNS algorithm once for repeated products of n x n matrices.
+    //! This is a collective operation on MATMUL_MPI_COMM.
+    //!
+    //! \param n The size of the square matrices.
+    //! \return The plan or 0 on all processes if the number of processes is no perfect cube or n can not be divided among them.
+    //-----------------------------------------------------------------------------
+    SMatMulMpiDnsPlan * matmul_gemm_par_mpi_dns_plan_create(
+        TIdx const n);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the DNS algorithm set up by matmul_gemm_par_mpi_dns_plan_create.
+    //! This is a collective operation on MATMUL_MPI_COMM. No memory is allocated and no communicator is created.
+    //!
+    //! \param pPlan The plan.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A Array, size lda-by-n. All processes except root will ignore the value.
+    //! \param lda Specifies the leading dimension of A. All processes except root will ignore the value.
+    //! \param B Array, size ldb-by-n. All processes except root will ignore the value.
+    //! \param ldb Specifies the leading dimension of B. All processes except root will ignore the value.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. All processes except root will ignore the value.
+    //! \param ldc Specifies the leading dimension of C. All processes except root will ignore the value.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_dns_plan_execute(
+        SMatMulMpiDnsPlan const * const pPlan,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Frees the communicators and the buffers of the plan. This is a collective operation on MATMUL_MPI_COMM.
+    //!
+    //! \param pPlan The plan. May be 0.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_dns_plan_destroy(
+        SMatMulMpiDnsPlan * const pPlan);
     #ifdef __cplusplus
         }
     #endif
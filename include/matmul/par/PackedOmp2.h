@@ -0,0 +1,94 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef MATMUL_BUILD_PAR_PACKED_OMP2
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+    #include <matmul/seq/Epilogue.h>    // SMatMulEpilogue
+    #include <matmul/seq/Prologue.h>    // SMatMulPrologue
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    #if _OPENMP >= 200203   // OpenMP 2.0
+        //-----------------------------------------------------------------------------
+        //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the packed GEMM with OpenMP 2.0 parallel for.
+        //!
+        //! The loops, block sizes and micro-kernel are the ones of matmul_gemm_seq_packed.
+        //! Each kc-by-nc panel of B is packed once by all threads together and shared, the row blocks of A are distributed across the threads which pack them into their own buffers.
+        //! The row blocks are made smaller than MATMUL_PACKED_MC if there would be fewer of them than threads.
+        //!
+        //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+        //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+        //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+        //! \param alpha Scalar value used to scale the product of matrices A and B.
+        //! \param A Array, size lda-by-k. The leading m-by-k part of the array must contain the matrix A.
+        //! \param lda Specifies the leading dimension of A.
+        //! \param B Array, size ldb-by-n. The leading k-by-n part of the array must contain the matrix B.
+        //! \param ldb Specifies the leading dimension of B.
+        //! \param beta Scalar value used to scale matrix C.
+        //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+        //! \param ldc Specifies the leading dimension of C.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_packed_omp2(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+        //-----------------------------------------------------------------------------
+        //! matmul_gemm_par_packed_omp2 with the epilogue fused like in matmul_gemm_seq_packed_epilogue.
+        //! Each thread applies the epilogue to the tiles of its row blocks for the last panel along k.
+        //! If the epilogue stores the result into pOut and k exceeds the panel depth, each thread accumulates its row blocks in its own MC-by-NC buffer and C is left unchanged.
+        //!
+        //! \param pEpilogue The epilogue. 0 computes the same as matmul_gemm_par_packed_omp2.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_packed_omp2_epilogue(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+            SMatMulEpilogue const * const pEpilogue);
+
+        //-----------------------------------------------------------------------------
+        //! matmul_gemm_par_packed_omp2 with the prologues and the epilogue fused like in matmul_gemm_seq_packed_fused.
+        //! The prologue of B is applied by the threads packing the shared panel, the one of A by each thread packing its row blocks.
+        //!
+        //! \param pPrologueA The prologue of A or 0.
+        //! \param pPrologueB The prologue of B or 0.
+        //! \param pEpilogue The epilogue or 0.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_packed_omp2_fused(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            SMatMulPrologue const * const pPrologueA,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            SMatMulPrologue const * const pPrologueB,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+            SMatMulEpilogue const * const pEpilogue);
+    #endif
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
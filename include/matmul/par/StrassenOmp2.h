@@ -18,6 +18,8 @@
 
     #include <matmul/common/Config.h>   // TElem, TIdx
 
+    #include <stdbool.h>                // bool
+
     #ifdef __cplusplus
         extern "C"
         {
@@ -65,6 +67,29 @@
             TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
             TElem * const MATMUL_RESTRICT C, TIdx const ldc);
 
+        //-----------------------------------------------------------------------------
+        //! Matrix-matrix addition C := A + fSign * B if bOverwrite, else C += A + fSign * B using OpenMP parallel for.
+        //! The quadrants of the result of the Strassen recursion are written with it directly, for beta == 0 without reading them.
+        //!
+        //! \param m Specifies the number of rows of the matrices A, B and C.
+        //! \param n Specifies the number of columns of the matrices A, B and C.
+        //! \param A Array, size lda-by-n. The leading m-by-n part of the array must contain the matrix A.
+        //! \param lda Specifies the leading dimension of A.
+        //! \param fSign The factor of B, 1 or -1.
+        //! \param B Array, size ldb-by-n. The leading m-by-n part of the array must contain the matrix B.
+        //! \param ldb Specifies the leading dimension of B.
+        //! \param bOverwrite If C is overwritten with the sum instead of being incremented by it. C does not have to be initialized then.
+        //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+        //! \param ldc Specifies the leading dimension of C.
+        //-----------------------------------------------------------------------------
+        void matmul_mat_add_sum_pitch_par_omp2(
+            TIdx const m, TIdx const n,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const fSign,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            bool const bOverwrite,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
         //-----------------------------------------------------------------------------
         //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the (Volker) Strassen algorithm.
         //!
@@ -81,10 +106,11 @@
         //! \param ldc Specifies the leading dimension of C.
         //!
         //! Theoretical Runtime is O(n^log2(7)) = O(n^2.807).
-        //! Assume NxN matrices where n is even.
+        //! Any m, n and k are supported by dynamic peeling like in matmul_gemm_seq_strassen.
+        //! The rank-1 update and the last column for odd k and n are distributed across the rows, the last row for odd m across the columns.
         //! Algorithm:
         //!   Matrices X and Y are split into four smaller
-        //!   (n/2)x(n/2) matrices as follows:
+        //!   (m/2)x(k/2) and (k/2)x(n/2) matrices as follows:
         //!          _    _          _   _
         //!     X = | A  B |    Y = | E F |
         //!         | C  D |        | G H |
@@ -113,6 +139,101 @@
             TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
             TElem const beta,
             TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+        //-----------------------------------------------------------------------------
+        //! The OpenMP Strassen GEMM with an explicit cut-off.
+        //! matmul_gemm_par_strassen_omp2 calls it with the cut-off of matmul_tune_get (MATMUL_STRASSEN_OMP_CUT_OFF if not tuned).
+        //!
+        //! \param uiCutOff The size up to which the conventional algorithm is used instead of further recursive calculation.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_cut_off(
+            TIdx const uiCutOff,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+        //-----------------------------------------------------------------------------
+        //! \return The number of elements of the workspace matmul_gemm_par_strassen_omp2_workspace needs for the given problem and cut-off.
+        //! Each recursion level needs seven (m/2)x(n/2) temporaries for the products and one for a sum of quadrants of each operand.
+        //! The levels below share the rest of the workspace because they are executed one after the other.
+        //-----------------------------------------------------------------------------
+        TIdx matmul_gemm_par_strassen_omp2_workspace_size(
+            TIdx const uiCutOff,
+            TIdx const m, TIdx const n, TIdx const k);
+
+        //-----------------------------------------------------------------------------
+        //! The OpenMP Strassen GEMM with an explicit cut-off computing all temporaries in a workspace given by the caller.
+        //! Nothing is allocated inside of the recursion and the workspace does not have to be initialized.
+        //!
+        //! \param uiCutOff The size up to which the conventional algorithm is used instead of further recursive calculation.
+        //! \param pWorkspace The workspace of at least matmul_gemm_par_strassen_omp2_workspace_size(uiCutOff, m, n, k) elements.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_workspace(
+            TIdx const uiCutOff,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+            TElem * const MATMUL_RESTRICT pWorkspace);
+
+        //-----------------------------------------------------------------------------
+        //! \return If the recursion ends for the given problem and cut-off. Odd sizes do not end it, they are peeled.
+        //-----------------------------------------------------------------------------
+        bool matmul_gemm_par_strassen_omp2_is_leaf(
+            TIdx const uiCutOff,
+            TIdx const m, TIdx const n, TIdx const k);
+
+        //-----------------------------------------------------------------------------
+        //! Scales the m x n matrix C by beta using OpenMP parallel for. For beta == 0 C is set to zero instead if bSet, else nothing is done.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_scale(
+            TIdx const m, TIdx const n,
+            TElem const beta,
+            bool const bSet,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+        //-----------------------------------------------------------------------------
+        //! The conventional algorithm used for the recursion leaves and the peeled fringes.
+        //! C is set instead of scaled for beta == 0 because the products are computed into the uninitialized workspace.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_leaf(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+        //-----------------------------------------------------------------------------
+        //! The vector-matrix product c = alpha * a * B + beta * c of a peeled last row.
+        //! matmul_gemm_par_omp2_static_schedule distributes the rows, here the columns are distributed in blocks.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_row(
+            TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT a,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT c);
+
+        //-----------------------------------------------------------------------------
+        //! Dynamic peeling: Computes the parts of C the recursion on the even sized leading parts of A and B leaves out.
+        //! The even sized leading part C(0:m2, 0:n2) already has to contain alpha * A(0:m2, 0:k2) * B(0:k2, 0:n2) + beta * C.
+        //! For odd k it gets the rank-1 update with the last column of A and the last row of B.
+        //! For odd n the last column and for odd m the last row of C are computed by the conventional algorithm.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_peel(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
     #endif
     #ifdef __cplusplus
         }
@@ -0,0 +1,154 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_PAR_STRASSEN_OMP3
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    #if _OPENMP >= 200805   // OpenMP 3.0
+        //-----------------------------------------------------------------------------
+        //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the Strassen algorithm with OpenMP 3.0 tasks.
+        //!
+        //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+        //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+        //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+        //! \param alpha Scalar value used to scale the product of matrices A and B.
+        //! \param A Array, size lda-by-k. The leading m-by-k part of the array must contain the matrix A.
+        //! \param lda Specifies the leading dimension of A.
+        //! \param B Array, size ldb-by-n. The leading k-by-n part of the array must contain the matrix B.
+        //! \param ldb Specifies the leading dimension of B.
+        //! \param beta Scalar value used to scale matrix C.
+        //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+        //! \param ldc Specifies the leading dimension of C.
+        //!
+        //! The formulas and the peeling of odd sizes are the ones of matmul_gemm_seq_strassen.
+        //! Other than matmul_gemm_par_strassen_omp2, which executes the seven products one after the other and parallelizes each addition and leaf GEMM, the seven products of a level are independent tasks.
+        //! Each task forms its sums of quadrants in its own part of the workspace, see matmul_gemm_par_strassen_omp3_workspace_size for the memory this costs. The peeled last row and column are tasks next to them, the four quadrants of C are combined by four more tasks.
+        //! Below the task depth each task computes its product with matmul_gemm_seq_strassen, so the leaf GEMMs run single-threaded and a single fork at the top keeps all threads busy on the 7-way tree.
+        //! The task depth is MATMUL_STRASSEN_OMP_TASK_DEPTH, by default the smallest one giving at least two tasks per thread.
+        //! The cut-off is the one of the sequential Strassen GEMM from matmul_tune_get (MATMUL_STRASSEN_CUT_OFF if not tuned).
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+        //-----------------------------------------------------------------------------
+        //! The OpenMP task Strassen GEMM with an explicit cut-off and task depth.
+        //!
+        //! \param uiCutOff The size up to which the conventional algorithm is used instead of further recursive calculation.
+        //! \param uiTaskDepth The number of recursion levels creating tasks. 0 chooses the smallest one giving at least two tasks per thread of omp_get_max_threads.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3_cut_off(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+        //-----------------------------------------------------------------------------
+        //! \return The number of elements of the workspace matmul_gemm_par_strassen_omp3_workspace needs for the given problem, cut-off and task depth.
+        //! The seven tasks of a level run concurrently so each of them gets its own temporaries and workspace for the levels below.
+        //! Each task level therefore reserves seven times the workspace of one task: For n x n matrices about 10.5*n*n elements at task depth 1 and 23.6*n*n at depth 2,
+        //! compared to about 3*n*n for matmul_gemm_seq_strassen and less than n*n for matmul_gemm_seq_strassen_winograd.
+        //-----------------------------------------------------------------------------
+        TIdx matmul_gemm_par_strassen_omp3_workspace_size(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k);
+
+        //-----------------------------------------------------------------------------
+        //! The OpenMP task Strassen GEMM computing all temporaries in a workspace given by the caller.
+        //! Nothing is allocated inside of the recursion and the workspace does not have to be initialized.
+        //!
+        //! \param uiCutOff The size up to which the conventional algorithm is used instead of further recursive calculation.
+        //! \param uiTaskDepth The number of recursion levels creating tasks. 0 chooses it like matmul_gemm_par_strassen_omp3_cut_off.
+        //! \param pWorkspace The workspace of at least matmul_gemm_par_strassen_omp3_workspace_size(uiCutOff, uiTaskDepth, m, n, k) elements.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3_workspace(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+            TElem * const MATMUL_RESTRICT pWorkspace);
+
+        //-----------------------------------------------------------------------------
+        //! \return The task depth to use. 0 is replaced by the smallest depth giving at least two tasks per thread.
+        //-----------------------------------------------------------------------------
+        TIdx matmul_gemm_par_strassen_omp3_task_depth(
+            TIdx const uiTaskDepth);
+
+        //-----------------------------------------------------------------------------
+        //! Combines one quadrant of C from the products: C := beta * C + P0 + fSign0 * P1 + P2 + fSign1 * P3.
+        //! P2 and P3 are optional. For beta == 0 C is not read.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3_combine(
+            TIdx const m, TIdx const n,
+            TElem const * const MATMUL_RESTRICT P0,
+            TElem const fSign0,
+            TElem const * const MATMUL_RESTRICT P1,
+            TElem const * const MATMUL_RESTRICT P2,
+            TElem const fSign1,
+            TElem const * const MATMUL_RESTRICT P3,
+            TIdx const ldp,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+        //-----------------------------------------------------------------------------
+        //! \return The number of elements of the workspace matmul_gemm_par_strassen_omp3_task needs for the given problem, cut-off and task depth.
+        //! Other than in matmul_gemm_par_strassen_omp3_workspace_size a task depth of 0 is not replaced, it means the sequential recursion.
+        //-----------------------------------------------------------------------------
+        TIdx matmul_gemm_par_strassen_omp3_workspace_size_depth(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k);
+
+        //-----------------------------------------------------------------------------
+        //! One recursion level creating tasks. Has to be called by a single thread of a parallel region.
+        //! Below the task depth and at the leaves it computes the product with matmul_gemm_seq_strassen_workspace.
+        //!
+        //! \param uiTaskDepth The number of recursion levels still creating tasks.
+        //! \param pWorkspace The workspace of at least matmul_gemm_par_strassen_omp3_workspace_size_depth(uiCutOff, uiTaskDepth, m, n, k) elements.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3_task(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+            TElem * const MATMUL_RESTRICT pWorkspace);
+    #endif
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
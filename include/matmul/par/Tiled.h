@@ -0,0 +1,150 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_PAR_TILED
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+    #include <matmul/common/Mat.h>      // EMatMulLayout
+
+    #include <stdbool.h>                // bool
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! A matrix stored as b x b tiles.
+    //!
+    //! Each tile is stored row major and continuous. The tiles are laid out in Morton (Z) order of their tile coordinates,
+    //! so that tiles which are close in both dimensions are close in memory at every scale.
+    //! For tile grids which are not square powers of two the Morton order skips the tiles outside of the grid.
+    //! The tiles at the right and bottom border are padded with zeros up to the full tile size.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulTiledMat
+    {
+        TIdx m;                     //!< The number of rows.
+        TIdx n;                     //!< The number of columns.
+        TIdx b;                     //!< The number of rows and columns of a tile.
+        TIdx uiTileRows;            //!< The number of tile rows, ceil(m/b).
+        TIdx uiTileCols;            //!< The number of tile columns, ceil(n/b).
+        TIdx * puiTileOffsets;      //!< The offset of each tile in pData indexed by row major tile coordinates.
+        TElem * pData;              //!< The tiles.
+    } SMatMulTiledMat;
+
+    //-----------------------------------------------------------------------------
+    //! Allocates a tiled matrix filled with zeros.
+    //!
+    //! \param pMat The matrix to initialize.
+    //! \param m The number of rows.
+    //! \param n The number of columns.
+    //! \param b The number of rows and columns of a tile.
+    //! \return If the memory could be allocated.
+    //-----------------------------------------------------------------------------
+    bool matmul_tiled_mat_alloc(
+        SMatMulTiledMat * const pMat,
+        TIdx const m, TIdx const n,
+        TIdx const b);
+
+    //-----------------------------------------------------------------------------
+    //! Frees the memory of a tiled matrix allocated by matmul_tiled_mat_alloc.
+    //!
+    //! \param pMat The matrix to free.
+    //-----------------------------------------------------------------------------
+    void matmul_tiled_mat_free(
+        SMatMulTiledMat * const pMat);
+
+    //-----------------------------------------------------------------------------
+    //! \param pMat The tiled matrix.
+    //! \param uiTileRow The row of the tile in the tile grid.
+    //! \param uiTileCol The column of the tile in the tile grid.
+    //! \return The b x b row major tile.
+    //-----------------------------------------------------------------------------
+    TElem * matmul_tiled_mat_get_tile(
+        SMatMulTiledMat const * const pMat,
+        TIdx const uiTileRow, TIdx const uiTileCol);
+
+    //-----------------------------------------------------------------------------
+    //! Copies a matrix into a tiled matrix of the same size. The padding of the border tiles is set to zero.
+    //! The tiles are distributed across the OpenMP threads. Rows of row major tiles are copied with memcpy, column major matrices are transposed in cache sized tiles.
+    //!
+    //! \param pSrcMat The source matrix.
+    //! \param lds The leading dimension of the source matrix.
+    //! \param eSrcLayout The layout of the source matrix.
+    //! \param pDstMat The destination tiled matrix.
+    //-----------------------------------------------------------------------------
+    void matmul_tiled_mat_from_mat(
+        TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds, EMatMulLayout const eSrcLayout,
+        SMatMulTiledMat * const pDstMat);
+
+    //-----------------------------------------------------------------------------
+    //! Copies a tiled matrix into a matrix of the same size. The padding of the border tiles is ignored.
+    //! The tiles are distributed across the OpenMP threads.
+    //!
+    //! \param pSrcMat The source tiled matrix.
+    //! \param pDstMat The destination matrix.
+    //! \param ldd The leading dimension of the destination matrix.
+    //! \param eDstLayout The layout of the destination matrix.
+    //-----------------------------------------------------------------------------
+    void matmul_tiled_mat_to_mat(
+        SMatMulTiledMat const * const pSrcMat,
+        TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd, EMatMulLayout const eDstLayout);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C on tiled matrices without converting them.
+    //!
+    //! The tiles of C are distributed across the OpenMP threads. Each one is computed from the continuous tiles of A and B without packing.
+    //! All matrices have to use the same tile size.
+    //!
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A The m x k tiled matrix A.
+    //! \param B The k x n tiled matrix B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C The m x n tiled matrix C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_tiled(
+        TElem const alpha,
+        SMatMulTiledMat const * const A,
+        SMatMulTiledMat const * const B,
+        TElem const beta,
+        SMatMulTiledMat * const C);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C converting the row major matrices to tiled matrices with MATMUL_TILED_TILE_SIZE x MATMUL_TILED_TILE_SIZE tiles for matmul_gemm_par_tiled and back.
+    //! This includes the conversions. Pipelines which keep their matrices tiled should call matmul_gemm_par_tiled directly.
+    //!
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A Array, size lda-by-k. The leading m-by-k part of the array must contain the matrix A.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param B Array, size ldb-by-n. The leading k-by-n part of the array must contain the matrix B.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_tiled_row_major(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_AUTOTUNE
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+    #include <matmul/common/Tune.h>     // SMatMulTuneParams
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! Searches the fastest parameters for the shape class of the given problem and stores them in the tuning database in memory.
+    //!
+    //! Only the implementations which are built are tuned:
+    //! - MC, KC and NC of the blocked sequential GEMMs,
+    //! - the micro-kernel, MC, KC and NC of the packed GEMM,
+    //! - the cut-offs of the sequential and the OpenMP Strassen GEMM (square problems only).
+    //! Each parameter is searched on its own starting from the current parameters of the shape class.
+    //! The candidates are timed on random matrices of the given size, the fastest of the repetitions counts.
+    //! Small problems are called multiple times per repetition so that each one takes at least a millisecond.
+    //! Block size candidates larger than the blocked dimension and Strassen cut-offs below 16 are not tried.
+    //! Problems with a dimension below 32 are not tuned, the current parameters are returned and the database is not changed.
+    //! matmul_tune_db_save persists the results.
+    //!
+    //! \param m The number of rows of A and C.
+    //! \param n The number of columns of B and C.
+    //! \param k The number of columns of A and rows of B.
+    //! \param uiRepeatCount The number of times each candidate is timed.
+    //! \return The fastest parameters.
+    //-----------------------------------------------------------------------------
+    SMatMulTuneParams matmul_autotune_seq(
+        TIdx const m, TIdx const n, TIdx const k,
+        TIdx const uiRepeatCount);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
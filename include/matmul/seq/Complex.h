@@ -0,0 +1,175 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_COMPLEX
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! The interleaved complex element types. The real and the imaginary part are stored consecutively like in BLAS.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulComplexS
+    {
+        float re;
+        float im;
+    } SMatMulComplexS;
+    typedef struct SMatMulComplexD
+    {
+        double re;
+        double im;
+    } SMatMulComplexD;
+    #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        typedef SMatMulComplexD TMatMulComplex;
+    #else
+        typedef SMatMulComplexS TMatMulComplex;
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //! The ways to build the complex product from real GEMMs.
+    //-----------------------------------------------------------------------------
+    typedef enum EMatMulComplexAlgo
+    {
+        EMatMulComplexAlgoAuto,     //!< 3M if all dimensions are at least MATMUL_COMPLEX_3M_MIN_SIZE, else 4M.
+        EMatMulComplexAlgo4M,       //!< Four real products: Re = Ar*Br - Ai*Bi, Im = Ar*Bi + Ai*Br.
+        EMatMulComplexAlgo3M        //!< Three real products: Re = Ar*Br - Ai*Bi, Im = (Ar+Ai)*(Br+Bi) - Ar*Br - Ai*Bi.
+    } EMatMulComplexAlgo;
+
+    //-----------------------------------------------------------------------------
+    //! Complex GEMM C = alpha * A * B + beta * C with interleaved storage (c: float, z: double).
+    //!
+    //! Both methods compute the real products with the packed GEMM.
+    //! The real and imaginary parts of A and B are read directly from the interleaved storage while packing.
+    //! C is split into planar buffers for the computation because the micro-kernels write contiguous rows.
+    //! The 3M method saves one of the four real products but needs buffers for Ar+Ai, Br+Bi and two products.
+    //! Its imaginary part is less accurate because it is computed as a difference of larger terms.
+    //! If beta is zero, C is not read.
+    //!
+    //! \param eAlgo The method used to build the complex product from real products.
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A Array, size m-by-k.
+    //! \param lda Specifies the leading dimension of A in complex elements.
+    //! \param B Array, size k-by-n.
+    //! \param ldb Specifies the leading dimension of B in complex elements.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size m-by-n.
+    //! \param ldc Specifies the leading dimension of C in complex elements.
+    //-----------------------------------------------------------------------------
+    void matmul_cgemm_seq(
+        EMatMulComplexAlgo const eAlgo,
+        TIdx const m, TIdx const n, TIdx const k,
+        SMatMulComplexS const alpha,
+        SMatMulComplexS const * const MATMUL_RESTRICT A, TIdx const lda,
+        SMatMulComplexS const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulComplexS const beta,
+        SMatMulComplexS * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_zgemm_seq(
+        EMatMulComplexAlgo const eAlgo,
+        TIdx const m, TIdx const n, TIdx const k,
+        SMatMulComplexD const alpha,
+        SMatMulComplexD const * const MATMUL_RESTRICT A, TIdx const lda,
+        SMatMulComplexD const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulComplexD const beta,
+        SMatMulComplexD * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Complex GEMM C = alpha * A * B + beta * C with split (planar) storage.
+    //! The real and the imaginary parts of each matrix are separate real matrices sharing the leading dimension.
+    //! C is computed in place.
+    //!
+    //! The other parameters are the same as the ones of matmul_cgemm_seq.
+    //-----------------------------------------------------------------------------
+    void matmul_cgemm_seq_planar(
+        EMatMulComplexAlgo const eAlgo,
+        TIdx const m, TIdx const n, TIdx const k,
+        SMatMulComplexS const alpha,
+        float const * const MATMUL_RESTRICT ARe, float const * const MATMUL_RESTRICT AIm, TIdx const lda,
+        float const * const MATMUL_RESTRICT BRe, float const * const MATMUL_RESTRICT BIm, TIdx const ldb,
+        SMatMulComplexS const beta,
+        float * const MATMUL_RESTRICT CRe, float * const MATMUL_RESTRICT CIm, TIdx const ldc);
+    void matmul_zgemm_seq_planar(
+        EMatMulComplexAlgo const eAlgo,
+        TIdx const m, TIdx const n, TIdx const k,
+        SMatMulComplexD const alpha,
+        double const * const MATMUL_RESTRICT ARe, double const * const MATMUL_RESTRICT AIm, TIdx const lda,
+        double const * const MATMUL_RESTRICT BRe, double const * const MATMUL_RESTRICT BIm, TIdx const ldb,
+        SMatMulComplexD const beta,
+        double * const MATMUL_RESTRICT CRe, double * const MATMUL_RESTRICT CIm, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! The naive complex GEMM with interleaved storage. It is used to verify the results.
+    //!
+    //! The parameters are the same as the ones of matmul_cgemm_seq.
+    //-----------------------------------------------------------------------------
+    void matmul_cgemm_seq_basic(
+        TIdx const m, TIdx const n, TIdx const k,
+        SMatMulComplexS const alpha,
+        SMatMulComplexS const * const MATMUL_RESTRICT A, TIdx const lda,
+        SMatMulComplexS const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulComplexS const beta,
+        SMatMulComplexS * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_zgemm_seq_basic(
+        TIdx const m, TIdx const n, TIdx const k,
+        SMatMulComplexD const alpha,
+        SMatMulComplexD const * const MATMUL_RESTRICT A, TIdx const lda,
+        SMatMulComplexD const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulComplexD const beta,
+        SMatMulComplexD * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! The complex GEMM for the complex type of TElem with interleaved storage.
+    //! matmul_gemm_seq_complex selects the method automatically.
+    //!
+    //! The parameters are the same as the ones of matmul_cgemm_seq without eAlgo.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_complex(
+        TIdx const m, TIdx const n, TIdx const k,
+        TMatMulComplex const alpha,
+        TMatMulComplex const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulComplex const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TMatMulComplex const beta,
+        TMatMulComplex * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_gemm_seq_complex_4m(
+        TIdx const m, TIdx const n, TIdx const k,
+        TMatMulComplex const alpha,
+        TMatMulComplex const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulComplex const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TMatMulComplex const beta,
+        TMatMulComplex * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_gemm_seq_complex_3m(
+        TIdx const m, TIdx const n, TIdx const k,
+        TMatMulComplex const alpha,
+        TMatMulComplex const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulComplex const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TMatMulComplex const beta,
+        TMatMulComplex * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_gemm_seq_complex_basic(
+        TIdx const m, TIdx const n, TIdx const k,
+        TMatMulComplex const alpha,
+        TMatMulComplex const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulComplex const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TMatMulComplex const beta,
+        TMatMulComplex * const MATMUL_RESTRICT C, TIdx const ldc);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
@@ -0,0 +1,308 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// The complex GEMM for one real element type.
+// This file is included once per instantiation by src/seq/Complex.c so that both precisions are compiled from the same source.
+//
+// MATMUL_COMPLEX_T             The real element type.
+// MATMUL_COMPLEX_TYPE          The interleaved complex element type.
+// MATMUL_COMPLEX_PREFIX        The BLAS prefix of the generated functions (c, z).
+// MATMUL_COMPLEX_REAL_GEMM     The strided real GEMM for MATMUL_COMPLEX_T.
+//
+// The parameters are undefined at the end of the file.
+//-----------------------------------------------------------------------------
+
+#define MATMUL_COMPLEX_CONCAT2(a, b) a##b
+#define MATMUL_COMPLEX_CONCAT(a, b) MATMUL_COMPLEX_CONCAT2(a, b)
+#define MATMUL_COMPLEX_NAME(name) MATMUL_COMPLEX_CONCAT(MATMUL_COMPLEX_CONCAT(matmul_, MATMUL_COMPLEX_PREFIX), name)
+
+//-----------------------------------------------------------------------------
+//! The complex GEMM on a planar C with the parts of A and B given by row and column strides.
+//-----------------------------------------------------------------------------
+void MATMUL_COMPLEX_NAME(gemm_seq_parts)(
+    EMatMulComplexAlgo const eAlgo,
+    TIdx const m, TIdx const n, TIdx const k,
+    MATMUL_COMPLEX_TYPE const alpha,
+    MATMUL_COMPLEX_T const * const ARe, MATMUL_COMPLEX_T const * const AIm, TIdx const rsa, TIdx const csa,
+    MATMUL_COMPLEX_T const * const BRe, MATMUL_COMPLEX_T const * const BIm, TIdx const rsb, TIdx const csb,
+    MATMUL_COMPLEX_TYPE const beta,
+    MATMUL_COMPLEX_T * const MATMUL_RESTRICT CRe, MATMUL_COMPLEX_T * const MATMUL_RESTRICT CIm, TIdx const ldc)
+{
+    if((m == 0) || (n == 0))
+    {
+        return;
+    }
+
+    bool const bProduct = (k != 0) && ((alpha.re != (MATMUL_COMPLEX_T)0) || (alpha.im != (MATMUL_COMPLEX_T)0));
+    bool const bScaleA = bProduct && (alpha.im != (MATMUL_COMPLEX_T)0);
+    bool const b3M = bProduct
+        && ((eAlgo == EMatMulComplexAlgo3M)
+            || ((eAlgo == EMatMulComplexAlgoAuto)
+                && (m >= MATMUL_COMPLEX_3M_MIN_SIZE) && (n >= MATMUL_COMPLEX_3M_MIN_SIZE) && (k >= MATMUL_COMPLEX_3M_MIN_SIZE)));
+
+    // The buffers are allocated before C is changed so that a failed allocation leaves C as it is.
+    MATMUL_COMPLEX_T * const pScaledA = bScaleA ? (MATMUL_COMPLEX_T *)matmul_arr_aligned_alloc_internal(2*m*k*sizeof(MATMUL_COMPLEX_T)) : 0;
+    MATMUL_COMPLEX_T * const pSumA = b3M ? (MATMUL_COMPLEX_T *)matmul_arr_aligned_alloc_internal(m*k*sizeof(MATMUL_COMPLEX_T)) : 0;
+    MATMUL_COMPLEX_T * const pSumB = b3M ? (MATMUL_COMPLEX_T *)matmul_arr_aligned_alloc_internal(k*n*sizeof(MATMUL_COMPLEX_T)) : 0;
+    MATMUL_COMPLEX_T * const pProdRe = b3M ? (MATMUL_COMPLEX_T *)matmul_arr_aligned_alloc_internal(m*n*sizeof(MATMUL_COMPLEX_T)) : 0;
+    MATMUL_COMPLEX_T * const pProdIm = b3M ? (MATMUL_COMPLEX_T *)matmul_arr_aligned_alloc_internal(m*n*sizeof(MATMUL_COMPLEX_T)) : 0;
+    if((bScaleA && !pScaledA) || (b3M && (!pSumA || !pSumB || !pProdRe || !pProdIm)))
+    {
+        printf("[GEMM Complex] The temporary buffers could not be allocated!\n");
+        MATMUL_COMPLEX_T * const apBuffers[] = {pScaledA, pSumA, pSumB, pProdRe, pProdIm};
+        for(TIdx i = 0; i < (TIdx)(sizeof(apBuffers)/sizeof(apBuffers[0])); ++i)
+        {
+            if(apBuffers[i])
+            {
+                matmul_arr_aligned_free_internal(apBuffers[i]);
+            }
+        }
+        return;
+    }
+
+    // C = beta * C. If beta is zero, C is not read.
+    if((beta.re == (MATMUL_COMPLEX_T)0) && (beta.im == (MATMUL_COMPLEX_T)0))
+    {
+        for(TIdx i = 0; i < m; ++i)
+        {
+            for(TIdx j = 0; j < n; ++j)
+            {
+                CRe[i*ldc + j] = (MATMUL_COMPLEX_T)0;
+                CIm[i*ldc + j] = (MATMUL_COMPLEX_T)0;
+            }
+        }
+    }
+    else if((beta.re != (MATMUL_COMPLEX_T)1) || (beta.im != (MATMUL_COMPLEX_T)0))
+    {
+        for(TIdx i = 0; i < m; ++i)
+        {
+            for(TIdx j = 0; j < n; ++j)
+            {
+                MATMUL_COMPLEX_T const cRe = CRe[i*ldc + j];
+                MATMUL_COMPLEX_T const cIm = CIm[i*ldc + j];
+                CRe[i*ldc + j] = beta.re * cRe - beta.im * cIm;
+                CIm[i*ldc + j] = beta.re * cIm + beta.im * cRe;
+            }
+        }
+    }
+
+    if(!bProduct)
+    {
+        return;
+    }
+
+    // A complex alpha is applied to A once so that all real products only need a real alpha.
+    MATMUL_COMPLEX_T const * pARe = ARe;
+    MATMUL_COMPLEX_T const * pAIm = AIm;
+    TIdx rs = rsa;
+    TIdx cs = csa;
+    MATMUL_COMPLEX_T a = alpha.re;
+    if(bScaleA)
+    {
+        for(TIdx i = 0; i < m; ++i)
+        {
+            for(TIdx p = 0; p < k; ++p)
+            {
+                MATMUL_COMPLEX_T const aRe = ARe[i*rsa + p*csa];
+                MATMUL_COMPLEX_T const aIm = AIm[i*rsa + p*csa];
+                pScaledA[i*k + p] = alpha.re * aRe - alpha.im * aIm;
+                pScaledA[m*k + i*k + p] = alpha.re * aIm + alpha.im * aRe;
+            }
+        }
+        pARe = pScaledA;
+        pAIm = pScaledA + m*k;
+        rs = k;
+        cs = 1;
+        a = (MATMUL_COMPLEX_T)1;
+    }
+
+    if(!b3M)
+    {
+        MATMUL_COMPLEX_REAL_GEMM(m, n, k, a, pARe, rs, cs, BRe, rsb, csb, (MATMUL_COMPLEX_T)1, CRe, ldc);
+        MATMUL_COMPLEX_REAL_GEMM(m, n, k, -a, pAIm, rs, cs, BIm, rsb, csb, (MATMUL_COMPLEX_T)1, CRe, ldc);
+        MATMUL_COMPLEX_REAL_GEMM(m, n, k, a, pARe, rs, cs, BIm, rsb, csb, (MATMUL_COMPLEX_T)1, CIm, ldc);
+        MATMUL_COMPLEX_REAL_GEMM(m, n, k, a, pAIm, rs, cs, BRe, rsb, csb, (MATMUL_COMPLEX_T)1, CIm, ldc);
+    }
+    else
+    {
+        for(TIdx i = 0; i < m; ++i)
+        {
+            for(TIdx p = 0; p < k; ++p)
+            {
+                pSumA[i*k + p] = pARe[i*rs + p*cs] + pAIm[i*rs + p*cs];
+            }
+        }
+        for(TIdx p = 0; p < k; ++p)
+        {
+            for(TIdx j = 0; j < n; ++j)
+            {
+                pSumB[p*n + j] = BRe[p*rsb + j*csb] + BIm[p*rsb + j*csb];
+            }
+        }
+
+        // P1 = a*Ar*Br, P2 = a*Ai*Bi, Im += a*(Ar+Ai)*(Br+Bi).
+        MATMUL_COMPLEX_REAL_GEMM(m, n, k, a, pARe, rs, cs, BRe, rsb, csb, (MATMUL_COMPLEX_T)0, pProdRe, n);
+        MATMUL_COMPLEX_REAL_GEMM(m, n, k, a, pAIm, rs, cs, BIm, rsb, csb, (MATMUL_COMPLEX_T)0, pProdIm, n);
+        MATMUL_COMPLEX_REAL_GEMM(m, n, k, a, pSumA, k, 1, pSumB, n, 1, (MATMUL_COMPLEX_T)1, CIm, ldc);
+
+        // Re += P1 - P2, Im -= P1 + P2.
+        for(TIdx i = 0; i < m; ++i)
+        {
+            for(TIdx j = 0; j < n; ++j)
+            {
+                MATMUL_COMPLEX_T const p1 = pProdRe[i*n + j];
+                MATMUL_COMPLEX_T const p2 = pProdIm[i*n + j];
+                CRe[i*ldc + j] += p1 - p2;
+                CIm[i*ldc + j] -= p1 + p2;
+            }
+        }
+
+        matmul_arr_aligned_free_internal(pSumA);
+        matmul_arr_aligned_free_internal(pSumB);
+        matmul_arr_aligned_free_internal(pProdRe);
+        matmul_arr_aligned_free_internal(pProdIm);
+    }
+
+    if(pScaledA)
+    {
+        matmul_arr_aligned_free_internal(pScaledA);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void MATMUL_COMPLEX_NAME(gemm_seq_planar)(
+    EMatMulComplexAlgo const eAlgo,
+    TIdx const m, TIdx const n, TIdx const k,
+    MATMUL_COMPLEX_TYPE const alpha,
+    MATMUL_COMPLEX_T const * const MATMUL_RESTRICT ARe, MATMUL_COMPLEX_T const * const MATMUL_RESTRICT AIm, TIdx const lda,
+    MATMUL_COMPLEX_T const * const MATMUL_RESTRICT BRe, MATMUL_COMPLEX_T const * const MATMUL_RESTRICT BIm, TIdx const ldb,
+    MATMUL_COMPLEX_TYPE const beta,
+    MATMUL_COMPLEX_T * const MATMUL_RESTRICT CRe, MATMUL_COMPLEX_T * const MATMUL_RESTRICT CIm, TIdx const ldc)
+{
+    MATMUL_COMPLEX_NAME(gemm_seq_parts)(
+        eAlgo,
+        m, n, k,
+        alpha,
+        ARe, AIm, lda, 1,
+        BRe, BIm, ldb, 1,
+        beta,
+        CRe, CIm, ldc);
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void MATMUL_COMPLEX_NAME(gemm_seq)(
+    EMatMulComplexAlgo const eAlgo,
+    TIdx const m, TIdx const n, TIdx const k,
+    MATMUL_COMPLEX_TYPE const alpha,
+    MATMUL_COMPLEX_TYPE const * const MATMUL_RESTRICT A, TIdx const lda,
+    MATMUL_COMPLEX_TYPE const * const MATMUL_RESTRICT B, TIdx const ldb,
+    MATMUL_COMPLEX_TYPE const beta,
+    MATMUL_COMPLEX_TYPE * const MATMUL_RESTRICT C, TIdx const ldc)
+{
+    if((m == 0) || (n == 0))
+    {
+        return;
+    }
+
+    // The parts of A and B are read in place with a stride of two. C is computed in planar buffers.
+    MATMUL_COMPLEX_T * const pCRe = (MATMUL_COMPLEX_T *)matmul_arr_aligned_alloc_internal(2*m*n*sizeof(MATMUL_COMPLEX_T));
+    if(!pCRe)
+    {
+        printf("[GEMM Complex] The temporary buffers could not be allocated!\n");
+        return;
+    }
+    MATMUL_COMPLEX_T * const pCIm = pCRe + m*n;
+
+    bool const bBetaZero = (beta.re == (MATMUL_COMPLEX_T)0) && (beta.im == (MATMUL_COMPLEX_T)0);
+    if(!bBetaZero)
+    {
+        for(TIdx i = 0; i < m; ++i)
+        {
+            for(TIdx j = 0; j < n; ++j)
+            {
+                pCRe[i*n + j] = C[i*ldc + j].re;
+                pCIm[i*n + j] = C[i*ldc + j].im;
+            }
+        }
+    }
+
+    MATMUL_COMPLEX_T const * const pA = (MATMUL_COMPLEX_T const *)A;
+    MATMUL_COMPLEX_T const * const pB = (MATMUL_COMPLEX_T const *)B;
+    MATMUL_COMPLEX_NAME(gemm_seq_parts)(
+        eAlgo,
+        m, n, k,
+        alpha,
+        pA, pA + 1, 2*lda, 2,
+        pB, pB + 1, 2*ldb, 2,
+        beta,
+        pCRe, pCIm, n);
+
+    for(TIdx i = 0; i < m; ++i)
+    {
+        for(TIdx j = 0; j < n; ++j)
+        {
+            C[i*ldc + j].re = pCRe[i*n + j];
+            C[i*ldc + j].im = pCIm[i*n + j];
+        }
+    }
+
+    matmul_arr_aligned_free_internal(pCRe);
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void MATMUL_COMPLEX_NAME(gemm_seq_basic)(
+    TIdx const m, TIdx const n, TIdx const k,
+    MATMUL_COMPLEX_TYPE const alpha,
+    MATMUL_COMPLEX_TYPE const * const MATMUL_RESTRICT A, TIdx const lda,
+    MATMUL_COMPLEX_TYPE const * const MATMUL_RESTRICT B, TIdx const ldb,
+    MATMUL_COMPLEX_TYPE const beta,
+    MATMUL_COMPLEX_TYPE * const MATMUL_RESTRICT C, TIdx const ldc)
+{
+    bool const bBetaZero = (beta.re == (MATMUL_COMPLEX_T)0) && (beta.im == (MATMUL_COMPLEX_T)0);
+
+    for(TIdx i = 0; i < m; ++i)
+    {
+        for(TIdx j = 0; j < n; ++j)
+        {
+            MATMUL_COMPLEX_T sumRe = (MATMUL_COMPLEX_T)0;
+            MATMUL_COMPLEX_T sumIm = (MATMUL_COMPLEX_T)0;
+            for(TIdx p = 0; p < k; ++p)
+            {
+                MATMUL_COMPLEX_TYPE const a = A[i*lda + p];
+                MATMUL_COMPLEX_TYPE const b = B[p*ldb + j];
+                sumRe += a.re * b.re - a.im * b.im;
+                sumIm += a.re * b.im + a.im * b.re;
+            }
+
+            MATMUL_COMPLEX_TYPE const c = C[i*ldc + j];
+            C[i*ldc + j].re = alpha.re * sumRe - alpha.im * sumIm + (bBetaZero ? (MATMUL_COMPLEX_T)0 : (beta.re * c.re - beta.im * c.im));
+            C[i*ldc + j].im = alpha.re * sumIm + alpha.im * sumRe + (bBetaZero ? (MATMUL_COMPLEX_T)0 : (beta.re * c.im + beta.im * c.re));
+        }
+    }
+}
+
+#undef MATMUL_COMPLEX_NAME
+#undef MATMUL_COMPLEX_CONCAT
+#undef MATMUL_COMPLEX_CONCAT2
+#undef MATMUL_COMPLEX_REAL_GEMM
+#undef MATMUL_COMPLEX_PREFIX
+#undef MATMUL_COMPLEX_TYPE
+#undef MATMUL_COMPLEX_T
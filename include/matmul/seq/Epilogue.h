@@ -0,0 +1,145 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef MATMUL_BUILD_SEQ_PACKED
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! The bias added to the product.
+    //-----------------------------------------------------------------------------
+    typedef enum EMatMulEpilogueBias
+    {
+        EMatMulEpilogueBiasNone,        //!< No bias.
+        EMatMulEpilogueBiasRow,         //!< One value per row of C, m values.
+        EMatMulEpilogueBiasCol          //!< One value per column of C, n values.
+    } EMatMulEpilogueBias;
+
+    //-----------------------------------------------------------------------------
+    //! The element-wise activation applied after the bias.
+    //-----------------------------------------------------------------------------
+    typedef enum EMatMulEpilogueActivation
+    {
+        EMatMulEpilogueActivationNone,  //!< x
+        EMatMulEpilogueActivationRelu,  //!< max(x, 0)
+        EMatMulEpilogueActivationGelu,  //!< 0.5 * x * (1 + tanh(sqrt(2/pi) * (x + 0.044715 * x^3)))
+        EMatMulEpilogueActivationClamp  //!< min(max(x, fClampMin), fClampMax)
+    } EMatMulEpilogueActivation;
+
+    //-----------------------------------------------------------------------------
+    //! The type the result is stored as.
+    //-----------------------------------------------------------------------------
+    typedef enum EMatMulEpilogueOutput
+    {
+        EMatMulEpilogueOutputC,         //!< The element type of C, stored into C.
+        EMatMulEpilogueOutputBf16,      //!< TMatMulBf16, stored into pOut.
+        EMatMulEpilogueOutputFp16       //!< TMatMulFp16, stored into pOut.
+    } EMatMulEpilogueOutput;
+
+    //-----------------------------------------------------------------------------
+    //! The operations the packed GEMMs apply to each tile of the result before storing it:
+    //!
+    //! D = fScale * activation(alpha * A * B + beta * C + bias)
+    //!
+    //! The tile computed by the micro-kernel is finished while it is still in the L1 cache, so there is no second pass over C.
+    //! There is one descriptor per element type (S: float, D: double) like for the micro-kernels, SMatMulEpilogue is the one for TElem.
+    //! matmul_epilogue_init sets the identity.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulEpilogueS
+    {
+        EMatMulEpilogueBias eBias;                  //!< The kind of the bias.
+        float const * pBias;                        //!< The m (row) or n (column) bias values.
+        EMatMulEpilogueActivation eActivation;      //!< The activation.
+        float fClampMin;                            //!< The lower bound of EMatMulEpilogueActivationClamp.
+        float fClampMax;                            //!< The upper bound of EMatMulEpilogueActivationClamp.
+        float fScale;                               //!< The factor applied after the activation.
+        EMatMulEpilogueOutput eOutput;              //!< The type of the result.
+        void * pOut;                                //!< The m-by-n result if it is not stored into C.
+        TIdx ldo;                                   //!< The leading dimension of pOut.
+    } SMatMulEpilogueS;
+    typedef struct SMatMulEpilogueD
+    {
+        EMatMulEpilogueBias eBias;                  //!< The kind of the bias.
+        double const * pBias;                       //!< The m (row) or n (column) bias values.
+        EMatMulEpilogueActivation eActivation;      //!< The activation.
+        double fClampMin;                           //!< The lower bound of EMatMulEpilogueActivationClamp.
+        double fClampMax;                           //!< The upper bound of EMatMulEpilogueActivationClamp.
+        double fScale;                              //!< The factor applied after the activation.
+        EMatMulEpilogueOutput eOutput;              //!< The type of the result.
+        void * pOut;                                //!< The m-by-n result if it is not stored into C.
+        TIdx ldo;                                   //!< The leading dimension of pOut.
+    } SMatMulEpilogueD;
+
+    #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        typedef SMatMulEpilogueD SMatMulEpilogue;
+    #else
+        typedef SMatMulEpilogueS SMatMulEpilogue;
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //! Sets the epilogue to the identity: no bias, no activation, a scale of one and the result stored into C.
+    //-----------------------------------------------------------------------------
+    void matmul_epilogue_init_s(SMatMulEpilogueS * const pEpilogue);
+    void matmul_epilogue_init_d(SMatMulEpilogueD * const pEpilogue);
+    void matmul_epilogue_init(SMatMulEpilogue * const pEpilogue);
+
+    //-----------------------------------------------------------------------------
+    //! Finishes one tile of the result: D = epilogue(AB + beta * C).
+    //!
+    //! This is called by the packed GEMMs for each tile of the last panel along k. The row and column of the tile select the bias values and the position in pOut.
+    //! If beta is zero, C is not read.
+    //!
+    //! \param pEpilogue The epilogue.
+    //! \param row The row of the first element of the tile in the whole result.
+    //! \param col The column of the first element of the tile in the whole result.
+    //! \param mr The number of rows of the tile, at most MATMUL_MICRO_KERNEL_MAX_MR.
+    //! \param nr The number of columns of the tile, at most MATMUL_MICRO_KERNEL_MAX_NR.
+    //! \param AB The tile of the scaled product alpha * A * B.
+    //! \param ldab Specifies the leading dimension of AB.
+    //! \param beta Scalar value used to scale the tile of C.
+    //! \param C The begin of the tile of C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_epilogue_apply_tile_s(
+        SMatMulEpilogueS const * const pEpilogue,
+        TIdx const row, TIdx const col,
+        TIdx const mr, TIdx const nr,
+        float const * const MATMUL_RESTRICT AB, TIdx const ldab,
+        float const beta,
+        float * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_epilogue_apply_tile_d(
+        SMatMulEpilogueD const * const pEpilogue,
+        TIdx const row, TIdx const col,
+        TIdx const mr, TIdx const nr,
+        double const * const MATMUL_RESTRICT AB, TIdx const ldab,
+        double const beta,
+        double * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_epilogue_apply_tile(
+        SMatMulEpilogue const * const pEpilogue,
+        TIdx const row, TIdx const col,
+        TIdx const mr, TIdx const nr,
+        TElem const * const MATMUL_RESTRICT AB, TIdx const ldab,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
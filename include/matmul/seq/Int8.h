@@ -0,0 +1,177 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_INT8
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+    #include <matmul/common/Cpu.h>      // MATMUL_ARCH_X86
+
+    #include <stdbool.h>                // bool
+    #include <stdint.h>                 // int8_t, uint8_t, int32_t
+
+    //-----------------------------------------------------------------------------
+    //! The upper bounds for the tile sizes of all 8 bit integer micro-kernels.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_MICRO_KERNEL_INT8_MAX_MR 16
+    #define MATMUL_MICRO_KERNEL_INT8_MAX_NR 32
+
+    //-----------------------------------------------------------------------------
+    //! The number of consecutive k values interleaved in the packed micro-panels.
+    //! This is the depth of one dot product of the pmaddwd and vpdpbusd instructions.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_INT8_K_GROUP 4
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! The element type of C written by the 8 bit integer GEMM.
+    //-----------------------------------------------------------------------------
+    typedef enum EMatMulInt8Output
+    {
+        EMatMulInt8OutputS32,       //!< int32_t: The unscaled accumulators.
+        EMatMulInt8OutputS8,        //!< int8_t: The accumulators scaled, rounded to nearest, shifted by the zero point and saturated.
+        EMatMulInt8OutputF32        //!< float: The accumulators scaled.
+    } EMatMulInt8Output;
+
+    //-----------------------------------------------------------------------------
+    //! The requantization applied to each 32 bit accumulator while its tile of C is written.
+    //!
+    //! S8:  C[i][j] = saturate(round(scale * acc) + zeroPoint)
+    //! F32: C[i][j] = scale * acc
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulInt8Requant
+    {
+        EMatMulInt8Output eOutput;
+        bool bPerRow;                       //!< If true, pScale and pZeroPoint contain one value per row of C, else a single value for all of C.
+        float const * pScale;
+        int32_t const * pZeroPoint;         //!< Only used for the S8 output. May be 0.
+    } SMatMulInt8Requant;
+
+    //-----------------------------------------------------------------------------
+    //! A register blocked micro-kernel C = A * B for one uiMR-by-uiNR tile of the 32 bit integer C.
+    //!
+    //! All micro-kernels multiply unsigned 8 bit A by signed 8 bit B. A signed A is made unsigned while packing, see matmul_gemm_seq_int8_s8s8.
+    //! The packed micro-panels interleave MATMUL_INT8_K_GROUP consecutive k values of each row of A and each column of B.
+    //! If bAccumulate is true, the product is added to C, else C is not read.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulInt8MicroKernel
+    {
+        void(*pMicroKernel)(TIdx const, uint8_t const * const, int8_t const * const, int32_t * const, TIdx const, bool const);
+        TIdx uiMR;
+        TIdx uiNR;
+        char const * pszName;
+    } SMatMulInt8MicroKernel;
+
+    //-----------------------------------------------------------------------------
+    //! Selects the fastest 8 bit integer micro-kernel supported by the current CPU on the first call and returns the same one on all following calls.
+    //! The environment variable MATMUL_MICRO_KERNEL (generic, avx2, avx512vnni) can be used to select a specific supported micro-kernel.
+    //!
+    //! \return The micro-kernel used by the 8 bit integer GEMM.
+    //-----------------------------------------------------------------------------
+    SMatMulInt8MicroKernel const * matmul_micro_kernel_int8_get(void);
+
+    //-----------------------------------------------------------------------------
+    //! The 8 bit integer micro-kernels.
+    //!
+    //! \param kg The number of groups of MATMUL_INT8_K_GROUP k values in the micro-panels.
+    //! \param pPackedA A packed micro-panel of A.
+    //! \param pPackedB A packed micro-panel of B.
+    //! \param C The begin of the tile.
+    //! \param ldc Specifies the leading dimension of C.
+    //! \param bAccumulate If the product is added to C.
+    //-----------------------------------------------------------------------------
+    void matmul_micro_kernel_int8_generic(TIdx const kg, uint8_t const * const MATMUL_RESTRICT pPackedA, int8_t const * const MATMUL_RESTRICT pPackedB, int32_t * const MATMUL_RESTRICT C, TIdx const ldc, bool const bAccumulate);
+    #ifdef MATMUL_ARCH_X86
+        //-----------------------------------------------------------------------------
+        //! AVX2:           6x8, widens to 16 bit and uses pmaddwd, which unlike pmaddubsw can not saturate.
+        //! AVX-512 VNNI:   12x32, uses vpdpbusd.
+        //-----------------------------------------------------------------------------
+        void matmul_micro_kernel_int8_avx2(TIdx const kg, uint8_t const * const MATMUL_RESTRICT pPackedA, int8_t const * const MATMUL_RESTRICT pPackedB, int32_t * const MATMUL_RESTRICT C, TIdx const ldc, bool const bAccumulate);
+        void matmul_micro_kernel_int8_avx512vnni(TIdx const kg, uint8_t const * const MATMUL_RESTRICT pPackedA, int8_t const * const MATMUL_RESTRICT pPackedB, int32_t * const MATMUL_RESTRICT C, TIdx const ldc, bool const bAccumulate);
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //! 8 bit integer GEMM C = requant((A - zeroPointA) * B) with 32 bit integer accumulation.
+    //! Unsigned activations with a zero point times symmetric signed weights.
+    //!
+    //! The operands are packed and blocked like in matmul_gemm_seq_packed. Unlike there, C is overwritten.
+    //! The zero point of A is applied once per column of C from the column sums of B collected while packing.
+    //!
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param A Array, size m-by-k. Row major.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param iZeroPointA The value of A representing zero.
+    //! \param B Array, size k-by-n. Row major.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param pRequant The requantization applied when writing C. If 0, C is the int32_t accumulator.
+    //! \param C Array, size m-by-n of the element type given by pRequant->eOutput.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_int8_u8s8(
+        TIdx const m, TIdx const n, TIdx const k,
+        uint8_t const * const MATMUL_RESTRICT A, TIdx const lda, int32_t const iZeroPointA,
+        int8_t const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulInt8Requant const * const pRequant,
+        void * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! 8 bit integer GEMM C = requant(A * B) with 32 bit integer accumulation for signed A and B.
+    //!
+    //! A is shifted by 128 into the unsigned range while packing and the shift is removed like a zero point.
+    //! This lets both variants share the u8*s8 micro-kernels.
+    //!
+    //! The parameters are the same as the ones of matmul_gemm_seq_int8_u8s8.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_int8_s8s8(
+        TIdx const m, TIdx const n, TIdx const k,
+        int8_t const * const MATMUL_RESTRICT A, TIdx const lda,
+        int8_t const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulInt8Requant const * const pRequant,
+        void * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Approximate GEMM C = alpha * A * B + beta * C computed by quantizing the operands on the fly.
+    //! A is quantized asymmetrically to uint8_t and B symmetrically to int8_t, both per tensor.
+    //! The product is computed by matmul_gemm_seq_int8_u8s8 and requantized to float.
+    //! The result has the precision of the 8 bit operands, not of TElem.
+    //!
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A Array, size m-by-k.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param B Array, size k-by-n.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size m-by-n.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_int8(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
@@ -0,0 +1,132 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef MATMUL_BUILD_SEQ_PACKED
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+    #include <matmul/common/Cpu.h>      // MATMUL_ARCH_X86
+
+    #include <stdbool.h>                // bool
+
+    //-----------------------------------------------------------------------------
+    //! The upper bounds for the tile sizes of all micro-kernels. The edge tiles are computed into a buffer of this size.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_MICRO_KERNEL_MAX_MR 16
+    #define MATMUL_MICRO_KERNEL_MAX_NR 32
+    //-----------------------------------------------------------------------------
+    //! The upper bound for the number of micro-kernels per element type.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_MICRO_KERNEL_MAX_NUM 8
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! A register blocked micro-kernel C = alpha * A * B + beta * C for one uiMR-by-uiNR tile of C.
+    //!
+    //! The micro-kernel reads the uiMR values of each column of the packed A micro-panel and the uiNR values of each row of the packed B micro-panel consecutively.
+    //! If beta is zero, C is not read.
+    //! There is one descriptor per element type (S: float, D: double), SMatMulMicroKernel is the one for TElem.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulMicroKernelS
+    {
+        void(*pMicroKernel)(TIdx const, float const, float const * const, float const * const, float const, float * const, TIdx const);
+        TIdx uiMR;
+        TIdx uiNR;
+        char const * pszName;
+    } SMatMulMicroKernelS;
+    typedef struct SMatMulMicroKernelD
+    {
+        void(*pMicroKernel)(TIdx const, double const, double const * const, double const * const, double const, double * const, TIdx const);
+        TIdx uiMR;
+        TIdx uiNR;
+        char const * pszName;
+    } SMatMulMicroKernelD;
+    #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        typedef SMatMulMicroKernelD SMatMulMicroKernel;
+    #else
+        typedef SMatMulMicroKernelS SMatMulMicroKernel;
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //! Selects the fastest micro-kernel supported by the current CPU on the first call and returns the same one on all following calls.
+    //! The environment variable MATMUL_MICRO_KERNEL (generic, sse42, avx2, avx512) can be used to select a specific supported micro-kernel.
+    //!
+    //! \return The micro-kernel used by the packed GEMM.
+    //-----------------------------------------------------------------------------
+    SMatMulMicroKernelS const * matmul_micro_kernel_get_s(void);
+    SMatMulMicroKernelD const * matmul_micro_kernel_get_d(void);
+    SMatMulMicroKernel const * matmul_micro_kernel_get(void);
+
+    //-----------------------------------------------------------------------------
+    //! \param pszName The name of the micro-kernel (generic, sse42, avx2, avx512).
+    //! \return The micro-kernel with the given name or null if it does not exist or is not supported by the current CPU.
+    //-----------------------------------------------------------------------------
+    SMatMulMicroKernelS const * matmul_micro_kernel_find_s(char const * const pszName);
+    SMatMulMicroKernelD const * matmul_micro_kernel_find_d(char const * const pszName);
+    SMatMulMicroKernel const * matmul_micro_kernel_find(char const * const pszName);
+
+    //-----------------------------------------------------------------------------
+    //! \param pszName The name of a micro-kernel (generic, sse42, avx2, avx512, avx512vnni).
+    //! \return If the current CPU supports the instruction set of the micro-kernel.
+    //-----------------------------------------------------------------------------
+    bool matmul_micro_kernel_is_supported(char const * const pszName);
+
+    //-----------------------------------------------------------------------------
+    //! Selects one of the given micro-kernels depending on the CPU features and the environment variable MATMUL_MICRO_KERNEL.
+    //!
+    //! \param apszNames The names of the micro-kernels (generic, sse42, avx2, avx512, avx512vnni) sorted from the least to the most preferable one.
+    //! \param uiNumMicroKernels The number of names.
+    //! \return The index of the selected micro-kernel.
+    //-----------------------------------------------------------------------------
+    TIdx matmul_micro_kernel_select(char const * const * const apszNames, TIdx const uiNumMicroKernels);
+
+    //-----------------------------------------------------------------------------
+    //! The portable micro-kernels relying on the compiler to vectorize the MATMUL_PACKED_MR-by-MATMUL_PACKED_NR tile.
+    //!
+    //! \param kc The number of columns of the A micro-panel and the number of rows of the B micro-panel.
+    //! \param alpha Scalar value used to scale the product of the micro-panels.
+    //! \param pPackedA A packed micro-panel of A.
+    //! \param pPackedB A packed micro-panel of B.
+    //! \param beta Scalar value used to scale the tile of C.
+    //! \param C The begin of the tile.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_micro_kernel_generic_s(TIdx const kc, float const alpha, float const * const MATMUL_RESTRICT pPackedA, float const * const MATMUL_RESTRICT pPackedB, float const beta, float * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_micro_kernel_generic_d(TIdx const kc, double const alpha, double const * const MATMUL_RESTRICT pPackedA, double const * const MATMUL_RESTRICT pPackedB, double const beta, double * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    #ifdef MATMUL_ARCH_X86
+        //-----------------------------------------------------------------------------
+        //! The micro-kernels explicitly vectorized with intrinsics. The suffix gives the element type (s: float, d: double).
+        //! Each one is compiled for its instruction set only, so it must not be called if the CPU does not support it.
+        //!
+        //! SSE4.2:         4x4 (d), 4x8 (s)
+        //! AVX2 + FMA:     6x8 (d), 6x16 (s)
+        //! AVX-512:        12x16 (d), 12x32 (s)
+        //-----------------------------------------------------------------------------
+        void matmul_micro_kernel_sse42_d(TIdx const kc, double const alpha, double const * const MATMUL_RESTRICT pPackedA, double const * const MATMUL_RESTRICT pPackedB, double const beta, double * const MATMUL_RESTRICT C, TIdx const ldc);
+        void matmul_micro_kernel_sse42_s(TIdx const kc, float const alpha, float const * const MATMUL_RESTRICT pPackedA, float const * const MATMUL_RESTRICT pPackedB, float const beta, float * const MATMUL_RESTRICT C, TIdx const ldc);
+        void matmul_micro_kernel_avx2_d(TIdx const kc, double const alpha, double const * const MATMUL_RESTRICT pPackedA, double const * const MATMUL_RESTRICT pPackedB, double const beta, double * const MATMUL_RESTRICT C, TIdx const ldc);
+        void matmul_micro_kernel_avx2_s(TIdx const kc, float const alpha, float const * const MATMUL_RESTRICT pPackedA, float const * const MATMUL_RESTRICT pPackedB, float const beta, float * const MATMUL_RESTRICT C, TIdx const ldc);
+        void matmul_micro_kernel_avx512_d(TIdx const kc, double const alpha, double const * const MATMUL_RESTRICT pPackedA, double const * const MATMUL_RESTRICT pPackedB, double const beta, double * const MATMUL_RESTRICT C, TIdx const ldc);
+        void matmul_micro_kernel_avx512_s(TIdx const kc, float const alpha, float const * const MATMUL_RESTRICT pPackedA, float const * const MATMUL_RESTRICT pPackedB, float const beta, float * const MATMUL_RESTRICT C, TIdx const ldc);
+    #endif
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
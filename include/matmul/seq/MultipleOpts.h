@@ -49,6 +49,7 @@
     #ifdef MATMUL_BUILD_SEQ_MULTIPLE_OPTS_BLOCK
         //-----------------------------------------------------------------------------
         //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using an optimized (blocked) version of the basic sequential algorithm.
+        //! The loops are blocked separately for each cache level with the block sizes MC, KC and NC of matmul_tune_get, which are derived from the cache sizes of the CPU if they are not tuned.
         //!
         //! \param m Specifies the number of rows of the matrix A and of the matrix C.
         //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
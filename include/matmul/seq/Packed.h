@@ -0,0 +1,448 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_PACKED
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+    #include <matmul/common/Mat.h>      // EMatMulLayout
+    #include <matmul/common/Half.h>     // TMatMulBf16, TMatMulFp16
+    #include <matmul/seq/Epilogue.h>   // SMatMulEpilogue
+    #include <matmul/seq/Prologue.h>   // SMatMulPrologue
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! Packs the mc-by-kc block of A into consecutive micro-panels of MR rows.
+    //! Inside a micro-panel the MR values of one column are stored consecutively.
+    //! The rows of the last micro-panel exceeding mc are filled with zeros.
+    //!
+    //! \param mc The number of rows of the block.
+    //! \param kc The number of columns of the block.
+    //! \param MR The number of rows of the micro-kernel tile.
+    //! \param A The begin of the block.
+    //! \param rsa The distance between two rows of A. This is lda for a row major A and 1 for a transposed A.
+    //! \param csa The distance between two columns of A. This is 1 for a row major A and lda for a transposed A.
+    //! \param pPackedA The destination buffer. Size ((mc+MR-1)/MR)*MR*kc.
+    //-----------------------------------------------------------------------------
+    void matmul_pack_a_seq(
+        TIdx const mc, TIdx const kc, TIdx const MR,
+        TElem const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+        TElem * const MATMUL_RESTRICT pPackedA);
+
+    //-----------------------------------------------------------------------------
+    //! matmul_pack_a_seq transforming the packed values by the prologue.
+    //!
+    //! \param pPrologue The prologue or 0.
+    //! \param row The row of the block in the whole operand. It selects the row scales and offsets.
+    //! \param col The column of the block in the whole operand. It selects the column scales and offsets.
+    //-----------------------------------------------------------------------------
+    void matmul_pack_a_seq_prologue(
+        TIdx const mc, TIdx const kc, TIdx const MR,
+        TElem const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+        SMatMulPrologue const * const pPrologue, TIdx const row, TIdx const col,
+        TElem * const MATMUL_RESTRICT pPackedA);
+
+    //-----------------------------------------------------------------------------
+    //! Packs the kc-by-nc block of B into consecutive micro-panels of NR columns.
+    //! Inside a micro-panel the NR values of one row are stored consecutively.
+    //! The columns of the last micro-panel exceeding nc are filled with zeros.
+    //!
+    //! \param kc The number of rows of the block.
+    //! \param nc The number of columns of the block.
+    //! \param NR The number of columns of the micro-kernel tile.
+    //! \param B The begin of the block.
+    //! \param rsb The distance between two rows of B. This is ldb for a row major B and 1 for a transposed B.
+    //! \param csb The distance between two columns of B. This is 1 for a row major B and ldb for a transposed B.
+    //! \param pPackedB The destination buffer. Size ((nc+NR-1)/NR)*NR*kc.
+    //-----------------------------------------------------------------------------
+    void matmul_pack_b_seq(
+        TIdx const kc, TIdx const nc, TIdx const NR,
+        TElem const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+        TElem * const MATMUL_RESTRICT pPackedB);
+
+    //-----------------------------------------------------------------------------
+    //! matmul_pack_b_seq transforming the packed values by the prologue.
+    //!
+    //! \param pPrologue The prologue or 0.
+    //! \param row The row of the panel in the whole operand. It selects the row scales and offsets.
+    //! \param col The column of the panel in the whole operand. It selects the column scales and offsets.
+    //-----------------------------------------------------------------------------
+    void matmul_pack_b_seq_prologue(
+        TIdx const kc, TIdx const nc, TIdx const NR,
+        TElem const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+        SMatMulPrologue const * const pPrologue, TIdx const row, TIdx const col,
+        TElem * const MATMUL_RESTRICT pPackedB);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C with A and B given by row and column strides.
+    //!
+    //! This is the driver behind matmul_gemm_seq_packed. Because the operands are only read while packing, any strided view (e.g. a transpose) is supported without copying it first.
+    //!
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A The m-by-k matrix A.
+    //! \param rsa The distance between two rows of A.
+    //! \param csa The distance between two columns of A.
+    //! \param B The k-by-n matrix B.
+    //! \param rsb The distance between two rows of B.
+    //! \param csb The distance between two columns of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_strided(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+        TElem const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! matmul_gemm_seq_packed_strided for float (s) and double (d) matrices independent of TElem.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_strided_s(
+        TIdx const m, TIdx const n, TIdx const k,
+        float const alpha,
+        float const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+        float const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+        float const beta,
+        float * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_gemm_seq_packed_strided_d(
+        TIdx const m, TIdx const n, TIdx const k,
+        double const alpha,
+        double const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+        double const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+        double const beta,
+        double * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the five loop blocking of Goto and BLIS.
+    //!
+    //! The outer three loops partition C into MATMUL_PACKED_NC wide column blocks, k into MATMUL_PACKED_KC deep panels and A into MATMUL_PACKED_MC high row blocks.
+    //! The kc-by-nc panel of B is packed once per panel to stay resident in the L3 cache, the mc-by-kc block of A is packed to stay resident in the L2 cache.
+    //! The inner two loops step over the packed micro-panels and call the register blocked micro-kernel.
+    //! The micro-kernel and with it the MR-by-NR tile size is selected at runtime by matmul_micro_kernel_get depending on the instruction sets supported by the CPU.
+    //! The block sizes and the micro-kernel can be tuned per shape class at runtime (see matmul_tune_get), the compile time settings are the defaults.
+    //! The algorithm is implemented once in matmul/seq/PackedTemplate.h and instantiated for each element type.
+    //! Tiny square problems matching one of the fixed-size kernels of matmul_gemm_seq_small are directly routed to them.
+    //! Because the signature matches the other sequential algorithms, it can be used as local GEMM of the distributed algorithms.
+    //!
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A Array, size lda-by-k. The leading m-by-k part of the array must contain the matrix A.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param B Array, size ldb-by-n. The leading k-by-n part of the array must contain the matrix B.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product D = epilogue(alpha * A * B + beta * C) with the bias, activation, scale and type conversion of the epilogue fused into the packed GEMM.
+    //!
+    //! The epilogue is applied to each tile computed by the micro-kernel for the last panel along k before it is stored, there is no second pass over C.
+    //! If the epilogue stores the result into pOut with a different type, C is only read for beta and left unchanged.
+    //! If k exceeds the panel depth in this case, the partial sums of each MC-by-NC block are accumulated in an internal buffer and B is packed once per row block.
+    //! Unlike matmul_gemm_seq_packed, tiny problems are not routed to the fixed-size kernels.
+    //!
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A Array, size lda-by-k. The leading m-by-k part of the array must contain the matrix A.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param B Array, size ldb-by-n. The leading k-by-n part of the array must contain the matrix B.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //! \param pEpilogue The epilogue. 0 computes the same as matmul_gemm_seq_packed.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_epilogue(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        SMatMulEpilogue const * const pEpilogue);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product D = epilogue(alpha * prologueA(A) * prologueB(B) + beta * C) with the transformations of the operands fused into packing them.
+    //!
+    //! The prologues scale, offset, negate or take the absolute value of the operands while they are packed into the micro-panels (see SMatMulPrologue).
+    //! This costs no memory traffic beyond the one of the packed GEMM and needs no transformed copy of A or B.
+    //! The epilogue is applied like in matmul_gemm_seq_packed_epilogue.
+    //! The parameters are the ones of matmul_gemm_seq_packed_epilogue.
+    //!
+    //! \param pPrologueA The prologue of A or 0.
+    //! \param pPrologueB The prologue of B or 0.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_fused(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        SMatMulPrologue const * const pPrologueA,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulPrologue const * const pPrologueB,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        SMatMulEpilogue const * const pEpilogue);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * op(A) * op(B) + beta * C with op(X) = X or op(X) = X^T.
+    //!
+    //! The transposition is resolved while packing the operands, the transposed matrices are never formed.
+    //! Invalid transposition characters are reported and nothing is computed.
+    //!
+    //! \param transA 'N' if op(A) = A, 'T' or 'C' if op(A) = A^T.
+    //! \param transB 'N' if op(B) = B, 'T' or 'C' if op(B) = B^T.
+    //! \param m Specifies the number of rows of the matrix op(A) and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix op(B) and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix op(A) and the number of rows of the matrix op(B).
+    //! \param alpha Scalar value used to scale the product of matrices op(A) and op(B).
+    //! \param A Array, size lda-by-k if transA is 'N' else lda-by-m.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param B Array, size ldb-by-n if transB is 'N' else ldb-by-k.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_trans(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * op(A) * op(B) + beta * C with a row or column major layout per matrix.
+    //!
+    //! A column major operand is packed like a transposed row major one, a column major C is computed as the row major C^T = op(B)^T * op(A)^T.
+    //! This way every combination of layouts is handled without converting any matrix.
+    //!
+    //! \param eLayoutA The layout of A.
+    //! \param transA 'N' if op(A) = A, 'T' or 'C' if op(A) = A^T.
+    //! \param eLayoutB The layout of B.
+    //! \param transB 'N' if op(B) = B, 'T' or 'C' if op(B) = B^T.
+    //! \param eLayoutC The layout of C.
+    //! \param m Specifies the number of rows of the matrix op(A) and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix op(B) and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix op(A) and the number of rows of the matrix op(B).
+    //! \param alpha Scalar value used to scale the product of matrices op(A) and op(B).
+    //! \param A The matrix A.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param B The matrix B.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C The m-by-n matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_layout(
+        EMatMulLayout const eLayoutA, char const transA,
+        EMatMulLayout const eLayoutB, char const transB,
+        EMatMulLayout const eLayoutC,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! An operand B packed once into the micro-panel format of the packed GEMM.
+    //!
+    //! The handle is opaque. It is created by matmul_pack_b, used by matmul_gemm_seq_packed_b and released by matmul_packed_b_free.
+    //! It does not reference the original B, which can be modified or freed after packing.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulPackedB SMatMulPackedB;
+
+    //-----------------------------------------------------------------------------
+    //! Packs the matrix op(B) for repeated products with different matrices A.
+    //!
+    //! The whole of op(B) is stored in the kc-by-nc panels the packed GEMM would pack per call, so the products with the handle never read B again.
+    //! The block sizes and the micro-kernel are fixed at packing time to the ones of the shape class m = n, because the rows of A are not known yet.
+    //!
+    //! \param transB 'N' if op(B) = B, 'T' or 'C' if op(B) = B^T.
+    //! \param k Specifies the number of rows of the matrix op(B).
+    //! \param n Specifies the number of columns of the matrix op(B).
+    //! \param B Array, size ldb-by-n if transB is 'N' else ldb-by-k.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \return The packed B or 0 if the transposition is invalid or the allocation failed.
+    //-----------------------------------------------------------------------------
+    SMatMulPackedB * matmul_pack_b(
+        char const transB,
+        TIdx const k, TIdx const n,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb);
+
+    //-----------------------------------------------------------------------------
+    //! Frees a B packed by matmul_pack_b.
+    //! \param pPackedB The packed B. May be 0.
+    //-----------------------------------------------------------------------------
+    void matmul_packed_b_free(
+        SMatMulPackedB * const pPackedB);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * op(A) * B + beta * C with a B packed beforehand by matmul_pack_b.
+    //!
+    //! Only A is packed by this function. n and k are the ones of the packed B.
+    //!
+    //! \param transA 'N' if op(A) = A, 'T' or 'C' if op(A) = A^T.
+    //! \param m Specifies the number of rows of the matrix op(A) and of the matrix C.
+    //! \param alpha Scalar value used to scale the product of matrices op(A) and B.
+    //! \param A Array, size lda-by-k if transA is 'N' else lda-by-m.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param pPackedB The packed k-by-n matrix B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_b(
+        char const transA,
+        TIdx const m,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        SMatMulPackedB const * const pPackedB,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! A packed GEMM of a fixed shape with its setup hoisted out of the calls.
+    //!
+    //! The handle is opaque. It keeps the tuned block sizes, the selected micro-kernel and the packing buffers so that the calls do not allocate anything.
+    //! One plan must not be executed by multiple threads at the same time because they would share the packing buffers.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulPackedPlan SMatMulPackedPlan;
+
+    //-----------------------------------------------------------------------------
+    //! Creates a plan for the packed GEMM of the given shape.
+    //!
+    //! \param m The number of rows of the matrix A and of the matrix C.
+    //! \param n The number of columns of the matrix B and of the matrix C.
+    //! \param k The number of columns of the matrix A and the number of rows of the matrix B.
+    //! \return The plan or 0 if the allocation failed.
+    //-----------------------------------------------------------------------------
+    SMatMulPackedPlan * matmul_gemm_seq_packed_plan_create(
+        TIdx const m, TIdx const n, TIdx const k);
+
+    //-----------------------------------------------------------------------------
+    //! Frees a plan created by matmul_gemm_seq_packed_plan_create.
+    //! \param pPlan The plan. May be 0.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_plan_destroy(
+        SMatMulPackedPlan * const pPlan);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C with the shape and the setup of the plan.
+    //!
+    //! The result is the same as the one of matmul_gemm_seq_packed.
+    //! The parameters are the ones of matmul_gemm_seq_packed without the sizes.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_plan_execute(
+        SMatMulPackedPlan * const pPlan,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! GEMM matrix-matrix products C = alpha * op(A) * op(B) + beta * C for a fixed element type independent of TElem.
+    //!
+    //! All of them are compiled from the same source as matmul_gemm_seq_packed so they are available in every build of the library.
+    //! matmul_sgemm_seq_packed works on float and matmul_dgemm_seq_packed on double matrices.
+    //! matmul_dsgemm_seq_packed reads float A and B, widens them to double while packing and accumulates into the double C.
+    //! The parameters are the same as the ones of matmul_gemm_seq_packed_trans.
+    //-----------------------------------------------------------------------------
+    void matmul_sgemm_seq_packed(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        float const alpha,
+        float const * const MATMUL_RESTRICT A, TIdx const lda,
+        float const * const MATMUL_RESTRICT B, TIdx const ldb,
+        float const beta,
+        float * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_dgemm_seq_packed(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        double const alpha,
+        double const * const MATMUL_RESTRICT A, TIdx const lda,
+        double const * const MATMUL_RESTRICT B, TIdx const ldb,
+        double const beta,
+        double * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_dsgemm_seq_packed(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        double const alpha,
+        float const * const MATMUL_RESTRICT A, TIdx const lda,
+        float const * const MATMUL_RESTRICT B, TIdx const ldb,
+        double const beta,
+        double * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! GEMM matrix-matrix products C = alpha * op(A) * op(B) + beta * C with 16 bit floating point operands accumulated in float.
+    //!
+    //! The operands are converted to float while packing. There is no full-size conversion of A or B.
+    //! matmul_sbgemm_seq_packed reads bfloat16 and matmul_shgemm_seq_packed IEEE half precision A and B into a float C.
+    //! matmul_bgemm_seq_packed reads and writes a bfloat16 C. Each column block of C is computed in float and rounded to bfloat16 once.
+    //! The parameters are the same as the ones of matmul_gemm_seq_packed_trans.
+    //-----------------------------------------------------------------------------
+    void matmul_sbgemm_seq_packed(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        float const alpha,
+        TMatMulBf16 const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulBf16 const * const MATMUL_RESTRICT B, TIdx const ldb,
+        float const beta,
+        float * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_shgemm_seq_packed(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        float const alpha,
+        TMatMulFp16 const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulFp16 const * const MATMUL_RESTRICT B, TIdx const ldb,
+        float const beta,
+        float * const MATMUL_RESTRICT C, TIdx const ldc);
+    void matmul_bgemm_seq_packed(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        float const alpha,
+        TMatMulBf16 const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulBf16 const * const MATMUL_RESTRICT B, TIdx const ldb,
+        float const beta,
+        TMatMulBf16 * const MATMUL_RESTRICT C, TIdx const ldc);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
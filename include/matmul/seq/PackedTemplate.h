@@ -0,0 +1,622 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// The packed GEMM for one combination of element types.
+// This file is included once per instantiation by src/seq/Packed.c so that all element types are compiled from the same source.
+//
+// MATMUL_PACKED_T_IN           The element type of A and B.
+// MATMUL_PACKED_T              The element type of C, of the packed micro-panels and of the micro-kernel.
+// MATMUL_PACKED_SUFFIX         The suffix of the generated functions.
+// MATMUL_PACKED_KERNEL_SUFFIX  The suffix of the micro-kernel getter for MATMUL_PACKED_T.
+// MATMUL_PACKED_MICRO_KERNEL   The micro-kernel descriptor type for MATMUL_PACKED_T.
+// MATMUL_PACKED_EPILOGUE       The epilogue descriptor type for MATMUL_PACKED_T.
+// MATMUL_PACKED_PROLOGUE       The prologue descriptor type for MATMUL_PACKED_T.
+// MATMUL_PACKED_LOAD(x)        Optional conversion of an element of A or B to MATMUL_PACKED_T. Defaults to a cast.
+//
+// The parameters are undefined at the end of the file.
+//-----------------------------------------------------------------------------
+
+#ifndef MATMUL_PACKED_LOAD
+    #define MATMUL_PACKED_LOAD(x) ((MATMUL_PACKED_T)(x))
+#endif
+
+#define MATMUL_PACKED_CONCAT2(a, b) a##b
+#define MATMUL_PACKED_CONCAT(a, b) MATMUL_PACKED_CONCAT2(a, b)
+#define MATMUL_PACKED_NAME(name) MATMUL_PACKED_CONCAT(name##_, MATMUL_PACKED_SUFFIX)
+#define MATMUL_PACKED_MICRO_KERNEL_GET MATMUL_PACKED_CONCAT(matmul_micro_kernel_get_, MATMUL_PACKED_KERNEL_SUFFIX)
+#define MATMUL_PACKED_MICRO_KERNEL_FIND MATMUL_PACKED_CONCAT(matmul_micro_kernel_find_, MATMUL_PACKED_KERNEL_SUFFIX)
+#define MATMUL_PACKED_TUNE_GET MATMUL_PACKED_CONCAT(matmul_tune_get_, MATMUL_PACKED_KERNEL_SUFFIX)
+#define MATMUL_PACKED_EPILOGUE_APPLY MATMUL_PACKED_CONCAT(matmul_epilogue_apply_tile_, MATMUL_PACKED_KERNEL_SUFFIX)
+#define MATMUL_PACKED_PROLOGUE_APPLY MATMUL_PACKED_CONCAT(matmul_prologue_apply_micro_panel_, MATMUL_PACKED_KERNEL_SUFFIX)
+
+//-----------------------------------------------------------------------------
+//! \param pPrologue The prologue applied to the packed values or 0.
+//! \param row The row of the block in the whole op(A).
+//! \param col The column of the block in the whole op(A).
+//-----------------------------------------------------------------------------
+void MATMUL_PACKED_NAME(matmul_pack_a_seq)(
+    TIdx const mc, TIdx const kc, TIdx const MR,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+    MATMUL_PACKED_PROLOGUE const * const pPrologue, TIdx const row, TIdx const col,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT pPackedA)
+{
+    MATMUL_PACKED_T * MATMUL_RESTRICT pDst = pPackedA;
+    for(TIdx ir = 0; ir < mc; ir += MR)
+    {
+        TIdx const mr = ((mc-ir)<MR) ? (mc-ir) : MR;
+        MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT pSrc = A + ir*rsa;
+
+        // The loop order is chosen so that the source is read along its smaller stride.
+        if(csa <= rsa)
+        {
+            for(TIdx i = 0; i < mr; ++i)
+            {
+                for(TIdx p = 0; p < kc; ++p)
+                {
+                    pDst[p*MR + i] = MATMUL_PACKED_LOAD(pSrc[i*rsa + p*csa]);
+                }
+            }
+        }
+        else
+        {
+            for(TIdx p = 0; p < kc; ++p)
+            {
+                for(TIdx i = 0; i < mr; ++i)
+                {
+                    pDst[p*MR + i] = MATMUL_PACKED_LOAD(pSrc[i*rsa + p*csa]);
+                }
+            }
+        }
+
+        // The micro-panel is transformed while it is still in the L1 cache.
+        if(pPrologue)
+        {
+            MATMUL_PACKED_PROLOGUE_APPLY(pPrologue, true, row+ir, col, kc, mr, MR, pDst);
+        }
+
+        // The last micro-panel is padded with zeros so that the micro-kernel does not need any edge cases.
+        if(mr != MR)
+        {
+            for(TIdx p = 0; p < kc; ++p)
+            {
+                for(TIdx i = mr; i < MR; ++i)
+                {
+                    pDst[p*MR + i] = (MATMUL_PACKED_T)0;
+                }
+            }
+        }
+
+        pDst += MR*kc;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! \param pPrologue The prologue applied to the packed values or 0.
+//! \param row The row of the panel in the whole op(B).
+//! \param col The column of the panel in the whole op(B).
+//-----------------------------------------------------------------------------
+void MATMUL_PACKED_NAME(matmul_pack_b_seq)(
+    TIdx const kc, TIdx const nc, TIdx const NR,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+    MATMUL_PACKED_PROLOGUE const * const pPrologue, TIdx const row, TIdx const col,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT pPackedB)
+{
+    MATMUL_PACKED_T * MATMUL_RESTRICT pDst = pPackedB;
+    for(TIdx jr = 0; jr < nc; jr += NR)
+    {
+        TIdx const nr = ((nc-jr)<NR) ? (nc-jr) : NR;
+        MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT pSrc = B + jr*csb;
+
+        // The loop order is chosen so that the source is read along its smaller stride.
+        if(csb <= rsb)
+        {
+            for(TIdx p = 0; p < kc; ++p)
+            {
+                for(TIdx j = 0; j < nr; ++j)
+                {
+                    pDst[p*NR + j] = MATMUL_PACKED_LOAD(pSrc[p*rsb + j*csb]);
+                }
+            }
+        }
+        else
+        {
+            for(TIdx j = 0; j < nr; ++j)
+            {
+                for(TIdx p = 0; p < kc; ++p)
+                {
+                    pDst[p*NR + j] = MATMUL_PACKED_LOAD(pSrc[p*rsb + j*csb]);
+                }
+            }
+        }
+
+        // The micro-panel is transformed while it is still in the L1 cache.
+        if(pPrologue)
+        {
+            MATMUL_PACKED_PROLOGUE_APPLY(pPrologue, false, row, col+jr, kc, nr, NR, pDst);
+        }
+
+        // The last micro-panel is padded with zeros so that the micro-kernel does not need any edge cases.
+        if(nr != NR)
+        {
+            for(TIdx p = 0; p < kc; ++p)
+            {
+                for(TIdx j = nr; j < NR; ++j)
+                {
+                    pDst[p*NR + j] = (MATMUL_PACKED_T)0;
+                }
+            }
+        }
+
+        pDst += NR*kc;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! The inner three loops of the packed GEMM: C(m, nc) = alpha * A(m, kc) * packed B(kc, nc) + beta * C.
+//! This is shared by the GEMM packing B itself and the GEMM with a B packed beforehand by matmul_pack_b.
+//!
+//! \param pPackedB The kc-by-nc panel of B packed into micro-panels of NR columns.
+//! \param pPackedA The buffer for packing A, size ((min(m, MC)+MR-1)/MR)*MR*kc.
+//! \param pPrologueA The prologue applied while packing A or 0.
+//! \param row The row of C and of A in the whole result and op(A).
+//! \param colA The column of A in the whole op(A).
+//! \param pEpilogue The epilogue applied to the tiles or 0. Only given for the last panel along k.
+//! \param col The column of C in the whole result. It selects the column bias and the position in the output of the epilogue.
+//-----------------------------------------------------------------------------
+void MATMUL_PACKED_NAME(matmul_gemm_seq_packed_panel)(
+    TIdx const m, TIdx const nc, TIdx const kc,
+    TIdx const MC,
+    MATMUL_PACKED_MICRO_KERNEL const * const pMicroKernel,
+    MATMUL_PACKED_T const alpha,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+    MATMUL_PACKED_T const * const MATMUL_RESTRICT pPackedB,
+    MATMUL_PACKED_T const beta,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT C, TIdx const ldc,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT pPackedA,
+    MATMUL_PACKED_PROLOGUE const * const pPrologueA,
+    TIdx const row,
+    TIdx const colA,
+    MATMUL_PACKED_EPILOGUE const * const pEpilogue,
+    TIdx const col)
+{
+    TIdx const MR = pMicroKernel->uiMR;
+    TIdx const NR = pMicroKernel->uiNR;
+
+    // The tile the micro-kernel writes into at the bottom and right edges of C.
+    MATMUL_PACKED_T AB[MATMUL_MICRO_KERNEL_MAX_MR*MATMUL_MICRO_KERNEL_MAX_NR];
+
+    // 3rd loop: Row blocks of C and A.
+    for(TIdx ic = 0; ic < m; ic += MC)
+    {
+        TIdx const mc = ((m-ic)<MC) ? (m-ic) : MC;
+
+        MATMUL_PACKED_NAME(matmul_pack_a_seq)(mc, kc, MR, &A[ic*rsa], rsa, csa, pPrologueA, row+ic, colA, pPackedA);
+
+        // 2nd loop: Micro-panels of B.
+        for(TIdx jr = 0; jr < nc; jr += NR)
+        {
+            TIdx const nr = ((nc-jr)<NR) ? (nc-jr) : NR;
+            MATMUL_PACKED_T const * const pMicroPanelB = &pPackedB[jr*kc];
+
+            // 1st loop: Micro-panels of A.
+            for(TIdx ir = 0; ir < mc; ir += MR)
+            {
+                TIdx const mr = ((mc-ir)<MR) ? (mc-ir) : MR;
+                MATMUL_PACKED_T const * const pMicroPanelA = &pPackedA[ir*kc];
+                MATMUL_PACKED_T * const pC = &C[(ic+ir)*ldc + jr];
+
+                if((mr == MR) && (nr == NR) && !pEpilogue)
+                {
+                    pMicroKernel->pMicroKernel(kc, alpha, pMicroPanelA, pMicroPanelB, beta, pC, ldc);
+                }
+                else if(pEpilogue)
+                {
+                    // The tile is finished while it is still in the L1 cache instead of in a second pass over C.
+                    pMicroKernel->pMicroKernel(kc, alpha, pMicroPanelA, pMicroPanelB, (MATMUL_PACKED_T)0, AB, NR);
+                    MATMUL_PACKED_EPILOGUE_APPLY(pEpilogue, row+ic+ir, col+jr, mr, nr, AB, NR, beta, pC, ldc);
+                }
+                else
+                {
+                    // Compute the full tile from the zero padded micro-panels and only write back the valid part.
+                    pMicroKernel->pMicroKernel(kc, alpha, pMicroPanelA, pMicroPanelB, (MATMUL_PACKED_T)0, AB, NR);
+                    for(TIdx i = 0; i < mr; ++i)
+                    {
+                        for(TIdx j = 0; j < nr; ++j)
+                        {
+                            pC[i*ldc + j] = (beta == (MATMUL_PACKED_T)0)
+                                ? AB[i*NR + j]
+                                : beta * pC[i*ldc + j] + AB[i*NR + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Completes the calls which do not need a product of A and B.
+//!
+//! \return If the call has been completed. Nothing has to be done if m or n is zero or if there is no product to add and beta is one. Without a product, C only has to be scaled by beta.
+//-----------------------------------------------------------------------------
+bool MATMUL_PACKED_NAME(matmul_gemm_seq_packed_without_product)(
+    TIdx const m, TIdx const n, TIdx const k,
+    MATMUL_PACKED_T const alpha,
+    MATMUL_PACKED_T const beta,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT C, TIdx const ldc)
+{
+    // Early out if nothing has to be computed.
+    if((m == 0) || (n == 0)
+        || (((alpha == (MATMUL_PACKED_T)0) || (k == 0)) && (beta == (MATMUL_PACKED_T)1)))
+    {
+        return true;
+    }
+
+    // If there is no product to add, only the scaling of C remains.
+    if((k == 0) || (alpha == (MATMUL_PACKED_T)0))
+    {
+        for(TIdx i = 0; i < m; ++i)
+        {
+            for(TIdx j = 0; j < n; ++j)
+            {
+                C[i*ldc + j] = (beta == (MATMUL_PACKED_T)0) ? (MATMUL_PACKED_T)0 : beta * C[i*ldc + j];
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+//! The packed GEMM with given block sizes, micro-kernel and packing buffers.
+//! This is shared by the GEMM allocating the buffers per call and the plans keeping them across calls.
+//!
+//! \param pPackedA The buffer for packing A, size ((min(m, MC)+MR-1)/MR)*MR*min(k, KC).
+//! \param pPackedB The buffer for packing B, size ((min(n, NC)+NR-1)/NR)*NR*min(k, KC).
+//! \param pPrologueA The prologue applied while packing A or 0.
+//! \param pPrologueB The prologue applied while packing B or 0.
+//! \param pEpilogue The epilogue applied while adding the last panel along k or 0.
+//-----------------------------------------------------------------------------
+void MATMUL_PACKED_NAME(matmul_gemm_seq_packed_blocked)(
+    TIdx const m, TIdx const n, TIdx const k,
+    TIdx const MC, TIdx const KC, TIdx const NC,
+    MATMUL_PACKED_MICRO_KERNEL const * const pMicroKernel,
+    MATMUL_PACKED_T const alpha,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+    MATMUL_PACKED_T const beta,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT C, TIdx const ldc,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT pPackedA,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT pPackedB,
+    MATMUL_PACKED_PROLOGUE const * const pPrologueA,
+    MATMUL_PACKED_PROLOGUE const * const pPrologueB,
+    MATMUL_PACKED_EPILOGUE const * const pEpilogue)
+{
+    TIdx const NR = pMicroKernel->uiNR;
+
+    // 5th loop: Column blocks of C and B.
+    for(TIdx jc = 0; jc < n; jc += NC)
+    {
+        TIdx const nc = ((n-jc)<NC) ? (n-jc) : NC;
+
+        // 4th loop: Panels along the k dimension.
+        for(TIdx pc = 0; pc < k; pc += KC)
+        {
+            TIdx const kc = ((k-pc)<KC) ? (k-pc) : KC;
+
+            MATMUL_PACKED_NAME(matmul_pack_b_seq)(kc, nc, NR, &B[pc*rsb + jc*csb], rsb, csb, pPrologueB, pc, jc, pPackedB);
+
+            // C is only scaled by beta when adding the first panel.
+            MATMUL_PACKED_NAME(matmul_gemm_seq_packed_panel)(
+                m, nc, kc,
+                MC,
+                pMicroKernel,
+                alpha,
+                &A[pc*csa], rsa, csa,
+                pPackedB,
+                (pc == 0) ? beta : (MATMUL_PACKED_T)1,
+                &C[jc], ldc,
+                pPackedA,
+                pPrologueA,
+                0,
+                pc,
+                ((pc+kc) == k) ? pEpilogue : 0,
+                jc);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! The packed GEMM for an epilogue storing the result into pOut if k exceeds KC.
+//! The row blocks are the outer loop of the panels along k so that the partial sums of a block are accumulated in pAccC instead of in C, which is only read for beta.
+//! B is therefore packed once per row block.
+//!
+//! \param pAccC The buffer for the partial sums, size min(m, MC)*min(n, NC).
+//! The other parameters are the ones of matmul_gemm_seq_packed_blocked.
+//-----------------------------------------------------------------------------
+void MATMUL_PACKED_NAME(matmul_gemm_seq_packed_blocked_accumulated)(
+    TIdx const m, TIdx const n, TIdx const k,
+    TIdx const MC, TIdx const KC, TIdx const NC,
+    MATMUL_PACKED_MICRO_KERNEL const * const pMicroKernel,
+    MATMUL_PACKED_T const alpha,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+    MATMUL_PACKED_T const beta,
+    MATMUL_PACKED_T const * const MATMUL_RESTRICT C, TIdx const ldc,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT pAccC,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT pPackedA,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT pPackedB,
+    MATMUL_PACKED_PROLOGUE const * const pPrologueA,
+    MATMUL_PACKED_PROLOGUE const * const pPrologueB,
+    MATMUL_PACKED_EPILOGUE const * const pEpilogue)
+{
+    TIdx const NR = pMicroKernel->uiNR;
+
+    // 5th loop: Column blocks of C and B.
+    for(TIdx jc = 0; jc < n; jc += NC)
+    {
+        TIdx const nc = ((n-jc)<NC) ? (n-jc) : NC;
+
+        // Row blocks of C and A.
+        for(TIdx ic = 0; ic < m; ic += MC)
+        {
+            TIdx const mc = ((m-ic)<MC) ? (m-ic) : MC;
+
+            // The accumulation starts with beta * C. If beta is zero, C is not read.
+            for(TIdx i = 0; i < mc; ++i)
+            {
+                for(TIdx j = 0; j < nc; ++j)
+                {
+                    pAccC[i*nc + j] = (beta == (MATMUL_PACKED_T)0)
+                        ? (MATMUL_PACKED_T)0
+                        : beta * C[(ic+i)*ldc + jc + j];
+                }
+            }
+
+            // 4th loop: Panels along the k dimension.
+            for(TIdx pc = 0; pc < k; pc += KC)
+            {
+                TIdx const kc = ((k-pc)<KC) ? (k-pc) : KC;
+
+                MATMUL_PACKED_NAME(matmul_pack_b_seq)(kc, nc, NR, &B[pc*rsb + jc*csb], rsb, csb, pPrologueB, pc, jc, pPackedB);
+
+                MATMUL_PACKED_NAME(matmul_gemm_seq_packed_panel)(
+                    mc, nc, kc,
+                    MC,
+                    pMicroKernel,
+                    alpha,
+                    &A[ic*rsa + pc*csa], rsa, csa,
+                    pPackedB,
+                    (MATMUL_PACKED_T)1,
+                    pAccC, nc,
+                    pPackedA,
+                    pPrologueA,
+                    ic,
+                    pc,
+                    ((pc+kc) == k) ? pEpilogue : 0,
+                    jc);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Completes the calls with an epilogue which do not need a product of A and B.
+//!
+//! \return If the call has been completed. Without a product, the epilogue is applied to beta * C.
+//-----------------------------------------------------------------------------
+bool MATMUL_PACKED_NAME(matmul_gemm_seq_packed_epilogue_without_product)(
+    TIdx const m, TIdx const n, TIdx const k,
+    MATMUL_PACKED_T const alpha,
+    MATMUL_PACKED_T const beta,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT C, TIdx const ldc,
+    MATMUL_PACKED_EPILOGUE const * const pEpilogue)
+{
+    if((m == 0) || (n == 0))
+    {
+        return true;
+    }
+    if((k != 0) && (alpha != (MATMUL_PACKED_T)0))
+    {
+        return false;
+    }
+
+    MATMUL_PACKED_T AB[MATMUL_MICRO_KERNEL_MAX_MR*MATMUL_MICRO_KERNEL_MAX_NR];
+    for(TIdx i = 0; i < MATMUL_MICRO_KERNEL_MAX_MR*MATMUL_MICRO_KERNEL_MAX_NR; ++i)
+    {
+        AB[i] = (MATMUL_PACKED_T)0;
+    }
+
+    for(TIdx i = 0; i < m; i += MATMUL_MICRO_KERNEL_MAX_MR)
+    {
+        TIdx const mr = ((m-i)<MATMUL_MICRO_KERNEL_MAX_MR) ? (m-i) : MATMUL_MICRO_KERNEL_MAX_MR;
+        for(TIdx j = 0; j < n; j += MATMUL_MICRO_KERNEL_MAX_NR)
+        {
+            TIdx const nr = ((n-j)<MATMUL_MICRO_KERNEL_MAX_NR) ? (n-j) : MATMUL_MICRO_KERNEL_MAX_NR;
+            MATMUL_PACKED_EPILOGUE_APPLY(pEpilogue, i, j, mr, nr, AB, MATMUL_MICRO_KERNEL_MAX_NR, beta, &C[i*ldc + j], ldc);
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+//! The packed GEMM with the prologues applied while packing the operands and the epilogue applied to each tile of the last panel along k.
+//!
+//! \param pPrologueA The prologue of A or 0.
+//! \param pPrologueB The prologue of B or 0.
+//! \param pEpilogue The epilogue or 0.
+//-----------------------------------------------------------------------------
+void MATMUL_PACKED_NAME(matmul_gemm_seq_packed_strided_fused)(
+    TIdx const m, TIdx const n, TIdx const k,
+    MATMUL_PACKED_T const alpha,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+    MATMUL_PACKED_PROLOGUE const * const pPrologueA,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+    MATMUL_PACKED_PROLOGUE const * const pPrologueB,
+    MATMUL_PACKED_T const beta,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT C, TIdx const ldc,
+    MATMUL_PACKED_EPILOGUE const * const pEpilogue)
+{
+    if(pEpilogue
+        ? MATMUL_PACKED_NAME(matmul_gemm_seq_packed_epilogue_without_product)(m, n, k, alpha, beta, C, ldc, pEpilogue)
+        : MATMUL_PACKED_NAME(matmul_gemm_seq_packed_without_product)(m, n, k, alpha, beta, C, ldc))
+    {
+        return;
+    }
+
+    // The blocking and the micro-kernel tuned for the shape class of the problem. The defaults are the compile time settings.
+    SMatMulTuneParams const * const pTune = MATMUL_PACKED_TUNE_GET(m, n, k);
+    MATMUL_PACKED_MICRO_KERNEL const * pMicroKernel = (pTune->szMicroKernel[0] != '\0') ? MATMUL_PACKED_MICRO_KERNEL_FIND(pTune->szMicroKernel) : 0;
+    if(!pMicroKernel)
+    {
+        pMicroKernel = MATMUL_PACKED_MICRO_KERNEL_GET();
+    }
+
+    TIdx const MR = pMicroKernel->uiMR;
+    TIdx const NR = pMicroKernel->uiNR;
+    // The row and column blocks are multiples of the micro-kernel tile so that only the last block contains partial micro-panels.
+    TIdx const MC = (pTune->uiPackedMC<MR) ? MR : (pTune->uiPackedMC/MR)*MR;
+    TIdx const KC = pTune->uiPackedKC;
+    TIdx const NC = (pTune->uiPackedNC<NR) ? NR : (pTune->uiPackedNC/NR)*NR;
+
+    // The buffers only have to be as big as the biggest blocks occurring for this problem size.
+    TIdx const uiMaxMc = (m<MC) ? m : MC;
+    TIdx const uiMaxKc = (k<KC) ? k : KC;
+    TIdx const uiMaxNc = (n<NC) ? n : NC;
+    MATMUL_PACKED_T * const pPackedA = (MATMUL_PACKED_T *)matmul_arr_aligned_alloc_internal(((uiMaxMc+MR-1)/MR)*MR*uiMaxKc*sizeof(MATMUL_PACKED_T));
+    MATMUL_PACKED_T * const pPackedB = (MATMUL_PACKED_T *)matmul_arr_aligned_alloc_internal(((uiMaxNc+NR-1)/NR)*NR*uiMaxKc*sizeof(MATMUL_PACKED_T));
+    // If the epilogue stores the result into pOut, C must not receive the partial sums of the leading panels along k.
+    bool const bAccumulate = pEpilogue && (pEpilogue->eOutput != EMatMulEpilogueOutputC) && (k > KC);
+    MATMUL_PACKED_T * const pAccC = bAccumulate ? (MATMUL_PACKED_T *)matmul_arr_aligned_alloc_internal(uiMaxMc*uiMaxNc*sizeof(MATMUL_PACKED_T)) : 0;
+    if(!pPackedA || !pPackedB || (bAccumulate && !pAccC))
+    {
+        printf("[GEMM Packed] The packing buffers could not be allocated!\n");
+        if(pPackedA)
+        {
+            matmul_arr_aligned_free_internal(pPackedA);
+        }
+        if(pPackedB)
+        {
+            matmul_arr_aligned_free_internal(pPackedB);
+        }
+        if(pAccC)
+        {
+            matmul_arr_aligned_free_internal(pAccC);
+        }
+        return;
+    }
+
+    if(bAccumulate)
+    {
+        MATMUL_PACKED_NAME(matmul_gemm_seq_packed_blocked_accumulated)(
+            m, n, k,
+            MC, KC, NC,
+            pMicroKernel,
+            alpha,
+            A, rsa, csa,
+            B, rsb, csb,
+            beta,
+            C, ldc,
+            pAccC,
+            pPackedA,
+            pPackedB,
+            pPrologueA,
+            pPrologueB,
+            pEpilogue);
+
+        matmul_arr_aligned_free_internal(pAccC);
+    }
+    else
+    {
+        MATMUL_PACKED_NAME(matmul_gemm_seq_packed_blocked)(
+            m, n, k,
+            MC, KC, NC,
+            pMicroKernel,
+            alpha,
+            A, rsa, csa,
+            B, rsb, csb,
+            beta,
+            C, ldc,
+            pPackedA,
+            pPackedB,
+            pPrologueA,
+            pPrologueB,
+            pEpilogue);
+    }
+
+    matmul_arr_aligned_free_internal(pPackedA);
+    matmul_arr_aligned_free_internal(pPackedB);
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void MATMUL_PACKED_NAME(matmul_gemm_seq_packed_strided)(
+    TIdx const m, TIdx const n, TIdx const k,
+    MATMUL_PACKED_T const alpha,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+    MATMUL_PACKED_T const beta,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT C, TIdx const ldc)
+{
+    MATMUL_PACKED_NAME(matmul_gemm_seq_packed_strided_fused)(m, n, k, alpha, A, rsa, csa, 0, B, rsb, csb, 0, beta, C, ldc, 0);
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void MATMUL_PACKED_CONCAT(MATMUL_PACKED_CONCAT(matmul_, MATMUL_PACKED_SUFFIX), gemm_seq_packed)(
+    char const transA, char const transB,
+    TIdx const m, TIdx const n, TIdx const k,
+    MATMUL_PACKED_T const alpha,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT A, TIdx const lda,
+    MATMUL_PACKED_T_IN const * const MATMUL_RESTRICT B, TIdx const ldb,
+    MATMUL_PACKED_T const beta,
+    MATMUL_PACKED_T * const MATMUL_RESTRICT C, TIdx const ldc)
+{
+    bool bTransA, bTransB;
+    if(!matmul_mat_parse_op(transA, &bTransA) || !matmul_mat_parse_op(transB, &bTransB))
+    {
+        printf("[GEMM Packed] Invalid transposition '%c' '%c'! Only 'N', 'T' and 'C' are supported.\n", transA, transB);
+        return;
+    }
+
+    MATMUL_PACKED_NAME(matmul_gemm_seq_packed_strided)(
+        m, n, k,
+        alpha,
+        A, bTransA ? 1 : lda, bTransA ? lda : 1,
+        B, bTransB ? 1 : ldb, bTransB ? ldb : 1,
+        beta,
+        C, ldc);
+}
+
+#undef MATMUL_PACKED_PROLOGUE_APPLY
+#undef MATMUL_PACKED_EPILOGUE_APPLY
+#undef MATMUL_PACKED_TUNE_GET
+#undef MATMUL_PACKED_MICRO_KERNEL_FIND
+#undef MATMUL_PACKED_MICRO_KERNEL_GET
+#undef MATMUL_PACKED_NAME
+#undef MATMUL_PACKED_CONCAT
+#undef MATMUL_PACKED_CONCAT2
+#undef MATMUL_PACKED_LOAD
+#undef MATMUL_PACKED_PROLOGUE
+#undef MATMUL_PACKED_EPILOGUE
+#undef MATMUL_PACKED_MICRO_KERNEL
+#undef MATMUL_PACKED_KERNEL_SUFFIX
+#undef MATMUL_PACKED_SUFFIX
+#undef MATMUL_PACKED_T
+#undef MATMUL_PACKED_T_IN
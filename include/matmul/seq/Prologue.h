@@ -0,0 +1,110 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef MATMUL_BUILD_SEQ_PACKED
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+
+    #include <stdbool.h>                // bool
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! The element-wise operation applied first.
+    //-----------------------------------------------------------------------------
+    typedef enum EMatMulPrologueOp
+    {
+        EMatMulPrologueOpNone,          //!< x
+        EMatMulPrologueOpNegate,        //!< -x
+        EMatMulPrologueOpAbs            //!< |x|
+    } EMatMulPrologueOp;
+
+    //-----------------------------------------------------------------------------
+    //! The transformation the packed GEMMs apply to an operand X while packing it:
+    //!
+    //! X'(i, j) = pRowScale[i] * pColScale[j] * (op(X(i, j)) - pRowOffset[i] - pColOffset[j])
+    //!
+    //! i and j are the row and column of the operand as it enters the product, after a transposition.
+    //! Each of the vectors is optional, 0 stands for ones (scales) or zeros (offsets).
+    //! Per column offsets and scales of B dequantize a B quantized per output channel, per row scales of A scale the rows of the result.
+    //! The operand is transformed in the packed micro-panels while they are in the L1 cache, it is neither copied nor modified.
+    //! There is one descriptor per element type (S: float, D: double) like for the micro-kernels, SMatMulPrologue is the one for TElem.
+    //! matmul_prologue_init sets the identity.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulPrologueS
+    {
+        EMatMulPrologueOp eOp;                      //!< The element-wise operation.
+        float const * pRowScale;                    //!< The scale per row or 0.
+        float const * pColScale;                    //!< The scale per column or 0.
+        float const * pRowOffset;                   //!< The offset per row or 0.
+        float const * pColOffset;                   //!< The offset per column or 0.
+    } SMatMulPrologueS;
+    typedef struct SMatMulPrologueD
+    {
+        EMatMulPrologueOp eOp;                      //!< The element-wise operation.
+        double const * pRowScale;                   //!< The scale per row or 0.
+        double const * pColScale;                   //!< The scale per column or 0.
+        double const * pRowOffset;                  //!< The offset per row or 0.
+        double const * pColOffset;                  //!< The offset per column or 0.
+    } SMatMulPrologueD;
+    #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        typedef SMatMulPrologueD SMatMulPrologue;
+    #else
+        typedef SMatMulPrologueS SMatMulPrologue;
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //! Sets the prologue to the identity.
+    //-----------------------------------------------------------------------------
+    void matmul_prologue_init_s(SMatMulPrologueS * const pPrologue);
+    void matmul_prologue_init_d(SMatMulPrologueD * const pPrologue);
+    void matmul_prologue_init(SMatMulPrologue * const pPrologue);
+
+    //-----------------------------------------------------------------------------
+    //! Transforms one packed micro-panel in place.
+    //!
+    //! The element (p, q) of the micro-panel is stored at pMicroPanel[p*R + q], p runs along k and q along the register dimension.
+    //! For a micro-panel of A q is the row, for a micro-panel of B q is the column of the operand.
+    //! Only the r valid values of each p are transformed, the zero padding is kept.
+    //!
+    //! \param pPrologue The prologue.
+    //! \param bRegisterRows If q is the row (A) instead of the column (B) of the operand.
+    //! \param row The row of the first element of the micro-panel in the operand.
+    //! \param col The column of the first element of the micro-panel in the operand.
+    //! \param kc The length of the micro-panel along k.
+    //! \param r The number of valid values along the register dimension.
+    //! \param R The size of the register dimension, at most MATMUL_MICRO_KERNEL_MAX_NR.
+    //! \param pMicroPanel The packed micro-panel.
+    //-----------------------------------------------------------------------------
+    void matmul_prologue_apply_micro_panel_s(
+        SMatMulPrologueS const * const pPrologue,
+        bool const bRegisterRows,
+        TIdx const row, TIdx const col,
+        TIdx const kc, TIdx const r, TIdx const R,
+        float * const MATMUL_RESTRICT pMicroPanel);
+    void matmul_prologue_apply_micro_panel_d(
+        SMatMulPrologueD const * const pPrologue,
+        bool const bRegisterRows,
+        TIdx const row, TIdx const col,
+        TIdx const kc, TIdx const r, TIdx const R,
+        double * const MATMUL_RESTRICT pMicroPanel);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
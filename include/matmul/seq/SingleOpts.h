@@ -184,7 +184,8 @@
         TElem * const C, TIdx const ldc);
 
     //-----------------------------------------------------------------------------
-    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the basic sequential algorithm blocked by in all dimensions by block-factor MATMUL_SEQ_BLOCK_FACTOR.
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the basic sequential algorithm blocked in all dimensions.
+    //! The block sizes MC, KC and NC of matmul_tune_get are derived from the cache sizes of the CPU if they are not tuned.
     //!
     //! \param m Specifies the number of rows of the matrix A and of the matrix C.
     //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
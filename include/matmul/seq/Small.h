@@ -0,0 +1,98 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_SMALL
+
+    #include <matmul/common/Config.h>   // TElem, TIdx
+
+    //-----------------------------------------------------------------------------
+    //! The sizes m = n = k of the fixed-size kernels.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_SMALL_MIN_SIZE 2
+    #define MATMUL_SMALL_MAX_SIZE 32
+    #define MATMUL_SMALL_SIZES_TILED(X)\
+        X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16)
+    #define MATMUL_SMALL_SIZES_ROWS(X)\
+        X(17) X(18) X(19) X(20) X(21) X(22) X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31) X(32)
+    #define MATMUL_SMALL_SIZES(X)\
+        MATMUL_SMALL_SIZES_TILED(X) MATMUL_SMALL_SIZES_ROWS(X)
+
+    #ifdef __cplusplus
+        extern "C"
+        {
+    #endif
+    //-----------------------------------------------------------------------------
+    //! The signature of the fixed-size kernels. The sizes are part of the function so they are not passed.
+    //-----------------------------------------------------------------------------
+    typedef void(*TMatMulSmallKernel)(
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! The fixed-size kernels matmul_gemm_seq_small_<N> computing C = alpha * A * B + beta * C for m = n = k = N.
+    //! All loop bounds are compile time constants so the loops are unrolled and the tiles of C are kept in registers.
+    //! C is updated in a single pass and is not read if beta is zero.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_SMALL_KERNEL_DECL(N)\
+        void matmul_gemm_seq_small_##N(\
+            TElem const alpha,\
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,\
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,\
+            TElem const beta,\
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+    MATMUL_SMALL_SIZES(MATMUL_SMALL_KERNEL_DECL)
+    #undef MATMUL_SMALL_KERNEL_DECL
+
+    //-----------------------------------------------------------------------------
+    //! \return The fixed-size kernel for the given sizes or null if there is none.
+    //! Kernels are only returned for alpha unequal zero because A and B must not be read otherwise.
+    //-----------------------------------------------------------------------------
+    TMatMulSmallKernel matmul_gemm_seq_small_get(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C.
+    //!
+    //! Calls with m = n = k between MATMUL_SMALL_MIN_SIZE and MATMUL_SMALL_MAX_SIZE are directly routed to the fixed-size kernels.
+    //! All other calls use matmul_gemm_seq_multiple_opts.
+    //!
+    //! \param m Specifies the number of rows of the matrix A and of the matrix C.
+    //! \param n Specifies the number of columns of the matrix B and the number of columns of the matrix C.
+    //! \param k Specifies the number of columns of the matrix A and the number of rows of the matrix B.
+    //! \param alpha Scalar value used to scale the product of matrices A and B.
+    //! \param A Array, size lda-by-k. The leading m-by-k part of the array must contain the matrix A.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param B Array, size ldb-by-n. The leading k-by-n part of the array must contain the matrix B.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param beta Scalar value used to scale matrix C.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_small(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+    #ifdef __cplusplus
+        }
+    #endif
+#endif
@@ -18,6 +18,8 @@
 
     #include <matmul/common/Config.h>   // TElem, TIdx
 
+    #include <stdbool.h>                // bool
+
     #ifdef __cplusplus
         extern "C"
         {
@@ -62,6 +64,53 @@
         TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
         TElem * const MATMUL_RESTRICT C, TIdx const ldc);
 
+    //-----------------------------------------------------------------------------
+    //! Matrix-matrix addition C := A + B.
+    //! Other than matmul_mat_add_pitch_seq C may be one of the inputs.
+    //!
+    //! The parameters are the ones of matmul_mat_add_pitch_seq.
+    //-----------------------------------------------------------------------------
+    void matmul_mat_add_pitch_inplace_seq(
+        TIdx const m, TIdx const n,
+        TElem const * const A, TIdx const lda,
+        TElem const * const B, TIdx const ldb,
+        TElem * const C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Matrix-matrix subtraction C := A - B.
+    //! Other than matmul_mat_sub_pitch_seq C may be one of the inputs.
+    //!
+    //! The parameters are the ones of matmul_mat_sub_pitch_seq.
+    //-----------------------------------------------------------------------------
+    void matmul_mat_sub_pitch_inplace_seq(
+        TIdx const m, TIdx const n,
+        TElem const * const A, TIdx const lda,
+        TElem const * const B, TIdx const ldb,
+        TElem * const C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Matrix-matrix addition C := A + fSign * B if bOverwrite, else C += A + fSign * B.
+    //! The quadrants of the result of the Strassen recursion are written with it directly, for beta == 0 without reading them.
+    //!
+    //! \param m Specifies the number of rows of the matrices A, B and C.
+    //! \param n Specifies the number of columns of the matrices A, B and C.
+    //! \param A Array, size lda-by-n. The leading m-by-n part of the array must contain the matrix A.
+    //! \param lda Specifies the leading dimension of A.
+    //! \param fSign The factor of B, 1 or -1.
+    //! \param B Array, size ldb-by-n. The leading m-by-n part of the array must contain the matrix B.
+    //! \param ldb Specifies the leading dimension of B.
+    //! \param bOverwrite If C is overwritten with the sum instead of being incremented by it. C does not have to be initialized then.
+    //! \param C Array, size ldc-by-n. The leading m-by-n part of the array must contain the matrix C.
+    //! \param ldc Specifies the leading dimension of C.
+    //-----------------------------------------------------------------------------
+    void matmul_mat_add_sum_pitch_seq(
+        TIdx const m, TIdx const n,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const fSign,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        bool const bOverwrite,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
     //-----------------------------------------------------------------------------
     //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the (Volker) Strassen algorithm.
     //!
@@ -78,10 +127,12 @@
     //! \param ldc Specifies the leading dimension of C.
     //!
     //! Theoretical Runtime is O(n^log2(7)) = O(n^2.807).
-    //! Assume NxN matrices where n is a power of two.
+    //! Any m, n and k are supported by dynamic peeling: The recursion works on the even sized leading parts of the matrices.
+    //! For odd k they get a rank-1 update, an odd last column or row of C is computed by the conventional algorithm.
+    //! The recursion continues while all of m, n and k are larger than the cut-off.
     //! Algorithm:
     //!   Matrices X and Y are split into four smaller
-    //!   (n/2)x(n/2) matrices as follows:
+    //!   (m/2)x(k/2) and (k/2)x(n/2) matrices as follows:
     //!          _    _          _   _
     //!     X = | A  B |    Y = | E F |
     //!         | C  D |        | G H |
@@ -110,6 +161,160 @@
         TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
         TElem const beta,
         TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! The Strassen GEMM with an explicit cut-off.
+    //! matmul_gemm_seq_strassen calls it with the cut-off of matmul_tune_get (MATMUL_STRASSEN_CUT_OFF if not tuned).
+    //!
+    //! \param uiCutOff The size up to which the conventional algorithm is used instead of further recursive calculation.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_cut_off(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! \return The number of elements of the workspace matmul_gemm_seq_strassen_workspace needs for the given problem and cut-off.
+    //! Each recursion level needs seven (m/2)x(n/2) temporaries for the products and one for a sum of quadrants of each operand.
+    //! The levels below share the rest of the workspace because they are executed one after the other.
+    //-----------------------------------------------------------------------------
+    TIdx matmul_gemm_seq_strassen_workspace_size(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k);
+
+    //-----------------------------------------------------------------------------
+    //! The Strassen GEMM with an explicit cut-off computing all temporaries in a workspace given by the caller.
+    //! Nothing is allocated inside of the recursion and the workspace does not have to be initialized.
+    //!
+    //! \param uiCutOff The size up to which the conventional algorithm is used instead of further recursive calculation.
+    //! \param pWorkspace The workspace of at least matmul_gemm_seq_strassen_workspace_size(uiCutOff, m, n, k) elements.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_workspace(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        TElem * const MATMUL_RESTRICT pWorkspace);
+
+    //-----------------------------------------------------------------------------
+    //! (S/D)GEMM matrix-matrix product C = alpha * A * B + beta * C using the Strassen-Winograd algorithm.
+    //!
+    //! The parameters are the ones of matmul_gemm_seq_strassen.
+    //!
+    //! Algorithm:
+    //!   Matrices A, B and C are split into four quadrants A11, A12, A21, A22 and so on. Odd sizes are peeled like in matmul_gemm_seq_strassen.
+    //!     S1 = A21 + A22     T1 = B12 - B11
+    //!     S2 = S1 - A11      T2 = B22 - T1
+    //!     S3 = A11 - A21     T3 = B22 - B12
+    //!     S4 = A12 - S2      T4 = T2 - B21
+    //!     P1 = A11*B11  P2 = A12*B21  P3 = S4*B22  P4 = A22*T4  P5 = S1*T1  P6 = S2*T2  P7 = S3*T3
+    //!     U2 = P1 + P6  U3 = U2 + P7  U4 = U2 + P5
+    //!   The final result is
+    //!        _                          _
+    //!   C = | P1 + P2       U4 + P3      |
+    //!       | U3 - P4       U3 + P5      |
+    //!        -                          -
+    //! 7*mul, 15*add
+    //! For beta == 0 the products are written directly into the quadrants of C and only two temporaries are needed per recursion level.
+    //! Otherwise the products used once are accumulated into C by the recursive calls and three temporaries and one more addition are needed.
+    //! The classic formulation of matmul_gemm_seq_strassen needs nine temporaries per level.
+    //! Boyer, Dumas, Pernet, Zhou: Memory efficient scheduling of Strassen-Winograd's matrix multiplication algorithm.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_winograd(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! The Strassen-Winograd GEMM with an explicit cut-off.
+    //! matmul_gemm_seq_strassen_winograd calls it with the cut-off of matmul_tune_get (MATMUL_STRASSEN_CUT_OFF if not tuned).
+    //!
+    //! \param uiCutOff The size up to which the conventional algorithm is used instead of further recursive calculation.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_winograd_cut_off(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! \return The number of elements of the workspace matmul_gemm_seq_strassen_winograd_workspace needs for the given problem and cut-off.
+    //! Each recursion level needs at most three temporaries, in total less than n*n elements for square matrices.
+    //-----------------------------------------------------------------------------
+    TIdx matmul_gemm_seq_strassen_winograd_workspace_size(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k);
+
+    //-----------------------------------------------------------------------------
+    //! The Strassen-Winograd GEMM with an explicit cut-off computing all temporaries in a workspace given by the caller.
+    //! Nothing is allocated inside of the recursion and the workspace does not have to be initialized.
+    //!
+    //! \param uiCutOff The size up to which the conventional algorithm is used instead of further recursive calculation.
+    //! \param pWorkspace The workspace of at least matmul_gemm_seq_strassen_winograd_workspace_size(uiCutOff, m, n, k) elements.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_winograd_workspace(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        TElem * const MATMUL_RESTRICT pWorkspace);
+
+    //-----------------------------------------------------------------------------
+    //! \return If the recursion ends for the given problem and cut-off. Odd sizes do not end it, they are peeled.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_seq_strassen_is_leaf(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k);
+
+    //-----------------------------------------------------------------------------
+    //! The conventional algorithm used for the recursion leaves and the peeled fringes.
+    //! C is set instead of scaled for beta == 0 because the products are computed into the uninitialized workspace.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_leaf(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Dynamic peeling: Computes the parts of C the recursion on the even sized leading parts of A and B leaves out.
+    //! The even sized leading part C(0:m2, 0:n2) already has to contain alpha * A(0:m2, 0:k2) * B(0:k2, 0:n2) + beta * C.
+    //! For odd k it gets the rank-1 update with the last column of A and the last row of B.
+    //! For odd n the last column and for odd m the last row of C are computed by the conventional algorithm.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_peel(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
+
+    //-----------------------------------------------------------------------------
+    //! Scales the m x n matrix C by beta. Nothing is done for beta == 0 because C is overwritten then.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_scale(
+        TIdx const m, TIdx const n,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc);
     #ifdef __cplusplus
         }
     #endif
@@ -116,6 +116,57 @@ IF(MATMUL_BUILD_SEQ_STRASSEN)
     SET(MATMUL_BUILD_SEQ_MULTIPLE_OPTS ON CACHE BOOL "" FORCE)
     LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_MULTIPLE_OPTS")
 ENDIF()
+OPTION(MATMUL_BUILD_SEQ_RECURSIVE "Enable the cache-oblivious recursive sequential GEMM" OFF)
+IF(MATMUL_BUILD_SEQ_RECURSIVE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_RECURSIVE")
+ENDIF()
+OPTION(MATMUL_BUILD_SEQ_SMALL "Enable the sequential GEMM routing tiny square problems to fixed-size kernels" OFF)
+IF(MATMUL_BUILD_SEQ_SMALL)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_SMALL")
+    SET(MATMUL_BUILD_SEQ_MULTIPLE_OPTS ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_MULTIPLE_OPTS")
+ENDIF()
+OPTION(MATMUL_BUILD_SEQ_PACKED "Enable the sequential GEMM packing A and B into micro-panels for a register blocked micro-kernel (Goto/BLIS)" OFF)
+IF(MATMUL_BUILD_SEQ_PACKED)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_PACKED")
+    # Tiny problems are routed to the fixed-size kernels.
+    SET(MATMUL_BUILD_SEQ_SMALL ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_SMALL")
+    SET(MATMUL_BUILD_SEQ_MULTIPLE_OPTS ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_MULTIPLE_OPTS")
+ENDIF()
+OPTION(MATMUL_BUILD_SEQ_INT8 "Enable the sequential 8 bit integer GEMM with 32 bit accumulation and optional requantization" OFF)
+IF(MATMUL_BUILD_SEQ_INT8)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_INT8")
+    # The integer GEMM uses the blocking, the micro-kernel selection and the buffers of the packed GEMM.
+    SET(MATMUL_BUILD_SEQ_PACKED ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_PACKED")
+    SET(MATMUL_BUILD_SEQ_SMALL ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_SMALL")
+    SET(MATMUL_BUILD_SEQ_MULTIPLE_OPTS ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_MULTIPLE_OPTS")
+ENDIF()
+OPTION(MATMUL_BUILD_SEQ_COMPLEX "Enable the sequential single and double precision complex GEMM built on the packed real GEMM (4M and 3M methods)" OFF)
+IF(MATMUL_BUILD_SEQ_COMPLEX)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_COMPLEX")
+    # The real products are computed by the packed GEMM.
+    SET(MATMUL_BUILD_SEQ_PACKED ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_PACKED")
+    SET(MATMUL_BUILD_SEQ_SMALL ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_SMALL")
+    SET(MATMUL_BUILD_SEQ_MULTIPLE_OPTS ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_MULTIPLE_OPTS")
+ENDIF()
+OPTION(MATMUL_BUILD_SEQ_AUTOTUNE "Enable the runtime search of the block sizes, micro-kernels and cut-offs of the built GEMMs for a shape class (matmul_autotune_seq)" OFF)
+IF(MATMUL_BUILD_SEQ_AUTOTUNE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_AUTOTUNE")
+ENDIF()
+OPTION(MATMUL_BUILD_SEQ_JIT "Enable the sequential GEMM generating shape specialized x86-64 kernels at runtime" OFF)
+IF(MATMUL_BUILD_SEQ_JIT)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_JIT")
+    SET(MATMUL_BUILD_SEQ_MULTIPLE_OPTS ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_MULTIPLE_OPTS")
+ENDIF()
 OPTION(MATMUL_BUILD_PAR_OMP2 "The optimized but not blocked algorithm with OpenMP 2 annotations" OFF)
 IF(MATMUL_BUILD_PAR_OMP2)
     SET(_MATMUL_BUILD_OMP ON)
@@ -138,6 +189,48 @@ IF(MATMUL_BUILD_PAR_STRASSEN_OMP2)
     SET(MATMUL_BUILD_PAR_OMP2 ON CACHE BOOL "" FORCE)
     LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_PAR_OMP2")
 ENDIF()
+OPTION(MATMUL_BUILD_PAR_STRASSEN_OMP3 "The Strassen algorithm computing the seven sub-products in OpenMP 3 tasks with single-threaded leaf GEMMs" OFF)
+IF(MATMUL_BUILD_PAR_STRASSEN_OMP3)
+    SET(_MATMUL_BUILD_OMP ON)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_PAR_STRASSEN_OMP3")
+    # The tasks below the task depth run the sequential Strassen GEMM.
+    SET(MATMUL_BUILD_SEQ_STRASSEN ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_STRASSEN")
+    SET(MATMUL_BUILD_SEQ_MULTIPLE_OPTS ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_MULTIPLE_OPTS")
+ENDIF()
+OPTION(MATMUL_BUILD_PAR_BATCHED "Enable the batched GEMM distributing independent problems across OpenMP threads" OFF)
+IF(MATMUL_BUILD_PAR_BATCHED)
+    SET(_MATMUL_BUILD_OMP ON)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_PAR_BATCHED")
+    # The problems are computed by the sequential packed GEMM and the fixed-size kernels.
+    SET(MATMUL_BUILD_SEQ_PACKED ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_PACKED")
+    SET(MATMUL_BUILD_SEQ_SMALL ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_SMALL")
+    SET(MATMUL_BUILD_SEQ_MULTIPLE_OPTS ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_MULTIPLE_OPTS")
+ENDIF()
+OPTION(MATMUL_BUILD_PAR_TILED "Enable the GEMM on matrices stored in tiles ordered along the Morton curve with OpenMP converters" OFF)
+IF(MATMUL_BUILD_PAR_TILED)
+    SET(_MATMUL_BUILD_OMP ON)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_PAR_TILED")
+ENDIF()
+OPTION(MATMUL_BUILD_PAR_PACKED_OMP2 "Enable the packed GEMM sharing the packed panels of B across OpenMP 2.0 threads" OFF)
+IF(MATMUL_BUILD_PAR_PACKED_OMP2)
+    SET(_MATMUL_BUILD_OMP ON)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_PAR_PACKED_OMP2")
+    SET(MATMUL_BUILD_SEQ_PACKED ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_PACKED")
+    SET(MATMUL_BUILD_SEQ_SMALL ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_SMALL")
+    SET(MATMUL_BUILD_SEQ_MULTIPLE_OPTS ON CACHE BOOL "" FORCE)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_SEQ_MULTIPLE_OPTS")
+ENDIF()
+OPTION(MATMUL_BUILD_DISPATCH "Enable the GEMM front end matmul_gemm choosing among the built implementations with a calibrated cost model" OFF)
+IF(MATMUL_BUILD_DISPATCH)
+    LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_BUILD_DISPATCH")
+ENDIF()
 OPTION(MATMUL_BUILD_PAR_OPENACC "Enable the optimized but not blocked algorithm with OpenACC annotations" OFF)
 IF(MATMUL_BUILD_PAR_OPENACC)
     SET(MATMUL_BUILD_PAR_OPENACC ON)
@@ -309,11 +402,87 @@ ENDIF()
 # Sequential settings.
 #-------------------------------------------------------------------------------
 IF(MATMUL_BUILD_SEQ_SINGLE_OPTS OR MATMUL_BUILD_SEQ_MULTIPLE_OPTS_BLOCK)
-    SET(MATMUL_SEQ_BLOCK_FACTOR 128 CACHE INTEGER "The block factor for local GEMM.")
+    SET(MATMUL_SEQ_BLOCK_FACTOR 128 CACHE INTEGER "The block factor for local GEMM if the cache sizes can not be detected.")
     IF(MATMUL_SEQ_BLOCK_FACTOR)
         LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_SEQ_BLOCK_FACTOR=${MATMUL_SEQ_BLOCK_FACTOR}")
     ENDIF()
 ENDIF()
+IF(MATMUL_BUILD_SEQ_RECURSIVE)
+    SET(MATMUL_RECURSIVE_CUT_OFF 64 CACHE INTEGER "The size up to which all dimensions of a sub-problem of the recursive GEMM have to be split before the base case is used.")
+    IF(MATMUL_RECURSIVE_CUT_OFF)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_RECURSIVE_CUT_OFF=${MATMUL_RECURSIVE_CUT_OFF}")
+    ENDIF()
+ENDIF()
+
+#-------------------------------------------------------------------------------
+# Packed settings.
+#-------------------------------------------------------------------------------
+IF(MATMUL_BUILD_SEQ_PACKED)
+    SET(MATMUL_PACKED_MR 4 CACHE INTEGER "The number of rows of the portable register blocked micro-kernel.")
+    IF(MATMUL_PACKED_MR)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_PACKED_MR=${MATMUL_PACKED_MR}")
+    ENDIF()
+    SET(MATMUL_PACKED_NR 8 CACHE INTEGER "The number of columns of the portable register blocked micro-kernel.")
+    IF(MATMUL_PACKED_NR)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_PACKED_NR=${MATMUL_PACKED_NR}")
+    ENDIF()
+    SET(MATMUL_PACKED_MC 128 CACHE INTEGER "The number of rows of the packed block of A (L2 cache).")
+    IF(MATMUL_PACKED_MC)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_PACKED_MC=${MATMUL_PACKED_MC}")
+    ENDIF()
+    SET(MATMUL_PACKED_KC 256 CACHE INTEGER "The depth of the packed panels of A and B (L1 cache).")
+    IF(MATMUL_PACKED_KC)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_PACKED_KC=${MATMUL_PACKED_KC}")
+    ENDIF()
+    SET(MATMUL_PACKED_NC 4096 CACHE INTEGER "The number of columns of the packed panel of B (L3 cache).")
+    IF(MATMUL_PACKED_NC)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_PACKED_NC=${MATMUL_PACKED_NC}")
+    ENDIF()
+ENDIF()
+
+#-------------------------------------------------------------------------------
+# JIT settings.
+#-------------------------------------------------------------------------------
+IF(MATMUL_BUILD_SEQ_JIT)
+    SET(MATMUL_JIT_MAX_SIZE 48 CACHE INTEGER "The maximum n and k kernels are generated for. Bigger shapes use the portable implementation because the unrolled code exceeds the instruction cache.")
+    IF(MATMUL_JIT_MAX_SIZE)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_JIT_MAX_SIZE=${MATMUL_JIT_MAX_SIZE}")
+    ENDIF()
+    SET(MATMUL_JIT_CACHE_SIZE 64 CACHE INTEGER "The maximum number of generated kernels kept for the lifetime of the process.")
+    IF(MATMUL_JIT_CACHE_SIZE)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_JIT_CACHE_SIZE=${MATMUL_JIT_CACHE_SIZE}")
+    ENDIF()
+ENDIF()
+
+#-------------------------------------------------------------------------------
+# Complex settings.
+#-------------------------------------------------------------------------------
+IF(MATMUL_BUILD_SEQ_COMPLEX)
+    SET(MATMUL_COMPLEX_3M_MIN_SIZE 512 CACHE INTEGER "The minimum m, n and k the automatic complex GEMM uses the 3M method for. Smaller problems use the 4M method because the additions of the 3M method do not pay off.")
+    IF(MATMUL_COMPLEX_3M_MIN_SIZE)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_COMPLEX_3M_MIN_SIZE=${MATMUL_COMPLEX_3M_MIN_SIZE}")
+    ENDIF()
+ENDIF()
+
+#-------------------------------------------------------------------------------
+# Batched settings.
+#-------------------------------------------------------------------------------
+IF(MATMUL_BUILD_PAR_BATCHED)
+    SET(MATMUL_GROUPED_TILE_SIZE 64 CACHE INTEGER "The number of rows and columns of the tiles of C the grouped GEMM schedules across the threads.")
+    IF(MATMUL_GROUPED_TILE_SIZE)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_GROUPED_TILE_SIZE=${MATMUL_GROUPED_TILE_SIZE}")
+    ENDIF()
+ENDIF()
+
+#-------------------------------------------------------------------------------
+# Tiled settings.
+#-------------------------------------------------------------------------------
+IF(MATMUL_BUILD_PAR_TILED)
+    SET(MATMUL_TILED_TILE_SIZE 64 CACHE INTEGER "The number of rows and columns of the tiles the row major GEMM converts the matrices to.")
+    IF(MATMUL_TILED_TILE_SIZE)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_TILED_TILE_SIZE=${MATMUL_TILED_TILE_SIZE}")
+    ENDIF()
+ENDIF()
 
 #-------------------------------------------------------------------------------
 # Strassen settings.
@@ -330,6 +499,22 @@ IF(MATMUL_BUILD_PAR_STRASSEN_OMP2)
         LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_STRASSEN_OMP_CUT_OFF=${MATMUL_STRASSEN_OMP_CUT_OFF}")
     ENDIF()
 ENDIF()
+IF(MATMUL_BUILD_PAR_STRASSEN_OMP3)
+    SET(MATMUL_STRASSEN_OMP_TASK_DEPTH 0 CACHE INTEGER "The number of recursion levels creating tasks. 0 uses the smallest one giving at least two tasks per thread.")
+    IF(MATMUL_STRASSEN_OMP_TASK_DEPTH)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_STRASSEN_OMP_TASK_DEPTH=${MATMUL_STRASSEN_OMP_TASK_DEPTH}")
+    ENDIF()
+ENDIF()
+
+#-------------------------------------------------------------------------------
+# Dispatch settings.
+#-------------------------------------------------------------------------------
+IF(MATMUL_BUILD_DISPATCH)
+    OPTION(MATMUL_GEMM_PRINT_DECISION "If this is defined, each call to matmul_gemm will print out the chosen implementation and its predicted time." OFF)
+    IF(MATMUL_GEMM_PRINT_DECISION)
+        LIST(APPEND _MATMUL_COMPILE_DEFINITIONS_PUBLIC "MATMUL_GEMM_PRINT_DECISION")
+    ENDIF()
+ENDIF()
 
 #-------------------------------------------------------------------------------
 # OpenMP Settings.
@@ -0,0 +1,422 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+
+#include <matmul/common/Cpu.h>
+
+#include <matmul/common/Once.h>     // matmul_once, SMatMulOnce
+
+#ifdef MATMUL_ARCH_X86
+    #if defined(_MSC_VER)
+        #include <intrin.h>     // __cpuidex, _xgetbv
+    #else
+        #include <cpuid.h>      // __get_cpuid_max, __cpuid_count
+    #endif
+#endif
+
+#ifdef _MSC_VER
+    #include <Windows.h>        // QueryPerformanceCounter
+#else
+    #include <sys/time.h>       // gettimeofday
+#endif
+
+#include <stdint.h>             // uint32_t, uint64_t
+#include <stdio.h>              // FILE, fopen, fgets, snprintf
+#include <stdlib.h>             // strtoul
+#include <string.h>             // memcpy, strlen, strcpy, strncmp
+
+#ifdef MATMUL_ARCH_X86
+    //-----------------------------------------------------------------------------
+    //! Executes cpuid for the given leaf and sub-leaf. All registers are zero if the leaf is not supported.
+    //-----------------------------------------------------------------------------
+    void matmul_cpu_cpuid(
+        uint32_t const uiLeaf,
+        uint32_t const uiSubLeaf,
+        uint32_t * const puiRegs)
+    {
+        puiRegs[0] = puiRegs[1] = puiRegs[2] = puiRegs[3] = 0;
+    #if defined(_MSC_VER)
+        int aiRegs[4];
+        __cpuid(aiRegs, (int)(uiLeaf & 0x80000000u));
+        if((uint32_t)aiRegs[0] >= uiLeaf)
+        {
+            __cpuidex(aiRegs, (int)uiLeaf, (int)uiSubLeaf);
+            puiRegs[0] = (uint32_t)aiRegs[0];
+            puiRegs[1] = (uint32_t)aiRegs[1];
+            puiRegs[2] = (uint32_t)aiRegs[2];
+            puiRegs[3] = (uint32_t)aiRegs[3];
+        }
+    #else
+        if(__get_cpuid_max(uiLeaf & 0x80000000u, 0) >= uiLeaf)
+        {
+            unsigned int a, b, c, d;
+            __cpuid_count(uiLeaf, uiSubLeaf, a, b, c, d);
+            puiRegs[0] = a;
+            puiRegs[1] = b;
+            puiRegs[2] = c;
+            puiRegs[3] = d;
+        }
+    #endif
+    }
+
+    //-----------------------------------------------------------------------------
+    //! \return The extended control register XCR0 telling which register states are saved by the operating system.
+    //-----------------------------------------------------------------------------
+    uint64_t matmul_cpu_xgetbv(void)
+    {
+    #if defined(_MSC_VER)
+        return (uint64_t)_xgetbv(0);
+    #else
+        // The xgetbv intrinsic would require compiling the whole file with -mxsave.
+        uint32_t uiEax, uiEdx;
+        __asm__ __volatile__("xgetbv" : "=a"(uiEax), "=d"(uiEdx) : "c"(0));
+        return ((uint64_t)uiEdx << 32) | uiEax;
+    #endif
+    }
+#endif
+
+//-----------------------------------------------------------------------------
+//! Queries the features via cpuid.
+//-----------------------------------------------------------------------------
+void matmul_cpu_detect_features(
+    void * const pFeatures)
+{
+    SMatMulCpuFeatures features;
+    features.bSse2 = false;
+    features.bSse42 = false;
+    features.bAvx = false;
+    features.bAvx2 = false;
+    features.bFma = false;
+    features.bF16c = false;
+    features.bAvx512f = false;
+    features.bAvx512bw = false;
+    features.bAvx512Vnni = false;
+    features.bAvx512Bf16 = false;
+
+#ifdef MATMUL_ARCH_X86
+    uint32_t auiLeaf1[4];
+    uint32_t auiLeaf7[4];
+    uint32_t auiLeaf7Sub1[4];
+    matmul_cpu_cpuid(1, 0, auiLeaf1);
+    matmul_cpu_cpuid(7, 0, auiLeaf7);
+    matmul_cpu_cpuid(7, 1, auiLeaf7Sub1);
+
+    features.bSse2 = (auiLeaf1[3] & (1u << 26)) != 0;
+    features.bSse42 = (auiLeaf1[2] & (1u << 20)) != 0;
+
+    // The AVX registers are only usable if the operating system saves them on context switches.
+    bool const bOsXSave = (auiLeaf1[2] & (1u << 27)) != 0;
+    uint64_t const uiXcr0 = bOsXSave ? matmul_cpu_xgetbv() : 0;
+    bool const bOsAvx = (uiXcr0 & 0x6u) == 0x6u;            // XMM and YMM state.
+    bool const bOsAvx512 = (uiXcr0 & 0xE6u) == 0xE6u;       // Additionally opmask, upper ZMM0-15 and ZMM16-31 state.
+
+    features.bAvx = bOsAvx && ((auiLeaf1[2] & (1u << 28)) != 0);
+    features.bFma = features.bAvx && ((auiLeaf1[2] & (1u << 12)) != 0);
+    features.bF16c = features.bAvx && ((auiLeaf1[2] & (1u << 29)) != 0);
+    features.bAvx2 = features.bAvx && ((auiLeaf7[1] & (1u << 5)) != 0);
+    features.bAvx512f = bOsAvx512 && ((auiLeaf7[1] & (1u << 16)) != 0);
+    features.bAvx512bw = features.bAvx512f && ((auiLeaf7[1] & (1u << 30)) != 0);
+    features.bAvx512Vnni = features.bAvx512f && ((auiLeaf7[2] & (1u << 11)) != 0);
+    features.bAvx512Bf16 = features.bAvx512f && ((auiLeaf7Sub1[0] & (1u << 5)) != 0);
+#endif
+
+    *(SMatMulCpuFeatures *)pFeatures = features;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+SMatMulCpuFeatures const * matmul_cpu_get_features(void)
+{
+    static SMatMulCpuFeatures features;
+    static SMatMulOnce once = MATMUL_ONCE_INIT;
+
+    matmul_once(&once, 1, matmul_cpu_detect_features, &features);
+
+    return &features;
+}
+
+//-----------------------------------------------------------------------------
+//! Queries the brand string via cpuid.
+//-----------------------------------------------------------------------------
+void matmul_cpu_detect_model(
+    void * const pszModel)
+{
+    strcpy((char *)pszModel, "unknown");
+
+#ifdef MATMUL_ARCH_X86
+    uint32_t auiLeaf[4];
+    matmul_cpu_cpuid(0x80000000u, 0, auiLeaf);
+    if(auiLeaf[0] >= 0x80000004u)
+    {
+        // The brand string is spread over the registers of three consecutive leaves.
+        char szBrand[49];
+        for(uint32_t i = 0; i < 3; ++i)
+        {
+            matmul_cpu_cpuid(0x80000002u + i, 0, auiLeaf);
+            memcpy(&szBrand[i*16], auiLeaf, 16);
+        }
+        szBrand[48] = '\0';
+
+        char const * pszBegin = szBrand;
+        while(*pszBegin == ' ')
+        {
+            ++pszBegin;
+        }
+        size_t uiLength = strlen(pszBegin);
+        while((uiLength > 0) && (pszBegin[uiLength-1] == ' '))
+        {
+            --uiLength;
+        }
+        if(uiLength > 0)
+        {
+            memcpy(pszModel, pszBegin, uiLength);
+            ((char *)pszModel)[uiLength] = '\0';
+        }
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+char const * matmul_cpu_get_model(void)
+{
+    static char szModel[49];
+    static SMatMulOnce once = MATMUL_ONCE_INIT;
+
+    matmul_once(&once, 1, matmul_cpu_detect_model, szModel);
+
+    return szModel;
+}
+
+//-----------------------------------------------------------------------------
+//! The cache sizes shared by matmul_cpu_get_cache_sizes and matmul_cpu_set_cache_sizes.
+//-----------------------------------------------------------------------------
+typedef struct SMatMulCpuCacheState
+{
+    SMatMulCpuCacheSizes sizes;         //!< The sizes in use. Only written by matmul_cpu_init_cache_sizes.
+    SMatMulCpuCacheSizes overrideSizes; //!< The sizes given to matmul_cpu_set_cache_sizes.
+    bool bOverride;                     //!< If overrideSizes are used instead of the detected ones.
+    long iGeneration;                   //!< Incremented by matmul_cpu_set_cache_sizes.
+    SMatMulOnce once;
+} SMatMulCpuCacheState;
+
+//-----------------------------------------------------------------------------
+//! \return The cache sizes of the process.
+//-----------------------------------------------------------------------------
+SMatMulCpuCacheState * matmul_cpu_get_cache_state(void)
+{
+    static SMatMulCpuCacheState state = {{0, 0, 0}, {0, 0, 0}, false, 1, MATMUL_ONCE_INIT};
+    return &state;
+}
+
+//-----------------------------------------------------------------------------
+//! Sets the size of the given cache level if it is not known yet.
+//-----------------------------------------------------------------------------
+void matmul_cpu_set_cache_level_size(
+    SMatMulCpuCacheSizes * const pCacheSizes,
+    unsigned int const uiLevel,
+    size_t const uiSize)
+{
+    size_t * const puiSize =
+        (uiLevel == 1) ? &pCacheSizes->uiL1d
+        : (uiLevel == 2) ? &pCacheSizes->uiL2
+        : (uiLevel == 3) ? &pCacheSizes->uiL3
+        : 0;
+    if(puiSize && (*puiSize == 0))
+    {
+        *puiSize = uiSize;
+    }
+}
+
+#ifdef __linux__
+    //-----------------------------------------------------------------------------
+    //! Reads the first line of the given attribute of a cache in /sys/devices/system/cpu/cpu0/cache.
+    //!
+    //! \return If the attribute could be read.
+    //-----------------------------------------------------------------------------
+    bool matmul_cpu_read_cache_attribute(
+        unsigned int const uiIndex,
+        char const * const pszAttribute,
+        char * const pszValue,
+        int const iValueSize)
+    {
+        char szPath[128];
+        snprintf(szPath, sizeof(szPath), "/sys/devices/system/cpu/cpu0/cache/index%u/%s", uiIndex, pszAttribute);
+
+        FILE * const pFile = fopen(szPath, "r");
+        if(!pFile)
+        {
+            return false;
+        }
+        bool const bRead = (fgets(pszValue, iValueSize, pFile) != 0);
+        fclose(pFile);
+
+        return bRead;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Detects the data cache sizes from the cache descriptions of the first core in sysfs.
+    //-----------------------------------------------------------------------------
+    void matmul_cpu_detect_cache_sizes_sysfs(
+        SMatMulCpuCacheSizes * const pCacheSizes)
+    {
+        for(unsigned int i = 0; i < 16; ++i)
+        {
+            char szLevel[16];
+            char szType[32];
+            char szSize[32];
+            if(!matmul_cpu_read_cache_attribute(i, "level", szLevel, (int)sizeof(szLevel))
+                || !matmul_cpu_read_cache_attribute(i, "type", szType, (int)sizeof(szType))
+                || !matmul_cpu_read_cache_attribute(i, "size", szSize, (int)sizeof(szSize)))
+            {
+                break;
+            }
+            if(strncmp(szType, "Instruction", 11) == 0)
+            {
+                continue;
+            }
+
+            // The size is given like "48K" or "32M".
+            char * pszUnit = 0;
+            size_t uiSize = (size_t)strtoul(szSize, &pszUnit, 10);
+            uiSize *= (*pszUnit == 'K') ? 1024u : (*pszUnit == 'M') ? 1024u*1024u : (*pszUnit == 'G') ? 1024u*1024u*1024u : 1u;
+
+            matmul_cpu_set_cache_level_size(pCacheSizes, (unsigned int)strtoul(szLevel, 0, 10), uiSize);
+        }
+    }
+#endif
+
+#ifdef MATMUL_ARCH_X86
+    //-----------------------------------------------------------------------------
+    //! Detects the data cache sizes from the deterministic cache parameters of cpuid.
+    //! Intel reports them in leaf 4, AMD in leaf 0x8000001D using the same layout. The leaf of the other vendor reports no caches.
+    //-----------------------------------------------------------------------------
+    void matmul_cpu_detect_cache_sizes_cpuid(
+        SMatMulCpuCacheSizes * const pCacheSizes)
+    {
+        uint32_t const auiLeaves[2] = {4u, 0x8000001Du};
+        for(uint32_t uiLeafIdx = 0; uiLeafIdx < 2; ++uiLeafIdx)
+        {
+            for(uint32_t uiSubLeaf = 0; uiSubLeaf < 16; ++uiSubLeaf)
+            {
+                uint32_t auiRegs[4];
+                matmul_cpu_cpuid(auiLeaves[uiLeafIdx], uiSubLeaf, auiRegs);
+
+                uint32_t const uiType = auiRegs[0] & 0x1Fu;     // 0: no more caches, 1: data, 2: instruction, 3: unified
+                if(uiType == 0)
+                {
+                    break;
+                }
+                if(uiType == 2)
+                {
+                    continue;
+                }
+
+                // size = ways * partitions * line size * sets
+                size_t const uiSize =
+                    (size_t)((auiRegs[1] >> 22) + 1u)
+                    * (size_t)(((auiRegs[1] >> 12) & 0x3FFu) + 1u)
+                    * (size_t)((auiRegs[1] & 0xFFFu) + 1u)
+                    * (size_t)(auiRegs[2] + 1u);
+
+                matmul_cpu_set_cache_level_size(pCacheSizes, (auiRegs[0] >> 5) & 0x7u, uiSize);
+            }
+        }
+    }
+#endif
+
+//-----------------------------------------------------------------------------
+//! Detects the sizes or takes the ones set. They are collected in a local and written at the end so that the sizes are never zero in between.
+//-----------------------------------------------------------------------------
+void matmul_cpu_init_cache_sizes(
+    void * const pState)
+{
+    SMatMulCpuCacheState * const pCacheState = (SMatMulCpuCacheState *)pState;
+    SMatMulCpuCacheSizes sizes = {0, 0, 0};
+
+    if(pCacheState->bOverride)
+    {
+        sizes = pCacheState->overrideSizes;
+    }
+    else
+    {
+#ifdef __linux__
+        matmul_cpu_detect_cache_sizes_sysfs(&sizes);
+#endif
+#ifdef MATMUL_ARCH_X86
+        matmul_cpu_detect_cache_sizes_cpuid(&sizes);
+#endif
+    }
+
+    pCacheState->sizes = sizes;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+SMatMulCpuCacheSizes const * matmul_cpu_get_cache_sizes(void)
+{
+    SMatMulCpuCacheState * const pState = matmul_cpu_get_cache_state();
+
+    matmul_once(&pState->once, pState->iGeneration, matmul_cpu_init_cache_sizes, pState);
+
+    return &pState->sizes;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+long matmul_cpu_get_cache_sizes_generation(void)
+{
+    return matmul_cpu_get_cache_state()->iGeneration;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_cpu_set_cache_sizes(
+    SMatMulCpuCacheSizes const * const pCacheSizes)
+{
+    SMatMulCpuCacheState * const pState = matmul_cpu_get_cache_state();
+
+    if(pCacheSizes)
+    {
+        pState->overrideSizes = *pCacheSizes;
+        pState->bOverride = true;
+    }
+    else
+    {
+        pState->bOverride = false;
+    }
+    ++pState->iGeneration;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+double matmul_cpu_get_time_sec(void)
+{
+#ifdef _MSC_VER
+    LARGE_INTEGER li, frequency;
+    QueryPerformanceCounter(&li);
+    QueryPerformanceFrequency(&frequency);
+    return ((double)li.QuadPart)/((double)frequency.QuadPart);
+#else
+    struct timeval act_time;
+    gettimeofday(&act_time, NULL);
+    return (double)act_time.tv_sec + (double)act_time.tv_usec / 1000000.0;
+#endif
+}
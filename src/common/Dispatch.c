@@ -0,0 +1,841 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_DISPATCH
+
+    #include <matmul/common/Dispatch.h>
+
+    #include <matmul/seq/Small.h>           // matmul_gemm_seq_small, matmul_gemm_seq_small_get
+    #include <matmul/seq/Packed.h>          // matmul_gemm_seq_packed
+    #include <matmul/seq/MultipleOpts.h>    // matmul_gemm_seq_multiple_opts_block
+    #include <matmul/seq/Recursive.h>       // matmul_gemm_seq_recursive
+    #include <matmul/seq/Strassen.h>        // matmul_gemm_seq_strassen
+    #include <matmul/par/Omp.h>             // matmul_gemm_par_omp2_guided_schedule
+    #include <matmul/par/StrassenOmp2.h>    // matmul_gemm_par_strassen_omp2
+    #include <matmul/par/Tiled.h>           // matmul_gemm_par_tiled_row_major
+    #include <matmul/par/PackedOmp2.h>      // matmul_gemm_par_packed_omp2
+    #include <matmul/par/Batched.h>         // matmul_gemm_strided_batched
+
+    #include <matmul/common/Alloc.h>        // matmul_arr_free
+    #include <matmul/common/Array.h>        // matmul_arr_alloc_fill_rand
+    #include <matmul/common/Cpu.h>          // matmul_cpu_get_model, matmul_cpu_get_time_sec
+    #include <matmul/common/Once.h>         // matmul_once, SMatMulOnce
+
+    #include <float.h>                      // DBL_MAX
+    #include <math.h>                       // fabs
+    #include <stdio.h>                      // FILE, fopen, fgets, fprintf, printf
+    #include <stdlib.h>                     // getenv, strtol, strtod
+    #include <string.h>                     // strcmp, strchr, strcspn
+
+    #ifdef _OPENMP
+        #include <omp.h>                    // omp_get_max_threads
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //! The number of ';' separated fields of an entry of the model file.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_GEMM_MODEL_NUM_FIELDS 7
+
+    //-----------------------------------------------------------------------------
+    //! The signature shared by all implementations the dispatcher chooses from.
+    //-----------------------------------------------------------------------------
+    typedef void(*TMatMulDispatchGemm)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const);
+
+    //-----------------------------------------------------------------------------
+    //! The cost model of one implementation.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulGemmModelEntry
+    {
+        double afCoeffs[3];             //!< The seconds per call, per element of A, B and C and per multiply-add.
+        int iNumThreads;                //!< The number of threads the coefficients have been measured with.
+        bool bCalibrated;               //!< If the coefficients have been measured instead of being the built-in estimates.
+    } SMatMulGemmModelEntry;
+
+    //-----------------------------------------------------------------------------
+    //! The cost models of all implementations.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulGemmModel
+    {
+        SMatMulGemmModelEntry aEntries[EMatMulGemmImplCount];
+    } SMatMulGemmModel;
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    char const * matmul_gemm_impl_name(
+        EMatMulGemmImpl const eImpl)
+    {
+        static char const * const apszNames[EMatMulGemmImplCount] = {
+            "seq_small",
+            "seq_packed",
+            "seq_multiple_opts_block",
+            "seq_recursive",
+            "seq_strassen",
+            "par_omp2",
+            "par_strassen_omp2",
+            "par_tiled",
+            "par_packed_omp2",
+            "par_batched"};
+
+        return ((int)eImpl >= 0 && eImpl < EMatMulGemmImplCount) ? apszNames[eImpl] : "unknown";
+    }
+
+    //-----------------------------------------------------------------------------
+    //! \return If the implementation uses all OpenMP threads for a single problem.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_impl_is_parallel(
+        EMatMulGemmImpl const eImpl)
+    {
+        return (eImpl == EMatMulGemmImplParOmp2)
+            || (eImpl == EMatMulGemmImplParStrassenOmp2)
+            || (eImpl == EMatMulGemmImplParTiled)
+            || (eImpl == EMatMulGemmImplParPackedOmp2);
+    }
+
+    //-----------------------------------------------------------------------------
+    //! \return The implementation for a single problem of the given size or null if it is not built or does not support the size.
+    //-----------------------------------------------------------------------------
+    TMatMulDispatchGemm matmul_gemm_impl_get(
+        EMatMulGemmImpl const eImpl,
+        TIdx const m, TIdx const n, TIdx const k)
+    {
+        (void)m; (void)n; (void)k;
+
+        switch(eImpl)
+        {
+    #ifdef MATMUL_BUILD_SEQ_SMALL
+        case EMatMulGemmImplSeqSmall:
+            return matmul_gemm_seq_small_get(m, n, k, (TElem)1) ? matmul_gemm_seq_small : 0;
+    #endif
+    #ifdef MATMUL_BUILD_SEQ_PACKED
+        case EMatMulGemmImplSeqPacked:
+            return matmul_gemm_seq_packed;
+    #endif
+    #ifdef MATMUL_BUILD_SEQ_MULTIPLE_OPTS_BLOCK
+        case EMatMulGemmImplSeqMultipleOptsBlock:
+            return matmul_gemm_seq_multiple_opts_block;
+    #endif
+    #ifdef MATMUL_BUILD_SEQ_RECURSIVE
+        case EMatMulGemmImplSeqRecursive:
+            return matmul_gemm_seq_recursive;
+    #endif
+    #ifdef MATMUL_BUILD_SEQ_STRASSEN
+        case EMatMulGemmImplSeqStrassen:
+            return matmul_gemm_seq_strassen;
+    #endif
+    #if defined(MATMUL_BUILD_PAR_OMP2) && (_OPENMP >= 200203)
+        case EMatMulGemmImplParOmp2:
+            return matmul_gemm_par_omp2_guided_schedule;
+    #endif
+    #if defined(MATMUL_BUILD_PAR_STRASSEN_OMP2) && (_OPENMP >= 200203)
+        case EMatMulGemmImplParStrassenOmp2:
+            return matmul_gemm_par_strassen_omp2;
+    #endif
+    #ifdef MATMUL_BUILD_PAR_TILED
+        case EMatMulGemmImplParTiled:
+            return matmul_gemm_par_tiled_row_major;
+    #endif
+    #if defined(MATMUL_BUILD_PAR_PACKED_OMP2) && (_OPENMP >= 200203)
+        case EMatMulGemmImplParPackedOmp2:
+            return matmul_gemm_par_packed_omp2;
+    #endif
+        default:
+            return 0;
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! \return The number of threads the parallel implementations use.
+    //-----------------------------------------------------------------------------
+    int matmul_gemm_get_num_threads(void)
+    {
+    #ifdef _OPENMP
+        return omp_get_max_threads();
+    #else
+        return 1;
+    #endif
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Sets the built-in estimates for a single thread of a current x86-64 core.
+    //! They only have to rank the implementations roughly, matmul_gemm_calibrate measures the real ones.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_model_set_defaults(
+        SMatMulGemmModel * const pModel)
+    {
+        static double const aafDefaultCoeffs[EMatMulGemmImplCount][3] = {
+            {2.0e-8, 0.0,       1.0/4.0e9},     // seq_small
+            {3.0e-6, 2.0e-9,    1.0/7.0e9},     // seq_packed
+            {1.0e-7, 0.0,       1.0/2.0e9},     // seq_multiple_opts_block
+            {5.0e-7, 0.0,       1.0/3.0e9},     // seq_recursive
+            {5.0e-6, 1.0e-8,    1.0/5.0e9},     // seq_strassen
+            {1.0e-5, 0.0,       1.0/1.0e9},     // par_omp2
+            {5.0e-5, 1.0e-8,    1.0/3.0e9},     // par_strassen_omp2
+            {2.0e-5, 5.0e-9,    1.0/1.5e9},     // par_tiled
+            {1.0e-5, 2.0e-9,    1.0/7.0e9},     // par_packed_omp2
+            {0.0,    0.0,       0.0}};          // par_batched (derived from the sequential implementations)
+
+        for(int i = 0; i < (int)EMatMulGemmImplCount; ++i)
+        {
+            for(int j = 0; j < 3; ++j)
+            {
+                pModel->aEntries[i].afCoeffs[j] = aafDefaultCoeffs[i][j];
+            }
+            pModel->aEntries[i].iNumThreads = 1;
+            pModel->aEntries[i].bCalibrated = false;
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Replaces the given model with the defaults and the entries of the given file.
+    //!
+    //! \return If the file could be read.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_model_read(
+        SMatMulGemmModel * const pModel,
+        char const * const pszPath);
+
+    //-----------------------------------------------------------------------------
+    //! Initializes the model with the defaults and the file given by MATMUL_GEMM_MODEL if it is set.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_model_init(
+        void * const pModel)
+    {
+        matmul_gemm_model_set_defaults((SMatMulGemmModel *)pModel);
+
+        char const * const pszPath = getenv("MATMUL_GEMM_MODEL");
+        if(pszPath)
+        {
+            matmul_gemm_model_read((SMatMulGemmModel *)pModel, pszPath);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! \return The model. It is loaded from the file given by MATMUL_GEMM_MODEL on the first call.
+    //-----------------------------------------------------------------------------
+    SMatMulGemmModel * matmul_gemm_model_get(void)
+    {
+        static SMatMulGemmModel model;
+        static SMatMulOnce once = MATMUL_ONCE_INIT;
+
+        matmul_once(&once, 1, matmul_gemm_model_init, &model);
+
+        return &model;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! \return The predicted time in seconds of a single problem.
+    //-----------------------------------------------------------------------------
+    double matmul_gemm_model_predict(
+        SMatMulGemmModel const * const pModel,
+        EMatMulGemmImpl const eImpl,
+        int const iNumThreads,
+        TIdx const m, TIdx const n, TIdx const k)
+    {
+        SMatMulGemmModelEntry const * const pEntry = &pModel->aEntries[eImpl];
+
+        double const fElements = (double)m * (double)k + (double)k * (double)n + (double)m * (double)n;
+        double const fMultiplyAdds = (double)m * (double)n * (double)k;
+        double const fThreadScale = matmul_gemm_impl_is_parallel(eImpl) ? ((double)pEntry->iNumThreads / (double)iNumThreads) : 1.0;
+
+        return pEntry->afCoeffs[0]
+            + pEntry->afCoeffs[1] * fElements * fThreadScale
+            + pEntry->afCoeffs[2] * fMultiplyAdds * fThreadScale;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_decide(
+        TIdx const m, TIdx const n, TIdx const k,
+        TIdx const batchCount,
+        SMatMulGemmDecision * const pDecision)
+    {
+        SMatMulGemmModel const * const pModel = matmul_gemm_model_get();
+        int const iNumThreads = matmul_gemm_get_num_threads();
+        double const fNumProblems = (batchCount > 0) ? (double)batchCount : 1.0;
+
+        pDecision->eImpl = EMatMulGemmImplCount;
+        pDecision->fPredictedSec = DBL_MAX;
+        pDecision->iNumThreads = iNumThreads;
+
+        // The problems are computed one after the other by the implementation for a single problem.
+        // The sequential GEMM of a batch is the fastest of the fixed-size kernel and the packed GEMM.
+        double fSeqBatchSec = DBL_MAX;
+        for(int i = 0; i < (int)EMatMulGemmImplParBatched; ++i)
+        {
+            EMatMulGemmImpl const eImpl = (EMatMulGemmImpl)i;
+            if(matmul_gemm_impl_get(eImpl, m, n, k))
+            {
+                double const fTimeSec = matmul_gemm_model_predict(pModel, eImpl, iNumThreads, m, n, k);
+                if(fTimeSec * fNumProblems < pDecision->fPredictedSec)
+                {
+                    pDecision->eImpl = eImpl;
+                    pDecision->fPredictedSec = fTimeSec * fNumProblems;
+                }
+                if(((eImpl == EMatMulGemmImplSeqSmall) || (eImpl == EMatMulGemmImplSeqPacked)) && (fTimeSec < fSeqBatchSec))
+                {
+                    fSeqBatchSec = fTimeSec;
+                }
+            }
+        }
+
+    #ifdef MATMUL_BUILD_PAR_BATCHED
+        // The problems of a batch are distributed across the threads, each one computed sequentially.
+        if((batchCount > 1) && (fSeqBatchSec < DBL_MAX))
+        {
+            double const fNumRounds = (double)((batchCount + (TIdx)iNumThreads - 1) / (TIdx)iNumThreads);
+            double const fTimeSec = fSeqBatchSec * fNumRounds;
+            if(fTimeSec < pDecision->fPredictedSec)
+            {
+                pDecision->eImpl = EMatMulGemmImplParBatched;
+                pDecision->fPredictedSec = fTimeSec;
+            }
+        }
+    #endif
+
+        if(pDecision->eImpl == EMatMulGemmImplCount)
+        {
+            pDecision->pszImpl = matmul_gemm_impl_name(pDecision->eImpl);
+            pDecision->bCalibrated = false;
+            return false;
+        }
+
+        // The batched prediction is derived from the sequential ones.
+        EMatMulGemmImpl const eModelImpl = (pDecision->eImpl == EMatMulGemmImplParBatched) ? EMatMulGemmImplSeqPacked : pDecision->eImpl;
+        pDecision->pszImpl = matmul_gemm_impl_name(pDecision->eImpl);
+        pDecision->bCalibrated = pModel->aEntries[eModelImpl].bCalibrated;
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Prints the decision if MATMUL_GEMM_PRINT_DECISION is defined.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_print_decision(
+        TIdx const m, TIdx const n, TIdx const k,
+        TIdx const batchCount,
+        SMatMulGemmDecision const * const pDecision)
+    {
+    #ifdef MATMUL_GEMM_PRINT_DECISION
+        printf("[GEMM Dispatch] m=%"MATMUL_PRINTF_SIZE_T" n=%"MATMUL_PRINTF_SIZE_T" k=%"MATMUL_PRINTF_SIZE_T" batch=%"MATMUL_PRINTF_SIZE_T" threads=%d: %s (predicted %g s, %s model)\n",
+            (size_t)m, (size_t)n, (size_t)k, (size_t)batchCount,
+            pDecision->iNumThreads,
+            pDecision->pszImpl,
+            pDecision->fPredictedSec,
+            pDecision->bCalibrated ? "calibrated" : "default");
+    #else
+        (void)m; (void)n; (void)k; (void)batchCount; (void)pDecision;
+    #endif
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        SMatMulGemmDecision decision;
+        if(!matmul_gemm_decide(m, n, k, 1, &decision))
+        {
+            printf("[GEMM Dispatch] No implementation is built for m=%"MATMUL_PRINTF_SIZE_T" n=%"MATMUL_PRINTF_SIZE_T" k=%"MATMUL_PRINTF_SIZE_T"!\n", (size_t)m, (size_t)n, (size_t)k);
+            return;
+        }
+        matmul_gemm_print_decision(m, n, k, 1, &decision);
+
+        matmul_gemm_impl_get(decision.eImpl, m, n, k)(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_strided_batched_auto(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const A, TIdx const lda, TIdx const strideA,
+        TElem const * const B, TIdx const ldb, TIdx const strideB,
+        TElem const beta,
+        TElem * const C, TIdx const ldc, TIdx const strideC,
+        TIdx const batchCount)
+    {
+        if(batchCount == 0)
+        {
+            return;
+        }
+
+        SMatMulGemmDecision decision;
+        if(!matmul_gemm_decide(m, n, k, batchCount, &decision))
+        {
+            printf("[GEMM Dispatch] No implementation is built for m=%"MATMUL_PRINTF_SIZE_T" n=%"MATMUL_PRINTF_SIZE_T" k=%"MATMUL_PRINTF_SIZE_T"!\n", (size_t)m, (size_t)n, (size_t)k);
+            return;
+        }
+        matmul_gemm_print_decision(m, n, k, batchCount, &decision);
+
+    #ifdef MATMUL_BUILD_PAR_BATCHED
+        if(decision.eImpl == EMatMulGemmImplParBatched)
+        {
+            matmul_gemm_strided_batched(m, n, k, alpha, A, lda, strideA, B, ldb, strideB, beta, C, ldc, strideC, batchCount);
+            return;
+        }
+    #endif
+
+        TMatMulDispatchGemm const pGemm = matmul_gemm_impl_get(decision.eImpl, m, n, k);
+        for(TIdx i = 0; i < batchCount; ++i)
+        {
+            pGemm(m, n, k, alpha, A + i*strideA, lda, B + i*strideB, ldb, beta, C + i*strideC, ldc);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! \return The fastest time in seconds of a single call of the GEMM.
+    //! Calls shorter than a millisecond are repeated so that the resolution of the timer does not matter.
+    //-----------------------------------------------------------------------------
+    double matmul_gemm_calibrate_measure(
+        TMatMulDispatchGemm const pGemm,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const * const A,
+        TElem const * const B,
+        TElem * const C,
+        TIdx const uiRepeatCount)
+    {
+        double fTimeMinSec = DBL_MAX;
+        for(TIdx i = 0; i < uiRepeatCount; ++i)
+        {
+            TIdx uiNumCalls = 1;
+            for(;;)
+            {
+                double const fTimeStart = matmul_cpu_get_time_sec();
+                for(TIdx j = 0; j < uiNumCalls; ++j)
+                {
+                    pGemm(m, n, k, (TElem)1, A, k, B, n, (TElem)1, C, n);
+                }
+                double const fTimeElapsed = matmul_cpu_get_time_sec() - fTimeStart;
+                if(fTimeElapsed >= 1.0e-3)
+                {
+                    double const fTimeCallSec = fTimeElapsed / (double)uiNumCalls;
+                    fTimeMinSec = (fTimeCallSec < fTimeMinSec) ? fTimeCallSec : fTimeMinSec;
+                    break;
+                }
+                uiNumCalls *= 2;
+            }
+        }
+
+        return fTimeMinSec;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Solves the normal equations of the least squares fit for the coefficients marked as active.
+    //! The features are scaled to a maximum of one beforehand so that the system is well conditioned.
+    //!
+    //! \return If the system is regular.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_calibrate_solve(
+        double const aafAtA[3][3],
+        double const afAtb[3],
+        bool const abActive[3],
+        double afCoeffs[3])
+    {
+        int aiIdx[3];
+        int iNumActive = 0;
+        for(int i = 0; i < 3; ++i)
+        {
+            afCoeffs[i] = 0.0;
+            if(abActive[i])
+            {
+                aiIdx[iNumActive] = i;
+                ++iNumActive;
+            }
+        }
+
+        // Gaussian elimination with partial pivoting on the augmented active sub-system.
+        double aafM[3][4];
+        for(int r = 0; r < iNumActive; ++r)
+        {
+            for(int c = 0; c < iNumActive; ++c)
+            {
+                aafM[r][c] = aafAtA[aiIdx[r]][aiIdx[c]];
+            }
+            aafM[r][iNumActive] = afAtb[aiIdx[r]];
+        }
+        for(int c = 0; c < iNumActive; ++c)
+        {
+            int iPivot = c;
+            for(int r = c+1; r < iNumActive; ++r)
+            {
+                if(fabs(aafM[r][c]) > fabs(aafM[iPivot][c]))
+                {
+                    iPivot = r;
+                }
+            }
+            if(fabs(aafM[iPivot][c]) < 1.0e-12)
+            {
+                return false;
+            }
+            for(int j = 0; j <= iNumActive; ++j)
+            {
+                double const fTmp = aafM[c][j];
+                aafM[c][j] = aafM[iPivot][j];
+                aafM[iPivot][j] = fTmp;
+            }
+            for(int r = c+1; r < iNumActive; ++r)
+            {
+                double const fFactor = aafM[r][c] / aafM[c][c];
+                for(int j = c; j <= iNumActive; ++j)
+                {
+                    aafM[r][j] -= fFactor * aafM[c][j];
+                }
+            }
+        }
+        for(int r = iNumActive-1; r >= 0; --r)
+        {
+            double fSum = aafM[r][iNumActive];
+            for(int c = r+1; c < iNumActive; ++c)
+            {
+                fSum -= aafM[r][c] * afCoeffs[aiIdx[c]];
+            }
+            afCoeffs[aiIdx[r]] = fSum / aafM[r][r];
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Fits non-negative coefficients to the samples by minimizing the sum of the squared relative errors.
+    //! The constant and memory coefficients which would become negative are removed from the fit one after the other.
+    //! The arithmetic coefficient is never removed, a model without it would predict big problems to be free.
+    //!
+    //! \return If the fit succeeded.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_calibrate_fit(
+        double const (* const aafFeatures)[3],
+        double const * const afTimesSec,
+        TIdx const uiNumSamples,
+        double afCoeffs[3])
+    {
+        double afScale[3] = {0.0, 0.0, 0.0};
+        for(TIdx s = 0; s < uiNumSamples; ++s)
+        {
+            for(int i = 0; i < 3; ++i)
+            {
+                afScale[i] = (aafFeatures[s][i] > afScale[i]) ? aafFeatures[s][i] : afScale[i];
+            }
+        }
+
+        // Each row x/t of the weighted system should be one.
+        double aafAtA[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+        double afAtb[3] = {0.0, 0.0, 0.0};
+        for(TIdx s = 0; s < uiNumSamples; ++s)
+        {
+            double afRow[3];
+            for(int i = 0; i < 3; ++i)
+            {
+                afRow[i] = aafFeatures[s][i] / afScale[i] / afTimesSec[s];
+            }
+            for(int i = 0; i < 3; ++i)
+            {
+                for(int j = 0; j < 3; ++j)
+                {
+                    aafAtA[i][j] += afRow[i] * afRow[j];
+                }
+                afAtb[i] += afRow[i];
+            }
+        }
+
+        bool abActive[3] = {true, true, true};
+        for(int iIteration = 0; iIteration < 3; ++iIteration)
+        {
+            if(!matmul_gemm_calibrate_solve(aafAtA, afAtb, abActive, afCoeffs))
+            {
+                return false;
+            }
+
+            int iMostNegative = -1;
+            for(int i = 0; i < 2; ++i)
+            {
+                if(abActive[i] && (afCoeffs[i] < 0.0) && ((iMostNegative < 0) || (afCoeffs[i] < afCoeffs[iMostNegative])))
+                {
+                    iMostNegative = i;
+                }
+            }
+            if(iMostNegative < 0)
+            {
+                if(afCoeffs[2] <= 0.0)
+                {
+                    return false;
+                }
+                for(int i = 0; i < 3; ++i)
+                {
+                    afCoeffs[i] /= afScale[i];
+                }
+                return true;
+            }
+            abActive[iMostNegative] = false;
+        }
+
+        return false;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_calibrate(
+        TIdx const uiMaxSize,
+        TIdx const uiRepeatCount)
+    {
+        SMatMulGemmModel * const pModel = matmul_gemm_model_get();
+
+        if((uiMaxSize < 4) || (uiRepeatCount == 0))
+        {
+            return;
+        }
+
+        // The squares cover the overhead and the compute bound range, the skinny shapes the memory bound one.
+        TIdx auiShapes[64][3];
+        TIdx uiNumShapes = 0;
+        for(TIdx s = 4; s <= uiMaxSize; s *= 2)
+        {
+            auiShapes[uiNumShapes][0] = auiShapes[uiNumShapes][1] = auiShapes[uiNumShapes][2] = s;
+            ++uiNumShapes;
+        }
+        if(uiMaxSize > 16)
+        {
+            TIdx const auiSkinny[3][3] = {{uiMaxSize, uiMaxSize, 16}, {16, uiMaxSize, uiMaxSize}, {uiMaxSize, 16, uiMaxSize}};
+            for(TIdx i = 0; i < 3; ++i)
+            {
+                auiShapes[uiNumShapes][0] = auiSkinny[i][0];
+                auiShapes[uiNumShapes][1] = auiSkinny[i][1];
+                auiShapes[uiNumShapes][2] = auiSkinny[i][2];
+                ++uiNumShapes;
+            }
+        }
+
+        TIdx const uiNumElements = uiMaxSize * uiMaxSize;
+        TElem const * const A = matmul_arr_alloc_fill_rand(uiNumElements, (TElem)0, (TElem)1);
+        TElem const * const B = matmul_arr_alloc_fill_rand(uiNumElements, (TElem)0, (TElem)1);
+        TElem * const C = matmul_arr_alloc_fill_rand(uiNumElements, (TElem)0, (TElem)1);
+
+        int const iNumThreads = matmul_gemm_get_num_threads();
+
+        for(int i = 0; i < (int)EMatMulGemmImplParBatched; ++i)
+        {
+            EMatMulGemmImpl const eImpl = (EMatMulGemmImpl)i;
+
+            double aafFeatures[64][3];
+            double afTimesSec[64];
+            TIdx uiNumSamples = 0;
+            for(TIdx s = 0; s < uiNumShapes; ++s)
+            {
+                TIdx const m = auiShapes[s][0];
+                TIdx const n = auiShapes[s][1];
+                TIdx const k = auiShapes[s][2];
+                TMatMulDispatchGemm const pGemm = matmul_gemm_impl_get(eImpl, m, n, k);
+                if(pGemm)
+                {
+                    aafFeatures[uiNumSamples][0] = 1.0;
+                    aafFeatures[uiNumSamples][1] = (double)m * (double)k + (double)k * (double)n + (double)m * (double)n;
+                    aafFeatures[uiNumSamples][2] = (double)m * (double)n * (double)k;
+                    afTimesSec[uiNumSamples] = matmul_gemm_calibrate_measure(pGemm, m, n, k, A, B, C, uiRepeatCount);
+                    ++uiNumSamples;
+                }
+            }
+
+            // Three coefficients need at least three samples.
+            double afCoeffs[3];
+            if((uiNumSamples >= 3) && matmul_gemm_calibrate_fit((double const (*)[3])aafFeatures, afTimesSec, uiNumSamples, afCoeffs))
+            {
+                SMatMulGemmModelEntry * const pEntry = &pModel->aEntries[eImpl];
+                for(int j = 0; j < 3; ++j)
+                {
+                    pEntry->afCoeffs[j] = afCoeffs[j];
+                }
+                pEntry->iNumThreads = iNumThreads;
+                pEntry->bCalibrated = true;
+            }
+        }
+
+        matmul_arr_free((TElem *)A);
+        matmul_arr_free((TElem *)B);
+        matmul_arr_free(C);
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Parses one line of the model file into the model if it belongs to the current CPU and element type. The line is modified.
+    //!
+    //! \return If the line is a valid entry.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_model_parse_entry(
+        char * const pszLine,
+        SMatMulGemmModel * const pModel)
+    {
+        pszLine[strcspn(pszLine, "\r\n")] = '\0';
+
+        char * apszFields[MATMUL_GEMM_MODEL_NUM_FIELDS];
+        TIdx uiNumFields = 0;
+        char * pszField = pszLine;
+        while(uiNumFields < MATMUL_GEMM_MODEL_NUM_FIELDS)
+        {
+            apszFields[uiNumFields] = pszField;
+            ++uiNumFields;
+            char * const pszSeparator = strchr(pszField, ';');
+            if(!pszSeparator)
+            {
+                break;
+            }
+            *pszSeparator = '\0';
+            pszField = pszSeparator + 1;
+        }
+        if(uiNumFields != MATMUL_GEMM_MODEL_NUM_FIELDS)
+        {
+            return false;
+        }
+
+        int iImpl = 0;
+        while((iImpl < (int)EMatMulGemmImplCount) && (strcmp(apszFields[3], matmul_gemm_impl_name((EMatMulGemmImpl)iImpl)) != 0))
+        {
+            ++iImpl;
+        }
+
+        char * pszEnd = 0;
+        long const iNumThreads = strtol(apszFields[2], &pszEnd, 10);
+        if((iImpl == (int)EMatMulGemmImplCount) || (pszEnd == apszFields[2]) || (*pszEnd != '\0') || (iNumThreads < 1))
+        {
+            return false;
+        }
+
+        double afCoeffs[3];
+        for(int i = 0; i < 3; ++i)
+        {
+            afCoeffs[i] = strtod(apszFields[4+i], &pszEnd);
+            if((pszEnd == apszFields[4+i]) || (*pszEnd != '\0') || (afCoeffs[i] < 0.0))
+            {
+                return false;
+            }
+        }
+
+    #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        char const * const pszElemType = "d";
+    #else
+        char const * const pszElemType = "s";
+    #endif
+        if((strcmp(apszFields[0], matmul_cpu_get_model()) == 0) && (strcmp(apszFields[1], pszElemType) == 0))
+        {
+            SMatMulGemmModelEntry * const pEntry = &pModel->aEntries[iImpl];
+            for(int i = 0; i < 3; ++i)
+            {
+                pEntry->afCoeffs[i] = afCoeffs[i];
+            }
+            pEntry->iNumThreads = (int)iNumThreads;
+            pEntry->bCalibrated = true;
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_model_read(
+        SMatMulGemmModel * const pModel,
+        char const * const pszPath)
+    {
+        FILE * const pFile = fopen(pszPath, "r");
+        if(!pFile)
+        {
+            printf("[GEMM Dispatch] The model '%s' could not be opened!\n", pszPath);
+            return false;
+        }
+
+        matmul_gemm_model_set_defaults(pModel);
+
+        char szLine[256];
+        TIdx uiLine = 0;
+        while(fgets(szLine, sizeof(szLine), pFile))
+        {
+            ++uiLine;
+            if((szLine[0] == '#') || (szLine[0] == '\n') || (szLine[0] == '\r'))
+            {
+                continue;
+            }
+            if(!matmul_gemm_model_parse_entry(szLine, pModel))
+            {
+                printf("[GEMM Dispatch] Invalid entry in line %"MATMUL_PRINTF_SIZE_T" of the model '%s'!\n", (size_t)uiLine, pszPath);
+            }
+        }
+
+        fclose(pFile);
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_model_load(
+        char const * const pszPath)
+    {
+        return matmul_gemm_model_read(matmul_gemm_model_get(), pszPath);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_model_save(
+        char const * const pszPath)
+    {
+        SMatMulGemmModel const * const pModel = matmul_gemm_model_get();
+
+        FILE * const pFile = fopen(pszPath, "w");
+        if(!pFile)
+        {
+            printf("[GEMM Dispatch] The model '%s' could not be created!\n", pszPath);
+            return false;
+        }
+
+    #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        char const cElemType = 'd';
+    #else
+        char const cElemType = 's';
+    #endif
+
+        fprintf(pFile, "# cpu model;element type;threads;implementation;seconds per call;seconds per element;seconds per multiply-add\n");
+        for(int i = 0; i < (int)EMatMulGemmImplCount; ++i)
+        {
+            SMatMulGemmModelEntry const * const pEntry = &pModel->aEntries[i];
+            if(pEntry->bCalibrated)
+            {
+                fprintf(pFile, "%s;%c;%d;%s;%.6e;%.6e;%.6e\n",
+                    matmul_cpu_get_model(),
+                    cElemType,
+                    pEntry->iNumThreads,
+                    matmul_gemm_impl_name((EMatMulGemmImpl)i),
+                    pEntry->afCoeffs[0],
+                    pEntry->afCoeffs[1],
+                    pEntry->afCoeffs[2]);
+            }
+        }
+
+        bool const bSuccess = (fclose(pFile) == 0);
+        if(!bSuccess)
+        {
+            printf("[GEMM Dispatch] The model '%s' could not be written!\n", pszPath);
+        }
+
+        return bSuccess;
+    }
+#endif
@@ -0,0 +1,263 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include <matmul/common/Half.h>
+
+#include <matmul/common/Cpu.h>      // matmul_cpu_get_features, MATMUL_ARCH_X86
+
+#include <string.h>                 // memcpy
+
+#ifdef MATMUL_ARCH_X86
+    #include <immintrin.h>          // _mm*
+
+    // The vectorized conversions are compiled for their own instruction set and only called if the CPU supports it.
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #define MATMUL_TARGET(x)
+    #else
+        #define MATMUL_TARGET(x) __attribute__((target(x)))
+    #endif
+#endif
+
+//-----------------------------------------------------------------------------
+//! \return The bits of the float.
+//-----------------------------------------------------------------------------
+uint32_t matmul_float_as_bits(
+    float const val)
+{
+    uint32_t uiBits;
+    memcpy(&uiBits, &val, sizeof(uiBits));
+    return uiBits;
+}
+
+//-----------------------------------------------------------------------------
+//! \return The float with the given bits.
+//-----------------------------------------------------------------------------
+float matmul_bits_as_float(
+    uint32_t const uiBits)
+{
+    float val;
+    memcpy(&val, &uiBits, sizeof(val));
+    return val;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+float matmul_bf16_to_float(
+    TMatMulBf16 const val)
+{
+    return matmul_bits_as_float(((uint32_t)val) << 16);
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+TMatMulBf16 matmul_float_to_bf16(
+    float const val)
+{
+    uint32_t const uiBits = matmul_float_as_bits(val);
+    // Truncating a NaN could make it infinity. Setting the quiet bit keeps it a NaN.
+    if((uiBits & 0x7fffffffu) > 0x7f800000u)
+    {
+        return (TMatMulBf16)((uiBits >> 16) | 0x40u);
+    }
+    // Round to nearest even. A carry out of the mantissa correctly increments the exponent.
+    return (TMatMulBf16)((uiBits + 0x7fffu + ((uiBits >> 16) & 1u)) >> 16);
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+float matmul_fp16_to_float(
+    TMatMulFp16 const val)
+{
+    // Moving the exponent and mantissa into place and multiplying by 2^(127-15) rebiases the exponent and normalizes denormals.
+    float const fMagic = matmul_bits_as_float((254u - 15u) << 23);
+    float const fInfNan = matmul_bits_as_float((127u + 16u) << 23);
+
+    float const fScaled = matmul_bits_as_float(((uint32_t)val & 0x7fffu) << 13) * fMagic;
+    uint32_t uiBits = matmul_float_as_bits(fScaled);
+    if(fScaled >= fInfNan)
+    {
+        uiBits |= 255u << 23;
+    }
+    uiBits |= ((uint32_t)val & 0x8000u) << 16;
+    return matmul_bits_as_float(uiBits);
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+TMatMulFp16 matmul_float_to_fp16(
+    float const val)
+{
+    uint32_t const uiInf = 255u << 23;
+    uint32_t const uiMax = (127u + 16u) << 23;                      // 2^16, the first value rounding to infinity.
+    uint32_t const uiDenormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    uint32_t uiBits = matmul_float_as_bits(val);
+    uint32_t const uiSign = uiBits & 0x80000000u;
+    uiBits ^= uiSign;
+
+    uint32_t uiHalf;
+    if(uiBits >= uiMax)
+    {
+        uiHalf = (uiBits > uiInf) ? 0x7e00u : 0x7c00u;
+    }
+    else if(uiBits < (113u << 23))
+    {
+        // Denormal half: Adding the magic value lets the float addition do the rounding and shifting.
+        uiHalf = matmul_float_as_bits(matmul_bits_as_float(uiBits) + matmul_bits_as_float(uiDenormMagic)) - uiDenormMagic;
+    }
+    else
+    {
+        // Normal half: Rebias the exponent and round to nearest even.
+        uint32_t const uiMantOdd = (uiBits >> 13) & 1u;
+        uiBits += ((uint32_t)(15 - 127) << 23) + 0xfffu;
+        uiBits += uiMantOdd;
+        uiHalf = uiBits >> 13;
+    }
+
+    return (TMatMulFp16)(uiHalf | (uiSign >> 16));
+}
+
+#ifdef MATMUL_ARCH_X86
+    //-----------------------------------------------------------------------------
+    //! Converts the largest multiple of 16 values with AVX-512 BF16. \return The number of converted values.
+    //-----------------------------------------------------------------------------
+    MATMUL_TARGET("avx512f,avx512bf16")
+    TIdx matmul_arr_float_to_bf16_avx512bf16(
+        TIdx const n,
+        float const * const MATMUL_RESTRICT pSrc,
+        TMatMulBf16 * const MATMUL_RESTRICT pDst)
+    {
+        TIdx i = 0;
+        for(; i + 16 <= n; i += 16)
+        {
+            _mm256_storeu_si256((__m256i *)&pDst[i], (__m256i)_mm512_cvtneps_pbh(_mm512_loadu_ps(&pSrc[i])));
+        }
+        return i;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Converts the largest multiple of 8 values with F16C. \return The number of converted values.
+    //-----------------------------------------------------------------------------
+    MATMUL_TARGET("avx,f16c")
+    TIdx matmul_arr_fp16_to_float_f16c(
+        TIdx const n,
+        TMatMulFp16 const * const MATMUL_RESTRICT pSrc,
+        float * const MATMUL_RESTRICT pDst)
+    {
+        TIdx i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm256_storeu_ps(&pDst[i], _mm256_cvtph_ps(_mm_loadu_si128((__m128i const *)&pSrc[i])));
+        }
+        return i;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Converts the largest multiple of 8 values with F16C. \return The number of converted values.
+    //-----------------------------------------------------------------------------
+    MATMUL_TARGET("avx,f16c")
+    TIdx matmul_arr_float_to_fp16_f16c(
+        TIdx const n,
+        float const * const MATMUL_RESTRICT pSrc,
+        TMatMulFp16 * const MATMUL_RESTRICT pDst)
+    {
+        TIdx i = 0;
+        for(; i + 8 <= n; i += 8)
+        {
+            _mm_storeu_si128((__m128i *)&pDst[i], _mm256_cvtps_ph(_mm256_loadu_ps(&pSrc[i]), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+        }
+        return i;
+    }
+#endif
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_arr_bf16_to_float(
+    TIdx const n,
+    TMatMulBf16 const * const MATMUL_RESTRICT pSrc,
+    float * const MATMUL_RESTRICT pDst)
+{
+    for(TIdx i = 0; i < n; ++i)
+    {
+        pDst[i] = matmul_bf16_to_float(pSrc[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_arr_float_to_bf16(
+    TIdx const n,
+    float const * const MATMUL_RESTRICT pSrc,
+    TMatMulBf16 * const MATMUL_RESTRICT pDst)
+{
+    TIdx i = 0;
+#ifdef MATMUL_ARCH_X86
+    if(matmul_cpu_get_features()->bAvx512Bf16)
+    {
+        i = matmul_arr_float_to_bf16_avx512bf16(n, pSrc, pDst);
+    }
+#endif
+    for(; i < n; ++i)
+    {
+        pDst[i] = matmul_float_to_bf16(pSrc[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_arr_fp16_to_float(
+    TIdx const n,
+    TMatMulFp16 const * const MATMUL_RESTRICT pSrc,
+    float * const MATMUL_RESTRICT pDst)
+{
+    TIdx i = 0;
+#ifdef MATMUL_ARCH_X86
+    if(matmul_cpu_get_features()->bF16c)
+    {
+        i = matmul_arr_fp16_to_float_f16c(n, pSrc, pDst);
+    }
+#endif
+    for(; i < n; ++i)
+    {
+        pDst[i] = matmul_fp16_to_float(pSrc[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_arr_float_to_fp16(
+    TIdx const n,
+    float const * const MATMUL_RESTRICT pSrc,
+    TMatMulFp16 * const MATMUL_RESTRICT pDst)
+{
+    TIdx i = 0;
+#ifdef MATMUL_ARCH_X86
+    if(matmul_cpu_get_features()->bF16c)
+    {
+        i = matmul_arr_float_to_fp16_f16c(n, pSrc, pDst);
+    }
+#endif
+    for(; i < n; ++i)
+    {
+        pDst[i] = matmul_float_to_fp16(pSrc[i]);
+    }
+}
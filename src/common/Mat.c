@@ -151,6 +151,33 @@ bool matmul_mat_gemm_early_out(
     }
 }
 
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool matmul_mat_parse_op(
+    char const op,
+    bool * const pbTrans)
+{
+    assert(pbTrans);
+
+    switch(op)
+    {
+    case 'N':
+    case 'n':
+        *pbTrans = false;
+        return true;
+    // For real matrices the conjugate transpose is the transpose.
+    case 'T':
+    case 't':
+    case 'C':
+    case 'c':
+        *pbTrans = true;
+        return true;
+    default:
+        return false;
+    }
+}
+
 //-----------------------------------------------------------------------------
 //
 //-----------------------------------------------------------------------------
@@ -176,6 +203,43 @@ void matmul_mat_copy_block(
     }
 }
 
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_mat_copy_block_transposed(
+    TIdx const m,
+    TIdx const n,
+    TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds,
+    TIdx const sr, TIdx const sc,
+    TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd,
+    TIdx const dr, TIdx const dc)
+{
+    // The edge length of the tiles the block is transposed in.
+    static TIdx const uiTile = 16;
+
+    // The start indices for the copy.
+    TElem const * const pSrcBlock = pSrcMat + lds * sr + sc;
+    TElem * const pDstBlock = pDstMat + ldd * dr + dc;
+
+    for(TIdx ii = 0; ii < m; ii += uiTile)
+    {
+        TIdx const iEnd = ((m-ii)<uiTile) ? m : ii+uiTile;
+        for(TIdx jj = 0; jj < n; jj += uiTile)
+        {
+            TIdx const jEnd = ((n-jj)<uiTile) ? n : jj+uiTile;
+
+            // Read the tile line by line and write it column by column.
+            for(TIdx i = ii; i < iEnd; ++i)
+            {
+                for(TIdx j = jj; j < jEnd; ++j)
+                {
+                    pDstBlock[j*ldd + i] = pSrcBlock[i*lds + j];
+                }
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 //
 //-----------------------------------------------------------------------------
@@ -198,38 +262,63 @@ void matmul_mat_copy(
         0);
 }
 
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_mat_copy_layout(
+    TIdx const m,
+    TIdx const n,
+    TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds, EMatMulLayout const eSrcLayout,
+    TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd, EMatMulLayout const eDstLayout)
+{
+    // The source viewed as row major matrix.
+    bool const bSrcRowMajor = (eSrcLayout == EMatMulLayoutRowMajor);
+    TIdx const uiSrcRows = bSrcRowMajor ? m : n;
+    TIdx const uiSrcCols = bSrcRowMajor ? n : m;
+
+    if(eSrcLayout == eDstLayout)
+    {
+        matmul_mat_copy_block(uiSrcRows, uiSrcCols, pSrcMat, lds, 0, 0, pDstMat, ldd, 0, 0);
+    }
+    else
+    {
+        matmul_mat_copy_block_transposed(uiSrcRows, uiSrcCols, pSrcMat, lds, 0, 0, pDstMat, ldd, 0, 0);
+    }
+}
+
 //-----------------------------------------------------------------------------
 //
 //-----------------------------------------------------------------------------
 void matmul_mat_row_major_to_mat_x_block_major(
-    TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const m, TIdx const n, TIdx const lds,
+    TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const m, TIdx const n, TIdx const lds, EMatMulLayout const eSrcLayout,
     TElem * MATMUL_RESTRICT pBlockMajorMat, TIdx const b,
-    bool const bColumnFirst)
+    bool const bColumnFirst,
+    bool const bTransposed)
 {
     assert(n == m);
     assert(n % b == 0);
 
+    // A column major matrix is read as the transpose of a row major matrix.
+    bool const bTransposedRowMajor = (bTransposed != (eSrcLayout == EMatMulLayoutColMajor));
+
     TIdx const q = n / b;
-    if(bColumnFirst)
+    for(TIdx x = 0; x < q; ++x)
     {
-        for(TIdx j = 0; j < q; ++j)
+        for(TIdx y = 0; y < q; ++y)
         {
-            for(TIdx i = 0; i < q; ++i)
+            TIdx const i = bColumnFirst ? y : x;
+            TIdx const j = bColumnFirst ? x : y;
+
+            // The block (i, j) of the transpose is the transpose of the block (j, i).
+            if(bTransposedRowMajor)
             {
-                matmul_mat_copy_block(b, b, pSrcMat, lds, i * b, j * b, pBlockMajorMat, b, 0, 0);
-                pBlockMajorMat += b*b;
+                matmul_mat_copy_block_transposed(b, b, pSrcMat, lds, j * b, i * b, pBlockMajorMat, b, 0, 0);
             }
-        }
-    }
-    else
-    {
-        for(TIdx i = 0; i < q; ++i)
-        {
-            for(TIdx j = 0; j < q; ++j)
+            else
             {
                 matmul_mat_copy_block(b, b, pSrcMat, lds, i * b, j * b, pBlockMajorMat, b, 0, 0);
-                pBlockMajorMat += b*b;
             }
+            pBlockMajorMat += b*b;
         }
     }
 }
@@ -239,33 +328,30 @@ void matmul_mat_row_major_to_mat_x_block_major(
 //-----------------------------------------------------------------------------
 void matmul_mat_x_block_major_to_mat_row_major(
     TElem const * MATMUL_RESTRICT pBlockMajorMat, TIdx const b,
-    TElem * const MATMUL_RESTRICT pDstMat, TIdx const m, TIdx const n, TIdx const ldd,
+    TElem * const MATMUL_RESTRICT pDstMat, TIdx const m, TIdx const n, TIdx const ldd, EMatMulLayout const eDstLayout,
     bool const bColumnFirst)
 {
     assert(n == m);
     assert(n % b == 0);
 
     TIdx const q = n / b;
-    if(bColumnFirst)
+    for(TIdx x = 0; x < q; ++x)
     {
-        for(TIdx j = 0; j < q; j++)
+        for(TIdx y = 0; y < q; ++y)
         {
-            for(TIdx i = 0; i < q; i++)
+            TIdx const i = bColumnFirst ? y : x;
+            TIdx const j = bColumnFirst ? x : y;
+
+            // The block (i, j) of a column major matrix is the transpose of the block (j, i) of the row major view.
+            if(eDstLayout == EMatMulLayoutColMajor)
             {
-                matmul_mat_copy_block(b, b, pBlockMajorMat, b, 0, 0, pDstMat, ldd, i * b, j * b);
-                pBlockMajorMat += b*b;
+                matmul_mat_copy_block_transposed(b, b, pBlockMajorMat, b, 0, 0, pDstMat, ldd, j * b, i * b);
             }
-        }
-    }
-    else
-    {
-        for(TIdx i = 0; i < q; i++)
-        {
-            for(TIdx j = 0; j < q; j++)
+            else
             {
                 matmul_mat_copy_block(b, b, pBlockMajorMat, b, 0, 0, pDstMat, ldd, i * b, j * b);
-                pBlockMajorMat += b*b;
             }
+            pBlockMajorMat += b*b;
         }
     }
 }
@@ -274,14 +360,23 @@ void matmul_mat_x_block_major_to_mat_row_major(
 //
 //-----------------------------------------------------------------------------
 void matmul_mat_get_block(
-    TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds,
+    TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds, EMatMulLayout const eSrcLayout,
     TIdx const uiBlockIdxHorizontal,
     TIdx const uiBlockIdxVertical,
-    TElem * const MATMUL_RESTRICT pDstBlock, TIdx const b)
+    TElem * const MATMUL_RESTRICT pDstBlock, TIdx const b,
+    bool const bTransposed)
 {
     TIdx const uiBlockOffsetHorizontal = uiBlockIdxHorizontal * b;
     TIdx const uiBlockOffsetVertical = uiBlockIdxVertical * b;
 
+    // The block of the transpose is the transpose of the mirrored block.
+    // A column major matrix is read as the transpose of a row major matrix.
+    if(bTransposed != (eSrcLayout == EMatMulLayoutColMajor))
+    {
+        matmul_mat_copy_block_transposed(b, b, pSrcMat, lds, uiBlockOffsetHorizontal, uiBlockOffsetVertical, pDstBlock, b, 0, 0);
+        return;
+    }
+
     // Reorder the block of the input so that it is laying linearly in memory.
     for(TIdx i = 0; i < b; ++i)
     {
@@ -303,13 +398,20 @@ void matmul_mat_get_block(
 //-----------------------------------------------------------------------------
 void matmul_mat_set_block(
     TElem const * const MATMUL_RESTRICT pSrcBlock, TIdx const b,
-    TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd,
+    TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd, EMatMulLayout const eDstLayout,
     TIdx const uiBlockIdxHorizontal,
     TIdx const uiBlockIdxVertical)
 {
     TIdx const uiBlockOffsetHorizontal = uiBlockIdxHorizontal * b;
     TIdx const uiBlockOffsetVertical = uiBlockIdxVertical * b;
 
+    // The block of a column major matrix is the transpose of the mirrored block of the row major view.
+    if(eDstLayout == EMatMulLayoutColMajor)
+    {
+        matmul_mat_copy_block_transposed(b, b, pSrcBlock, b, 0, 0, pDstMat, ldd, uiBlockOffsetHorizontal, uiBlockOffsetVertical);
+        return;
+    }
+
     // Reorder the block of the input so that it is laying linearly in memory.
     for(TIdx i = 0; i < b; ++i)
     {
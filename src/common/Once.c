@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include <matmul/common/Once.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>             // _InterlockedCompareExchange, _InterlockedExchange
+
+    #define MATMUL_ONCE_LOAD_ACQUIRE(p) _InterlockedCompareExchange((p), 0, 0)
+    #define MATMUL_ONCE_LOAD_RELAXED(p) (*(p))
+    #define MATMUL_ONCE_STORE_RELEASE(p, v) (void)_InterlockedExchange((p), (v))
+    #define MATMUL_ONCE_EXCHANGE_ACQUIRE(p, v) _InterlockedExchange((p), (v))
+#elif defined(__GNUC__)             // gcc, clang and icc
+    #define MATMUL_ONCE_LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define MATMUL_ONCE_LOAD_RELAXED(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+    #define MATMUL_ONCE_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define MATMUL_ONCE_EXCHANGE_ACQUIRE(p, v) __atomic_exchange_n((p), (v), __ATOMIC_ACQUIRE)
+#endif
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_once(
+    SMatMulOnce * const pOnce,
+    long const iGeneration,
+    void(*pInit)(void *),
+    void * const pArg)
+{
+#ifdef MATMUL_ONCE_LOAD_ACQUIRE
+    if(MATMUL_ONCE_LOAD_ACQUIRE(&pOnce->iGeneration) == iGeneration)
+    {
+        return;
+    }
+
+    while(MATMUL_ONCE_EXCHANGE_ACQUIRE(&pOnce->iLock, 1) != 0)
+    {
+        // Only read while the lock is held so that the cache line is not written by all waiting threads.
+        while(MATMUL_ONCE_LOAD_RELAXED(&pOnce->iLock) != 0)
+        {
+        }
+    }
+    // Another thread may have completed the initialization while this one was waiting for the lock.
+    if(pOnce->iGeneration != iGeneration)
+    {
+        pInit(pArg);
+        MATMUL_ONCE_STORE_RELEASE(&pOnce->iGeneration, iGeneration);
+    }
+    MATMUL_ONCE_STORE_RELEASE(&pOnce->iLock, 0);
+#else
+    // Without known atomics only the threads of the library itself are synchronized.
+    #pragma omp critical(matmul_once)
+    {
+        if(pOnce->iGeneration != iGeneration)
+        {
+            pInit(pArg);
+            pOnce->iGeneration = iGeneration;
+        }
+    }
+#endif
+}
@@ -0,0 +1,219 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include <matmul/common/Plan.h>
+
+#include <matmul/seq/Packed.h>      // matmul_gemm_seq_packed_plan_create, matmul_gemm_seq_packed_plan_execute, matmul_gemm_seq_packed_plan_destroy
+#include <matmul/seq/Strassen.h>    // matmul_gemm_seq_strassen_workspace_size, matmul_gemm_seq_strassen_workspace
+#include <matmul/par/MpiCannon.h>   // matmul_gemm_par_mpi_cannon_plan_create, matmul_gemm_par_mpi_cannon_plan_execute, matmul_gemm_par_mpi_cannon_plan_destroy
+#include <matmul/par/MpiDns.h>      // matmul_gemm_par_mpi_dns_plan_create, matmul_gemm_par_mpi_dns_plan_execute, matmul_gemm_par_mpi_dns_plan_destroy
+#include <matmul/common/Alloc.h>    // matmul_arr_alloc, matmul_arr_free
+#include <matmul/common/Tune.h>     // matmul_tune_get
+
+#include <stdio.h>                  // printf
+#include <stdlib.h>                 // malloc, free
+
+//-----------------------------------------------------------------------------
+//! The plan behind the opaque handle.
+//-----------------------------------------------------------------------------
+struct SMatMulPlan
+{
+    EMatMulPlanAlgo eAlgo;
+    TIdx m, n, k;
+    TIdx lda, ldb, ldc;
+
+#ifdef MATMUL_BUILD_SEQ_PACKED
+    SMatMulPackedPlan * pPackedPlan;
+#endif
+#ifdef MATMUL_BUILD_SEQ_STRASSEN
+    TIdx uiStrassenCutOff;
+    TElem * pStrassenWorkspace;
+#endif
+#ifdef MATMUL_BUILD_PAR_MPI_CANNON_STD
+    SMatMulMpiCannonPlan * pMpiCannonPlan;
+#endif
+#ifdef MATMUL_BUILD_PAR_MPI_DNS
+    SMatMulMpiDnsPlan * pMpiDnsPlan;
+#endif
+};
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool matmul_plan_is_square(
+    TIdx const m, TIdx const n, TIdx const k,
+    char const * const pszAlgo)
+{
+    // \TODO: Implement for non square matrices?
+    if((m!=n) || (m!=k))
+    {
+        printf("[GEMM %s] Invalid matrix size! The matrices have to be square for the %s GEMM.\n", pszAlgo, pszAlgo);
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+SMatMulPlan * matmul_plan_create(
+    EMatMulPlanAlgo const eAlgo,
+    TIdx const m, TIdx const n, TIdx const k,
+    TIdx const lda, TIdx const ldb, TIdx const ldc,
+    SMatMulPlanOptions const * const pOptions)
+{
+    SMatMulPlan * const pPlan = (SMatMulPlan *)malloc(sizeof(SMatMulPlan));
+    if(!pPlan)
+    {
+        return 0;
+    }
+    pPlan->eAlgo = eAlgo;
+    pPlan->m = m;
+    pPlan->n = n;
+    pPlan->k = k;
+    pPlan->lda = lda;
+    pPlan->ldb = ldb;
+    pPlan->ldc = ldc;
+
+    bool bCreated = false;
+    switch(eAlgo)
+    {
+    case EMatMulPlanAlgoSeqPacked:
+#ifdef MATMUL_BUILD_SEQ_PACKED
+        pPlan->pPackedPlan = matmul_gemm_seq_packed_plan_create(m, n, k);
+        bCreated = (pPlan->pPackedPlan != 0);
+#endif
+        break;
+    case EMatMulPlanAlgoSeqStrassen:
+#ifdef MATMUL_BUILD_SEQ_STRASSEN
+        {
+            pPlan->uiStrassenCutOff = (pOptions && (pOptions->uiStrassenCutOff != 0)) ? pOptions->uiStrassenCutOff : matmul_tune_get(m, n, k)->uiStrassenCutOff;
+            TIdx const uiNumElementsWorkspace = matmul_gemm_seq_strassen_workspace_size(pPlan->uiStrassenCutOff, m, n, k);
+            pPlan->pStrassenWorkspace = (uiNumElementsWorkspace > 0) ? matmul_arr_alloc(uiNumElementsWorkspace) : 0;
+            bCreated = (uiNumElementsWorkspace == 0) || (pPlan->pStrassenWorkspace != 0);
+        }
+#endif
+        break;
+    case EMatMulPlanAlgoParMpiCannon:
+#ifdef MATMUL_BUILD_PAR_MPI_CANNON_STD
+        if(matmul_plan_is_square(m, n, k, "MPI Cannon"))
+        {
+            pPlan->pMpiCannonPlan = matmul_gemm_par_mpi_cannon_plan_create(n, !(pOptions && pOptions->bMpiNonBlockingComm));
+            bCreated = (pPlan->pMpiCannonPlan != 0);
+        }
+#endif
+        break;
+    case EMatMulPlanAlgoParMpiDns:
+#ifdef MATMUL_BUILD_PAR_MPI_DNS
+        if(matmul_plan_is_square(m, n, k, "MPI DNS"))
+        {
+            pPlan->pMpiDnsPlan = matmul_gemm_par_mpi_dns_plan_create(n);
+            bCreated = (pPlan->pMpiDnsPlan != 0);
+        }
+#endif
+        break;
+    default:
+        break;
+    }
+
+    if(!bCreated)
+    {
+        printf("[GEMM Plan] The plan for the algorithm %d could not be created! Either it has not been built or the setup failed.\n", (int)eAlgo);
+        free(pPlan);
+        return 0;
+    }
+
+    return pPlan;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_plan_execute(
+    SMatMulPlan * const pPlan,
+    TElem const alpha,
+    TElem const * const MATMUL_RESTRICT A,
+    TElem const * const MATMUL_RESTRICT B,
+    TElem const beta,
+    TElem * const MATMUL_RESTRICT C)
+{
+    switch(pPlan->eAlgo)
+    {
+#ifdef MATMUL_BUILD_SEQ_PACKED
+    case EMatMulPlanAlgoSeqPacked:
+        matmul_gemm_seq_packed_plan_execute(pPlan->pPackedPlan, alpha, A, pPlan->lda, B, pPlan->ldb, beta, C, pPlan->ldc);
+        break;
+#endif
+#ifdef MATMUL_BUILD_SEQ_STRASSEN
+    case EMatMulPlanAlgoSeqStrassen:
+        matmul_gemm_seq_strassen_workspace(pPlan->uiStrassenCutOff, pPlan->m, pPlan->n, pPlan->k, alpha, A, pPlan->lda, B, pPlan->ldb, beta, C, pPlan->ldc, pPlan->pStrassenWorkspace);
+        break;
+#endif
+#ifdef MATMUL_BUILD_PAR_MPI_CANNON_STD
+    case EMatMulPlanAlgoParMpiCannon:
+        matmul_gemm_par_mpi_cannon_plan_execute(pPlan->pMpiCannonPlan, alpha, A, pPlan->lda, B, pPlan->ldb, beta, C, pPlan->ldc);
+        break;
+#endif
+#ifdef MATMUL_BUILD_PAR_MPI_DNS
+    case EMatMulPlanAlgoParMpiDns:
+        matmul_gemm_par_mpi_dns_plan_execute(pPlan->pMpiDnsPlan, alpha, A, pPlan->lda, B, pPlan->ldb, beta, C, pPlan->ldc);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_plan_destroy(
+    SMatMulPlan * const pPlan)
+{
+    if(!pPlan)
+    {
+        return;
+    }
+
+    switch(pPlan->eAlgo)
+    {
+#ifdef MATMUL_BUILD_SEQ_PACKED
+    case EMatMulPlanAlgoSeqPacked:
+        matmul_gemm_seq_packed_plan_destroy(pPlan->pPackedPlan);
+        break;
+#endif
+#ifdef MATMUL_BUILD_SEQ_STRASSEN
+    case EMatMulPlanAlgoSeqStrassen:
+        if(pPlan->pStrassenWorkspace)
+        {
+            matmul_arr_free(pPlan->pStrassenWorkspace);
+        }
+        break;
+#endif
+#ifdef MATMUL_BUILD_PAR_MPI_CANNON_STD
+    case EMatMulPlanAlgoParMpiCannon:
+        matmul_gemm_par_mpi_cannon_plan_destroy(pPlan->pMpiCannonPlan);
+        break;
+#endif
+#ifdef MATMUL_BUILD_PAR_MPI_DNS
+    case EMatMulPlanAlgoParMpiDns:
+        matmul_gemm_par_mpi_dns_plan_destroy(pPlan->pMpiDnsPlan);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    free(pPlan);
+}
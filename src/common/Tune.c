@@ -0,0 +1,565 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#include <matmul/common/Tune.h>
+
+#include <matmul/common/Cpu.h>      // matmul_cpu_get_model, matmul_cpu_get_cache_sizes, matmul_cpu_get_cache_sizes_generation
+#include <matmul/common/Once.h>     // matmul_once, SMatMulOnce
+
+#include <stdio.h>                  // FILE, fopen, fgets, fprintf, printf
+#include <stdlib.h>                 // getenv, strtol
+#include <string.h>                 // strcmp, strchr, strcspn, strlen, memcpy
+
+//-----------------------------------------------------------------------------
+// The compile time settings of the implementations which are not built are zero.
+//-----------------------------------------------------------------------------
+#ifdef MATMUL_SEQ_BLOCK_FACTOR
+    #define MATMUL_TUNE_DEFAULT_SEQ_BLOCK_FACTOR MATMUL_SEQ_BLOCK_FACTOR
+#else
+    #define MATMUL_TUNE_DEFAULT_SEQ_BLOCK_FACTOR 0
+#endif
+#ifdef MATMUL_STRASSEN_CUT_OFF
+    #define MATMUL_TUNE_DEFAULT_STRASSEN_CUT_OFF MATMUL_STRASSEN_CUT_OFF
+#else
+    #define MATMUL_TUNE_DEFAULT_STRASSEN_CUT_OFF 0
+#endif
+#ifdef MATMUL_STRASSEN_OMP_CUT_OFF
+    #define MATMUL_TUNE_DEFAULT_STRASSEN_OMP_CUT_OFF MATMUL_STRASSEN_OMP_CUT_OFF
+#else
+    #define MATMUL_TUNE_DEFAULT_STRASSEN_OMP_CUT_OFF 0
+#endif
+#ifdef MATMUL_PACKED_MC
+    #define MATMUL_TUNE_DEFAULT_PACKED_MC MATMUL_PACKED_MC
+#else
+    #define MATMUL_TUNE_DEFAULT_PACKED_MC 0
+#endif
+#ifdef MATMUL_PACKED_KC
+    #define MATMUL_TUNE_DEFAULT_PACKED_KC MATMUL_PACKED_KC
+#else
+    #define MATMUL_TUNE_DEFAULT_PACKED_KC 0
+#endif
+#ifdef MATMUL_PACKED_NC
+    #define MATMUL_TUNE_DEFAULT_PACKED_NC MATMUL_PACKED_NC
+#else
+    #define MATMUL_TUNE_DEFAULT_PACKED_NC 0
+#endif
+
+//-----------------------------------------------------------------------------
+//! The number of ';' separated fields of an entry of the tuning database file.
+//-----------------------------------------------------------------------------
+#define MATMUL_TUNE_DB_NUM_FIELDS 14
+
+//-----------------------------------------------------------------------------
+//! The number of slots of the hash index of the tuning database. There are more slots than entries so that each probe sequence ends at an empty slot.
+//-----------------------------------------------------------------------------
+#define MATMUL_TUNE_DB_INDEX_SIZE (2*MATMUL_TUNE_DB_SIZE)
+
+//-----------------------------------------------------------------------------
+//! One entry of the tuning database.
+//-----------------------------------------------------------------------------
+typedef struct SMatMulTuneEntry
+{
+    char szCpuModel[49];
+    bool bCurrentCpu;               //!< If the entry belongs to the CPU the process is running on.
+    char cElemType;                 //!< s: float, d: double
+    TIdx auiShapeClass[3];          //!< floor(log2) of m, n and k.
+    SMatMulTuneParams params;
+} SMatMulTuneEntry;
+
+//-----------------------------------------------------------------------------
+//! The tuning database.
+//-----------------------------------------------------------------------------
+typedef struct SMatMulTuneDb
+{
+    SMatMulTuneEntry aEntries[MATMUL_TUNE_DB_SIZE];
+    TIdx uiNumEntries;
+    TIdx auiIndex[MATMUL_TUNE_DB_INDEX_SIZE];   //!< Open addressing hash index of the entries of the current CPU. The entry index plus one, 0 for an empty slot.
+} SMatMulTuneDb;
+
+//-----------------------------------------------------------------------------
+//! Derives the blocking of the blocked sequential GEMMs from the cache sizes.
+//!
+//! The innermost loops update a row of the C block with the rows of the B block, so one row of each of them (2*NC elements) has to fit into half of the level 1 data cache.
+//! The KC x NC block of B is reused for all rows of the A block and fills half of the level 2 cache.
+//! The MC x KC block of A and the MC x NC block of C fill half of the level 3 cache (the level 2 cache if there is none).
+//! If the level 1 or 2 cache size is unknown, all of them are MATMUL_SEQ_BLOCK_FACTOR.
+//-----------------------------------------------------------------------------
+void matmul_tune_get_seq_block_sizes(
+    SMatMulCpuCacheSizes const * const pCacheSizes,
+    size_t const uiElemSize,
+    TIdx * const puiMC, TIdx * const puiKC, TIdx * const puiNC)
+{
+    if((pCacheSizes->uiL1d == 0) || (pCacheSizes->uiL2 == 0))
+    {
+        *puiMC = MATMUL_TUNE_DEFAULT_SEQ_BLOCK_FACTOR;
+        *puiKC = MATMUL_TUNE_DEFAULT_SEQ_BLOCK_FACTOR;
+        *puiNC = MATMUL_TUNE_DEFAULT_SEQ_BLOCK_FACTOR;
+        return;
+    }
+
+    // The block sizes are multiples of the number of elements per cache line.
+    size_t const uiLineElems = (64 / uiElemSize > 0) ? 64 / uiElemSize : 1;
+
+    size_t uiNC = pCacheSizes->uiL1d / (4 * uiElemSize);
+    uiNC = (uiNC / uiLineElems) * uiLineElems;
+    uiNC = (uiNC < uiLineElems) ? uiLineElems : uiNC;
+
+    size_t uiKC = pCacheSizes->uiL2 / (2 * uiNC * uiElemSize);
+    uiKC = (uiKC / 8) * 8;
+    uiKC = (uiKC < 8) ? 8 : uiKC;
+
+    size_t const uiOuterCache = (pCacheSizes->uiL3 > pCacheSizes->uiL2) ? pCacheSizes->uiL3 : pCacheSizes->uiL2;
+    size_t uiMC = uiOuterCache / (2 * (uiKC + uiNC) * uiElemSize);
+    uiMC = (uiMC / 8) * 8;
+    uiMC = (uiMC < 8) ? 8 : uiMC;
+
+    *puiMC = (TIdx)uiMC;
+    *puiKC = (TIdx)uiKC;
+    *puiNC = (TIdx)uiNC;
+}
+
+//-----------------------------------------------------------------------------
+//! Computes the defaults for the current cache sizes.
+//-----------------------------------------------------------------------------
+void matmul_tune_init_defaults(
+    void * const pDefaults)
+{
+    SMatMulTuneParams defaults = {
+        MATMUL_TUNE_DEFAULT_SEQ_BLOCK_FACTOR,
+        MATMUL_TUNE_DEFAULT_SEQ_BLOCK_FACTOR,
+        MATMUL_TUNE_DEFAULT_SEQ_BLOCK_FACTOR,
+        MATMUL_TUNE_DEFAULT_STRASSEN_CUT_OFF,
+        MATMUL_TUNE_DEFAULT_STRASSEN_OMP_CUT_OFF,
+        MATMUL_TUNE_DEFAULT_PACKED_MC,
+        MATMUL_TUNE_DEFAULT_PACKED_KC,
+        MATMUL_TUNE_DEFAULT_PACKED_NC,
+        ""};
+
+    matmul_tune_get_seq_block_sizes(matmul_cpu_get_cache_sizes(), sizeof(TElem), &defaults.uiSeqBlockMC, &defaults.uiSeqBlockKC, &defaults.uiSeqBlockNC);
+
+    *(SMatMulTuneParams *)pDefaults = defaults;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+SMatMulTuneParams const * matmul_tune_get_defaults(void)
+{
+    static SMatMulTuneParams defaults;
+    static SMatMulOnce once = MATMUL_ONCE_INIT;
+
+    // The defaults are only recomputed after matmul_cpu_set_cache_sizes has been called.
+    matmul_once(&once, matmul_cpu_get_cache_sizes_generation(), matmul_tune_init_defaults, &defaults);
+
+    return &defaults;
+}
+
+//-----------------------------------------------------------------------------
+//! Replaces the parameters which are zero by the defaults so that the implementations never see invalid values.
+//-----------------------------------------------------------------------------
+void matmul_tune_params_complete(
+    SMatMulTuneParams * const pParams)
+{
+    SMatMulTuneParams const * const pDefaults = matmul_tune_get_defaults();
+    pParams->uiSeqBlockMC = (pParams->uiSeqBlockMC == 0) ? pDefaults->uiSeqBlockMC : pParams->uiSeqBlockMC;
+    pParams->uiSeqBlockKC = (pParams->uiSeqBlockKC == 0) ? pDefaults->uiSeqBlockKC : pParams->uiSeqBlockKC;
+    pParams->uiSeqBlockNC = (pParams->uiSeqBlockNC == 0) ? pDefaults->uiSeqBlockNC : pParams->uiSeqBlockNC;
+    pParams->uiStrassenCutOff = (pParams->uiStrassenCutOff == 0) ? pDefaults->uiStrassenCutOff : pParams->uiStrassenCutOff;
+    pParams->uiStrassenOmpCutOff = (pParams->uiStrassenOmpCutOff == 0) ? pDefaults->uiStrassenOmpCutOff : pParams->uiStrassenOmpCutOff;
+    pParams->uiPackedMC = (pParams->uiPackedMC == 0) ? pDefaults->uiPackedMC : pParams->uiPackedMC;
+    pParams->uiPackedKC = (pParams->uiPackedKC == 0) ? pDefaults->uiPackedKC : pParams->uiPackedKC;
+    pParams->uiPackedNC = (pParams->uiPackedNC == 0) ? pDefaults->uiPackedNC : pParams->uiPackedNC;
+    pParams->szMicroKernel[MATMUL_TUNE_MICRO_KERNEL_NAME_SIZE-1] = '\0';
+}
+
+//-----------------------------------------------------------------------------
+//! \return floor(log2(x)) or 0 for x=0.
+//-----------------------------------------------------------------------------
+TIdx matmul_tune_shape_class(
+    TIdx const x)
+{
+    TIdx uiClass = 0;
+    for(TIdx y = x; y > 1; y /= 2)
+    {
+        ++uiClass;
+    }
+    return uiClass;
+}
+
+//-----------------------------------------------------------------------------
+//! \return The first slot of the probe sequence of the given key in the hash index.
+//-----------------------------------------------------------------------------
+TIdx matmul_tune_db_hash(
+    char const cElemType,
+    TIdx const uiClassM, TIdx const uiClassN, TIdx const uiClassK)
+{
+    size_t const uiHash =
+        ((size_t)uiClassM * 73856093u)
+        ^ ((size_t)uiClassN * 19349663u)
+        ^ ((size_t)uiClassK * 83492791u)
+        ^ ((cElemType == 'd') ? 1u : 0u);
+    return (TIdx)(uiHash % MATMUL_TUNE_DB_INDEX_SIZE);
+}
+
+//-----------------------------------------------------------------------------
+//! \return The slot of the hash index holding the entry with the given key or the empty slot where it would be inserted.
+//-----------------------------------------------------------------------------
+TIdx matmul_tune_db_index_probe(
+    SMatMulTuneDb const * const pDb,
+    char const cElemType,
+    TIdx const uiClassM, TIdx const uiClassN, TIdx const uiClassK)
+{
+    TIdx uiSlot = matmul_tune_db_hash(cElemType, uiClassM, uiClassN, uiClassK);
+    while(pDb->auiIndex[uiSlot] != 0)
+    {
+        SMatMulTuneEntry const * const pEntry = &pDb->aEntries[pDb->auiIndex[uiSlot] - 1];
+        if((pEntry->cElemType == cElemType)
+            && (pEntry->auiShapeClass[0] == uiClassM)
+            && (pEntry->auiShapeClass[1] == uiClassN)
+            && (pEntry->auiShapeClass[2] == uiClassK))
+        {
+            break;
+        }
+        uiSlot = (uiSlot + 1) % MATMUL_TUNE_DB_INDEX_SIZE;
+    }
+    return uiSlot;
+}
+
+//-----------------------------------------------------------------------------
+//! Adds the given entry to the hash index if it belongs to the current CPU. An entry with the same key added before is kept.
+//-----------------------------------------------------------------------------
+void matmul_tune_db_index_insert(
+    SMatMulTuneDb * const pDb,
+    TIdx const uiEntry)
+{
+    SMatMulTuneEntry const * const pEntry = &pDb->aEntries[uiEntry];
+    if(pEntry->bCurrentCpu)
+    {
+        TIdx const uiSlot = matmul_tune_db_index_probe(pDb, pEntry->cElemType, pEntry->auiShapeClass[0], pEntry->auiShapeClass[1], pEntry->auiShapeClass[2]);
+        if(pDb->auiIndex[uiSlot] == 0)
+        {
+            pDb->auiIndex[uiSlot] = uiEntry + 1;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Rebuilds the hash index from all entries.
+//-----------------------------------------------------------------------------
+void matmul_tune_db_index_build(
+    SMatMulTuneDb * const pDb)
+{
+    for(TIdx i = 0; i < MATMUL_TUNE_DB_INDEX_SIZE; ++i)
+    {
+        pDb->auiIndex[i] = 0;
+    }
+    for(TIdx i = 0; i < pDb->uiNumEntries; ++i)
+    {
+        matmul_tune_db_index_insert(pDb, i);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Replaces the entries of the given database with the contents of the given file.
+//!
+//! \return If the file could be read.
+//-----------------------------------------------------------------------------
+bool matmul_tune_db_read(
+    SMatMulTuneDb * const pDb,
+    char const * const pszPath);
+
+//-----------------------------------------------------------------------------
+//! Initializes the database from the file given by MATMUL_TUNE_DB if it is set.
+//-----------------------------------------------------------------------------
+void matmul_tune_db_init(
+    void * const pDb)
+{
+    SMatMulTuneDb * const pTuneDb = (SMatMulTuneDb *)pDb;
+    pTuneDb->uiNumEntries = 0;
+    matmul_tune_db_index_build(pTuneDb);
+
+    char const * const pszPath = getenv("MATMUL_TUNE_DB");
+    if(pszPath)
+    {
+        matmul_tune_db_read(pTuneDb, pszPath);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! \return The tuning database. It is loaded from the file given by MATMUL_TUNE_DB on the first call.
+//-----------------------------------------------------------------------------
+SMatMulTuneDb * matmul_tune_db_get(void)
+{
+    static SMatMulTuneDb db;
+    static SMatMulOnce once = MATMUL_ONCE_INIT;
+
+    matmul_once(&once, 1, matmul_tune_db_init, &db);
+
+    return &db;
+}
+
+//-----------------------------------------------------------------------------
+//! \return The entry for the given key or null if there is none.
+//-----------------------------------------------------------------------------
+SMatMulTuneEntry * matmul_tune_db_find(
+    SMatMulTuneDb * const pDb,
+    char const cElemType,
+    TIdx const m, TIdx const n, TIdx const k)
+{
+    TIdx const uiSlot = matmul_tune_db_index_probe(pDb, cElemType, matmul_tune_shape_class(m), matmul_tune_shape_class(n), matmul_tune_shape_class(k));
+    return (pDb->auiIndex[uiSlot] != 0) ? &pDb->aEntries[pDb->auiIndex[uiSlot] - 1] : 0;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+SMatMulTuneParams const * matmul_tune_get_s(
+    TIdx const m, TIdx const n, TIdx const k)
+{
+    SMatMulTuneEntry const * const pEntry = matmul_tune_db_find(matmul_tune_db_get(), 's', m, n, k);
+    return pEntry ? &pEntry->params : matmul_tune_get_defaults();
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+SMatMulTuneParams const * matmul_tune_get_d(
+    TIdx const m, TIdx const n, TIdx const k)
+{
+    SMatMulTuneEntry const * const pEntry = matmul_tune_db_find(matmul_tune_db_get(), 'd', m, n, k);
+    return pEntry ? &pEntry->params : matmul_tune_get_defaults();
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+SMatMulTuneParams const * matmul_tune_get(
+    TIdx const m, TIdx const n, TIdx const k)
+{
+#ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+    return matmul_tune_get_d(m, n, k);
+#else
+    return matmul_tune_get_s(m, n, k);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void matmul_tune_set(
+    TIdx const m, TIdx const n, TIdx const k,
+    SMatMulTuneParams const * const pParams)
+{
+#ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+    char const cElemType = 'd';
+#else
+    char const cElemType = 's';
+#endif
+
+    SMatMulTuneDb * const pDb = matmul_tune_db_get();
+    SMatMulTuneEntry * pEntry = matmul_tune_db_find(pDb, cElemType, m, n, k);
+    if(!pEntry)
+    {
+        if(pDb->uiNumEntries == MATMUL_TUNE_DB_SIZE)
+        {
+            printf("[Tune] The tuning database is full! The parameters are not stored.\n");
+            return;
+        }
+
+        pEntry = &pDb->aEntries[pDb->uiNumEntries];
+        char const * const pszModel = matmul_cpu_get_model();
+        size_t const uiLength = strlen(pszModel);
+        memcpy(pEntry->szCpuModel, pszModel, uiLength + 1);
+        pEntry->bCurrentCpu = true;
+        pEntry->cElemType = cElemType;
+        pEntry->auiShapeClass[0] = matmul_tune_shape_class(m);
+        pEntry->auiShapeClass[1] = matmul_tune_shape_class(n);
+        pEntry->auiShapeClass[2] = matmul_tune_shape_class(k);
+        ++pDb->uiNumEntries;
+        matmul_tune_db_index_insert(pDb, pDb->uiNumEntries - 1);
+    }
+
+    pEntry->params = *pParams;
+    matmul_tune_params_complete(&pEntry->params);
+}
+
+//-----------------------------------------------------------------------------
+//! Parses one line of the tuning database file. The line is modified.
+//!
+//! \return If the line is a valid entry.
+//-----------------------------------------------------------------------------
+bool matmul_tune_db_parse_entry(
+    char * const pszLine,
+    SMatMulTuneEntry * const pEntry)
+{
+    pszLine[strcspn(pszLine, "\r\n")] = '\0';
+
+    char * apszFields[MATMUL_TUNE_DB_NUM_FIELDS];
+    TIdx uiNumFields = 0;
+    char * pszField = pszLine;
+    while(uiNumFields < MATMUL_TUNE_DB_NUM_FIELDS)
+    {
+        apszFields[uiNumFields] = pszField;
+        ++uiNumFields;
+        char * const pszSeparator = strchr(pszField, ';');
+        if(!pszSeparator)
+        {
+            break;
+        }
+        *pszSeparator = '\0';
+        pszField = pszSeparator + 1;
+    }
+
+    size_t const uiModelLength = strlen(apszFields[0]);
+    size_t const uiKernelLength = strlen(apszFields[MATMUL_TUNE_DB_NUM_FIELDS-1]);
+    if((uiNumFields != MATMUL_TUNE_DB_NUM_FIELDS)
+        || (uiModelLength >= sizeof(pEntry->szCpuModel))
+        || ((strcmp(apszFields[1], "s") != 0) && (strcmp(apszFields[1], "d") != 0))
+        || (uiKernelLength >= MATMUL_TUNE_MICRO_KERNEL_NAME_SIZE))
+    {
+        return false;
+    }
+
+    TIdx auiValues[MATMUL_TUNE_DB_NUM_FIELDS-3];
+    for(TIdx i = 0; i < MATMUL_TUNE_DB_NUM_FIELDS-3; ++i)
+    {
+        char * pszEnd = 0;
+        long const iValue = strtol(apszFields[2+i], &pszEnd, 10);
+        if((pszEnd == apszFields[2+i]) || (*pszEnd != '\0') || (iValue < 0))
+        {
+            return false;
+        }
+        auiValues[i] = (TIdx)iValue;
+    }
+
+    memcpy(pEntry->szCpuModel, apszFields[0], uiModelLength + 1);
+    pEntry->bCurrentCpu = (strcmp(pEntry->szCpuModel, matmul_cpu_get_model()) == 0);
+    pEntry->cElemType = apszFields[1][0];
+    pEntry->auiShapeClass[0] = auiValues[0];
+    pEntry->auiShapeClass[1] = auiValues[1];
+    pEntry->auiShapeClass[2] = auiValues[2];
+    pEntry->params.uiSeqBlockMC = auiValues[3];
+    pEntry->params.uiSeqBlockKC = auiValues[4];
+    pEntry->params.uiSeqBlockNC = auiValues[5];
+    pEntry->params.uiStrassenCutOff = auiValues[6];
+    pEntry->params.uiStrassenOmpCutOff = auiValues[7];
+    pEntry->params.uiPackedMC = auiValues[8];
+    pEntry->params.uiPackedKC = auiValues[9];
+    pEntry->params.uiPackedNC = auiValues[10];
+    memcpy(pEntry->params.szMicroKernel, apszFields[MATMUL_TUNE_DB_NUM_FIELDS-1], uiKernelLength + 1);
+    matmul_tune_params_complete(&pEntry->params);
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool matmul_tune_db_read(
+    SMatMulTuneDb * const pDb,
+    char const * const pszPath)
+{
+    FILE * const pFile = fopen(pszPath, "r");
+    if(!pFile)
+    {
+        printf("[Tune] The tuning database '%s' could not be opened!\n", pszPath);
+        return false;
+    }
+
+    pDb->uiNumEntries = 0;
+
+    char szLine[256];
+    TIdx uiLine = 0;
+    while(fgets(szLine, sizeof(szLine), pFile))
+    {
+        ++uiLine;
+        if((szLine[0] == '#') || (szLine[0] == '\n') || (szLine[0] == '\r'))
+        {
+            continue;
+        }
+        if(pDb->uiNumEntries == MATMUL_TUNE_DB_SIZE)
+        {
+            printf("[Tune] The tuning database '%s' has more than %d entries! The remaining ones are ignored.\n", pszPath, (int)MATMUL_TUNE_DB_SIZE);
+            break;
+        }
+        if(matmul_tune_db_parse_entry(szLine, &pDb->aEntries[pDb->uiNumEntries]))
+        {
+            ++pDb->uiNumEntries;
+        }
+        else
+        {
+            printf("[Tune] Invalid entry in line %"MATMUL_PRINTF_SIZE_T" of the tuning database '%s'!\n", (size_t)uiLine, pszPath);
+        }
+    }
+
+    fclose(pFile);
+
+    matmul_tune_db_index_build(pDb);
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool matmul_tune_db_load(
+    char const * const pszPath)
+{
+    return matmul_tune_db_read(matmul_tune_db_get(), pszPath);
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool matmul_tune_db_save(
+    char const * const pszPath)
+{
+    SMatMulTuneDb const * const pDb = matmul_tune_db_get();
+
+    FILE * const pFile = fopen(pszPath, "w");
+    if(!pFile)
+    {
+        printf("[Tune] The tuning database '%s' could not be created!\n", pszPath);
+        return false;
+    }
+
+    fprintf(pFile, "# cpu model;element type;log2 m;log2 n;log2 k;block mc;block kc;block nc;strassen cut-off;strassen omp cut-off;mc;kc;nc;micro-kernel\n");
+    for(TIdx i = 0; i < pDb->uiNumEntries; ++i)
+    {
+        SMatMulTuneEntry const * const pEntry = &pDb->aEntries[i];
+        fprintf(pFile, "%s;%c;%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%"MATMUL_PRINTF_SIZE_T";%s\n",
+            pEntry->szCpuModel,
+            pEntry->cElemType,
+            (size_t)pEntry->auiShapeClass[0],
+            (size_t)pEntry->auiShapeClass[1],
+            (size_t)pEntry->auiShapeClass[2],
+            (size_t)pEntry->params.uiSeqBlockMC,
+            (size_t)pEntry->params.uiSeqBlockKC,
+            (size_t)pEntry->params.uiSeqBlockNC,
+            (size_t)pEntry->params.uiStrassenCutOff,
+            (size_t)pEntry->params.uiStrassenOmpCutOff,
+            (size_t)pEntry->params.uiPackedMC,
+            (size_t)pEntry->params.uiPackedKC,
+            (size_t)pEntry->params.uiPackedNC,
+            pEntry->params.szMicroKernel);
+    }
+
+    bool const bSuccess = (fclose(pFile) == 0);
+    if(!bSuccess)
+    {
+        printf("[Tune] The tuning database '%s' could not be written!\n", pszPath);
+    }
+
+    return bSuccess;
+}
@@ -0,0 +1,213 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_PAR_BATCHED
+
+    #include <matmul/par/Batched.h>
+
+    #include <matmul/seq/MultipleOpts.h>    // matmul_gemm_seq_multiple_opts
+    #include <matmul/seq/Packed.h>          // matmul_gemm_seq_packed
+    #include <matmul/seq/Small.h>           // MATMUL_SMALL_MAX_SIZE
+    #include <matmul/common/Mat.h>          // matmul_mat_gemm_early_out
+
+    #include <stdlib.h>                     // malloc, free, qsort
+    #include <stdio.h>                      // printf
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_batched_seq(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        // The packed GEMM itself routes the square problems to the fixed-size kernels.
+        // For the remaining tiny problems packing costs more than it saves.
+        double const fMaxUnpacked = (double)MATMUL_SMALL_MAX_SIZE * (double)MATMUL_SMALL_MAX_SIZE * (double)MATMUL_SMALL_MAX_SIZE;
+        if(((double)m * (double)n * (double)k < fMaxUnpacked) && !((m == n) && (n == k)))
+        {
+            matmul_gemm_seq_multiple_opts(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+        }
+        else
+        {
+            matmul_gemm_seq_packed(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_batched(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const * const A, TIdx const lda,
+        TElem const * const * const B, TIdx const ldb,
+        TElem const beta,
+        TElem * const * const C, TIdx const ldc,
+        TIdx const batchCount)
+    {
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        {
+            return;
+        }
+
+        int const iBatchCount = (int)batchCount;
+        int i;
+        #pragma omp parallel for schedule(static)
+        for(i = 0; i < iBatchCount; ++i)
+        {
+            matmul_gemm_batched_seq(m, n, k, alpha, A[i], lda, B[i], ldb, beta, C[i], ldc);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_strided_batched(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const A, TIdx const lda, TIdx const strideA,
+        TElem const * const B, TIdx const ldb, TIdx const strideB,
+        TElem const beta,
+        TElem * const C, TIdx const ldc, TIdx const strideC,
+        TIdx const batchCount)
+    {
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        {
+            return;
+        }
+
+        int const iBatchCount = (int)batchCount;
+        int i;
+        #pragma omp parallel for schedule(static)
+        for(i = 0; i < iBatchCount; ++i)
+        {
+            matmul_gemm_batched_seq(m, n, k, alpha, &A[(TIdx)i*strideA], lda, &B[(TIdx)i*strideB], ldb, beta, &C[(TIdx)i*strideC], ldc);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! The order of the problems in the tile pool.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulGemmGroupedOrder
+    {
+        TIdx uiProblem;
+        TIdx k;
+    } SMatMulGemmGroupedOrder;
+
+    //-----------------------------------------------------------------------------
+    //! Sorts descending by k and ascending by the problem index for equal k.
+    //-----------------------------------------------------------------------------
+    int matmul_gemm_grouped_order_compare(
+        void const * const pLhs,
+        void const * const pRhs)
+    {
+        SMatMulGemmGroupedOrder const * const pL = (SMatMulGemmGroupedOrder const *)pLhs;
+        SMatMulGemmGroupedOrder const * const pR = (SMatMulGemmGroupedOrder const *)pRhs;
+        if(pL->k != pR->k)
+        {
+            return (pL->k > pR->k) ? -1 : 1;
+        }
+        return (pL->uiProblem < pR->uiProblem) ? -1 : ((pL->uiProblem > pR->uiProblem) ? 1 : 0);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_grouped(
+        SMatMulGemmProblem const * const pProblems,
+        TIdx const problemCount)
+    {
+        if(problemCount == 0)
+        {
+            return;
+        }
+
+        TIdx const uiTileSize = MATMUL_GROUPED_TILE_SIZE;
+
+        SMatMulGemmGroupedOrder * const pOrder = (SMatMulGemmGroupedOrder *)malloc(sizeof(SMatMulGemmGroupedOrder) * problemCount);
+        // The exclusive prefix sum of the number of tiles in the order of pOrder.
+        TIdx * const pTileBegin = (TIdx *)malloc(sizeof(TIdx) * (problemCount + 1));
+        if(!pOrder || !pTileBegin)
+        {
+            printf("[GEMM Grouped] Allocation of the tile pool failed!\n");
+            free(pOrder);
+            free(pTileBegin);
+            return;
+        }
+
+        for(TIdx i = 0; i < problemCount; ++i)
+        {
+            pOrder[i].uiProblem = i;
+            pOrder[i].k = pProblems[i].k;
+        }
+        qsort(pOrder, (size_t)problemCount, sizeof(SMatMulGemmGroupedOrder), matmul_gemm_grouped_order_compare);
+
+        pTileBegin[0] = 0;
+        for(TIdx i = 0; i < problemCount; ++i)
+        {
+            SMatMulGemmProblem const * const pProblem = &pProblems[pOrder[i].uiProblem];
+            TIdx uiNumTiles = 0;
+            if(!matmul_mat_gemm_early_out(pProblem->m, pProblem->n, pProblem->k, pProblem->alpha, pProblem->beta))
+            {
+                uiNumTiles = ((pProblem->m + uiTileSize - 1) / uiTileSize) * ((pProblem->n + uiTileSize - 1) / uiTileSize);
+            }
+            pTileBegin[i+1] = pTileBegin[i] + uiNumTiles;
+        }
+
+        int const iNumTiles = (int)pTileBegin[problemCount];
+        int t;
+        #pragma omp parallel for schedule(dynamic)
+        for(t = 0; t < iNumTiles; ++t)
+        {
+            // Binary search for the last problem beginning at or before the tile. Problems without tiles share their begin with the next one and are skipped this way.
+            TIdx uiLo = 0;
+            TIdx uiHi = problemCount;
+            while(uiHi - uiLo > 1)
+            {
+                TIdx const uiMid = uiLo + (uiHi - uiLo) / 2;
+                if(pTileBegin[uiMid] <= (TIdx)t)
+                {
+                    uiLo = uiMid;
+                }
+                else
+                {
+                    uiHi = uiMid;
+                }
+            }
+
+            SMatMulGemmProblem const * const pProblem = &pProblems[pOrder[uiLo].uiProblem];
+            TIdx const uiTile = (TIdx)t - pTileBegin[uiLo];
+            TIdx const uiNumTileCols = (pProblem->n + uiTileSize - 1) / uiTileSize;
+            TIdx const i0 = (uiTile / uiNumTileCols) * uiTileSize;
+            TIdx const j0 = (uiTile % uiNumTileCols) * uiTileSize;
+            TIdx const mt = ((pProblem->m-i0)<uiTileSize) ? (pProblem->m-i0) : uiTileSize;
+            TIdx const nt = ((pProblem->n-j0)<uiTileSize) ? (pProblem->n-j0) : uiTileSize;
+
+            matmul_gemm_batched_seq(
+                mt, nt, pProblem->k,
+                pProblem->alpha,
+                &pProblem->A[i0*pProblem->lda], pProblem->lda,
+                &pProblem->B[j0], pProblem->ldb,
+                pProblem->beta,
+                &pProblem->C[i0*pProblem->ldc + j0], pProblem->ldc);
+        }
+
+        free(pOrder);
+        free(pTileBegin);
+    }
+#endif
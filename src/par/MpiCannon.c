@@ -18,109 +18,126 @@
 
     #include <matmul/seq/MultipleOpts.h>
     #include <matmul/common/Alloc.h>
-    #include <matmul/common/Mat.h>      // matmul_mat_get_block, matmul_mat_set_block, matmul_mat_gemm_early_out
+    #include <matmul/common/Mat.h>      // matmul_mat_get_block, matmul_mat_set_block, matmul_mat_gemm_early_out, matmul_mat_parse_op
+    #include <matmul/common/Plan.h>     // matmul_plan_is_square
 
     #include <stdbool.h>                // bool, true, false
     #include <math.h>                   // sqrt
     #include <stdio.h>                  // printf
+    #include <stdlib.h>                 // malloc, free
     #include <assert.h>                 // assert
 
     #include <mpi.h>
 
     //#define MATMUL_MPI_ADDITIONAL_DEBUG_OUTPUT
 
+    //-----------------------------------------------------------------------------
+    //! The setup of the Cannon algorithm for one matrix size.
+    //! It is created per call by the GEMM functions and kept across calls by the plans.
+    //-----------------------------------------------------------------------------
+    struct SMatMulMpiCannonPlan
+    {
+        TIdx n;                         //!< The size of the full matrices is n x n.
+        TIdx b;                         //!< The size of the local blocks is b x b with b = n/q.
+        TIdx q;                         //!< The processes are arranged in a q x q grid.
+
+        int iNumProcesses;              //!< The number of processes.
+        int iRank1D;                    //!< The rank in MATMUL_MPI_COMM.
+
+        MPI_Comm comm2D;                //!< The periodic 2D grid topology.
+        int aiGridCoords[2];            //!< The coordinates of this process in the grid.
+
+        int iRankShiftSourceA;          //!< The source of the initial alignment of A.
+        int iRankShiftDestA;            //!< The destination of the initial alignment of A.
+        int iRankShiftSourceB;          //!< The source of the initial alignment of B.
+        int iRankShiftDestB;            //!< The destination of the initial alignment of B.
+        int iRankUp;                    //!< The neighbour B is shifted to.
+        int iRankDown;                  //!< The neighbour B is received from.
+        int iRankLeft;                  //!< The neighbour A is shifted to.
+        int iRankRight;                 //!< The neighbour A is received from.
+
+        bool bBlockingComm;             //!< If blocking MPI communication is used.
+
+        TElem * pALocal;                //!< The local block of A.
+        TElem * pBLocal;                //!< The local block of B.
+        TElem * pCLocal;                //!< The local block of C.
+        TElem * pALocalRecv;            //!< The block of A received while computing with non-blocking communication.
+        TElem * pBLocalRecv;            //!< The block of B received while computing with non-blocking communication.
+        TElem * pBufferCopyLocal;       //!< The buffer the root copies the blocks to send and received into.
+
+        void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const);
+    };
+
     //-----------------------------------------------------------------------------
     //
     //-----------------------------------------------------------------------------
     void matmul_gemm_par_mpi_cannon_local_block(
-        TIdx const b,
-        TElem const alpha,
-        TElem * const MATMUL_RESTRICT pALocal,
-        TElem * const MATMUL_RESTRICT pBLocal,
-        TElem * const MATMUL_RESTRICT pCLocal,
-        MPI_Comm * const pComm2D,
-        int const iRankLeft,
-        int const iRankRight,
-        int const iRankUp,
-        int const iRankDown,
-        TIdx const q,
-        void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const))
+        SMatMulMpiCannonPlan const * const pPlan,
+        TElem const alpha)
     {
-        assert(pComm2D);
-        assert(q>0);
+        assert(pPlan->q>0);
 
-        TIdx const uiNumElementsBlock = b * b;
-        int const iNumElementsBlock = (int)uiNumElementsBlock;
+        TIdx const b = pPlan->b;
+        int const iNumElementsBlock = (int)(b * b);
 
         MPI_Status status;
 
         // Compute the current block.
         int const iComputeShiftSendRecTagA = 6;
         int const iComputeShiftSendRecTagB = 7;
-        for(TIdx i = 0; i<q; ++i)
+        for(TIdx i = 0; i<pPlan->q; ++i)
         {
             // Perform the local calculation.
-            pMatMul(b, b, b, alpha, pALocal, b, pBLocal, b, (TElem)1, pCLocal, b);
+            pPlan->pMatMul(b, b, b, alpha, pPlan->pALocal, b, pPlan->pBLocal, b, (TElem)1, pPlan->pCLocal, b);
 
             // Shift matrix A left by one.
-            MPI_Sendrecv_replace(pALocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankLeft, iComputeShiftSendRecTagA, iRankRight, iComputeShiftSendRecTagA, *pComm2D, &status);
+            MPI_Sendrecv_replace(pPlan->pALocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pPlan->iRankLeft, iComputeShiftSendRecTagA, pPlan->iRankRight, iComputeShiftSendRecTagA, pPlan->comm2D, &status);
 
             // Shift matrix B up by one.
-            MPI_Sendrecv_replace(pBLocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankUp, iComputeShiftSendRecTagB, iRankDown, iComputeShiftSendRecTagB, *pComm2D, &status);
+            MPI_Sendrecv_replace(pPlan->pBLocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pPlan->iRankUp, iComputeShiftSendRecTagB, pPlan->iRankDown, iComputeShiftSendRecTagB, pPlan->comm2D, &status);
         }
     }
     //-----------------------------------------------------------------------------
     //
     //-----------------------------------------------------------------------------
     void matmul_gemm_par_mpi_cannon_local_nonblock(
-        TIdx const b,
-        TElem const alpha,
-        TElem * const MATMUL_RESTRICT pALocal,
-        TElem * const MATMUL_RESTRICT pBLocal,
-        TElem * const MATMUL_RESTRICT pCLocal,
-        MPI_Comm * const pComm2D,
-        int const iRankLeft,
-        int const iRankRight,
-        int const iRankUp,
-        int const iRankDown,
-        TIdx const q,
-        void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const))
+        SMatMulMpiCannonPlan const * const pPlan,
+        TElem const alpha)
     {
-        assert(pComm2D);
-        assert(q>0);
+        assert(pPlan->q>0);
 
-        TIdx const uiNumElementsBlock = b * b;
-        int const iNumElementsBlock = (int)uiNumElementsBlock;
+        TIdx const b = pPlan->b;
+        int const iNumElementsBlock = (int)(b * b);
 
         MPI_Status status;
 
         // Setup the A and B buffers that are swapped between the current calculation and the current receiver buffer.
         TElem * apALocal[2];
-        apALocal[0] = pALocal;
-        apALocal[1] = matmul_arr_alloc(uiNumElementsBlock);
+        apALocal[0] = pPlan->pALocal;
+        apALocal[1] = pPlan->pALocalRecv;
         TElem * apBLocal[2];
-        apBLocal[0] = pBLocal;
-        apBLocal[1] = matmul_arr_alloc(uiNumElementsBlock);
+        apBLocal[0] = pPlan->pBLocal;
+        apBLocal[1] = pPlan->pBLocalRecv;
 
         // Compute the current block.
         int const iComputeShiftSendRecTagA = 6;
         int const iComputeShiftSendRecTagB = 7;
-        for(TIdx i = 0; i<q; ++i)
+        for(TIdx i = 0; i<pPlan->q; ++i)
         {
             MPI_Request reqs[4];
 
-            bool const bLastIteration = ((i+1) == q);
+            bool const bLastIteration = ((i+1) == pPlan->q);
             if(!bLastIteration)
             {
                 // Shift matrix A left and B up by one.
-                MPI_Isend(apALocal[i%2], iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankLeft, iComputeShiftSendRecTagA, *pComm2D, &reqs[0]);
-                MPI_Isend(apBLocal[i%2], iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankUp, iComputeShiftSendRecTagB, *pComm2D, &reqs[1]);
-                MPI_Irecv(apALocal[(i+1)%2], iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankRight, iComputeShiftSendRecTagA, *pComm2D, &reqs[2]);
-                MPI_Irecv(apBLocal[(i+1)%2], iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankDown, iComputeShiftSendRecTagB, *pComm2D, &reqs[3]);
+                MPI_Isend(apALocal[i%2], iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pPlan->iRankLeft, iComputeShiftSendRecTagA, pPlan->comm2D, &reqs[0]);
+                MPI_Isend(apBLocal[i%2], iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pPlan->iRankUp, iComputeShiftSendRecTagB, pPlan->comm2D, &reqs[1]);
+                MPI_Irecv(apALocal[(i+1)%2], iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pPlan->iRankRight, iComputeShiftSendRecTagA, pPlan->comm2D, &reqs[2]);
+                MPI_Irecv(apBLocal[(i+1)%2], iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pPlan->iRankDown, iComputeShiftSendRecTagB, pPlan->comm2D, &reqs[3]);
             }
 
             // Perform the local calculation.
-            pMatMul(b, b, b, alpha, apALocal[i%2], b, apBLocal[i%2], b, (TElem)1, pCLocal, b);
+            pPlan->pMatMul(b, b, b, alpha, apALocal[i%2], b, apBLocal[i%2], b, (TElem)1, pPlan->pCLocal, b);
 
             if(!bLastIteration)
             {
@@ -130,131 +147,83 @@
                 }
             }
         }
-
-        // Free up the resources.
-        matmul_arr_free(apALocal[1]);
-        matmul_arr_free(apBLocal[1]);
     }
     //-----------------------------------------------------------------------------
     //
     //-----------------------------------------------------------------------------
     void matmul_gemm_par_mpi_cannon_local(
-        TIdx const b,
-        TElem const alpha,
-        TElem * const MATMUL_RESTRICT pALocal,
-        TElem * const MATMUL_RESTRICT pBLocal,
-        TElem * const MATMUL_RESTRICT pCLocal,
-        MPI_Comm * const pComm2D,
-        bool const bBlockingComm,
-        int aiGridCoords[2],
-        TIdx const q,
-        void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const))
+        SMatMulMpiCannonPlan const * const pPlan,
+        TElem const alpha)
     {
-        assert(pComm2D);
-        assert(q>0);
+        assert(pPlan->q>0);
 
-        TIdx const uiNumElementsBlock = b * b;
-        int const iNumElementsBlock = (int)uiNumElementsBlock;
+        int const iNumElementsBlock = (int)(pPlan->b * pPlan->b);
 
         MPI_Status status;
         int const iInitialShiftSendRecTagA = 4;
         int const iInitialShiftSendRecTagB = 5;
-        int iRankShiftSource, iRankShiftDest;
         // Perform the initial matrix alignment for A.
-        MPI_Cart_shift(*pComm2D, 1, -aiGridCoords[0], &iRankShiftSource, &iRankShiftDest);
-        MPI_Sendrecv_replace(pALocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankShiftDest, iInitialShiftSendRecTagA, iRankShiftSource, iInitialShiftSendRecTagA, *pComm2D, &status);
+        MPI_Sendrecv_replace(pPlan->pALocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pPlan->iRankShiftDestA, iInitialShiftSendRecTagA, pPlan->iRankShiftSourceA, iInitialShiftSendRecTagA, pPlan->comm2D, &status);
 
         // Perform the initial matrix alignment for B
-        MPI_Cart_shift(*pComm2D, 0, -aiGridCoords[1], &iRankShiftSource, &iRankShiftDest);
-        MPI_Sendrecv_replace(pBLocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankShiftDest, iInitialShiftSendRecTagB, iRankShiftSource, iInitialShiftSendRecTagB, *pComm2D, &status);
+        MPI_Sendrecv_replace(pPlan->pBLocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pPlan->iRankShiftDestB, iInitialShiftSendRecTagB, pPlan->iRankShiftSourceB, iInitialShiftSendRecTagB, pPlan->comm2D, &status);
 
-        // Compute ranks of the up and left shifts. (-1 == disp) < 0 -> shift down.
-        int iRankUp, iRankDown, iRankLeft, iRankRight;
-        MPI_Cart_shift(*pComm2D, 1, -1, &iRankRight, &iRankLeft);
-        MPI_Cart_shift(*pComm2D, 0, -1, &iRankDown, &iRankUp);
-
-        if(bBlockingComm)
+        if(pPlan->bBlockingComm)
         {
-            matmul_gemm_par_mpi_cannon_local_block(b, alpha, pALocal, pBLocal, pCLocal, pComm2D, iRankLeft, iRankRight, iRankUp, iRankDown, q, pMatMul);
+            matmul_gemm_par_mpi_cannon_local_block(pPlan, alpha);
         }
         else
         {
-            matmul_gemm_par_mpi_cannon_local_nonblock(b, alpha, pALocal, pBLocal, pCLocal, pComm2D, iRankLeft, iRankRight, iRankUp, iRankDown, q, pMatMul);
+            matmul_gemm_par_mpi_cannon_local_nonblock(pPlan, alpha);
         }
 
         // Restore the original distribution of A and B.
         // This is not necessary for our implementation because the A and B sub-matrices are initially scattered and not used any more.
-        /*
-        int const iRestoreShiftSendRecTagA = 8;
-        int const iRestoreShiftSendRecTagB = 9;
-        MPI_Cart_shift(*pComm2D, 1, aiGridCoords[0], &iRankShiftSource, &iRankShiftDest);
-        MPI_Sendrecv_replace(pALocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankShiftDest, iRestoreShiftSendRecTagA, iRankShiftSource, iRestoreShiftSendRecTagA, *pComm2D, &status);
-
-        MPI_Cart_shift(*pComm2D, 0, aiGridCoords[1], &iRankShiftSource, &iRankShiftDest);
-        MPI_Sendrecv_replace(pBLocal, iNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankShiftDest, iRestoreShiftSendRecTagB, iRankShiftSource, iRestoreShiftSendRecTagB, *pComm2D, &status);
-        */
     }
+
     //-----------------------------------------------------------------------------
-    //
+    //! Sets up the topology and the buffers of the Cannon algorithm for n x n matrices.
+    //!
+    //! \return If the setup succeeded. It fails on all processes if the number of processes is no perfect square or if n can not be divided among them.
     //-----------------------------------------------------------------------------
-    void matmul_gemm_par_mpi_cannon_local_algo(
-        TIdx const m, TIdx const n, TIdx const k,
-        TElem const alpha,
-        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
-        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
-        TElem const beta,
-        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+    bool matmul_gemm_par_mpi_cannon_plan_init(
+        SMatMulMpiCannonPlan * const pPlan,
+        TIdx const n,
         bool const bBlockingComm,
         void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const))
     {
-        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
-        {
-            return;
-        }
-
-        // \TODO: Implement for non square matrices?
-        if((m!=n) || (m!=k))
-        {
-            printf("[GEMM MPI Cannon] Invalid matrix size! The matrices have to be square for the MPI Cannon GEMM.\n");
-            return;
-        }
-
-        // \FIXME: Fix alpha != 1!
-        if(alpha!=(TElem)1)
-        {
-            printf("[GEMM MPI Cannon] alpha != 1 currently not implemented.\n");
-            return;
-        }
+        pPlan->n = n;
+        pPlan->bBlockingComm = bBlockingComm;
+        pPlan->pMatMul = pMatMul;
 
         // Get the number of processes.
-        int iNumProcesses;
-        MPI_Comm_size(MATMUL_MPI_COMM, &iNumProcesses);
+        MPI_Comm_size(MATMUL_MPI_COMM, &pPlan->iNumProcesses);
 
         // Get the local Rank.
-        int iRank1D;
-        MPI_Comm_rank(MATMUL_MPI_COMM, &iRank1D);
+        MPI_Comm_rank(MATMUL_MPI_COMM, &pPlan->iRank1D);
 
 #ifdef MATMUL_MPI_ADDITIONAL_DEBUG_OUTPUT
-        if(iRank1D == MATMUL_MPI_ROOT)
+        if(pPlan->iRank1D == MATMUL_MPI_ROOT)
         {
-            printf(" p=%d", iNumProcesses);
+            printf(" p=%d", pPlan->iNumProcesses);
         }
 #endif
 
         // Set up the sizes for a cartesian 2d grid topology.
-        TIdx const q = (TIdx)sqrt((double)iNumProcesses);
+        TIdx const q = (TIdx)sqrt((double)pPlan->iNumProcesses);
+        pPlan->q = q;
 
         // Test if it is a square.
-        if(q * q != iNumProcesses)
+        if(q * q != pPlan->iNumProcesses)
         {
-            if(iRank1D == MATMUL_MPI_ROOT)
+            if(pPlan->iRank1D == MATMUL_MPI_ROOT)
             {
-                printf("\n[GEMM MPI Cannon] Invalid environment! The number of processors (%d given) should be perfect square.\n", iNumProcesses);
+                printf("\n[GEMM MPI Cannon] Invalid environment! The number of processors (%d given) should be perfect square.\n", pPlan->iNumProcesses);
             }
-            return;
+            return false;
         }
 #ifdef MATMUL_MPI_ADDITIONAL_DEBUG_OUTPUT
-        if(iRank1D == MATMUL_MPI_ROOT)
+        if(pPlan->iRank1D == MATMUL_MPI_ROOT)
         {
             printf(" -> %"MATMUL_PRINTF_SIZE_T" x %"MATMUL_PRINTF_SIZE_T" grid", q, q);
         }
@@ -263,15 +232,16 @@
         // Test if the matrix can be divided equally. This can fail if e.g. the matrix is 3x3 and the processes are 2x2.
         if(n % q != 0)
         {
-            if(iRank1D == MATMUL_MPI_ROOT)
+            if(pPlan->iRank1D == MATMUL_MPI_ROOT)
             {
                 printf("\n[GEMM MPI Cannon] The matrices can't be divided among processors equally!\n");
             }
-            return;
+            return false;
         }
 
         // Determine block size of the local block.
         TIdx const b = n/q;
+        pPlan->b = b;
 
         // Set that the structure is periodical around the given dimension for wraparound connections.
         int aiPeriods[2];
@@ -280,39 +250,95 @@
         int aiProcesses[2];
         aiProcesses[0] = aiProcesses[1] = (int)q;
         // Create the cartesian 2d grid topology. Ranks can be reordered.
-        MPI_Comm comm2D;
-        MPI_Cart_create(MATMUL_MPI_COMM, 2, aiProcesses, aiPeriods, 1, &comm2D);
+        MPI_Cart_create(MATMUL_MPI_COMM, 2, aiProcesses, aiPeriods, 1, &pPlan->comm2D);
 
         // Get the rank and coordinates with respect to the new 2D grid topology.
         int iRank2D;
-        MPI_Comm_rank(comm2D, &iRank2D);
-        int aiGridCoords[2];
-        MPI_Cart_coords(comm2D, iRank2D, 2, aiGridCoords);
+        MPI_Comm_rank(pPlan->comm2D, &iRank2D);
+        MPI_Cart_coords(pPlan->comm2D, iRank2D, 2, pPlan->aiGridCoords);
 #ifdef MATMUL_MPI_ADDITIONAL_DEBUG_OUTPUT
-        printf(" iRank2D=%d, x=%d y=%d\n", iRank2D, aiGridCoords[1], aiGridCoords[0]);
+        printf(" iRank2D=%d, x=%d y=%d\n", iRank2D, pPlan->aiGridCoords[1], pPlan->aiGridCoords[0]);
 #endif
 
+        // The ranks of the initial alignment.
+        MPI_Cart_shift(pPlan->comm2D, 1, -pPlan->aiGridCoords[0], &pPlan->iRankShiftSourceA, &pPlan->iRankShiftDestA);
+        MPI_Cart_shift(pPlan->comm2D, 0, -pPlan->aiGridCoords[1], &pPlan->iRankShiftSourceB, &pPlan->iRankShiftDestB);
+
+        // Compute ranks of the up and left shifts. (-1 == disp) < 0 -> shift down.
+        MPI_Cart_shift(pPlan->comm2D, 1, -1, &pPlan->iRankRight, &pPlan->iRankLeft);
+        MPI_Cart_shift(pPlan->comm2D, 0, -1, &pPlan->iRankDown, &pPlan->iRankUp);
+
         // Initialize the local buffers
         TIdx const uiNumElementsBlock = b * b;
 
-        TElem * const pALocal = matmul_arr_alloc(uiNumElementsBlock);
-        TElem * const pBLocal = matmul_arr_alloc(uiNumElementsBlock);
-        TElem * const pCLocal = matmul_arr_alloc(uiNumElementsBlock);
+        pPlan->pALocal = matmul_arr_alloc(uiNumElementsBlock);
+        pPlan->pBLocal = matmul_arr_alloc(uiNumElementsBlock);
+        pPlan->pCLocal = matmul_arr_alloc(uiNumElementsBlock);
+        pPlan->pALocalRecv = bBlockingComm ? 0 : matmul_arr_alloc(uiNumElementsBlock);
+        pPlan->pBLocalRecv = bBlockingComm ? 0 : matmul_arr_alloc(uiNumElementsBlock);
+        pPlan->pBufferCopyLocal = (pPlan->iRank1D == MATMUL_MPI_ROOT) ? matmul_arr_alloc(uiNumElementsBlock) : 0;
+
+        return true;
+    }
 
-        TElem * pBufferCopyLocal = 0;
+    //-----------------------------------------------------------------------------
+    //! Frees the topology and the buffers of a setup by matmul_gemm_par_mpi_cannon_plan_init.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_cannon_plan_release(
+        SMatMulMpiCannonPlan * const pPlan)
+    {
+        if(pPlan->pBufferCopyLocal)
+        {
+            matmul_arr_free(pPlan->pBufferCopyLocal);
+        }
+        if(pPlan->pBLocalRecv)
+        {
+            matmul_arr_free(pPlan->pBLocalRecv);
+        }
+        if(pPlan->pALocalRecv)
+        {
+            matmul_arr_free(pPlan->pALocalRecv);
+        }
+        matmul_arr_free(pPlan->pCLocal);
+        matmul_arr_free(pPlan->pBLocal);
+        matmul_arr_free(pPlan->pALocal);
+        MPI_Comm_free(&pPlan->comm2D);
+    }
 
-        if(iRank1D == MATMUL_MPI_ROOT)
+    //-----------------------------------------------------------------------------
+    //! Distributes the matrices, computes the local products and collects C with a setup by matmul_gemm_par_mpi_cannon_plan_init.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_cannon_plan_run(
+        SMatMulMpiCannonPlan const * const pPlan,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        EMatMulLayout const eLayoutA, bool const bTransA,
+        EMatMulLayout const eLayoutB, bool const bTransB,
+        EMatMulLayout const eLayoutC)
+    {
+        // \FIXME: Fix alpha != 1!
+        if(alpha!=(TElem)1)
         {
-            pBufferCopyLocal = matmul_arr_alloc(uiNumElementsBlock);
+            printf("[GEMM MPI Cannon] alpha != 1 currently not implemented.\n");
+            return;
         }
 
+        TIdx const b = pPlan->b;
+        TIdx const uiNumElementsBlock = b * b;
+
         // Send the blocks.
-        TElem * apBuffersLocal[3] = {pALocal, pBLocal, pCLocal};
+        TElem * apBuffersLocal[3] = {pPlan->pALocal, pPlan->pBLocal, pPlan->pCLocal};
         TElem const * apBuffersGlobal[3] = {A, B, C};
         TIdx const ald[3] = {lda, ldb, ldc};
+        // Transposed and column major operands are transposed block by block while distributing them.
+        EMatMulLayout const aeLayouts[3] = {eLayoutA, eLayoutB, eLayoutC};
+        bool const abTransposed[3] = {bTransA, bTransB, false};
 
 #ifdef MATMUL_MPI_ADDITIONAL_DEBUG_OUTPUT
-        if(iRank1D == MATMUL_MPI_ROOT)
+        if(pPlan->iRank1D == MATMUL_MPI_ROOT)
         {
             printf(" Begin sending Blocks.\n");
         }
@@ -321,21 +347,21 @@
         {
             int const iInitSendRecTag = 2;
 
-            if(iRank1D == MATMUL_MPI_ROOT)
+            if(pPlan->iRank1D == MATMUL_MPI_ROOT)
             {
-                for(int iRankDestination = 1; iRankDestination<iNumProcesses; ++iRankDestination)
+                for(int iRankDestination = 1; iRankDestination<pPlan->iNumProcesses; ++iRankDestination)
                 {
                     int aiGridCoordsDest[2];
-                    MPI_Cart_coords(comm2D, iRankDestination, 2, aiGridCoordsDest);
+                    MPI_Cart_coords(pPlan->comm2D, iRankDestination, 2, aiGridCoordsDest);
 
                     // Copy the blocks so that they lay linearly in memory.
-                    matmul_mat_get_block(apBuffersGlobal[uiBuffer], ald[uiBuffer], aiGridCoordsDest[1], aiGridCoordsDest[0], pBufferCopyLocal, b);
+                    matmul_mat_get_block(apBuffersGlobal[uiBuffer], ald[uiBuffer], aeLayouts[uiBuffer], aiGridCoordsDest[1], aiGridCoordsDest[0], pPlan->pBufferCopyLocal, b, abTransposed[uiBuffer]);
 
-                    MPI_Send(pBufferCopyLocal, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankDestination, iInitSendRecTag, MATMUL_MPI_COMM);
+                    MPI_Send(pPlan->pBufferCopyLocal, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankDestination, iInitSendRecTag, MATMUL_MPI_COMM);
                 }
 
                 // Copy the root block.
-                matmul_mat_get_block(apBuffersGlobal[uiBuffer], ald[uiBuffer], aiGridCoords[1], aiGridCoords[0], apBuffersLocal[uiBuffer], b);
+                matmul_mat_get_block(apBuffersGlobal[uiBuffer], ald[uiBuffer], aeLayouts[uiBuffer], pPlan->aiGridCoords[1], pPlan->aiGridCoords[0], apBuffersLocal[uiBuffer], b, abTransposed[uiBuffer]);
             }
             else
             {
@@ -344,7 +370,7 @@
             }
         }
 #ifdef MATMUL_MPI_ADDITIONAL_DEBUG_OUTPUT
-        if(iRank1D == MATMUL_MPI_ROOT)
+        if(pPlan->iRank1D == MATMUL_MPI_ROOT)
         {
             printf(" Finished sending Blocks.\n");
         }
@@ -357,57 +383,85 @@
             {
                 for(TIdx j = 0; j < b; ++j)
                 {
-                    pCLocal[i*b + j] *= beta;
+                    pPlan->pCLocal[i*b + j] *= beta;
                 }
             }
         }
 
         // Do the node local calculation.
-        matmul_gemm_par_mpi_cannon_local(b, alpha, pALocal, pBLocal, pCLocal, &comm2D, bBlockingComm, aiGridCoords, q, pMatMul);
+        matmul_gemm_par_mpi_cannon_local(pPlan, alpha);
 
         // Collect the results and integrate into C
         int const iCollectSendRecTag = 3;
 
 #ifdef MATMUL_MPI_ADDITIONAL_DEBUG_OUTPUT
-        if(iRank1D == MATMUL_MPI_ROOT)
+        if(pPlan->iRank1D == MATMUL_MPI_ROOT)
         {
             printf(" Begin collecting Blocks.\n");
         }
 #endif
-        if(iRank1D == MATMUL_MPI_ROOT)
+        if(pPlan->iRank1D == MATMUL_MPI_ROOT)
         {
-            for(int iRankOrigin = 1; iRankOrigin<iNumProcesses; ++iRankOrigin)
+            for(int iRankOrigin = 1; iRankOrigin<pPlan->iNumProcesses; ++iRankOrigin)
             {
                 int aiGridCoordsDest[2];
-                MPI_Cart_coords(comm2D, iRankOrigin, 2, aiGridCoordsDest);
+                MPI_Cart_coords(pPlan->comm2D, iRankOrigin, 2, aiGridCoordsDest);
 
                 MPI_Status status;
-                MPI_Recv(pBufferCopyLocal, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankOrigin, iCollectSendRecTag, MATMUL_MPI_COMM, &status);
+                MPI_Recv(pPlan->pBufferCopyLocal, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, iRankOrigin, iCollectSendRecTag, MATMUL_MPI_COMM, &status);
 
                 // Copy the blocks so that they lay linearly in memory.
-                matmul_mat_set_block(pBufferCopyLocal, b, C, ldc, aiGridCoordsDest[1], aiGridCoordsDest[0]);
+                matmul_mat_set_block(pPlan->pBufferCopyLocal, b, C, ldc, eLayoutC, aiGridCoordsDest[1], aiGridCoordsDest[0]);
             }
 
             // Copy the root block.
-            matmul_mat_set_block(pCLocal, b, C, ldc, aiGridCoords[1], aiGridCoords[0]);
+            matmul_mat_set_block(pPlan->pCLocal, b, C, ldc, eLayoutC, pPlan->aiGridCoords[1], pPlan->aiGridCoords[0]);
         }
         else
         {
-            MPI_Send(pCLocal, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, MATMUL_MPI_ROOT, iCollectSendRecTag, MATMUL_MPI_COMM);
+            MPI_Send(pPlan->pCLocal, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, MATMUL_MPI_ROOT, iCollectSendRecTag, MATMUL_MPI_COMM);
         }
 #ifdef MATMUL_MPI_ADDITIONAL_DEBUG_OUTPUT
-        if(iRank1D == MATMUL_MPI_ROOT)
+        if(pPlan->iRank1D == MATMUL_MPI_ROOT)
         {
-            matmul_arr_free(pBufferCopyLocal);
             printf(" Finished collecting Blocks.\n");
         }
 #endif
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_cannon_local_algo(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        EMatMulLayout const eLayoutA, bool const bTransA,
+        EMatMulLayout const eLayoutB, bool const bTransB,
+        EMatMulLayout const eLayoutC,
+        bool const bBlockingComm,
+        void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const))
+    {
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        {
+            return;
+        }
+
+        if(!matmul_plan_is_square(m, n, k, "MPI Cannon"))
+        {
+            return;
+        }
 
-        // Free up the resources.
-        matmul_arr_free(pALocal);
-        matmul_arr_free(pBLocal);
-        matmul_arr_free(pCLocal);
-        MPI_Comm_free(&comm2D);
+        SMatMulMpiCannonPlan plan;
+        if(matmul_gemm_par_mpi_cannon_plan_init(&plan, n, bBlockingComm, pMatMul))
+        {
+            matmul_gemm_par_mpi_cannon_plan_run(&plan, alpha, A, lda, B, ldb, beta, C, ldc, eLayoutA, bTransA, eLayoutB, bTransB, eLayoutC);
+
+            matmul_gemm_par_mpi_cannon_plan_release(&plan);
+        }
     }
 
 #ifdef MATMUL_BUILD_PAR_MPI_CANNON_STD
@@ -427,7 +481,7 @@
             return;
         }
 
-        matmul_gemm_par_mpi_cannon_local_algo(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, true, matmul_gemm_seq_multiple_opts);
+        matmul_gemm_par_mpi_cannon_local_algo(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, true, matmul_gemm_seq_multiple_opts);
     }
 
     //-----------------------------------------------------------------------------
@@ -446,7 +500,103 @@
             return;
         }
 
-        matmul_gemm_par_mpi_cannon_local_algo(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, false, matmul_gemm_seq_multiple_opts);
+        matmul_gemm_par_mpi_cannon_local_algo(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, false, matmul_gemm_seq_multiple_opts);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_cannon_layout(
+        EMatMulLayout const eLayoutA, char const transA,
+        EMatMulLayout const eLayoutB, char const transB,
+        EMatMulLayout const eLayoutC,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        bool const bBlockingComm)
+    {
+        bool bTransA, bTransB;
+        if(!matmul_mat_parse_op(transA, &bTransA) || !matmul_mat_parse_op(transB, &bTransB))
+        {
+            printf("[GEMM MPI Cannon] Invalid transposition '%c' '%c'! Only 'N', 'T' and 'C' are supported.\n", transA, transB);
+            return;
+        }
+
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        {
+            return;
+        }
+
+        matmul_gemm_par_mpi_cannon_local_algo(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, eLayoutA, bTransA, eLayoutB, bTransB, eLayoutC, bBlockingComm, matmul_gemm_seq_multiple_opts);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_cannon_trans(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        bool const bBlockingComm)
+    {
+        matmul_gemm_par_mpi_cannon_layout(EMatMulLayoutRowMajor, transA, EMatMulLayoutRowMajor, transB, EMatMulLayoutRowMajor, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, bBlockingComm);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    SMatMulMpiCannonPlan * matmul_gemm_par_mpi_cannon_plan_create(
+        TIdx const n,
+        bool const bBlockingComm)
+    {
+        SMatMulMpiCannonPlan * const pPlan = (SMatMulMpiCannonPlan *)malloc(sizeof(SMatMulMpiCannonPlan));
+
+        if(!matmul_gemm_par_mpi_cannon_plan_init(pPlan, n, bBlockingComm, matmul_gemm_seq_multiple_opts))
+        {
+            free(pPlan);
+            return 0;
+        }
+
+        return pPlan;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_cannon_plan_execute(
+        SMatMulMpiCannonPlan const * const pPlan,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if(matmul_mat_gemm_early_out(pPlan->n, pPlan->n, pPlan->n, alpha, beta))
+        {
+            return;
+        }
+
+        matmul_gemm_par_mpi_cannon_plan_run(pPlan, alpha, A, lda, B, ldb, beta, C, ldc, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_cannon_plan_destroy(
+        SMatMulMpiCannonPlan * const pPlan)
+    {
+        if(pPlan)
+        {
+            matmul_gemm_par_mpi_cannon_plan_release(pPlan);
+            free(pPlan);
+        }
     }
 #endif
 #ifdef MATMUL_BUILD_PAR_MPI_CANNON_MKL
@@ -469,7 +619,7 @@
             return;
         }
 
-        matmul_gemm_par_mpi_cannon_local_algo(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, false, matmul_gemm_par_blas_mkl);
+        matmul_gemm_par_mpi_cannon_local_algo(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, false, matmul_gemm_par_blas_mkl);
     }
 #endif
 #ifdef MATMUL_BUILD_PAR_MPI_CANNON_CUBLAS
@@ -492,7 +642,7 @@
             return;
         }
 
-        matmul_gemm_par_mpi_cannon_local_algo(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, false, matmul_gemm_par_blas_cublas2_memcpy);
+        matmul_gemm_par_mpi_cannon_local_algo(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, false, matmul_gemm_par_blas_cublas2_memcpy);
     }
 #endif
 #endif
@@ -18,12 +18,14 @@
 
     #include <matmul/seq/MultipleOpts.h>
     #include <matmul/common/Alloc.h>
-    #include <matmul/common/Mat.h>          // matmul_mat_row_major_to_mat_x_block_major, matmul_mat_gemm_early_out
-    #include <matmul/common/Array.h>        // matmul_arr_alloc_fill_zero
+    #include <matmul/common/Mat.h>          // matmul_mat_row_major_to_mat_x_block_major, matmul_mat_gemm_early_out, matmul_mat_parse_op
+    #include <matmul/common/Plan.h>         // matmul_plan_is_square
 
     #include <stdbool.h>                    // bool
     #include <math.h>                       // cbrt
     #include <stdio.h>                      // printf
+    #include <stdlib.h>                     // malloc, free
+    #include <string.h>                     // memset
     #include <assert.h>                     // assert
 
     #include <mpi.h>
@@ -57,6 +59,22 @@
         TIdx b;                         // b = (n/q)
     } STopologyInfo;
 
+    //-----------------------------------------------------------------------------
+    //! The topology and the buffers of the DNS algorithm for one matrix size.
+    //! It is created per call by the GEMM functions and kept across calls by the plans.
+    //-----------------------------------------------------------------------------
+    struct SMatMulMpiDnsPlan
+    {
+        STopologyInfo info;             //!< The topology.
+
+        TElem * pASub;                  //!< The local block of A.
+        TElem * pBSub;                  //!< The local block of B.
+        TElem * pCSub;                  //!< The local block of C.
+        TElem * pBlocks;                //!< The n x n buffer of the root the matrices are converted to block major order in.
+
+        void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const);
+    };
+
     //-----------------------------------------------------------------------------
     //
     //-----------------------------------------------------------------------------
@@ -64,27 +82,21 @@
         STopologyInfo const * const MATMUL_RESTRICT info,
         TElem const * const MATMUL_RESTRICT pX,
         TIdx const ldx,
+        EMatMulLayout const eLayoutX,
         TElem * const MATMUL_RESTRICT pXSub,
+        TElem * const MATMUL_RESTRICT pXBlocks,
         bool const bColumnFirst,
+        bool const bTransposed,
         MPI_Comm const mesh)
     {
-        TElem * pXBlocks = 0;
         if(info->iLocalRank1D == MATMUL_MPI_ROOT)
         {
-            TIdx const uiNumElements =  info->n * info->n;
-            pXBlocks = matmul_arr_alloc(uiNumElements);
-
-            matmul_mat_row_major_to_mat_x_block_major(pX, info->n, info->n, ldx, pXBlocks, info->b, bColumnFirst);
+            matmul_mat_row_major_to_mat_x_block_major(pX, info->n, info->n, ldx, eLayoutX, pXBlocks, info->b, bColumnFirst, bTransposed);
         }
 
         TIdx const uiNumElementsBlock = info->b * info->b;
 
         MPI_Scatter(pXBlocks, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pXSub, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, MATMUL_MPI_ROOT, mesh);
-
-        if(info->iLocalRank1D == MATMUL_MPI_ROOT)
-        {
-            matmul_arr_free(pXBlocks);
-        }
     }
 
     //-----------------------------------------------------------------------------
@@ -94,9 +106,12 @@
         STopologyInfo const * const MATMUL_RESTRICT info,
         TElem const * const MATMUL_RESTRICT pX,
         TIdx const ldx,
+        EMatMulLayout const eLayoutX,
         TElem * const MATMUL_RESTRICT pXSub,
+        TElem * const MATMUL_RESTRICT pXBlocks,
         TIdx const ringdim,
-        bool const bColumnFirst)
+        bool const bColumnFirst,
+        bool const bTransposed)
     {
         MPI_Comm mesh, ring;
         if(ringdim == J_DIM)
@@ -117,8 +132,11 @@
                 info,
                 pX,
                 ldx,
+                eLayoutX,
                 pXSub,
+                pXBlocks,
                 bColumnFirst,
+                bTransposed,
                 mesh);
         }
 
@@ -155,7 +173,9 @@
         STopologyInfo const * const MATMUL_RESTRICT info,
         TElem * const MATMUL_RESTRICT C,
         TIdx const ldc,
-        TElem * const MATMUL_RESTRICT pCSub)
+        EMatMulLayout const eLayoutC,
+        TElem * const MATMUL_RESTRICT pCSub,
+        TElem * const MATMUL_RESTRICT pCBlocks)
     {
         if(info->aiGridCoords[K_DIM] == MATMUL_MPI_ROOT)
         {
@@ -163,7 +183,10 @@
                 info,
                 C,
                 ldc,
+                eLayoutC,
                 pCSub,
+                pCBlocks,
+                false,
                 false,
                 info->commMeshIJ);
         }
@@ -175,26 +198,20 @@
     void matmul_gemm_par_mpi_dns_gather_c_blocks_2d(
         STopologyInfo const * const MATMUL_RESTRICT info,
         TElem * const MATMUL_RESTRICT pCSub,
+        TElem * const MATMUL_RESTRICT pCBlocks,
         TElem * const MATMUL_RESTRICT C,
-        TIdx const ldc)
+        TIdx const ldc,
+        EMatMulLayout const eLayoutC)
     {
         if(info->aiGridCoords[K_DIM] == MATMUL_MPI_ROOT)
         {
-            TElem * pCBlocks = 0;
-            if(info->iLocalRank1D == MATMUL_MPI_ROOT)
-            {
-                TIdx const uiNumElements = info->n * info->n;
-                pCBlocks = matmul_arr_alloc(uiNumElements);
-            }
-
             TIdx const uiNumElementsBlock = info->b * info->b;
 
             MPI_Gather(pCSub, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, pCBlocks, (int)uiNumElementsBlock, MATMUL_MPI_ELEMENT_TYPE, MATMUL_MPI_ROOT, info->commMeshIJ);
 
             if(info->iLocalRank1D == MATMUL_MPI_ROOT)
             {
-                matmul_mat_x_block_major_to_mat_row_major(pCBlocks, info->b, C, info->n, info->n, ldc, false);
-                matmul_arr_free(pCBlocks);
+                matmul_mat_x_block_major_to_mat_row_major(pCBlocks, info->b, C, info->n, info->n, ldc, eLayoutC, false);
             }
         }
     }
@@ -203,39 +220,51 @@
     //
     //-----------------------------------------------------------------------------
     void matmul_gemm_par_mpi_dns_local(
-        STopologyInfo const * const MATMUL_RESTRICT info,
+        SMatMulMpiDnsPlan const * const pPlan,
         TElem const alpha,
         TElem const * const MATMUL_RESTRICT A, TIdx const lda,
         TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
         TElem const beta,
         TElem * const MATMUL_RESTRICT C, TIdx const ldc,
-        void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const))
+        EMatMulLayout const eLayoutA, bool const bTransA,
+        EMatMulLayout const eLayoutB, bool const bTransB,
+        EMatMulLayout const eLayoutC)
     {
+        // \FIXME: Fix alpha != 1!
+        if(alpha!=(TElem)1)
+        {
+            printf("[GEMM MPI DNS] alpha != 1 currently not implemented.\n");
+            return;
+        }
+
+        STopologyInfo const * const info = &pPlan->info;
+
         assert(info->commMesh3D);
         assert(info->n>0);
         assert(info->b>0);
 
-        // Allocate the local matrices
         TIdx const uiNumElementsBlock = info->b * info->b;
-        TElem * const ASub = matmul_arr_alloc(uiNumElementsBlock);
-        TElem * const BSub = matmul_arr_alloc(uiNumElementsBlock);
+        TElem * const ASub = pPlan->pASub;
+        TElem * const BSub = pPlan->pBSub;
+        TElem * const CSub = pPlan->pCSub;
         // The elements in the root IJ plane get sub-matrices of the input C, all others zeros.
         bool const bIJPlane = (info->aiGridCoords[K_DIM] == MATMUL_MPI_ROOT);
-        TElem * const CSub = bIJPlane
-                                ? matmul_arr_alloc(uiNumElementsBlock)
-                                : matmul_arr_alloc_fill_zero(uiNumElementsBlock);
+        if(!bIJPlane)
+        {
+            memset(CSub, 0, uiNumElementsBlock * sizeof(TElem));
+        }
 
         // Scatter C on the i-j plane.
-        matmul_gemm_par_mpi_dns_scatter_c_blocks_2d(info, C, ldc, CSub);
+        matmul_gemm_par_mpi_dns_scatter_c_blocks_2d(info, C, ldc, eLayoutC, CSub, pPlan->pBlocks);
         // Distribute A along the i-k plane and then in the j direction.
-        matmul_gemm_par_mpi_dns_distribute_mat(info, A, lda, ASub, J_DIM, false);
+        matmul_gemm_par_mpi_dns_distribute_mat(info, A, lda, eLayoutA, ASub, pPlan->pBlocks, J_DIM, false, bTransA);
         // Distribute B along the k-j plane and then in the i direction.
-        matmul_gemm_par_mpi_dns_distribute_mat(info, B, ldb, BSub, I_DIM, true);
+        matmul_gemm_par_mpi_dns_distribute_mat(info, B, ldb, eLayoutB, BSub, pPlan->pBlocks, I_DIM, true, bTransB);
 
         // Apply beta multiplication to local C.
         if(bIJPlane)
         {
-            if(alpha != (TElem)1)
+            if(beta != (TElem)1)
             {
                 for(TIdx i = 0; i < info->b; ++i)
                 {
@@ -248,17 +277,13 @@
         }
 
         // Do the local matrix multiplication.
-        pMatMul(info->b, info->b, info->b, alpha, ASub, info->b, BSub, info->b, (TElem)1, CSub, info->b);
+        pPlan->pMatMul(info->b, info->b, info->b, alpha, ASub, info->b, BSub, info->b, (TElem)1, CSub, info->b);
 
         // Reduce along k dimension to the i-j plane
         matmul_gemm_par_mpi_dns_reduce_c(info, CSub);
 
         // Gather C on the i-j plane to the root node.
-        matmul_gemm_par_mpi_dns_gather_c_blocks_2d(info, CSub, C, ldc);
-
-        matmul_arr_free(CSub);
-        matmul_arr_free(BSub);
-        matmul_arr_free(ASub);
+        matmul_gemm_par_mpi_dns_gather_c_blocks_2d(info, CSub, pPlan->pBlocks, C, ldc, eLayoutC);
     }
 
     //-----------------------------------------------------------------------------
@@ -383,6 +408,46 @@
         MPI_Comm_free(&info->commMesh3D);
     }
     //-----------------------------------------------------------------------------
+    //! Sets up the topology and the buffers of the DNS algorithm for n x n matrices.
+    //!
+    //! \return If the setup succeeded. It fails on all processes if the number of processes is no perfect cube or if n can not be divided among them.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_par_mpi_dns_plan_init(
+        SMatMulMpiDnsPlan * const pPlan,
+        TIdx const n,
+        void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const))
+    {
+        if(!matmul_gemm_par_mpi_dns_create_topology_info(&pPlan->info, n))
+        {
+            return false;
+        }
+
+        pPlan->pMatMul = pMatMul;
+
+        TIdx const uiNumElementsBlock = pPlan->info.b * pPlan->info.b;
+        pPlan->pASub = matmul_arr_alloc(uiNumElementsBlock);
+        pPlan->pBSub = matmul_arr_alloc(uiNumElementsBlock);
+        pPlan->pCSub = matmul_arr_alloc(uiNumElementsBlock);
+        pPlan->pBlocks = (pPlan->info.iLocalRank1D == MATMUL_MPI_ROOT) ? matmul_arr_alloc(n * n) : 0;
+
+        return true;
+    }
+    //-----------------------------------------------------------------------------
+    //! Frees the topology and the buffers of a setup by matmul_gemm_par_mpi_dns_plan_init.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_dns_plan_release(
+        SMatMulMpiDnsPlan * const pPlan)
+    {
+        if(pPlan->pBlocks)
+        {
+            matmul_arr_free(pPlan->pBlocks);
+        }
+        matmul_arr_free(pPlan->pCSub);
+        matmul_arr_free(pPlan->pBSub);
+        matmul_arr_free(pPlan->pASub);
+        matmul_gemm_par_mpi_dns_destroy_topology_info(&pPlan->info);
+    }
+    //-----------------------------------------------------------------------------
     //
     //-----------------------------------------------------------------------------
     void matmul_gemm_par_mpi_dns_local_algo(
@@ -392,6 +457,9 @@
         TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
         TElem const beta,
         TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        EMatMulLayout const eLayoutA, bool const bTransA,
+        EMatMulLayout const eLayoutB, bool const bTransB,
+        EMatMulLayout const eLayoutC,
         void(*pMatMul)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const))
     {
         if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
@@ -399,33 +467,56 @@
             return;
         }
 
-        // \TODO: Implement for non square matrices?
-        if((m!=n) || (m!=k))
+        if(!matmul_plan_is_square(m, n, k, "MPI DNS"))
         {
-            printf("[GEMM MPI DNS] Invalid matrix size! The matrices have to be square for the MPI DNS GEMM.\n");
             return;
         }
 
-        // \FIXME: Fix alpha != 1!
-        if(alpha!=(TElem)1)
+        SMatMulMpiDnsPlan plan;
+        if(matmul_gemm_par_mpi_dns_plan_init(&plan, n, pMatMul))
         {
-            printf("[GEMM MPI DNS] alpha != 1 currently not implemented.\n");
-            return;
+            matmul_gemm_par_mpi_dns_local(&plan, alpha, A, lda, B, ldb, beta, C, ldc, eLayoutA, bTransA, eLayoutB, bTransB, eLayoutC);
+
+            matmul_gemm_par_mpi_dns_plan_release(&plan);
         }
+    }
 
-        struct STopologyInfo info;
-        if(matmul_gemm_par_mpi_dns_create_topology_info(&info, n))
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_dns(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
         {
-            matmul_gemm_par_mpi_dns_local(&info, alpha, A, lda, B, ldb, beta, C, ldc, pMatMul);
-
-            matmul_gemm_par_mpi_dns_destroy_topology_info(&info);
+            return;
         }
+
+        matmul_gemm_par_mpi_dns_local_algo(
+            m, n, k,
+            alpha,
+            A, lda,
+            B, ldb,
+            beta,
+            C, ldc,
+            EMatMulLayoutRowMajor, false,
+            EMatMulLayoutRowMajor, false,
+            EMatMulLayoutRowMajor,
+            matmul_gemm_seq_multiple_opts);
     }
 
     //-----------------------------------------------------------------------------
     //
     //-----------------------------------------------------------------------------
-    void matmul_gemm_par_mpi_dns(
+    void matmul_gemm_par_mpi_dns_layout(
+        EMatMulLayout const eLayoutA, char const transA,
+        EMatMulLayout const eLayoutB, char const transB,
+        EMatMulLayout const eLayoutC,
         TIdx const m, TIdx const n, TIdx const k,
         TElem const alpha,
         TElem const * const MATMUL_RESTRICT A, TIdx const lda,
@@ -433,6 +524,13 @@
         TElem const beta,
         TElem * const MATMUL_RESTRICT C, TIdx const ldc)
     {
+        bool bTransA, bTransB;
+        if(!matmul_mat_parse_op(transA, &bTransA) || !matmul_mat_parse_op(transB, &bTransB))
+        {
+            printf("[GEMM MPI DNS] Invalid transposition '%c' '%c'! Only 'N', 'T' and 'C' are supported.\n", transA, transB);
+            return;
+        }
+
         if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
         {
             return;
@@ -445,6 +543,83 @@
             B, ldb,
             beta,
             C, ldc,
+            eLayoutA, bTransA,
+            eLayoutB, bTransB,
+            eLayoutC,
             matmul_gemm_seq_multiple_opts);
     }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_dns_trans(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        matmul_gemm_par_mpi_dns_layout(
+            EMatMulLayoutRowMajor, transA,
+            EMatMulLayoutRowMajor, transB,
+            EMatMulLayoutRowMajor,
+            m, n, k,
+            alpha,
+            A, lda,
+            B, ldb,
+            beta,
+            C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    SMatMulMpiDnsPlan * matmul_gemm_par_mpi_dns_plan_create(
+        TIdx const n)
+    {
+        SMatMulMpiDnsPlan * const pPlan = (SMatMulMpiDnsPlan *)malloc(sizeof(SMatMulMpiDnsPlan));
+
+        if(!matmul_gemm_par_mpi_dns_plan_init(pPlan, n, matmul_gemm_seq_multiple_opts))
+        {
+            free(pPlan);
+            return 0;
+        }
+
+        return pPlan;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_dns_plan_execute(
+        SMatMulMpiDnsPlan const * const pPlan,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        TIdx const n = pPlan->info.n;
+        if(matmul_mat_gemm_early_out(n, n, n, alpha, beta))
+        {
+            return;
+        }
+
+        matmul_gemm_par_mpi_dns_local(pPlan, alpha, A, lda, B, ldb, beta, C, ldc, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor, false, EMatMulLayoutRowMajor);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_mpi_dns_plan_destroy(
+        SMatMulMpiDnsPlan * const pPlan)
+    {
+        if(pPlan)
+        {
+            matmul_gemm_par_mpi_dns_plan_release(pPlan);
+            free(pPlan);
+        }
+    }
 #endif
@@ -0,0 +1,306 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_PAR_PACKED_OMP2
+
+    #include <matmul/par/PackedOmp2.h>
+
+    #include <matmul/seq/Packed.h>          // matmul_pack_a_seq_prologue, matmul_pack_b_seq_prologue, matmul_gemm_seq_packed_fused
+    #include <matmul/seq/MicroKernel.h>     // matmul_micro_kernel_get, matmul_micro_kernel_find, MATMUL_MICRO_KERNEL_MAX_MR, MATMUL_MICRO_KERNEL_MAX_NR
+    #include <matmul/common/Alloc.h>        // matmul_arr_aligned_alloc_internal, matmul_arr_aligned_free_internal
+    #include <matmul/common/Tune.h>         // matmul_tune_get
+
+    #include <stdio.h>                      // printf
+
+    #include <omp.h>
+
+    #if _OPENMP >= 200203   // OpenMP 2.0
+        //-----------------------------------------------------------------------------
+        //! C(mc, nc) = alpha * A(mc, kc) * packed B(kc, nc) + beta * C for one row block packed by the calling thread.
+        //!
+        //! \param pEpilogue The epilogue applied to the tiles or 0.
+        //! \param row The row of C in the whole result.
+        //! \param col The column of C in the whole result.
+        //! \param AB The tile the micro-kernel writes into at the bottom and right edges of C and for the epilogue.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_packed_omp2_row_block(
+            TIdx const mc, TIdx const nc, TIdx const kc,
+            SMatMulMicroKernel const * const pMicroKernel,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT pPackedA,
+            TElem const * const MATMUL_RESTRICT pPackedB,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+            SMatMulEpilogue const * const pEpilogue,
+            TIdx const row, TIdx const col,
+            TElem * const MATMUL_RESTRICT AB)
+        {
+            TIdx const MR = pMicroKernel->uiMR;
+            TIdx const NR = pMicroKernel->uiNR;
+
+            // 2nd loop: Micro-panels of B.
+            for(TIdx jr = 0; jr < nc; jr += NR)
+            {
+                TIdx const nr = ((nc-jr)<NR) ? (nc-jr) : NR;
+                TElem const * const pMicroPanelB = &pPackedB[jr*kc];
+
+                // 1st loop: Micro-panels of A.
+                for(TIdx ir = 0; ir < mc; ir += MR)
+                {
+                    TIdx const mr = ((mc-ir)<MR) ? (mc-ir) : MR;
+                    TElem const * const pMicroPanelA = &pPackedA[ir*kc];
+                    TElem * const pC = &C[ir*ldc + jr];
+
+                    if((mr == MR) && (nr == NR) && !pEpilogue)
+                    {
+                        pMicroKernel->pMicroKernel(kc, alpha, pMicroPanelA, pMicroPanelB, beta, pC, ldc);
+                    }
+                    else if(pEpilogue)
+                    {
+                        pMicroKernel->pMicroKernel(kc, alpha, pMicroPanelA, pMicroPanelB, (TElem)0, AB, NR);
+                        matmul_epilogue_apply_tile(pEpilogue, row+ir, col+jr, mr, nr, AB, NR, beta, pC, ldc);
+                    }
+                    else
+                    {
+                        pMicroKernel->pMicroKernel(kc, alpha, pMicroPanelA, pMicroPanelB, (TElem)0, AB, NR);
+                        for(TIdx i = 0; i < mr; ++i)
+                        {
+                            for(TIdx j = 0; j < nr; ++j)
+                            {
+                                pC[i*ldc + j] = (beta == (TElem)0)
+                                    ? AB[i*NR + j]
+                                    : beta * pC[i*ldc + j] + AB[i*NR + j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //! The parallel packed GEMM for an epilogue storing the result into pOut if k exceeds KC.
+        //! Each thread accumulates the partial sums of its row blocks in its own MC-by-NC buffer instead of in C, which is only read for beta.
+        //! The row blocks are therefore the outer loop of the panels along k and each thread packs the panels of B itself.
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_packed_omp2_accumulated(
+            TIdx const m, TIdx const n, TIdx const k,
+            TIdx const MC, TIdx const KC, TIdx const NC,
+            SMatMulMicroKernel const * const pMicroKernel,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            SMatMulPrologue const * const pPrologueA,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            SMatMulPrologue const * const pPrologueB,
+            TElem const beta,
+            TElem const * const MATMUL_RESTRICT C, TIdx const ldc,
+            SMatMulEpilogue const * const pEpilogue)
+        {
+            TIdx const MR = pMicroKernel->uiMR;
+            TIdx const NR = pMicroKernel->uiNR;
+            int const iNumRowBlocks = (int)((m+MC-1)/MC);
+
+            TIdx const uiMaxMc = (m<MC) ? m : MC;
+            TIdx const uiMaxKc = (k<KC) ? k : KC;
+            TIdx const uiMaxNc = (n<NC) ? n : NC;
+
+            #pragma omp parallel
+            {
+                TElem * const pPackedA = (TElem *)matmul_arr_aligned_alloc_internal(((uiMaxMc+MR-1)/MR)*MR*uiMaxKc*sizeof(TElem));
+                TElem * const pPackedB = (TElem *)matmul_arr_aligned_alloc_internal(((uiMaxNc+NR-1)/NR)*NR*uiMaxKc*sizeof(TElem));
+                TElem * const pAccC = (TElem *)matmul_arr_aligned_alloc_internal(uiMaxMc*uiMaxNc*sizeof(TElem));
+
+                TElem AB[MATMUL_MICRO_KERNEL_MAX_MR*MATMUL_MICRO_KERNEL_MAX_NR];
+
+                // 5th loop: Column blocks of C and B.
+                for(TIdx jc = 0; jc < n; jc += NC)
+                {
+                    TIdx const nc = ((n-jc)<NC) ? (n-jc) : NC;
+
+                    // Row blocks of C and A. They are independent so the threads do not wait for each other.
+                    int iRowBlock;
+                    #pragma omp for schedule(static) nowait
+                    for(iRowBlock = 0; iRowBlock < iNumRowBlocks; ++iRowBlock)
+                    {
+                        TIdx const ic = (TIdx)iRowBlock*MC;
+                        TIdx const mc = ((m-ic)<MC) ? (m-ic) : MC;
+
+                        // The accumulation starts with beta * C. If beta is zero, C is not read.
+                        for(TIdx i = 0; i < mc; ++i)
+                        {
+                            for(TIdx j = 0; j < nc; ++j)
+                            {
+                                pAccC[i*nc + j] = (beta == (TElem)0) ? (TElem)0 : beta * C[(ic+i)*ldc + jc + j];
+                            }
+                        }
+
+                        // 4th loop: Panels along the k dimension.
+                        for(TIdx pc = 0; pc < k; pc += KC)
+                        {
+                            TIdx const kc = ((k-pc)<KC) ? (k-pc) : KC;
+
+                            matmul_pack_b_seq_prologue(kc, nc, NR, &B[pc*ldb + jc], ldb, 1, pPrologueB, pc, jc, pPackedB);
+                            matmul_pack_a_seq_prologue(mc, kc, MR, &A[ic*lda + pc], lda, 1, pPrologueA, ic, pc, pPackedA);
+
+                            matmul_gemm_par_packed_omp2_row_block(mc, nc, kc, pMicroKernel, alpha, pPackedA, pPackedB, (TElem)1, pAccC, nc, ((pc+kc) == k) ? pEpilogue : 0, ic, jc, AB);
+                        }
+                    }
+                }
+
+                matmul_arr_aligned_free_internal(pPackedA);
+                matmul_arr_aligned_free_internal(pPackedB);
+                matmul_arr_aligned_free_internal(pAccC);
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_packed_omp2_fused(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            SMatMulPrologue const * const pPrologueA,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            SMatMulPrologue const * const pPrologueB,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+            SMatMulEpilogue const * const pEpilogue)
+        {
+            // Without a product there is only a single pass over C left.
+            if((m == 0) || (n == 0) || (k == 0) || (alpha == (TElem)0))
+            {
+                matmul_gemm_seq_packed_fused(m, n, k, alpha, A, lda, pPrologueA, B, ldb, pPrologueB, beta, C, ldc, pEpilogue);
+                return;
+            }
+
+            SMatMulTuneParams const * const pTune = matmul_tune_get(m, n, k);
+            SMatMulMicroKernel const * pMicroKernel = (pTune->szMicroKernel[0] != '\0') ? matmul_micro_kernel_find(pTune->szMicroKernel) : 0;
+            if(!pMicroKernel)
+            {
+                pMicroKernel = matmul_micro_kernel_get();
+            }
+
+            TIdx const MR = pMicroKernel->uiMR;
+            TIdx const NR = pMicroKernel->uiNR;
+            TIdx const KC = pTune->uiPackedKC;
+            TIdx const NC = (pTune->uiPackedNC<NR) ? NR : (pTune->uiPackedNC/NR)*NR;
+
+            // There should be at least one row block per thread.
+            TIdx const uiNumThreads = (TIdx)omp_get_max_threads();
+            TIdx const uiRowsPerThread = (((m+uiNumThreads-1)/uiNumThreads+MR-1)/MR)*MR;
+            TIdx const uiTunedMC = (pTune->uiPackedMC<MR) ? MR : (pTune->uiPackedMC/MR)*MR;
+            TIdx const MC = (uiRowsPerThread<uiTunedMC) ? uiRowsPerThread : uiTunedMC;
+
+            // If the epilogue stores the result into pOut, C must not receive the partial sums of the leading panels along k.
+            if(pEpilogue && (pEpilogue->eOutput != EMatMulEpilogueOutputC) && (k > KC))
+            {
+                matmul_gemm_par_packed_omp2_accumulated(m, n, k, MC, KC, NC, pMicroKernel, alpha, A, lda, pPrologueA, B, ldb, pPrologueB, beta, C, ldc, pEpilogue);
+                return;
+            }
+
+            int const iNumRowBlocks = (int)((m+MC-1)/MC);
+
+            TIdx const uiMaxMc = (m<MC) ? m : MC;
+            TIdx const uiMaxKc = (k<KC) ? k : KC;
+            TIdx const uiMaxNc = (n<NC) ? n : NC;
+            TElem * const pPackedB = (TElem *)matmul_arr_aligned_alloc_internal(((uiMaxNc+NR-1)/NR)*NR*uiMaxKc*sizeof(TElem));
+
+            #pragma omp parallel
+            {
+    #ifdef MATMUL_OMP_PRINT_NUM_CORES
+                #pragma omp single
+                {
+                    printf(" p=%d ", omp_get_num_threads());
+                }
+    #endif
+                TElem * const pPackedA = (TElem *)matmul_arr_aligned_alloc_internal(((uiMaxMc+MR-1)/MR)*MR*uiMaxKc*sizeof(TElem));
+
+                // The tile the micro-kernel writes into at the bottom and right edges of C and for the epilogue.
+                TElem AB[MATMUL_MICRO_KERNEL_MAX_MR*MATMUL_MICRO_KERNEL_MAX_NR];
+
+                // 5th loop: Column blocks of C and B.
+                for(TIdx jc = 0; jc < n; jc += NC)
+                {
+                    TIdx const nc = ((n-jc)<NC) ? (n-jc) : NC;
+                    int const iNumMicroPanelsB = (int)((nc+NR-1)/NR);
+
+                    // 4th loop: Panels along the k dimension.
+                    for(TIdx pc = 0; pc < k; pc += KC)
+                    {
+                        TIdx const kc = ((k-pc)<KC) ? (k-pc) : KC;
+                        // C is only scaled by beta when adding the first panel and only finished when adding the last one.
+                        TElem const betaPanel = (pc == 0) ? beta : (TElem)1;
+                        SMatMulEpilogue const * const pEpiloguePanel = ((pc+kc) == k) ? pEpilogue : 0;
+
+                        // The micro-panels of the shared panel of B are packed by all threads. The implicit barrier completes it before it is used.
+                        int iMicroPanelB;
+                        #pragma omp for schedule(static)
+                        for(iMicroPanelB = 0; iMicroPanelB < iNumMicroPanelsB; ++iMicroPanelB)
+                        {
+                            TIdx const jr = (TIdx)iMicroPanelB*NR;
+                            TIdx const nr = ((nc-jr)<NR) ? (nc-jr) : NR;
+                            matmul_pack_b_seq_prologue(kc, nr, NR, &B[pc*ldb + jc + jr], ldb, 1, pPrologueB, pc, jc+jr, &pPackedB[jr*kc]);
+                        }
+
+                        // 3rd loop: Row blocks of C and A. The implicit barrier keeps the panel of B until all threads are done with it.
+                        int iRowBlock;
+                        #pragma omp for schedule(static)
+                        for(iRowBlock = 0; iRowBlock < iNumRowBlocks; ++iRowBlock)
+                        {
+                            TIdx const ic = (TIdx)iRowBlock*MC;
+                            TIdx const mc = ((m-ic)<MC) ? (m-ic) : MC;
+
+                            matmul_pack_a_seq_prologue(mc, kc, MR, &A[ic*lda + pc], lda, 1, pPrologueA, ic, pc, pPackedA);
+
+                            matmul_gemm_par_packed_omp2_row_block(mc, nc, kc, pMicroKernel, alpha, pPackedA, pPackedB, betaPanel, &C[ic*ldc + jc], ldc, pEpiloguePanel, ic, jc, AB);
+                        }
+                    }
+                }
+
+                matmul_arr_aligned_free_internal(pPackedA);
+            }
+
+            matmul_arr_aligned_free_internal(pPackedB);
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_packed_omp2_epilogue(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+            SMatMulEpilogue const * const pEpilogue)
+        {
+            matmul_gemm_par_packed_omp2_fused(m, n, k, alpha, A, lda, 0, B, ldb, 0, beta, C, ldc, pEpilogue);
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_packed_omp2(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            matmul_gemm_par_packed_omp2_epilogue(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, 0);
+        }
+    #endif
+#endif
@@ -18,12 +18,12 @@
 
     #include <matmul/par/Omp.h>         // matmul_gemm_par_omp2_guided_schedule
 
-    #include <matmul/common/Alloc.h>    // matmul_arr_alloc
-    #include <matmul/common/Array.h>    // matmul_arr_alloc_fill_zero
+    #include <matmul/common/Alloc.h>    // matmul_arr_alloc, matmul_arr_free
     #include <matmul/common/Mat.h>      // matmul_mat_gemm_early_out
+    #include <matmul/common/Tune.h>     // matmul_tune_get
 
     #include <assert.h>                 // assert
-    #include <stdio.h>                  // printf
+    #include <stdbool.h>                // bool
 
     #include <omp.h>
 
@@ -56,9 +56,10 @@
         //-----------------------------------------------------------------------------
         //
         //-----------------------------------------------------------------------------
-        void matmul_mat_add2_pitch_par_omp2(
+        void matmul_mat_sub_pitch_par_omp2(
             TIdx const m, TIdx const n,
             TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
             TElem * const MATMUL_RESTRICT C, TIdx const ldc)
         {
         #if _OPENMP < 200805    // For OpenMP < 3.0 you have to declare the loop index outside of the loop header.
@@ -73,17 +74,20 @@
             {
                 for(TIdx j = 0; j < n; ++j)
                 {
-                    C[i*ldc + j] += A[i*lda + j];
+                    C[i*ldc + j] = A[i*lda + j] - B[i*ldb + j];
                 }
             }
         }
+
         //-----------------------------------------------------------------------------
         //
         //-----------------------------------------------------------------------------
-        void matmul_mat_sub_pitch_par_omp2(
+        void matmul_mat_add_sum_pitch_par_omp2(
             TIdx const m, TIdx const n,
             TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const fSign,
             TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            bool const bOverwrite,
             TElem * const MATMUL_RESTRICT C, TIdx const ldc)
         {
         #if _OPENMP < 200805    // For OpenMP < 3.0 you have to declare the loop index outside of the loop header.
@@ -96,9 +100,19 @@
             for(TIdx i = 0; i < m; ++i)
         #endif
             {
-                for(TIdx j = 0; j < n; ++j)
+                if(bOverwrite)
                 {
-                    C[i*ldc + j] = A[i*lda + j] - B[i*ldb + j];
+                    for(TIdx j = 0; j < n; ++j)
+                    {
+                        C[i*ldc + j] = A[i*lda + j] + fSign * B[i*ldb + j];
+                    }
+                }
+                else
+                {
+                    for(TIdx j = 0; j < n; ++j)
+                    {
+                        C[i*ldc + j] += A[i*lda + j] + fSign * B[i*ldb + j];
+                    }
                 }
             }
         }
@@ -106,164 +120,284 @@
         //-----------------------------------------------------------------------------
         //
         //-----------------------------------------------------------------------------
-        void matmul_gemm_par_strassen_omp2(
-            TIdx const m, TIdx const n, TIdx const k,
-            TElem const alpha,
-            TElem const * const MATMUL_RESTRICT X, TIdx const lda,
-            TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+        bool matmul_gemm_par_strassen_omp2_is_leaf(
+            TIdx const uiCutOff,
+            TIdx const m, TIdx const n, TIdx const k)
+        {
+            TIdx const uiMinSize = (m<n) ? ((m<k) ? m : k) : ((n<k) ? n : k);
+            return (uiMinSize <= uiCutOff) || (uiMinSize < 2);
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_scale(
+            TIdx const m, TIdx const n,
             TElem const beta,
-            TElem * const MATMUL_RESTRICT Z, TIdx const ldc)
+            bool const bSet,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc)
         {
-            if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+            if((beta == (TElem)1) || ((beta == (TElem)0) && !bSet))
             {
                 return;
             }
 
-            // Apply beta multiplication to C.
-            if(beta != (TElem)1)
-            {
         #if _OPENMP < 200805    // For OpenMP < 3.0 you have to declare the loop index outside of the loop header.
-                int iM = (int)m;
-                int i;
-                #pragma omp parallel for
-                for(i = 0; i < iM; ++i)
+            int iM = (int)m;
+            int i;
+            #pragma omp parallel for
+            for(i = 0; i < iM; ++i)
         #else
-                #pragma omp parallel for
-                for(TIdx i = 0; i < m; ++i)
+            #pragma omp parallel for
+            for(TIdx i = 0; i < m; ++i)
         #endif
+            {
+                for(TIdx j = 0; j < n; ++j)
                 {
-                    for(TIdx j = 0; j < n; ++j)
+                    C[i*ldc + j] = (beta == (TElem)0) ? (TElem)0 : beta * C[i*ldc + j];
+                }
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_leaf(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            matmul_gemm_par_strassen_omp2_scale(m, n, beta, true, C, ldc);
+            matmul_gemm_par_omp2_static_schedule(m, n, k, alpha, A, lda, B, ldb, (TElem)1, C, ldc);
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_row(
+            TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT a,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT c)
+        {
+            TIdx const uiBlockSize = 64;
+            int const iNumBlocks = (int)((n+uiBlockSize-1)/uiBlockSize);
+            int iBlock;
+            #pragma omp parallel for schedule(static)
+            for(iBlock = 0; iBlock < iNumBlocks; ++iBlock)
+            {
+                TIdx const uiBegin = (TIdx)iBlock*uiBlockSize;
+                TIdx const uiEnd = ((n-uiBegin)<uiBlockSize) ? n : uiBegin+uiBlockSize;
+                for(TIdx j = uiBegin; j < uiEnd; ++j)
+                {
+                    c[j] = (beta == (TElem)0) ? (TElem)0 : beta * c[j];
+                }
+                for(TIdx p = 0; p < k; ++p)
+                {
+                    TElem const fA = alpha * a[p];
+                    for(TIdx j = uiBegin; j < uiEnd; ++j)
                     {
-                        Z[i*ldc + j] *= beta;
+                        c[j] += fA * B[p*ldb + j];
                     }
                 }
             }
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_peel(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            TIdx const m2 = m - (m % 2);
+            TIdx const n2 = n - (n % 2);
+            TIdx const k2 = k - (k % 2);
+
+            if(k2 < k)
+            {
+                matmul_gemm_par_omp2_static_schedule(m2, n2, k-k2, alpha, A + k2, lda, B + k2*ldb, ldb, (TElem)1, C, ldc);
+            }
+            if(n2 < n)
+            {
+                matmul_gemm_par_strassen_omp2_leaf(m2, n-n2, k, alpha, A, lda, B + n2, ldb, beta, C + n2, ldc);
+            }
+            if(m2 < m)
+            {
+                matmul_gemm_par_strassen_omp2_row(n, k, alpha, A + m2*lda, B, ldb, beta, C + m2*ldc);
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        TIdx matmul_gemm_par_strassen_omp2_workspace_size(
+            TIdx const uiCutOff,
+            TIdx const m, TIdx const n, TIdx const k)
+        {
+            // The recursion ends at the same sizes as in matmul_gemm_par_strassen_omp2_workspace.
+            if(matmul_gemm_par_strassen_omp2_is_leaf(uiCutOff, m, n, k))
+            {
+                return 0;
+            }
+
+            TIdx const hm = m/2;
+            TIdx const hn = n/2;
+            TIdx const hk = k/2;
+            return 7*hm*hn + hm*hk + hk*hn + matmul_gemm_par_strassen_omp2_workspace_size(uiCutOff, hm, hn, hk);
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_workspace(
+            TIdx const uiCutOff,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT Z, TIdx const ldc,
+            TElem * const MATMUL_RESTRICT pWorkspace)
+        {
+            if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+            {
+                return;
+            }
 
             // Recursive base case.
             // If the matrices are smaller then the cutoff size we just use the conventional algorithm.
-            if((n % 2 == 1) || (n <= MATMUL_STRASSEN_OMP_CUT_OFF))
+            if((alpha == (TElem)0) || matmul_gemm_par_strassen_omp2_is_leaf(uiCutOff, m, n, k))
             {
-                matmul_gemm_par_omp2_static_schedule(m, n, k, alpha, X, lda, Y, ldb, (TElem)1, Z, ldc);
+                matmul_gemm_par_strassen_omp2_leaf(m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc);
+                return;
             }
-            else
+
+            TIdx const hm = m/2;            // size of sub-matrices
+            TIdx const hn = n/2;
+            TIdx const hk = k/2;
+
+            // Apply beta multiplication to the even sized part of C. For beta == 0 its quadrants are written directly without reading them.
+            matmul_gemm_par_strassen_omp2_scale(2*hm, 2*hn, beta, false, Z, ldc);
+
+            TElem const * const A = X;      // A-D matrices embedded in X
+            TElem const * const B = X + hk;
+            TElem const * const C = X + hm*lda;
+            TElem const * const D = C + hk;
+
+            TElem const * const E = Y;      // E-H matrices embeded in Y
+            TElem const * const F = Y + hn;
+            TElem const * const G = Y + hk*ldb;
+            TElem const * const H = G + hn;
+
+            // Take the temporary matrices from the workspace. The rest of it is used by the recursive calls.
+            // T holds the sums of the quadrants of X, U the ones of Y.
+            TIdx const uiNumElements = hm * hn;
+            TElem * P[7];
+            for(TIdx i = 0; i < 7; ++i)
             {
-                // \TODO: Implement for non square matrices?
-                if(m!=n || m!=k)
-                {
-                    printf("[GEMM Strassen OpenMP] Invalid matrix size! The matrices have to be square for the MPI Cannon GEMM.\n");
-                    return;
-                }
+                P[i] = pWorkspace + i*uiNumElements;
+            }
+            TElem * const T = pWorkspace + 7*uiNumElements;
+            TElem * const U = T + hm*hk;
+            TElem * const pWorkspaceRec = U + hk*hn;
 
-                TIdx const h = n/2;             // size of sub-matrices
+            // P0 = A*(F - H);
+            matmul_mat_sub_pitch_par_omp2(hk, hn, F, ldb, H, ldb, U, hn);
+            matmul_gemm_par_strassen_omp2_workspace(uiCutOff, hm, hn, hk, alpha, A, lda, U, hn, (TElem)0, P[0], hn, pWorkspaceRec);
 
-                TElem const * const A = X;      // A-D matrices embedded in X
-                TElem const * const B = X + h;
-                TElem const * const C = X + h*lda;
-                TElem const * const D = C + h;
+            // P1 = (A + B)*H
+            matmul_mat_add_pitch_par_omp2(hm, hk, A, lda, B, lda, T, hk);
+            matmul_gemm_par_strassen_omp2_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, H, ldb, (TElem)0, P[1], hn, pWorkspaceRec);
 
-                TElem const * const E = Y;      // E-H matrices embeded in Y
-                TElem const * const F = Y + h;
-                TElem const * const G = Y + h*ldb;
-                TElem const * const H = G + h;
+            // P2 = (C + D)*E
+            matmul_mat_add_pitch_par_omp2(hm, hk, C, lda, D, lda, T, hk);
+            matmul_gemm_par_strassen_omp2_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, E, ldb, (TElem)0, P[2], hn, pWorkspaceRec);
 
-                // Allocate temporary matrices.
-                TIdx const uiNumElements = h * h;
-                TElem * P[7];
-                for(TIdx i = 0; i < 7; ++i)
-                {
-                    P[i] = matmul_arr_alloc_fill_zero(uiNumElements);
-                }
-                TElem * const T = matmul_arr_alloc(uiNumElements);
-                TElem * const U = matmul_arr_alloc(uiNumElements);
+            // P3 = D*(G - E);
+            matmul_mat_sub_pitch_par_omp2(hk, hn, G, ldb, E, ldb, U, hn);
+            matmul_gemm_par_strassen_omp2_workspace(uiCutOff, hm, hn, hk, alpha, D, lda, U, hn, (TElem)0, P[3], hn, pWorkspaceRec);
 
-                //#pragma omp parallel sections    // Parallel sections decrease the performance!
-                {
-                    //#pragma omp section
-                    {
-                        // P0 = A*(F - H);
-                        matmul_mat_sub_pitch_par_omp2(h, h, F, ldb, H, ldb, T, h);
-                        matmul_gemm_par_strassen_omp2(h, h, h, alpha, A, lda, T, h, (TElem)1, P[0], h);
-                    }
-                    //#pragma omp section
-                    {
-                        // P1 = (A + B)*H
-                        matmul_mat_add_pitch_par_omp2(h, h, A, lda, B, lda, T, h);
-                        matmul_gemm_par_strassen_omp2(h, h, h, alpha, T, h, H, ldb, (TElem)1, P[1], h);
-                    }
-                    //#pragma omp section
-                    {
-                        // P2 = (C + D)*E
-                        matmul_mat_add_pitch_par_omp2(h, h, C, lda, D, lda, T, h);
-                        matmul_gemm_par_strassen_omp2(h, h, h, alpha, T, h, E, ldb, (TElem)1, P[2], h);
-                    }
-                    //#pragma omp section
-                    {
-                        // P3 = D*(G - E);
-                        matmul_mat_sub_pitch_par_omp2(h, h, G, ldb, E, ldb, T, h);
-                        matmul_gemm_par_strassen_omp2(h, h, h, alpha, D, lda, T, h, (TElem)1, P[3], h);
-                    }
-                    //#pragma omp section
-                    {
-                        // P4 = (A + D)*(E + H)
-                        matmul_mat_add_pitch_par_omp2(h, h, A, lda, D, lda, T, h);
-                        matmul_mat_add_pitch_par_omp2(h, h, E, ldb, H, ldb, U, h);
-                        matmul_gemm_par_strassen_omp2(h, h, h, alpha, T, h, U, h, (TElem)1, P[4], h);
-                    }
-                    //#pragma omp section
-                    {
-                        // P5 = (B - D)*(G + H)
-                        matmul_mat_sub_pitch_par_omp2(h, h, B, lda, D, lda, T, h);
-                        matmul_mat_add_pitch_par_omp2(h, h, G, ldb, H, ldb, U, h);
-                        matmul_gemm_par_strassen_omp2(h, h, h, alpha, T, h, U, h, (TElem)1, P[5], h);
-                    }
-                    //#pragma omp section
-                    {
-                        // P6 = (A - C)*(E + F)
-                        matmul_mat_sub_pitch_par_omp2(h, h, A, lda, C, lda, T, h);
-                        matmul_mat_add_pitch_par_omp2(h, h, E, ldb, F, ldb, U, h);
-                        matmul_gemm_par_strassen_omp2(h, h, h, alpha, T, h, U, h, (TElem)1, P[6], h);
-                    }
-                }
+            // P4 = (A + D)*(E + H)
+            matmul_mat_add_pitch_par_omp2(hm, hk, A, lda, D, lda, T, hk);
+            matmul_mat_add_pitch_par_omp2(hk, hn, E, ldb, H, ldb, U, hn);
+            matmul_gemm_par_strassen_omp2_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, U, hn, (TElem)0, P[4], hn, pWorkspaceRec);
 
-                //#pragma omp parallel sections
-                {
-                    //#pragma omp section
-                    // Z upper left = (P3 + P4) + (P5 - P1)
-                    matmul_mat_add_pitch_par_omp2(h, h, P[4], h, P[3], h, T, h);
-                    //#pragma omp section
-                    matmul_mat_sub_pitch_par_omp2(h, h, P[5], h, P[1], h, U, h);
-                }
-                TElem * const V = P[5];    // P[5] is only used once, so we reuse it as temporary buffer.
-                matmul_mat_add_pitch_par_omp2(h, h, T, h, U, h, V, h);
-                matmul_mat_add2_pitch_par_omp2(h, h, V, h, Z, ldc);
+            // P5 = (B - D)*(G + H)
+            matmul_mat_sub_pitch_par_omp2(hm, hk, B, lda, D, lda, T, hk);
+            matmul_mat_add_pitch_par_omp2(hk, hn, G, ldb, H, ldb, U, hn);
+            matmul_gemm_par_strassen_omp2_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, U, hn, (TElem)0, P[5], hn, pWorkspaceRec);
 
-                // Z lower left = P2 + P3
-                matmul_mat_add_pitch_par_omp2(h, h, P[2], h, P[3], h, V, h);
-                matmul_mat_add2_pitch_par_omp2(h, h, V, h, Z + h*ldc, ldc);
+            // P6 = (A - C)*(E + F)
+            matmul_mat_sub_pitch_par_omp2(hm, hk, A, lda, C, lda, T, hk);
+            matmul_mat_add_pitch_par_omp2(hk, hn, E, ldb, F, ldb, U, hn);
+            matmul_gemm_par_strassen_omp2_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, U, hn, (TElem)0, P[6], hn, pWorkspaceRec);
 
-                // Z upper right = P0 + P1
-                matmul_mat_add_pitch_par_omp2(h, h, P[0], h, P[1], h, V, h);
-                matmul_mat_add2_pitch_par_omp2(h, h, V, h, Z + h, ldc);
+            bool const bOverwrite = (beta == (TElem)0);
 
-                //#pragma omp parallel sections
-                {
-                    //#pragma omp section
-                    // Z lower right = (P0 + P4) - (P2 + P6)
-                    matmul_mat_add_pitch_par_omp2(h, h, P[0], h, P[4], h, T, h);
-                    //#pragma omp section
-                    matmul_mat_add_pitch_par_omp2(h, h, P[2], h, P[6], h, U, h);
-                }
-                matmul_mat_add_pitch_par_omp2(h, h, T, h, U, h, V, h);
-                matmul_mat_add2_pitch_par_omp2(h, h, V, h, Z + h*(ldc + 1), ldc);
+            // Z upper left = (P3 + P4) + (P5 - P1)
+            matmul_mat_add_sum_pitch_par_omp2(hm, hn, P[4], hn, (TElem)1, P[3], hn, bOverwrite, Z, ldc);
+            matmul_mat_add_sum_pitch_par_omp2(hm, hn, P[5], hn, (TElem)-1, P[1], hn, false, Z, ldc);
 
-                // Deallocate temporary matrices.
-                matmul_arr_free(U);
-                matmul_arr_free(T);
-                for(TIdx i = 0; i < 7; ++i)
-                {
-                    matmul_arr_free(P[i]);
-                }
+            // Z lower left = P2 + P3
+            matmul_mat_add_sum_pitch_par_omp2(hm, hn, P[2], hn, (TElem)1, P[3], hn, bOverwrite, Z + hm*ldc, ldc);
+
+            // Z upper right = P0 + P1
+            matmul_mat_add_sum_pitch_par_omp2(hm, hn, P[0], hn, (TElem)1, P[1], hn, bOverwrite, Z + hn, ldc);
+
+            // Z lower right = (P0 - P2) + (P4 - P6)
+            matmul_mat_add_sum_pitch_par_omp2(hm, hn, P[0], hn, (TElem)-1, P[2], hn, bOverwrite, Z + hm*ldc + hn, ldc);
+            matmul_mat_add_sum_pitch_par_omp2(hm, hn, P[4], hn, (TElem)-1, P[6], hn, false, Z + hm*ldc + hn, ldc);
+
+            matmul_gemm_par_strassen_omp2_peel(m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc);
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2_cut_off(
+            TIdx const uiCutOff,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT Z, TIdx const ldc)
+        {
+            // The workspace for all recursion levels is allocated at once.
+            TIdx const uiNumElementsWorkspace = matmul_gemm_par_strassen_omp2_workspace_size(uiCutOff, m, n, k);
+            TElem * const pWorkspace = (uiNumElementsWorkspace > 0) ? matmul_arr_alloc(uiNumElementsWorkspace) : 0;
+
+            matmul_gemm_par_strassen_omp2_workspace(uiCutOff, m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc, pWorkspace);
+
+            if(pWorkspace)
+            {
+                matmul_arr_free(pWorkspace);
             }
         }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp2(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT Z, TIdx const ldc)
+        {
+            // The cut-off is looked up once for the whole problem so that all recursion levels use the one tuned for its shape class.
+            matmul_gemm_par_strassen_omp2_cut_off(matmul_tune_get(m, n, k)->uiStrassenOmpCutOff, m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc);
+        }
     #endif
 #endif
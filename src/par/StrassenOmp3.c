@@ -0,0 +1,342 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_PAR_STRASSEN_OMP3
+
+    #include <matmul/par/StrassenOmp3.h>
+
+    #include <matmul/seq/Strassen.h>        // matmul_gemm_seq_strassen_workspace, matmul_gemm_seq_strassen_workspace_size, matmul_gemm_seq_strassen_is_leaf, matmul_gemm_seq_strassen_leaf, matmul_mat_add_pitch_seq, matmul_mat_sub_pitch_seq
+    #include <matmul/seq/MultipleOpts.h>    // matmul_gemm_seq_multiple_opts
+
+    #include <matmul/common/Alloc.h>        // matmul_arr_alloc, matmul_arr_free
+    #include <matmul/common/Mat.h>          // matmul_mat_gemm_early_out
+    #include <matmul/common/Tune.h>         // matmul_tune_get
+
+    #include <stdbool.h>                    // bool
+    #include <stdio.h>                      // printf
+
+    #include <omp.h>
+
+    #ifndef MATMUL_STRASSEN_OMP_TASK_DEPTH
+        #define MATMUL_STRASSEN_OMP_TASK_DEPTH 0
+    #endif
+
+    #if _OPENMP >= 200805   // OpenMP 3.0
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        TIdx matmul_gemm_par_strassen_omp3_task_depth(
+            TIdx const uiTaskDepth)
+        {
+            if(uiTaskDepth > 0)
+            {
+                return uiTaskDepth;
+            }
+
+            TIdx const uiNumThreads = (TIdx)omp_get_max_threads();
+            TIdx uiDepth = 1;
+            for(TIdx uiNumTasks = 7; uiNumTasks < 2*uiNumThreads; uiNumTasks *= 7)
+            {
+                ++uiDepth;
+            }
+            return uiDepth;
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3_combine(
+            TIdx const m, TIdx const n,
+            TElem const * const MATMUL_RESTRICT P0,
+            TElem const fSign0,
+            TElem const * const MATMUL_RESTRICT P1,
+            TElem const * const MATMUL_RESTRICT P2,
+            TElem const fSign1,
+            TElem const * const MATMUL_RESTRICT P3,
+            TIdx const ldp,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            for(TIdx i = 0; i < m; ++i)
+            {
+                for(TIdx j = 0; j < n; ++j)
+                {
+                    TElem fSum = P0[i*ldp + j] + fSign0 * P1[i*ldp + j];
+                    if(P2)
+                    {
+                        fSum += P2[i*ldp + j] + fSign1 * P3[i*ldp + j];
+                    }
+                    C[i*ldc + j] = (beta == (TElem)0) ? fSum : beta * C[i*ldc + j] + fSum;
+                }
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        TIdx matmul_gemm_par_strassen_omp3_workspace_size_depth(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k)
+        {
+            if(uiTaskDepth == 0)
+            {
+                return matmul_gemm_seq_strassen_workspace_size(uiCutOff, m, n, k);
+            }
+            if(matmul_gemm_seq_strassen_is_leaf(uiCutOff, m, n, k))
+            {
+                return 0;
+            }
+
+            TIdx const hm = m/2;
+            TIdx const hn = n/2;
+            TIdx const hk = k/2;
+            return 7*(hm*hn + hm*hk + hk*hn + matmul_gemm_par_strassen_omp3_workspace_size_depth(uiCutOff, uiTaskDepth-1, hm, hn, hk));
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3_task(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT Z, TIdx const ldc,
+            TElem * const MATMUL_RESTRICT pWorkspace)
+        {
+            // Below the task depth and at the leaves the task computes its product alone.
+            if((uiTaskDepth == 0) || (alpha == (TElem)0) || matmul_gemm_seq_strassen_is_leaf(uiCutOff, m, n, k))
+            {
+                matmul_gemm_seq_strassen_workspace(uiCutOff, m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc, pWorkspace);
+                return;
+            }
+
+            TIdx const hm = m/2;            // size of sub-matrices
+            TIdx const hn = n/2;
+            TIdx const hk = k/2;
+            TIdx const m2 = 2*hm;
+            TIdx const n2 = 2*hn;
+            TIdx const k2 = 2*hk;
+
+            TElem const * const A = X;      // A-D matrices embedded in X
+            TElem const * const B = X + hk;
+            TElem const * const C = X + hm*lda;
+            TElem const * const D = C + hk;
+
+            TElem const * const E = Y;      // E-H matrices embeded in Y
+            TElem const * const F = Y + hn;
+            TElem const * const G = Y + hk*ldb;
+            TElem const * const H = G + hn;
+
+            // The products are followed by the parts of the workspace of the seven tasks.
+            // Each one holds the sum of quadrants of X (T) and of Y (U) and the workspace of the levels below.
+            TIdx const uiNumElements = hm * hn;
+            TIdx const uiNumElementsTask = hm*hk + hk*hn + matmul_gemm_par_strassen_omp3_workspace_size_depth(uiCutOff, uiTaskDepth-1, hm, hn, hk);
+            TElem * P[7];
+            TElem * T[7];
+            TElem * U[7];
+            TElem * W[7];
+            for(TIdx i = 0; i < 7; ++i)
+            {
+                P[i] = pWorkspace + i*uiNumElements;
+                T[i] = pWorkspace + 7*uiNumElements + i*uiNumElementsTask;
+                U[i] = T[i] + hm*hk;
+                W[i] = U[i] + hk*hn;
+            }
+
+            // P0 = A*(F - H);
+            #pragma omp task
+            {
+                matmul_mat_sub_pitch_seq(hk, hn, F, ldb, H, ldb, U[0], hn);
+                matmul_gemm_par_strassen_omp3_task(uiCutOff, uiTaskDepth-1, hm, hn, hk, alpha, A, lda, U[0], hn, (TElem)0, P[0], hn, W[0]);
+            }
+            // P1 = (A + B)*H
+            #pragma omp task
+            {
+                matmul_mat_add_pitch_seq(hm, hk, A, lda, B, lda, T[1], hk);
+                matmul_gemm_par_strassen_omp3_task(uiCutOff, uiTaskDepth-1, hm, hn, hk, alpha, T[1], hk, H, ldb, (TElem)0, P[1], hn, W[1]);
+            }
+            // P2 = (C + D)*E
+            #pragma omp task
+            {
+                matmul_mat_add_pitch_seq(hm, hk, C, lda, D, lda, T[2], hk);
+                matmul_gemm_par_strassen_omp3_task(uiCutOff, uiTaskDepth-1, hm, hn, hk, alpha, T[2], hk, E, ldb, (TElem)0, P[2], hn, W[2]);
+            }
+            // P3 = D*(G - E);
+            #pragma omp task
+            {
+                matmul_mat_sub_pitch_seq(hk, hn, G, ldb, E, ldb, U[3], hn);
+                matmul_gemm_par_strassen_omp3_task(uiCutOff, uiTaskDepth-1, hm, hn, hk, alpha, D, lda, U[3], hn, (TElem)0, P[3], hn, W[3]);
+            }
+            // P4 = (A + D)*(E + H)
+            #pragma omp task
+            {
+                matmul_mat_add_pitch_seq(hm, hk, A, lda, D, lda, T[4], hk);
+                matmul_mat_add_pitch_seq(hk, hn, E, ldb, H, ldb, U[4], hn);
+                matmul_gemm_par_strassen_omp3_task(uiCutOff, uiTaskDepth-1, hm, hn, hk, alpha, T[4], hk, U[4], hn, (TElem)0, P[4], hn, W[4]);
+            }
+            // P5 = (B - D)*(G + H)
+            #pragma omp task
+            {
+                matmul_mat_sub_pitch_seq(hm, hk, B, lda, D, lda, T[5], hk);
+                matmul_mat_add_pitch_seq(hk, hn, G, ldb, H, ldb, U[5], hn);
+                matmul_gemm_par_strassen_omp3_task(uiCutOff, uiTaskDepth-1, hm, hn, hk, alpha, T[5], hk, U[5], hn, (TElem)0, P[5], hn, W[5]);
+            }
+            // P6 = (A - C)*(E + F)
+            #pragma omp task
+            {
+                matmul_mat_sub_pitch_seq(hm, hk, A, lda, C, lda, T[6], hk);
+                matmul_mat_add_pitch_seq(hk, hn, E, ldb, F, ldb, U[6], hn);
+                matmul_gemm_par_strassen_omp3_task(uiCutOff, uiTaskDepth-1, hm, hn, hk, alpha, T[6], hk, U[6], hn, (TElem)0, P[6], hn, W[6]);
+            }
+
+            // The peeled last column and row of Z do not depend on the products.
+            if(n2 < n)
+            {
+                #pragma omp task
+                matmul_gemm_seq_strassen_leaf(m2, n-n2, k, alpha, X, lda, Y + n2, ldb, beta, Z + n2, ldc);
+            }
+            if(m2 < m)
+            {
+                #pragma omp task
+                matmul_gemm_seq_strassen_leaf(m-m2, n, k, alpha, X + m2*lda, lda, Y, ldb, beta, Z + m2*ldc, ldc);
+            }
+
+            #pragma omp taskwait
+
+            // The quadrants of Z are combined independently. For odd k each one gets its part of the rank-1 update.
+            TElem const * const pRank1A = X + k2;
+            TElem const * const pRank1B = Y + k2*ldb;
+
+            // Z upper left = (P3 + P4) + (P5 - P1)
+            #pragma omp task
+            {
+                matmul_gemm_par_strassen_omp3_combine(hm, hn, P[4], (TElem)1, P[3], P[5], (TElem)-1, P[1], hn, beta, Z, ldc);
+                matmul_gemm_seq_multiple_opts(hm, hn, k-k2, alpha, pRank1A, lda, pRank1B, ldb, (TElem)1, Z, ldc);
+            }
+            // Z lower left = P2 + P3
+            #pragma omp task
+            {
+                matmul_gemm_par_strassen_omp3_combine(hm, hn, P[2], (TElem)1, P[3], 0, (TElem)0, 0, hn, beta, Z + hm*ldc, ldc);
+                matmul_gemm_seq_multiple_opts(hm, hn, k-k2, alpha, pRank1A + hm*lda, lda, pRank1B, ldb, (TElem)1, Z + hm*ldc, ldc);
+            }
+            // Z upper right = P0 + P1
+            #pragma omp task
+            {
+                matmul_gemm_par_strassen_omp3_combine(hm, hn, P[0], (TElem)1, P[1], 0, (TElem)0, 0, hn, beta, Z + hn, ldc);
+                matmul_gemm_seq_multiple_opts(hm, hn, k-k2, alpha, pRank1A, lda, pRank1B + hn, ldb, (TElem)1, Z + hn, ldc);
+            }
+            // Z lower right = (P0 - P2) + (P4 - P6)
+            #pragma omp task
+            {
+                matmul_gemm_par_strassen_omp3_combine(hm, hn, P[0], (TElem)-1, P[2], P[4], (TElem)-1, P[6], hn, beta, Z + hm*ldc + hn, ldc);
+                matmul_gemm_seq_multiple_opts(hm, hn, k-k2, alpha, pRank1A + hm*lda, lda, pRank1B + hn, ldb, (TElem)1, Z + hm*ldc + hn, ldc);
+            }
+
+            #pragma omp taskwait
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        TIdx matmul_gemm_par_strassen_omp3_workspace_size(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k)
+        {
+            return matmul_gemm_par_strassen_omp3_workspace_size_depth(uiCutOff, matmul_gemm_par_strassen_omp3_task_depth(uiTaskDepth), m, n, k);
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3_workspace(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT Z, TIdx const ldc,
+            TElem * const MATMUL_RESTRICT pWorkspace)
+        {
+            if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+            {
+                return;
+            }
+
+            TIdx const uiTaskDepthUsed = matmul_gemm_par_strassen_omp3_task_depth(uiTaskDepth);
+
+            // A single fork for the whole recursion. One thread creates the tasks of the top level, the tasks create the ones below.
+            #pragma omp parallel
+            {
+    #ifdef MATMUL_OMP_PRINT_NUM_CORES
+                #pragma omp single
+                {
+                    printf(" p=%d ", omp_get_num_threads());
+                }
+    #endif
+                #pragma omp single
+                {
+                    matmul_gemm_par_strassen_omp3_task(uiCutOff, uiTaskDepthUsed, m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc, pWorkspace);
+                }
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3_cut_off(
+            TIdx const uiCutOff,
+            TIdx const uiTaskDepth,
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT Z, TIdx const ldc)
+        {
+            // The workspace for all recursion levels and tasks is allocated at once.
+            TIdx const uiTaskDepthUsed = matmul_gemm_par_strassen_omp3_task_depth(uiTaskDepth);
+            TIdx const uiNumElementsWorkspace = matmul_gemm_par_strassen_omp3_workspace_size(uiCutOff, uiTaskDepthUsed, m, n, k);
+            TElem * const pWorkspace = (uiNumElementsWorkspace > 0) ? matmul_arr_alloc(uiNumElementsWorkspace) : 0;
+
+            matmul_gemm_par_strassen_omp3_workspace(uiCutOff, uiTaskDepthUsed, m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc, pWorkspace);
+
+            if(pWorkspace)
+            {
+                matmul_arr_free(pWorkspace);
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_gemm_par_strassen_omp3(
+            TIdx const m, TIdx const n, TIdx const k,
+            TElem const alpha,
+            TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+            TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+            TElem const beta,
+            TElem * const MATMUL_RESTRICT Z, TIdx const ldc)
+        {
+            matmul_gemm_par_strassen_omp3_cut_off(matmul_tune_get(m, n, k)->uiStrassenCutOff, MATMUL_STRASSEN_OMP_TASK_DEPTH, m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc);
+        }
+    #endif
+#endif
@@ -0,0 +1,374 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_PAR_TILED
+
+    #include <matmul/par/Tiled.h>
+
+    #include <matmul/common/Alloc.h>        // matmul_arr_free
+    #include <matmul/common/Array.h>        // matmul_arr_alloc_fill_zero
+    #include <matmul/common/Mat.h>          // matmul_mat_copy_block_transposed, matmul_mat_gemm_early_out
+
+    #include <stdint.h>                     // uint64_t
+    #include <stdio.h>                      // printf
+    #include <stdlib.h>                     // malloc, free, qsort
+    #include <string.h>                     // memcpy, memset
+
+    //-----------------------------------------------------------------------------
+    //! A tile and its position in the Morton order.
+    //-----------------------------------------------------------------------------
+    typedef struct SMatMulTiledMortonTile
+    {
+        uint64_t uiCode;        //!< The Morton code of the tile coordinates.
+        TIdx uiTileIdx;         //!< The row major index of the tile in the tile grid.
+    } SMatMulTiledMortonTile;
+
+    //-----------------------------------------------------------------------------
+    //! \return The Morton code interleaving the bits of the column (even bits) and the row (odd bits).
+    //-----------------------------------------------------------------------------
+    uint64_t matmul_tiled_morton_code(
+        TIdx const uiTileRow, TIdx const uiTileCol)
+    {
+        uint64_t uiCode = 0;
+        for(unsigned int uiBit = 0; uiBit < 32; ++uiBit)
+        {
+            uiCode |= (((uint64_t)uiTileCol >> uiBit) & 1u) << (2*uiBit);
+            uiCode |= (((uint64_t)uiTileRow >> uiBit) & 1u) << (2*uiBit + 1);
+        }
+        return uiCode;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Orders the tiles by their Morton code.
+    //-----------------------------------------------------------------------------
+    int matmul_tiled_morton_tile_cmp(
+        void const * pLhs,
+        void const * pRhs)
+    {
+        uint64_t const uiLhs = ((SMatMulTiledMortonTile const *)pLhs)->uiCode;
+        uint64_t const uiRhs = ((SMatMulTiledMortonTile const *)pRhs)->uiCode;
+        return (uiLhs < uiRhs) ? -1 : ((uiLhs > uiRhs) ? 1 : 0);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    bool matmul_tiled_mat_alloc(
+        SMatMulTiledMat * const pMat,
+        TIdx const m, TIdx const n,
+        TIdx const b)
+    {
+        pMat->m = m;
+        pMat->n = n;
+        pMat->b = b;
+        pMat->uiTileRows = (b > 0) ? (m + b - 1) / b : 0;
+        pMat->uiTileCols = (b > 0) ? (n + b - 1) / b : 0;
+        pMat->puiTileOffsets = 0;
+        pMat->pData = 0;
+
+        TIdx const uiNumTiles = pMat->uiTileRows * pMat->uiTileCols;
+        if(uiNumTiles == 0)
+        {
+            return (b > 0);
+        }
+
+        // The offsets are the ranks of the tiles sorted by their Morton code.
+        // Sorting instead of enumerating the codes skips the holes of tile grids which are not square powers of two.
+        SMatMulTiledMortonTile * const pOrder = (SMatMulTiledMortonTile *)malloc(sizeof(SMatMulTiledMortonTile) * uiNumTiles);
+        pMat->puiTileOffsets = (TIdx *)malloc(sizeof(TIdx) * uiNumTiles);
+        pMat->pData = matmul_arr_alloc_fill_zero(uiNumTiles * b * b);
+        if(!pOrder || !pMat->puiTileOffsets || !pMat->pData)
+        {
+            printf("[Tiled] Allocation of a %"MATMUL_PRINTF_SIZE_T"x%"MATMUL_PRINTF_SIZE_T" matrix with %"MATMUL_PRINTF_SIZE_T"x%"MATMUL_PRINTF_SIZE_T" tiles failed!\n", (size_t)m, (size_t)n, (size_t)b, (size_t)b);
+            free(pOrder);
+            matmul_tiled_mat_free(pMat);
+            return false;
+        }
+
+        for(TIdx i = 0; i < uiNumTiles; ++i)
+        {
+            pOrder[i].uiCode = matmul_tiled_morton_code(i / pMat->uiTileCols, i % pMat->uiTileCols);
+            pOrder[i].uiTileIdx = i;
+        }
+        qsort(pOrder, uiNumTiles, sizeof(SMatMulTiledMortonTile), matmul_tiled_morton_tile_cmp);
+        for(TIdx i = 0; i < uiNumTiles; ++i)
+        {
+            pMat->puiTileOffsets[pOrder[i].uiTileIdx] = i * b * b;
+        }
+
+        free(pOrder);
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_tiled_mat_free(
+        SMatMulTiledMat * const pMat)
+    {
+        free(pMat->puiTileOffsets);
+        pMat->puiTileOffsets = 0;
+        if(pMat->pData)
+        {
+            matmul_arr_free(pMat->pData);
+            pMat->pData = 0;
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    TElem * matmul_tiled_mat_get_tile(
+        SMatMulTiledMat const * const pMat,
+        TIdx const uiTileRow, TIdx const uiTileCol)
+    {
+        return pMat->pData + pMat->puiTileOffsets[uiTileRow * pMat->uiTileCols + uiTileCol];
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_tiled_mat_from_mat(
+        TElem const * const MATMUL_RESTRICT pSrcMat, TIdx const lds, EMatMulLayout const eSrcLayout,
+        SMatMulTiledMat * const pDstMat)
+    {
+        TIdx const b = pDstMat->b;
+
+        int const iNumTiles = (int)(pDstMat->uiTileRows * pDstMat->uiTileCols);
+        int t;
+        #pragma omp parallel for schedule(static)
+        for(t = 0; t < iNumTiles; ++t)
+        {
+            TIdx const uiTileRow = (TIdx)t / pDstMat->uiTileCols;
+            TIdx const uiTileCol = (TIdx)t % pDstMat->uiTileCols;
+            TIdx const uiRow = uiTileRow * b;
+            TIdx const uiCol = uiTileCol * b;
+            TIdx const uiRows = ((pDstMat->m - uiRow) < b) ? (pDstMat->m - uiRow) : b;
+            TIdx const uiCols = ((pDstMat->n - uiCol) < b) ? (pDstMat->n - uiCol) : b;
+            TElem * const MATMUL_RESTRICT pTile = matmul_tiled_mat_get_tile(pDstMat, uiTileRow, uiTileCol);
+
+            if(eSrcLayout == EMatMulLayoutRowMajor)
+            {
+                for(TIdx i = 0; i < uiRows; ++i)
+                {
+                    memcpy(pTile + i*b, pSrcMat + (uiRow + i)*lds + uiCol, sizeof(TElem)*uiCols);
+                }
+            }
+            else
+            {
+                // The tile is the transpose of the block of the row major view of the column major matrix.
+                matmul_mat_copy_block_transposed(uiCols, uiRows, pSrcMat, lds, uiCol, uiRow, pTile, b, 0, 0);
+            }
+
+            // Padding.
+            if(uiCols < b)
+            {
+                for(TIdx i = 0; i < uiRows; ++i)
+                {
+                    memset(pTile + i*b + uiCols, 0, sizeof(TElem)*(b - uiCols));
+                }
+            }
+            if(uiRows < b)
+            {
+                memset(pTile + uiRows*b, 0, sizeof(TElem)*(b - uiRows)*b);
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_tiled_mat_to_mat(
+        SMatMulTiledMat const * const pSrcMat,
+        TElem * const MATMUL_RESTRICT pDstMat, TIdx const ldd, EMatMulLayout const eDstLayout)
+    {
+        TIdx const b = pSrcMat->b;
+
+        int const iNumTiles = (int)(pSrcMat->uiTileRows * pSrcMat->uiTileCols);
+        int t;
+        #pragma omp parallel for schedule(static)
+        for(t = 0; t < iNumTiles; ++t)
+        {
+            TIdx const uiTileRow = (TIdx)t / pSrcMat->uiTileCols;
+            TIdx const uiTileCol = (TIdx)t % pSrcMat->uiTileCols;
+            TIdx const uiRow = uiTileRow * b;
+            TIdx const uiCol = uiTileCol * b;
+            TIdx const uiRows = ((pSrcMat->m - uiRow) < b) ? (pSrcMat->m - uiRow) : b;
+            TIdx const uiCols = ((pSrcMat->n - uiCol) < b) ? (pSrcMat->n - uiCol) : b;
+            TElem const * const MATMUL_RESTRICT pTile = matmul_tiled_mat_get_tile(pSrcMat, uiTileRow, uiTileCol);
+
+            if(eDstLayout == EMatMulLayoutRowMajor)
+            {
+                for(TIdx i = 0; i < uiRows; ++i)
+                {
+                    memcpy(pDstMat + (uiRow + i)*ldd + uiCol, pTile + i*b, sizeof(TElem)*uiCols);
+                }
+            }
+            else
+            {
+                matmul_mat_copy_block_transposed(uiRows, uiCols, pTile, b, 0, 0, pDstMat, ldd, uiCol, uiRow);
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! C += alpha * A * B for b x b row major tiles. Four rows of C are updated at once so that each loaded element of B is used four times.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_tiled_tile(
+        TIdx const b,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A,
+        TElem const * const MATMUL_RESTRICT B,
+        TElem * const MATMUL_RESTRICT C)
+    {
+        TIdx i = 0;
+        for(; i + 4 <= b; i += 4)
+        {
+            TElem * const MATMUL_RESTRICT C0 = C + i*b;
+            TElem * const MATMUL_RESTRICT C1 = C0 + b;
+            TElem * const MATMUL_RESTRICT C2 = C1 + b;
+            TElem * const MATMUL_RESTRICT C3 = C2 + b;
+            for(TIdx k2 = 0; k2 < b; ++k2)
+            {
+                TElem const a0 = alpha * A[i*b + k2];
+                TElem const a1 = alpha * A[(i+1)*b + k2];
+                TElem const a2 = alpha * A[(i+2)*b + k2];
+                TElem const a3 = alpha * A[(i+3)*b + k2];
+                TElem const * const MATMUL_RESTRICT pB = B + k2*b;
+                for(TIdx j = 0; j < b; ++j)
+                {
+                    TElem const bj = pB[j];
+                    C0[j] += a0 * bj;
+                    C1[j] += a1 * bj;
+                    C2[j] += a2 * bj;
+                    C3[j] += a3 * bj;
+                }
+            }
+        }
+        for(; i < b; ++i)
+        {
+            TElem * const MATMUL_RESTRICT C0 = C + i*b;
+            for(TIdx k2 = 0; k2 < b; ++k2)
+            {
+                TElem const a0 = alpha * A[i*b + k2];
+                TElem const * const MATMUL_RESTRICT pB = B + k2*b;
+                for(TIdx j = 0; j < b; ++j)
+                {
+                    C0[j] += a0 * pB[j];
+                }
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_tiled(
+        TElem const alpha,
+        SMatMulTiledMat const * const A,
+        SMatMulTiledMat const * const B,
+        TElem const beta,
+        SMatMulTiledMat * const C)
+    {
+        if((A->b != C->b) || (B->b != C->b) || (A->m != C->m) || (B->n != C->n) || (A->n != B->m))
+        {
+            printf("[GEMM Tiled] Invalid matrices! A (%"MATMUL_PRINTF_SIZE_T"x%"MATMUL_PRINTF_SIZE_T") * B (%"MATMUL_PRINTF_SIZE_T"x%"MATMUL_PRINTF_SIZE_T") does not fit C (%"MATMUL_PRINTF_SIZE_T"x%"MATMUL_PRINTF_SIZE_T") or the tile sizes differ.\n",
+                (size_t)A->m, (size_t)A->n, (size_t)B->m, (size_t)B->n, (size_t)C->m, (size_t)C->n);
+            return;
+        }
+        if(matmul_mat_gemm_early_out(C->m, C->n, A->n, alpha, beta))
+        {
+            return;
+        }
+
+        TIdx const b = C->b;
+        TIdx const uiNumElements = b * b;
+        TIdx const uiTileDepth = A->uiTileCols;
+
+        int const iNumTiles = (int)(C->uiTileRows * C->uiTileCols);
+        int t;
+        #pragma omp parallel for schedule(static)
+        for(t = 0; t < iNumTiles; ++t)
+        {
+            TIdx const uiTileRow = (TIdx)t / C->uiTileCols;
+            TIdx const uiTileCol = (TIdx)t % C->uiTileCols;
+            TElem * const MATMUL_RESTRICT pC = matmul_tiled_mat_get_tile(C, uiTileRow, uiTileCol);
+
+            // With beta == 0 the old values of C are ignored, even NaN. The whole tile including the padding is scaled.
+            if(beta == (TElem)0)
+            {
+                memset(pC, 0, sizeof(TElem)*uiNumElements);
+            }
+            else if(beta != (TElem)1)
+            {
+                for(TIdx i = 0; i < uiNumElements; ++i)
+                {
+                    pC[i] *= beta;
+                }
+            }
+
+            // The padding of A and B is zero so the full tiles can be multiplied.
+            for(TIdx uiTileK = 0; uiTileK < uiTileDepth; ++uiTileK)
+            {
+                matmul_gemm_par_tiled_tile(
+                    b,
+                    alpha,
+                    matmul_tiled_mat_get_tile(A, uiTileRow, uiTileK),
+                    matmul_tiled_mat_get_tile(B, uiTileK, uiTileCol),
+                    pC);
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_par_tiled_row_major(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        {
+            return;
+        }
+
+        SMatMulTiledMat tiledA, tiledB, tiledC;
+        bool const bAllocA = matmul_tiled_mat_alloc(&tiledA, m, k, MATMUL_TILED_TILE_SIZE);
+        bool const bAllocB = matmul_tiled_mat_alloc(&tiledB, k, n, MATMUL_TILED_TILE_SIZE);
+        bool const bAllocC = matmul_tiled_mat_alloc(&tiledC, m, n, MATMUL_TILED_TILE_SIZE);
+        if(bAllocA && bAllocB && bAllocC)
+        {
+            matmul_tiled_mat_from_mat(A, lda, EMatMulLayoutRowMajor, &tiledA);
+            matmul_tiled_mat_from_mat(B, ldb, EMatMulLayoutRowMajor, &tiledB);
+            // C only has to be read if it contributes to the result.
+            if(beta != (TElem)0)
+            {
+                matmul_tiled_mat_from_mat(C, ldc, EMatMulLayoutRowMajor, &tiledC);
+            }
+
+            matmul_gemm_par_tiled(alpha, &tiledA, &tiledB, beta, &tiledC);
+
+            matmul_tiled_mat_to_mat(&tiledC, C, ldc, EMatMulLayoutRowMajor);
+        }
+
+        matmul_tiled_mat_free(&tiledC);
+        matmul_tiled_mat_free(&tiledB);
+        matmul_tiled_mat_free(&tiledA);
+    }
+#endif
@@ -0,0 +1,251 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_AUTOTUNE
+
+    #include <matmul/seq/Autotune.h>
+
+    #include <matmul/seq/SingleOpts.h>      // matmul_gemm_seq_block
+    #include <matmul/seq/MultipleOpts.h>    // matmul_gemm_seq_multiple_opts_block
+    #include <matmul/seq/Packed.h>          // matmul_gemm_seq_packed
+    #include <matmul/seq/MicroKernel.h>     // matmul_micro_kernel_find
+    #include <matmul/seq/Strassen.h>        // matmul_gemm_seq_strassen
+    #include <matmul/par/StrassenOmp2.h>    // matmul_gemm_par_strassen_omp2
+
+    #include <matmul/common/Alloc.h>        // matmul_arr_free
+    #include <matmul/common/Array.h>        // matmul_arr_alloc_fill_rand
+    #include <matmul/common/Cpu.h>          // matmul_cpu_get_time_sec
+
+    #include <float.h>                      // DBL_MAX
+    #include <string.h>                     // strcpy
+
+    //-----------------------------------------------------------------------------
+    //! The minimum time in seconds of a single timing sample. Smaller problems are called multiple times per sample so that the timer resolution does not decide.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_AUTOTUNE_MIN_SAMPLE_SEC 0.001
+    //-----------------------------------------------------------------------------
+    //! The maximum number of calls per timing sample. This bounds the calibration if the timer does not advance.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_AUTOTUNE_MAX_SAMPLE_CALLS 65536
+    //-----------------------------------------------------------------------------
+    //! Problems with a smaller dimension are not tuned. Their run time is dominated by the call overhead so the differences between the candidates are noise.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_AUTOTUNE_MIN_SIZE 32
+    //-----------------------------------------------------------------------------
+    //! The smallest Strassen cut-off candidate.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_AUTOTUNE_MIN_STRASSEN_CUT_OFF 16
+
+    //-----------------------------------------------------------------------------
+    //! The signature shared by all tuned GEMMs.
+    //-----------------------------------------------------------------------------
+    typedef void(*TMatMulAutotuneGemm)(TIdx const, TIdx const, TIdx const, TElem const, TElem const * const, TIdx const, TElem const * const, TIdx const, TElem const, TElem * const, TIdx const);
+
+    //-----------------------------------------------------------------------------
+    //! \param puiCallsPerSample The number of calls per timing sample. It is doubled until a sample takes at least MATMUL_AUTOTUNE_MIN_SAMPLE_SEC and kept for the following candidates.
+    //! \return The fastest time in seconds of a single call of the GEMM using the given parameters.
+    //-----------------------------------------------------------------------------
+    double matmul_autotune_measure(
+        TMatMulAutotuneGemm const pGemm,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const * const A,
+        TElem const * const B,
+        TElem * const C,
+        TIdx const uiRepeatCount,
+        TIdx * const puiCallsPerSample,
+        SMatMulTuneParams const * const pParams)
+    {
+        // The implementations read the parameters from the tuning database.
+        matmul_tune_set(m, n, k, pParams);
+
+        double fTimeMinSec = DBL_MAX;
+        for(TIdx i = 0; i < uiRepeatCount; ++i)
+        {
+            double fTimeElapsed;
+            for(;;)
+            {
+                double const fTimeStart = matmul_cpu_get_time_sec();
+                for(TIdx j = 0; j < *puiCallsPerSample; ++j)
+                {
+                    pGemm(m, n, k, (TElem)1, A, k, B, n, (TElem)1, C, n);
+                }
+                fTimeElapsed = matmul_cpu_get_time_sec() - fTimeStart;
+
+                if((fTimeElapsed >= MATMUL_AUTOTUNE_MIN_SAMPLE_SEC) || (*puiCallsPerSample >= MATMUL_AUTOTUNE_MAX_SAMPLE_CALLS))
+                {
+                    break;
+                }
+                *puiCallsPerSample *= 2;
+            }
+            fTimeElapsed /= (double)*puiCallsPerSample;
+            fTimeMinSec = (fTimeElapsed < fTimeMinSec) ? fTimeElapsed : fTimeMinSec;
+        }
+
+        return fTimeMinSec;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Sets the parameter pointed to by puiParam, which is a member of *pParams, to the fastest of the candidates and its current value.
+    //!
+    //! \param uiMaxValue The dimension the parameter blocks. All values not smaller than it result in a single block so larger candidates are skipped and the current value is clamped to it.
+    //-----------------------------------------------------------------------------
+    void matmul_autotune_search(
+        TMatMulAutotuneGemm const pGemm,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const * const A,
+        TElem const * const B,
+        TElem * const C,
+        TIdx const uiRepeatCount,
+        TIdx * const puiCallsPerSample,
+        SMatMulTuneParams * const pParams,
+        TIdx * const puiParam,
+        TIdx const uiMaxValue,
+        TIdx const * const auiCandidates,
+        TIdx const uiNumCandidates)
+    {
+        *puiParam = (*puiParam > uiMaxValue) ? uiMaxValue : *puiParam;
+        TIdx uiBest = *puiParam;
+        double fBestSec = matmul_autotune_measure(pGemm, m, n, k, A, B, C, uiRepeatCount, puiCallsPerSample, pParams);
+
+        for(TIdx i = 0; i < uiNumCandidates; ++i)
+        {
+            if((auiCandidates[i] != uiBest) && (auiCandidates[i] <= uiMaxValue))
+            {
+                *puiParam = auiCandidates[i];
+                double const fTimeSec = matmul_autotune_measure(pGemm, m, n, k, A, B, C, uiRepeatCount, puiCallsPerSample, pParams);
+                if(fTimeSec < fBestSec)
+                {
+                    fBestSec = fTimeSec;
+                    uiBest = auiCandidates[i];
+                }
+            }
+        }
+
+        *puiParam = uiBest;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Fills the Strassen cut-off candidates. Each one stops the recursion at a different depth, the first one does not recurse at all.
+    //! The recursion is not continued below MATMUL_AUTOTUNE_MIN_STRASSEN_CUT_OFF.
+    //!
+    //! \param uiMinSize The smallest of m, n and k. The recursion halves all of them and ends as soon as one is not larger than the cut-off.
+    //! \return The number of candidates.
+    //-----------------------------------------------------------------------------
+    TIdx matmul_autotune_strassen_cut_offs(
+        TIdx const uiMinSize,
+        TIdx * const auiCandidates,
+        TIdx const uiMaxNumCandidates)
+    {
+        TIdx uiNumCandidates = 0;
+        for(TIdx uiCutOff = uiMinSize; (uiCutOff >= MATMUL_AUTOTUNE_MIN_STRASSEN_CUT_OFF) && (uiNumCandidates < uiMaxNumCandidates); uiCutOff /= 2)
+        {
+            auiCandidates[uiNumCandidates] = uiCutOff;
+            ++uiNumCandidates;
+        }
+        return uiNumCandidates;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    SMatMulTuneParams matmul_autotune_seq(
+        TIdx const m, TIdx const n, TIdx const k,
+        TIdx const uiRepeatCount)
+    {
+        SMatMulTuneParams params = *matmul_tune_get(m, n, k);
+
+        TIdx const uiMinSize = (m<n) ? ((m<k) ? m : k) : ((n<k) ? n : k);
+        if((uiMinSize < MATMUL_AUTOTUNE_MIN_SIZE) || (uiRepeatCount == 0))
+        {
+            return params;
+        }
+
+        TIdx uiCallsPerSample = 1;
+
+        TElem const * const A = matmul_arr_alloc_fill_rand(m*k, (TElem)0, (TElem)1);
+        TElem const * const B = matmul_arr_alloc_fill_rand(k*n, (TElem)0, (TElem)1);
+        TElem * const C = matmul_arr_alloc_fill_rand(m*n, (TElem)0, (TElem)1);
+
+    #if defined(MATMUL_BUILD_SEQ_MULTIPLE_OPTS_BLOCK) || defined(MATMUL_BUILD_SEQ_SINGLE_OPTS)
+        {
+        #ifdef MATMUL_BUILD_SEQ_MULTIPLE_OPTS_BLOCK
+            TMatMulAutotuneGemm const pGemm = matmul_gemm_seq_multiple_opts_block;
+        #else
+            TMatMulAutotuneGemm const pGemm = matmul_gemm_seq_block;
+        #endif
+            // The cache derived defaults are the starting point, the innermost level is searched first.
+            static TIdx const auiNCs[] = {64, 128, 256, 512, 1024, 2048, 4096};
+            matmul_autotune_search(pGemm, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params, &params.uiSeqBlockNC, n, auiNCs, (TIdx)(sizeof(auiNCs)/sizeof(auiNCs[0])));
+            static TIdx const auiKCs[] = {16, 32, 64, 128, 256, 512};
+            matmul_autotune_search(pGemm, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params, &params.uiSeqBlockKC, k, auiKCs, (TIdx)(sizeof(auiKCs)/sizeof(auiKCs[0])));
+            static TIdx const auiMCs[] = {32, 64, 128, 256, 512, 1024, 2048};
+            matmul_autotune_search(pGemm, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params, &params.uiSeqBlockMC, m, auiMCs, (TIdx)(sizeof(auiMCs)/sizeof(auiMCs[0])));
+        }
+    #endif
+
+    #ifdef MATMUL_BUILD_SEQ_PACKED
+        {
+            TMatMulAutotuneGemm const pGemm = matmul_gemm_seq_packed;
+
+            // The micro-kernel determines the tile size so it is chosen before the blocking.
+            static char const * const apszMicroKernels[] = {"generic", "sse42", "avx2", "avx512"};
+            char szBest[MATMUL_TUNE_MICRO_KERNEL_NAME_SIZE];
+            strcpy(szBest, params.szMicroKernel);
+            double fBestSec = matmul_autotune_measure(pGemm, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params);
+            for(TIdx i = 0; i < (TIdx)(sizeof(apszMicroKernels)/sizeof(apszMicroKernels[0])); ++i)
+            {
+                if(matmul_micro_kernel_find(apszMicroKernels[i]))
+                {
+                    strcpy(params.szMicroKernel, apszMicroKernels[i]);
+                    double const fTimeSec = matmul_autotune_measure(pGemm, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params);
+                    if(fTimeSec < fBestSec)
+                    {
+                        fBestSec = fTimeSec;
+                        strcpy(szBest, apszMicroKernels[i]);
+                    }
+                }
+            }
+            strcpy(params.szMicroKernel, szBest);
+
+            static TIdx const auiKCs[] = {128, 192, 256, 320, 384, 512};
+            matmul_autotune_search(pGemm, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params, &params.uiPackedKC, k, auiKCs, (TIdx)(sizeof(auiKCs)/sizeof(auiKCs[0])));
+            static TIdx const auiMCs[] = {48, 72, 96, 144, 192, 288, 384};
+            matmul_autotune_search(pGemm, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params, &params.uiPackedMC, m, auiMCs, (TIdx)(sizeof(auiMCs)/sizeof(auiMCs[0])));
+            static TIdx const auiNCs[] = {512, 1024, 2048, 4096, 8192};
+            matmul_autotune_search(pGemm, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params, &params.uiPackedNC, n, auiNCs, (TIdx)(sizeof(auiNCs)/sizeof(auiNCs[0])));
+        }
+    #endif
+
+    #if defined(MATMUL_BUILD_SEQ_STRASSEN) || (defined(MATMUL_BUILD_PAR_STRASSEN_OMP2) && (_OPENMP >= 200203))
+        {
+            TIdx auiCutOffs[64];
+            TIdx const uiNumCutOffs = matmul_autotune_strassen_cut_offs(uiMinSize, auiCutOffs, (TIdx)(sizeof(auiCutOffs)/sizeof(auiCutOffs[0])));
+        #ifdef MATMUL_BUILD_SEQ_STRASSEN
+            matmul_autotune_search(matmul_gemm_seq_strassen, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params, &params.uiStrassenCutOff, uiMinSize, auiCutOffs, uiNumCutOffs);
+        #endif
+        #if defined(MATMUL_BUILD_PAR_STRASSEN_OMP2) && (_OPENMP >= 200203)
+            matmul_autotune_search(matmul_gemm_par_strassen_omp2, m, n, k, A, B, C, uiRepeatCount, &uiCallsPerSample, &params, &params.uiStrassenOmpCutOff, uiMinSize, auiCutOffs, uiNumCutOffs);
+        #endif
+        }
+    #endif
+
+        matmul_tune_set(m, n, k, &params);
+
+        matmul_arr_free((TElem *)A);
+        matmul_arr_free((TElem *)B);
+        matmul_arr_free(C);
+
+        return params;
+    }
+#endif
@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_COMPLEX
+
+    #include <matmul/seq/Complex.h>
+
+    #include <matmul/seq/Packed.h>      // matmul_gemm_seq_packed_strided_s, matmul_gemm_seq_packed_strided_d
+    #include <matmul/common/Alloc.h>    // matmul_arr_aligned_alloc_internal, matmul_arr_aligned_free_internal
+
+    #include <stdbool.h>                // bool
+    #include <stdio.h>                  // printf
+
+    //-----------------------------------------------------------------------------
+    // The instantiations for single and double precision.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_COMPLEX_T float
+    #define MATMUL_COMPLEX_TYPE SMatMulComplexS
+    #define MATMUL_COMPLEX_PREFIX c
+    #define MATMUL_COMPLEX_REAL_GEMM matmul_gemm_seq_packed_strided_s
+    #include <matmul/seq/ComplexTemplate.h>
+
+    #define MATMUL_COMPLEX_T double
+    #define MATMUL_COMPLEX_TYPE SMatMulComplexD
+    #define MATMUL_COMPLEX_PREFIX z
+    #define MATMUL_COMPLEX_REAL_GEMM matmul_gemm_seq_packed_strided_d
+    #include <matmul/seq/ComplexTemplate.h>
+
+    //-----------------------------------------------------------------------------
+    // The TElem versions forward to the instantiation of the configured element type.
+    //-----------------------------------------------------------------------------
+    #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        #define MATMUL_COMPLEX_TELEM(name) matmul_z##name
+    #else
+        #define MATMUL_COMPLEX_TELEM(name) matmul_c##name
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_complex(
+        TIdx const m, TIdx const n, TIdx const k,
+        TMatMulComplex const alpha,
+        TMatMulComplex const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulComplex const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TMatMulComplex const beta,
+        TMatMulComplex * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        MATMUL_COMPLEX_TELEM(gemm_seq)(EMatMulComplexAlgoAuto, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_complex_4m(
+        TIdx const m, TIdx const n, TIdx const k,
+        TMatMulComplex const alpha,
+        TMatMulComplex const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulComplex const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TMatMulComplex const beta,
+        TMatMulComplex * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        MATMUL_COMPLEX_TELEM(gemm_seq)(EMatMulComplexAlgo4M, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_complex_3m(
+        TIdx const m, TIdx const n, TIdx const k,
+        TMatMulComplex const alpha,
+        TMatMulComplex const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulComplex const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TMatMulComplex const beta,
+        TMatMulComplex * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        MATMUL_COMPLEX_TELEM(gemm_seq)(EMatMulComplexAlgo3M, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_complex_basic(
+        TIdx const m, TIdx const n, TIdx const k,
+        TMatMulComplex const alpha,
+        TMatMulComplex const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulComplex const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TMatMulComplex const beta,
+        TMatMulComplex * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        MATMUL_COMPLEX_TELEM(gemm_seq_basic)(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+#endif
@@ -0,0 +1,166 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_PACKED
+
+    #include <matmul/seq/Epilogue.h>
+
+    #include <matmul/seq/MicroKernel.h> // MATMUL_MICRO_KERNEL_MAX_NR
+    #include <matmul/common/Half.h>     // matmul_float_to_bf16, matmul_float_to_fp16
+
+    #include <math.h>                   // tanh, tanhf
+
+    //-----------------------------------------------------------------------------
+    // Finishes one row of a tile into DST with the activation ACT(x) in a single loop.
+    // The loop is duplicated for beta being zero because C must not be read then.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_EPILOGUE_ROW(T, DST, ACT)\
+    if(beta == (T)0)\
+    {\
+        for(TIdx j = 0; j < nr; ++j)\
+        {\
+            T const x = pAB[j] + fRowBias + pColBias[j];\
+            DST[j] = fScale * (ACT);\
+        }\
+    }\
+    else\
+    {\
+        for(TIdx j = 0; j < nr; ++j)\
+        {\
+            T const x = beta * pC[j] + pAB[j] + fRowBias + pColBias[j];\
+            DST[j] = fScale * (ACT);\
+        }\
+    }
+
+    //-----------------------------------------------------------------------------
+    // Finishes one row of a tile into DST with the activation of the epilogue.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_EPILOGUE_ROW_ACTIVATION(T, DST, TANH)\
+    switch(pEpilogue->eActivation)\
+    {\
+    case EMatMulEpilogueActivationRelu:\
+        MATMUL_EPILOGUE_ROW(T, DST, (x > (T)0) ? x : (T)0)\
+        break;\
+    case EMatMulEpilogueActivationGelu:\
+        MATMUL_EPILOGUE_ROW(T, DST, (T)0.5 * x * ((T)1 + TANH((T)0.7978845608028654 * (x + (T)0.044715 * x * x * x))))\
+        break;\
+    case EMatMulEpilogueActivationClamp:\
+        MATMUL_EPILOGUE_ROW(T, DST, (x < fClampMin) ? fClampMin : ((x > fClampMax) ? fClampMax : x))\
+        break;\
+    default:\
+        MATMUL_EPILOGUE_ROW(T, DST, x)\
+        break;\
+    }
+
+    //-----------------------------------------------------------------------------
+    // The initialization and the tile function for the element type T.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_EPILOGUE(T, SUFFIX, DESC, TANH)\
+    void matmul_epilogue_init_##SUFFIX(\
+        DESC * const pEpilogue)\
+    {\
+        pEpilogue->eBias = EMatMulEpilogueBiasNone;\
+        pEpilogue->pBias = 0;\
+        pEpilogue->eActivation = EMatMulEpilogueActivationNone;\
+        pEpilogue->fClampMin = (T)0;\
+        pEpilogue->fClampMax = (T)0;\
+        pEpilogue->fScale = (T)1;\
+        pEpilogue->eOutput = EMatMulEpilogueOutputC;\
+        pEpilogue->pOut = 0;\
+        pEpilogue->ldo = 0;\
+    }\
+\
+    void matmul_epilogue_apply_tile_##SUFFIX(\
+        DESC const * const pEpilogue,\
+        TIdx const row, TIdx const col,\
+        TIdx const mr, TIdx const nr,\
+        T const * const MATMUL_RESTRICT AB, TIdx const ldab,\
+        T const beta,\
+        T * const MATMUL_RESTRICT C, TIdx const ldc)\
+    {\
+        /* Without a column bias zeros are added so that the loops do not depend on the kind of the bias. */\
+        static T const aZeros[MATMUL_MICRO_KERNEL_MAX_NR] = {(T)0};\
+        T const * const MATMUL_RESTRICT pColBias = (pEpilogue->eBias == EMatMulEpilogueBiasCol) ? &pEpilogue->pBias[col] : aZeros;\
+        T const fClampMin = pEpilogue->fClampMin;\
+        T const fClampMax = pEpilogue->fClampMax;\
+        T const fScale = pEpilogue->fScale;\
+\
+        /* The row of the result if it is converted before it is stored. */\
+        T aV[MATMUL_MICRO_KERNEL_MAX_NR];\
+\
+        for(TIdx i = 0; i < mr; ++i)\
+        {\
+            T const * const MATMUL_RESTRICT pAB = &AB[i*ldab];\
+            T * const MATMUL_RESTRICT pC = &C[i*ldc];\
+            T const fRowBias = (pEpilogue->eBias == EMatMulEpilogueBiasRow) ? pEpilogue->pBias[row + i] : (T)0;\
+\
+            if(pEpilogue->eOutput == EMatMulEpilogueOutputBf16)\
+            {\
+                MATMUL_EPILOGUE_ROW_ACTIVATION(T, aV, TANH)\
+                TMatMulBf16 * const pOut = (TMatMulBf16 *)pEpilogue->pOut + (row+i)*pEpilogue->ldo + col;\
+                for(TIdx j = 0; j < nr; ++j)\
+                {\
+                    pOut[j] = matmul_float_to_bf16((float)aV[j]);\
+                }\
+            }\
+            else if(pEpilogue->eOutput == EMatMulEpilogueOutputFp16)\
+            {\
+                MATMUL_EPILOGUE_ROW_ACTIVATION(T, aV, TANH)\
+                TMatMulFp16 * const pOut = (TMatMulFp16 *)pEpilogue->pOut + (row+i)*pEpilogue->ldo + col;\
+                for(TIdx j = 0; j < nr; ++j)\
+                {\
+                    pOut[j] = matmul_float_to_fp16((float)aV[j]);\
+                }\
+            }\
+            else\
+            {\
+                MATMUL_EPILOGUE_ROW_ACTIVATION(T, pC, TANH)\
+            }\
+        }\
+    }
+
+    MATMUL_EPILOGUE(float, s, SMatMulEpilogueS, tanhf)
+    MATMUL_EPILOGUE(double, d, SMatMulEpilogueD, tanh)
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_epilogue_init(
+        SMatMulEpilogue * const pEpilogue)
+    {
+#ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        matmul_epilogue_init_d(pEpilogue);
+#else
+        matmul_epilogue_init_s(pEpilogue);
+#endif
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_epilogue_apply_tile(
+        SMatMulEpilogue const * const pEpilogue,
+        TIdx const row, TIdx const col,
+        TIdx const mr, TIdx const nr,
+        TElem const * const MATMUL_RESTRICT AB, TIdx const ldab,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+#ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        matmul_epilogue_apply_tile_d(pEpilogue, row, col, mr, nr, AB, ldab, beta, C, ldc);
+#else
+        matmul_epilogue_apply_tile_s(pEpilogue, row, col, mr, nr, AB, ldab, beta, C, ldc);
+#endif
+    }
+#endif
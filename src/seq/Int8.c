@@ -0,0 +1,551 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_INT8
+
+    #include <matmul/seq/Int8.h>
+
+    #include <matmul/seq/MicroKernel.h> // matmul_micro_kernel_select
+    #include <matmul/common/Alloc.h>    // matmul_arr_aligned_alloc_internal, matmul_arr_aligned_free_internal
+    #include <matmul/common/Once.h>     // matmul_once, SMatMulOnce
+
+    #include <math.h>                   // floor, lrintf
+    #include <stdio.h>                  // printf
+
+    #define MATMUL_INT8_GENERIC_MR 4
+    #define MATMUL_INT8_GENERIC_NR 8
+
+    #if (MATMUL_INT8_GENERIC_MR > MATMUL_MICRO_KERNEL_INT8_MAX_MR) || (MATMUL_INT8_GENERIC_NR > MATMUL_MICRO_KERNEL_INT8_MAX_NR)
+        #error MATMUL_INT8_GENERIC_MR and MATMUL_INT8_GENERIC_NR must not exceed MATMUL_MICRO_KERNEL_INT8_MAX_MR and MATMUL_MICRO_KERNEL_INT8_MAX_NR!
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_micro_kernel_int8_generic(
+        TIdx const kg,
+        uint8_t const * const MATMUL_RESTRICT pPackedA,
+        int8_t const * const MATMUL_RESTRICT pPackedB,
+        int32_t * const MATMUL_RESTRICT C, TIdx const ldc,
+        bool const bAccumulate)
+    {
+        int32_t AB[MATMUL_INT8_GENERIC_MR*MATMUL_INT8_GENERIC_NR];
+        for(TIdx i = 0; i < MATMUL_INT8_GENERIC_MR*MATMUL_INT8_GENERIC_NR; ++i)
+        {
+            AB[i] = 0;
+        }
+
+        uint8_t const * MATMUL_RESTRICT pA = pPackedA;
+        int8_t const * MATMUL_RESTRICT pB = pPackedB;
+        for(TIdx g = 0; g < kg; ++g)
+        {
+            for(TIdx i = 0; i < MATMUL_INT8_GENERIC_MR; ++i)
+            {
+                for(TIdx j = 0; j < MATMUL_INT8_GENERIC_NR; ++j)
+                {
+                    int32_t iDot = 0;
+                    for(TIdx u = 0; u < MATMUL_INT8_K_GROUP; ++u)
+                    {
+                        iDot += (int32_t)pA[i*MATMUL_INT8_K_GROUP + u] * (int32_t)pB[j*MATMUL_INT8_K_GROUP + u];
+                    }
+                    AB[i*MATMUL_INT8_GENERIC_NR + j] += iDot;
+                }
+            }
+            pA += MATMUL_INT8_GENERIC_MR*MATMUL_INT8_K_GROUP;
+            pB += MATMUL_INT8_GENERIC_NR*MATMUL_INT8_K_GROUP;
+        }
+
+        for(TIdx i = 0; i < MATMUL_INT8_GENERIC_MR; ++i)
+        {
+            for(TIdx j = 0; j < MATMUL_INT8_GENERIC_NR; ++j)
+            {
+                C[i*ldc + j] = bAccumulate ? (C[i*ldc + j] + AB[i*MATMUL_INT8_GENERIC_NR + j]) : AB[i*MATMUL_INT8_GENERIC_NR + j];
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Selects the micro-kernel.
+    //-----------------------------------------------------------------------------
+    void matmul_micro_kernel_int8_init(
+        void * const ppSelected)
+    {
+        // Sorted from the least to the most preferable one.
+        static SMatMulInt8MicroKernel const aMicroKernels[] = {
+            {matmul_micro_kernel_int8_generic, MATMUL_INT8_GENERIC_MR, MATMUL_INT8_GENERIC_NR, "generic"},
+    #ifdef MATMUL_ARCH_X86
+            {matmul_micro_kernel_int8_avx2, 6, 8, "avx2"},
+            {matmul_micro_kernel_int8_avx512vnni, 12, 32, "avx512vnni"},
+    #endif
+        };
+        TIdx const uiNumMicroKernels = (TIdx)(sizeof(aMicroKernels)/sizeof(aMicroKernels[0]));
+
+        char const * apszNames[sizeof(aMicroKernels)/sizeof(aMicroKernels[0])];
+        for(TIdx i = 0; i < uiNumMicroKernels; ++i)
+        {
+            apszNames[i] = aMicroKernels[i].pszName;
+        }
+        *(SMatMulInt8MicroKernel const **)ppSelected = &aMicroKernels[matmul_micro_kernel_select(apszNames, uiNumMicroKernels)];
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    SMatMulInt8MicroKernel const * matmul_micro_kernel_int8_get(void)
+    {
+        static SMatMulInt8MicroKernel const * pSelected = 0;
+        static SMatMulOnce once = MATMUL_ONCE_INIT;
+
+        matmul_once(&once, 1, matmul_micro_kernel_int8_init, (void *)&pSelected);
+
+        return pSelected;
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Packs the mc-by-kc block of A into micro-panels of MR rows interleaving MATMUL_INT8_K_GROUP consecutive values of each row.
+    //! Each value is xor'ed with uiXor. The rows exceeding mc and the columns exceeding kc up to the next full group are zero.
+    //-----------------------------------------------------------------------------
+    void matmul_pack_a_int8_seq(
+        TIdx const mc, TIdx const kc, TIdx const MR,
+        uint8_t const * const MATMUL_RESTRICT A, TIdx const lda,
+        uint8_t const uiXor,
+        uint8_t * const MATMUL_RESTRICT pPackedA)
+    {
+        TIdx const kg = (kc + MATMUL_INT8_K_GROUP - 1) / MATMUL_INT8_K_GROUP;
+
+        uint8_t * MATMUL_RESTRICT pDst = pPackedA;
+        for(TIdx ir = 0; ir < mc; ir += MR)
+        {
+            TIdx const mr = ((mc-ir)<MR) ? (mc-ir) : MR;
+
+            for(TIdx i = 0; i < MR; ++i)
+            {
+                // The padding rows read the first row of the micro-panel so that no pointer beyond A is formed.
+                uint8_t const * const MATMUL_RESTRICT pSrc = A + (ir + ((i < mr) ? i : 0))*lda;
+                for(TIdx g = 0; g < kg; ++g)
+                {
+                    for(TIdx u = 0; u < MATMUL_INT8_K_GROUP; ++u)
+                    {
+                        TIdx const p = g*MATMUL_INT8_K_GROUP + u;
+                        pDst[(g*MR + i)*MATMUL_INT8_K_GROUP + u] = ((i < mr) && (p < kc)) ? (uint8_t)(pSrc[p] ^ uiXor) : (uint8_t)0;
+                    }
+                }
+            }
+
+            pDst += MR*kg*MATMUL_INT8_K_GROUP;
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Packs the kc-by-nc block of B into micro-panels of NR columns interleaving MATMUL_INT8_K_GROUP consecutive values of each column.
+    //! The columns exceeding nc and the rows exceeding kc up to the next full group are zero.
+    //! If pColSums is not 0, the sums of the nc columns of the block are added to it.
+    //-----------------------------------------------------------------------------
+    void matmul_pack_b_int8_seq(
+        TIdx const kc, TIdx const nc, TIdx const NR,
+        int8_t const * const MATMUL_RESTRICT B, TIdx const ldb,
+        int8_t * const MATMUL_RESTRICT pPackedB,
+        int32_t * const MATMUL_RESTRICT pColSums)
+    {
+        TIdx const kg = (kc + MATMUL_INT8_K_GROUP - 1) / MATMUL_INT8_K_GROUP;
+
+        int8_t * MATMUL_RESTRICT pDst = pPackedB;
+        for(TIdx jr = 0; jr < nc; jr += NR)
+        {
+            TIdx const nr = ((nc-jr)<NR) ? (nc-jr) : NR;
+
+            for(TIdx g = 0; g < kg; ++g)
+            {
+                for(TIdx u = 0; u < MATMUL_INT8_K_GROUP; ++u)
+                {
+                    TIdx const p = g*MATMUL_INT8_K_GROUP + u;
+                    int8_t * const MATMUL_RESTRICT pDstRow = pDst + g*NR*MATMUL_INT8_K_GROUP + u;
+                    TIdx const uiNumValid = (p < kc) ? nr : 0;
+                    for(TIdx j = 0; j < uiNumValid; ++j)
+                    {
+                        pDstRow[j*MATMUL_INT8_K_GROUP] = B[p*ldb + jr + j];
+                    }
+                    for(TIdx j = uiNumValid; j < NR; ++j)
+                    {
+                        pDstRow[j*MATMUL_INT8_K_GROUP] = 0;
+                    }
+                }
+            }
+
+            pDst += NR*kg*MATMUL_INT8_K_GROUP;
+        }
+
+        if(pColSums)
+        {
+            for(TIdx p = 0; p < kc; ++p)
+            {
+                for(TIdx j = 0; j < nc; ++j)
+                {
+                    pColSums[j] += B[p*ldb + j];
+                }
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Writes the mr-by-nr accumulators minus the compensation of their column requantized to the tile of C beginning at uiRow, uiCol.
+    //! pCompensation may be 0. pAcc may be the tile of an int32_t C itself.
+    //-----------------------------------------------------------------------------
+    void matmul_int8_store_tile(
+        TIdx const mr, TIdx const nr,
+        int32_t const * const pAcc, TIdx const ldacc,
+        int32_t const * const pCompensation,
+        SMatMulInt8Requant const * const pRequant,
+        TIdx const uiRow, TIdx const uiCol,
+        void * const C, TIdx const ldc)
+    {
+        for(TIdx i = 0; i < mr; ++i)
+        {
+            TIdx const r = uiRow + i;
+            TIdx const uiScaleIdx = pRequant->bPerRow ? r : 0;
+
+            if(pRequant->eOutput == EMatMulInt8OutputS32)
+            {
+                int32_t * const pC = (int32_t *)C + r*ldc + uiCol;
+                for(TIdx j = 0; j < nr; ++j)
+                {
+                    pC[j] = pAcc[i*ldacc + j] - (pCompensation ? pCompensation[j] : 0);
+                }
+            }
+            else if(pRequant->eOutput == EMatMulInt8OutputS8)
+            {
+                float const fScale = pRequant->pScale[uiScaleIdx];
+                int32_t const iZeroPoint = pRequant->pZeroPoint ? pRequant->pZeroPoint[uiScaleIdx] : 0;
+                int8_t * const pC = (int8_t *)C + r*ldc + uiCol;
+                for(TIdx j = 0; j < nr; ++j)
+                {
+                    int32_t const iAcc = pAcc[i*ldacc + j] - (pCompensation ? pCompensation[j] : 0);
+                    // lrintf rounds half to even in the default rounding mode.
+                    long const iVal = lrintf(fScale * (float)iAcc) + iZeroPoint;
+                    pC[j] = (int8_t)((iVal < -128) ? -128 : ((iVal > 127) ? 127 : iVal));
+                }
+            }
+            else
+            {
+                float const fScale = pRequant->pScale[uiScaleIdx];
+                float * const pC = (float *)C + r*ldc + uiCol;
+                for(TIdx j = 0; j < nr; ++j)
+                {
+                    pC[j] = fScale * (float)(pAcc[i*ldacc + j] - (pCompensation ? pCompensation[j] : 0));
+                }
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! The 8 bit integer GEMM C = requant((A ^ uiXorA) * B - iOffsetA * colsum(B)) shared by the u8*s8 and s8*s8 variants.
+    //!
+    //! \return If the buffers could be allocated. Otherwise C is not written.
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_seq_int8_internal(
+        TIdx const m, TIdx const n, TIdx const k,
+        uint8_t const * const MATMUL_RESTRICT A, TIdx const lda, uint8_t const uiXorA, int32_t const iOffsetA,
+        int8_t const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulInt8Requant const * const pRequant,
+        void * const C, TIdx const ldc)
+    {
+        if((m == 0) || (n == 0))
+        {
+            return true;
+        }
+
+        SMatMulInt8Requant const requantS32 = {EMatMulInt8OutputS32, false, 0, 0};
+        SMatMulInt8Requant const * const pReq = pRequant ? pRequant : &requantS32;
+        bool const bOutputS32 = (pReq->eOutput == EMatMulInt8OutputS32);
+
+        SMatMulInt8MicroKernel const * const pMicroKernel = matmul_micro_kernel_int8_get();
+
+        TIdx const MR = pMicroKernel->uiMR;
+        TIdx const NR = pMicroKernel->uiNR;
+        TIdx const MC = (MATMUL_PACKED_MC<MR) ? MR : (MATMUL_PACKED_MC/MR)*MR;
+        // The panels have to consist of full groups so that only the last one is padded.
+        TIdx const KC = ((MATMUL_PACKED_KC + MATMUL_INT8_K_GROUP - 1) / MATMUL_INT8_K_GROUP) * MATMUL_INT8_K_GROUP;
+        TIdx const NC = (MATMUL_PACKED_NC<NR) ? NR : (MATMUL_PACKED_NC/NR)*NR;
+
+        TIdx const uiMaxMc = (m<MC) ? m : MC;
+        TIdx const uiMaxKc = (k<KC) ? k : KC;
+        TIdx const uiMaxNc = (n<NC) ? n : NC;
+        TIdx const uiMaxKcPadded = ((uiMaxKc + MATMUL_INT8_K_GROUP - 1) / MATMUL_INT8_K_GROUP) * MATMUL_INT8_K_GROUP;
+        uint8_t * const pPackedA = (uint8_t *)matmul_arr_aligned_alloc_internal(((uiMaxMc+MR-1)/MR)*MR*uiMaxKcPadded + 1);
+        int8_t * const pPackedB = (int8_t *)matmul_arr_aligned_alloc_internal(((uiMaxNc+NR-1)/NR)*NR*uiMaxKcPadded + 1);
+
+        // The zero point of A times the column sums of B is subtracted once in the epilogue.
+        int32_t * const pCompensation = (iOffsetA != 0) ? (int32_t *)matmul_arr_aligned_alloc_internal(uiMaxNc*sizeof(int32_t)) : 0;
+
+        // Only a C of another type with more than one panel needs a buffer for the accumulators between the panels.
+        bool const bAccBuffer = !bOutputS32 && (k > KC);
+        int32_t * const pAccBuffer = bAccBuffer ? (int32_t *)matmul_arr_aligned_alloc_internal(m*uiMaxNc*sizeof(int32_t)) : 0;
+        TIdx const ldacc = bOutputS32 ? ldc : uiMaxNc;
+        if(!pPackedA || !pPackedB || ((iOffsetA != 0) && !pCompensation) || (bAccBuffer && !pAccBuffer))
+        {
+            printf("[GEMM Int8] The packing buffers could not be allocated!\n");
+            void * const apBuffers[] = {pPackedA, pPackedB, pCompensation, pAccBuffer};
+            for(TIdx i = 0; i < (TIdx)(sizeof(apBuffers)/sizeof(apBuffers[0])); ++i)
+            {
+                if(apBuffers[i])
+                {
+                    matmul_arr_aligned_free_internal(apBuffers[i]);
+                }
+            }
+            return false;
+        }
+
+        // The tile the micro-kernel writes into at the bottom and right edges and for the requantized tiles.
+        int32_t AB[MATMUL_MICRO_KERNEL_INT8_MAX_MR*MATMUL_MICRO_KERNEL_INT8_MAX_NR];
+
+        // Even without any panel (k == 0) one pass is required to write C.
+        TIdx const uiNumPanels = (k == 0) ? 1 : (k + KC - 1) / KC;
+
+        // 5th loop: Column blocks of C and B.
+        for(TIdx jc = 0; jc < n; jc += NC)
+        {
+            TIdx const nc = ((n-jc)<NC) ? (n-jc) : NC;
+
+            if(pCompensation)
+            {
+                for(TIdx j = 0; j < nc; ++j)
+                {
+                    pCompensation[j] = 0;
+                }
+            }
+
+            // 4th loop: Panels along the k dimension.
+            for(TIdx uiPanel = 0; uiPanel < uiNumPanels; ++uiPanel)
+            {
+                TIdx const pc = uiPanel*KC;
+                TIdx const kc = ((k-pc)<KC) ? (k-pc) : KC;
+                TIdx const kg = (kc + MATMUL_INT8_K_GROUP - 1) / MATMUL_INT8_K_GROUP;
+                bool const bFirst = (uiPanel == 0);
+                bool const bLast = (uiPanel+1 == uiNumPanels);
+
+                matmul_pack_b_int8_seq(kc, nc, NR, &B[pc*ldb + jc], ldb, pPackedB, pCompensation);
+                if(bLast && pCompensation)
+                {
+                    for(TIdx j = 0; j < nc; ++j)
+                    {
+                        pCompensation[j] *= iOffsetA;
+                    }
+                }
+
+                // 3rd loop: Row blocks of C and A.
+                for(TIdx ic = 0; ic < m; ic += MC)
+                {
+                    TIdx const mc = ((m-ic)<MC) ? (m-ic) : MC;
+
+                    matmul_pack_a_int8_seq(mc, kc, MR, &A[ic*lda + pc], lda, uiXorA, pPackedA);
+
+                    // 2nd loop: Micro-panels of B.
+                    for(TIdx jr = 0; jr < nc; jr += NR)
+                    {
+                        TIdx const nr = ((nc-jr)<NR) ? (nc-jr) : NR;
+                        int8_t const * const pMicroPanelB = &pPackedB[jr*kg*MATMUL_INT8_K_GROUP];
+                        int32_t const * const pCompensationTile = pCompensation ? &pCompensation[jr] : 0;
+
+                        // 1st loop: Micro-panels of A.
+                        for(TIdx ir = 0; ir < mc; ir += MR)
+                        {
+                            TIdx const mr = ((mc-ir)<MR) ? (mc-ir) : MR;
+                            uint8_t const * const pMicroPanelA = &pPackedA[ir*kg*MATMUL_INT8_K_GROUP];
+                            TIdx const uiRow = ic + ir;
+                            TIdx const uiCol = jc + jr;
+                            int32_t * const pAcc = bOutputS32
+                                ? ((int32_t *)C + uiRow*ldc + uiCol)
+                                : (bAccBuffer ? &pAccBuffer[uiRow*ldacc + jr] : 0);
+
+                            if((mr == MR) && (nr == NR) && (bOutputS32 || !bLast))
+                            {
+                                pMicroKernel->pMicroKernel(kg, pMicroPanelA, pMicroPanelB, pAcc, ldacc, !bFirst);
+                                if(bLast && pCompensationTile)
+                                {
+                                    matmul_int8_store_tile(mr, nr, pAcc, ldacc, pCompensationTile, pReq, uiRow, uiCol, C, ldc);
+                                }
+                            }
+                            else
+                            {
+                                // The requantization is fused: the tile is written to C right after its last panel.
+                                pMicroKernel->pMicroKernel(kg, pMicroPanelA, pMicroPanelB, AB, NR, false);
+                                if(!bFirst)
+                                {
+                                    for(TIdx i = 0; i < mr; ++i)
+                                    {
+                                        for(TIdx j = 0; j < nr; ++j)
+                                        {
+                                            AB[i*NR + j] += pAcc[i*ldacc + j];
+                                        }
+                                    }
+                                }
+                                if(bLast)
+                                {
+                                    matmul_int8_store_tile(mr, nr, AB, NR, pCompensationTile, pReq, uiRow, uiCol, C, ldc);
+                                }
+                                else
+                                {
+                                    for(TIdx i = 0; i < mr; ++i)
+                                    {
+                                        for(TIdx j = 0; j < nr; ++j)
+                                        {
+                                            pAcc[i*ldacc + j] = AB[i*NR + j];
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        matmul_arr_aligned_free_internal(pPackedA);
+        matmul_arr_aligned_free_internal(pPackedB);
+        if(pCompensation)
+        {
+            matmul_arr_aligned_free_internal(pCompensation);
+        }
+        if(pAccBuffer)
+        {
+            matmul_arr_aligned_free_internal(pAccBuffer);
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_int8_u8s8(
+        TIdx const m, TIdx const n, TIdx const k,
+        uint8_t const * const MATMUL_RESTRICT A, TIdx const lda, int32_t const iZeroPointA,
+        int8_t const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulInt8Requant const * const pRequant,
+        void * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        (void)matmul_gemm_seq_int8_internal(m, n, k, A, lda, 0, iZeroPointA, B, ldb, pRequant, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_int8_s8s8(
+        TIdx const m, TIdx const n, TIdx const k,
+        int8_t const * const MATMUL_RESTRICT A, TIdx const lda,
+        int8_t const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulInt8Requant const * const pRequant,
+        void * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        // Flipping the sign bit maps a to the unsigned a+128.
+        (void)matmul_gemm_seq_int8_internal(m, n, k, (uint8_t const *)A, lda, 0x80, 128, B, ldb, pRequant, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_int8(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if((m == 0) || (n == 0))
+        {
+            return;
+        }
+
+        // The range of A always contains zero so that it is represented exactly.
+        TElem fMinA = (TElem)0;
+        TElem fMaxA = (TElem)0;
+        for(TIdx i = 0; i < m; ++i)
+        {
+            for(TIdx p = 0; p < k; ++p)
+            {
+                TElem const a = A[i*lda + p];
+                fMinA = (a < fMinA) ? a : fMinA;
+                fMaxA = (a > fMaxA) ? a : fMaxA;
+            }
+        }
+        TElem fMaxAbsB = (TElem)0;
+        for(TIdx p = 0; p < k; ++p)
+        {
+            for(TIdx j = 0; j < n; ++j)
+            {
+                TElem const b = (B[p*ldb + j] < (TElem)0) ? -B[p*ldb + j] : B[p*ldb + j];
+                fMaxAbsB = (b > fMaxAbsB) ? b : fMaxAbsB;
+            }
+        }
+
+        double const fScaleA = (fMaxA > fMinA) ? ((double)fMaxA - (double)fMinA) / 255.0 : 1.0;
+        double const fScaleB = (fMaxAbsB > (TElem)0) ? (double)fMaxAbsB / 127.0 : 1.0;
+        int32_t const iZeroPointA = (int32_t)floor(-(double)fMinA / fScaleA + 0.5);
+
+        uint8_t * const pQuantA = (uint8_t *)matmul_arr_aligned_alloc_internal(m*k + 1);
+        int8_t * const pQuantB = (int8_t *)matmul_arr_aligned_alloc_internal(k*n + 1);
+        float * const pProduct = (float *)matmul_arr_aligned_alloc_internal(m*n*sizeof(float));
+        if(!pQuantA || !pQuantB || !pProduct)
+        {
+            printf("[GEMM Int8] The quantization buffers could not be allocated!\n");
+            void * const apBuffers[] = {pQuantA, pQuantB, pProduct};
+            for(TIdx i = 0; i < (TIdx)(sizeof(apBuffers)/sizeof(apBuffers[0])); ++i)
+            {
+                if(apBuffers[i])
+                {
+                    matmul_arr_aligned_free_internal(apBuffers[i]);
+                }
+            }
+            return;
+        }
+
+        for(TIdx i = 0; i < m; ++i)
+        {
+            for(TIdx p = 0; p < k; ++p)
+            {
+                int32_t const iVal = (int32_t)floor((double)A[i*lda + p] / fScaleA + 0.5) + iZeroPointA;
+                pQuantA[i*k + p] = (uint8_t)((iVal < 0) ? 0 : ((iVal > 255) ? 255 : iVal));
+            }
+        }
+        for(TIdx p = 0; p < k; ++p)
+        {
+            for(TIdx j = 0; j < n; ++j)
+            {
+                int32_t const iVal = (int32_t)floor((double)B[p*ldb + j] / fScaleB + 0.5);
+                pQuantB[p*n + j] = (int8_t)((iVal < -127) ? -127 : ((iVal > 127) ? 127 : iVal));
+            }
+        }
+
+        float const fScale = (float)((double)alpha * fScaleA * fScaleB);
+        SMatMulInt8Requant const requant = {EMatMulInt8OutputF32, false, &fScale, 0};
+        // If the product could not be computed, C is left unchanged.
+        if(matmul_gemm_seq_int8_internal(m, n, k, pQuantA, k, 0, iZeroPointA, pQuantB, n, &requant, pProduct, n))
+        {
+            for(TIdx i = 0; i < m; ++i)
+            {
+                for(TIdx j = 0; j < n; ++j)
+                {
+                    C[i*ldc + j] = (beta == (TElem)0)
+                        ? (TElem)pProduct[i*n + j]
+                        : beta * C[i*ldc + j] + (TElem)pProduct[i*n + j];
+                }
+            }
+        }
+
+        matmul_arr_aligned_free_internal(pQuantA);
+        matmul_arr_aligned_free_internal(pQuantB);
+        matmul_arr_aligned_free_internal(pProduct);
+    }
+#endif
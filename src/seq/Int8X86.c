@@ -0,0 +1,141 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#if defined(MATMUL_BUILD_SEQ_INT8)
+
+    #include <matmul/seq/Int8.h>
+
+    #ifdef MATMUL_ARCH_X86
+
+        #include <immintrin.h>              // _mm*
+        #include <string.h>                 // memcpy
+
+        // Each micro-kernel is compiled for its own instruction set. The other translation units are not affected so the library still runs on CPUs without those extensions.
+        #if defined(_MSC_VER) && !defined(__clang__)
+            #define MATMUL_TARGET(x)
+        #else
+            #define MATMUL_TARGET(x) __attribute__((target(x)))
+        #endif
+
+        #define MATMUL_ROWS_6(X) X(0) X(1) X(2) X(3) X(4) X(5)
+        #define MATMUL_ROWS_12(X) MATMUL_ROWS_6(X) X(6) X(7) X(8) X(9) X(10) X(11)
+
+        //-----------------------------------------------------------------------------
+        //! \return The MATMUL_INT8_K_GROUP packed values of A as one 32 bit integer.
+        //-----------------------------------------------------------------------------
+        int32_t matmul_int8_load_group(
+            uint8_t const * const p)
+        {
+            int32_t iGroup;
+            memcpy(&iGroup, p, sizeof(iGroup));
+            return iGroup;
+        }
+
+        //-----------------------------------------------------------------------------
+        // AVX2
+        // pmaddubsw would multiply the 8 bit values directly but saturates the sum of two u8*s8 products to 16 bit.
+        // Widening to 16 bit first and using pmaddwd is exact. Each 32 bit lane holds the sum over two of the four k values of a group.
+        // The two partial sums of each column are only added once at the end of the micro-panel.
+        //-----------------------------------------------------------------------------
+        #define MATMUL_INT8_AVX2_ROW_DECL(i)\
+            __m256i c##i##_0 = _mm256_setzero_si256();\
+            __m256i c##i##_1 = _mm256_setzero_si256();
+        #define MATMUL_INT8_AVX2_ROW_MADD(i)\
+            {\
+                __m256i const a = _mm256_broadcastq_epi64(_mm_cvtepu8_epi16(_mm_cvtsi32_si128(matmul_int8_load_group(pA + i*MATMUL_INT8_K_GROUP))));\
+                c##i##_0 = _mm256_add_epi32(c##i##_0, _mm256_madd_epi16(a, b0));\
+                c##i##_1 = _mm256_add_epi32(c##i##_1, _mm256_madd_epi16(a, b1));\
+            }
+        // hadd yields the columns in the order 0 1 4 5 | 2 3 6 7 which the permutation restores.
+        #define MATMUL_INT8_AVX2_ROW_STORE(i)\
+            {\
+                __m256i const c = _mm256_permute4x64_epi64(_mm256_hadd_epi32(c##i##_0, c##i##_1), 0xD8);\
+                __m256i * const pC = (__m256i *)&C[i*ldc];\
+                _mm256_storeu_si256(pC, bAccumulate ? _mm256_add_epi32(c, _mm256_loadu_si256(pC)) : c);\
+            }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        MATMUL_TARGET("avx2")
+        void matmul_micro_kernel_int8_avx2(
+            TIdx const kg,
+            uint8_t const * const MATMUL_RESTRICT pPackedA,
+            int8_t const * const MATMUL_RESTRICT pPackedB,
+            int32_t * const MATMUL_RESTRICT C, TIdx const ldc,
+            bool const bAccumulate)
+        {
+            MATMUL_ROWS_6(MATMUL_INT8_AVX2_ROW_DECL)
+            uint8_t const * MATMUL_RESTRICT pA = pPackedA;
+            int8_t const * MATMUL_RESTRICT pB = pPackedB;
+            for(TIdx g = 0; g < kg; ++g)
+            {
+                // The columns 0-3 and 4-7 with their four k values each.
+                __m256i const b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i const *)pB));
+                __m256i const b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i const *)(pB + 16)));
+                MATMUL_ROWS_6(MATMUL_INT8_AVX2_ROW_MADD)
+                pA += 6*MATMUL_INT8_K_GROUP;
+                pB += 8*MATMUL_INT8_K_GROUP;
+            }
+            MATMUL_ROWS_6(MATMUL_INT8_AVX2_ROW_STORE)
+        }
+
+        //-----------------------------------------------------------------------------
+        // AVX-512 VNNI
+        // vpdpbusd adds the four u8*s8 products of a group to each 32 bit lane without intermediate saturation.
+        //-----------------------------------------------------------------------------
+        #define MATMUL_INT8_AVX512VNNI_ROW_DECL(i)\
+            __m512i c##i##_0 = _mm512_setzero_si512();\
+            __m512i c##i##_1 = _mm512_setzero_si512();
+        #define MATMUL_INT8_AVX512VNNI_ROW_DPBUSD(i)\
+            {\
+                __m512i const a = _mm512_set1_epi32(matmul_int8_load_group(pA + i*MATMUL_INT8_K_GROUP));\
+                c##i##_0 = _mm512_dpbusd_epi32(c##i##_0, a, b0);\
+                c##i##_1 = _mm512_dpbusd_epi32(c##i##_1, a, b1);\
+            }
+        #define MATMUL_INT8_AVX512VNNI_ROW_STORE(i)\
+            if(bAccumulate)\
+            {\
+                c##i##_0 = _mm512_add_epi32(c##i##_0, _mm512_loadu_si512(&C[i*ldc]));\
+                c##i##_1 = _mm512_add_epi32(c##i##_1, _mm512_loadu_si512(&C[i*ldc + 16]));\
+            }\
+            _mm512_storeu_si512(&C[i*ldc], c##i##_0);\
+            _mm512_storeu_si512(&C[i*ldc + 16], c##i##_1);
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        MATMUL_TARGET("avx512f,avx512bw,avx512vnni")
+        void matmul_micro_kernel_int8_avx512vnni(
+            TIdx const kg,
+            uint8_t const * const MATMUL_RESTRICT pPackedA,
+            int8_t const * const MATMUL_RESTRICT pPackedB,
+            int32_t * const MATMUL_RESTRICT C, TIdx const ldc,
+            bool const bAccumulate)
+        {
+            MATMUL_ROWS_12(MATMUL_INT8_AVX512VNNI_ROW_DECL)
+            uint8_t const * MATMUL_RESTRICT pA = pPackedA;
+            int8_t const * MATMUL_RESTRICT pB = pPackedB;
+            for(TIdx g = 0; g < kg; ++g)
+            {
+                __m512i const b0 = _mm512_loadu_si512(pB);
+                __m512i const b1 = _mm512_loadu_si512(pB + 16*MATMUL_INT8_K_GROUP);
+                MATMUL_ROWS_12(MATMUL_INT8_AVX512VNNI_ROW_DPBUSD)
+                pA += 12*MATMUL_INT8_K_GROUP;
+                pB += 32*MATMUL_INT8_K_GROUP;
+            }
+            MATMUL_ROWS_12(MATMUL_INT8_AVX512VNNI_ROW_STORE)
+        }
+    #endif
+#endif
@@ -0,0 +1,473 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_JIT
+
+    #if defined(__x86_64__) && (defined(__unix__) || defined(__APPLE__))
+        #define MATMUL_JIT_X86_64
+        // MAP_ANONYMOUS is not part of C99.
+        #if !defined(_DEFAULT_SOURCE)
+            #define _DEFAULT_SOURCE
+        #endif
+    #endif
+
+    #include <matmul/seq/Jit.h>
+
+    #include <matmul/seq/MultipleOpts.h>    // matmul_gemm_seq_multiple_opts
+    #include <matmul/common/Mat.h>          // matmul_mat_gemm_early_out
+
+    #ifdef MATMUL_JIT_X86_64
+        #include <sys/mman.h>               // mmap, mprotect
+
+        #include <stdbool.h>                // bool
+        #include <stddef.h>                 // size_t
+        #include <stdint.h>                 // uint8_t, uint32_t, INT32_MAX
+        #include <stdio.h>                  // printf
+
+        //-----------------------------------------------------------------------------
+        //! A growing buffer of machine code.
+        //! If pBuffer is null, only the size is counted so that the exact size of a kernel is known before the memory is mapped.
+        //-----------------------------------------------------------------------------
+        typedef struct SMatMulJitCode
+        {
+            uint8_t * pBuffer;
+            size_t uiSize;
+        } SMatMulJitCode;
+
+        //-----------------------------------------------------------------------------
+        //! The signature of the generated kernels (System V AMD64 calling convention).
+        //! pAlphaBeta points to alpha followed by beta. m is the number of rows of C and has to be at least one.
+        //-----------------------------------------------------------------------------
+        typedef void(*TMatMulJitKernel)(TElem const * A, TElem const * B, TElem * C, TElem const * pAlphaBeta, size_t m);
+
+        //-----------------------------------------------------------------------------
+        //! The classes of alpha and beta a kernel is specialized for.
+        //-----------------------------------------------------------------------------
+        typedef enum EMatMulJitScalar
+        {
+            EMatMulJitScalarZero,
+            EMatMulJitScalarOne,
+            EMatMulJitScalarAny,
+        } EMatMulJitScalar;
+
+        //-----------------------------------------------------------------------------
+        //! The cache entry of a generated kernel. pKernel is written last so that a non-null kernel guarantees a complete key.
+        //-----------------------------------------------------------------------------
+        typedef struct SMatMulJitEntry
+        {
+            TIdx n;
+            TIdx k;
+            TIdx lda;
+            TIdx ldb;
+            TIdx ldc;
+            EMatMulJitScalar eAlpha;
+            EMatMulJitScalar eBeta;
+            TMatMulJitKernel volatile pKernel;
+        } SMatMulJitEntry;
+
+        // The x86-64 registers used by the generated code.
+        #define MATMUL_JIT_RDX 2
+        #define MATMUL_JIT_RCX 1
+        #define MATMUL_JIT_RSI 6
+        #define MATMUL_JIT_RDI 7
+        // xmm0 - xmm11 hold the accumulators.
+        #define MATMUL_JIT_NUM_ACCUMULATORS 12
+        #define MATMUL_JIT_XMM_BETA 12
+        #define MATMUL_JIT_XMM_ALPHA 13
+        #define MATMUL_JIT_XMM_A 14
+        #define MATMUL_JIT_XMM_B 15
+
+        // The mandatory prefixes selecting the packed or scalar variant of the SSE2 instructions for the element type.
+        #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+            #define MATMUL_JIT_PREFIX_PACKED 0x66
+            #define MATMUL_JIT_PREFIX_SCALAR 0xF2
+        #else
+            #define MATMUL_JIT_PREFIX_PACKED 0x00
+            #define MATMUL_JIT_PREFIX_SCALAR 0xF3
+        #endif
+        #define MATMUL_JIT_OP_LOAD 0x10
+        #define MATMUL_JIT_OP_STORE 0x11
+        #define MATMUL_JIT_OP_UNPCKL 0x14
+        #define MATMUL_JIT_OP_XOR 0x57
+        #define MATMUL_JIT_OP_ADD 0x58
+        #define MATMUL_JIT_OP_MUL 0x59
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_jit_emit_byte(
+            SMatMulJitCode * const pCode,
+            uint8_t const uiByte)
+        {
+            if(pCode->pBuffer)
+            {
+                pCode->pBuffer[pCode->uiSize] = uiByte;
+            }
+            ++pCode->uiSize;
+        }
+
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        void matmul_jit_emit_u32(
+            SMatMulJitCode * const pCode,
+            uint32_t const uiValue)
+        {
+            matmul_jit_emit_byte(pCode, (uint8_t)(uiValue & 0xFF));
+            matmul_jit_emit_byte(pCode, (uint8_t)((uiValue >> 8) & 0xFF));
+            matmul_jit_emit_byte(pCode, (uint8_t)((uiValue >> 16) & 0xFF));
+            matmul_jit_emit_byte(pCode, (uint8_t)((uiValue >> 24) & 0xFF));
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Emits the SSE instruction [prefix] 0F opcode xmm<uiReg>, xmm<uiRm>.
+        //-----------------------------------------------------------------------------
+        void matmul_jit_emit_sse_rr(
+            SMatMulJitCode * const pCode,
+            uint8_t const uiPrefix,
+            uint8_t const uiOpcode,
+            uint8_t const uiReg,
+            uint8_t const uiRm)
+        {
+            if(uiPrefix)
+            {
+                matmul_jit_emit_byte(pCode, uiPrefix);
+            }
+            uint8_t const uiRex = (uint8_t)(((uiReg >= 8) ? 0x04 : 0x00) | ((uiRm >= 8) ? 0x01 : 0x00));
+            if(uiRex)
+            {
+                matmul_jit_emit_byte(pCode, (uint8_t)(0x40 | uiRex));
+            }
+            matmul_jit_emit_byte(pCode, 0x0F);
+            matmul_jit_emit_byte(pCode, uiOpcode);
+            matmul_jit_emit_byte(pCode, (uint8_t)(0xC0 | ((uiReg & 7) << 3) | (uiRm & 7)));
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Emits the SSE instruction [prefix] 0F opcode xmm<uiReg>, [uiBase + iDisp].
+        //! The base has to be one of the legacy registers except rsp and rbp.
+        //-----------------------------------------------------------------------------
+        void matmul_jit_emit_sse_rm(
+            SMatMulJitCode * const pCode,
+            uint8_t const uiPrefix,
+            uint8_t const uiOpcode,
+            uint8_t const uiReg,
+            uint8_t const uiBase,
+            int32_t const iDisp)
+        {
+            if(uiPrefix)
+            {
+                matmul_jit_emit_byte(pCode, uiPrefix);
+            }
+            if(uiReg >= 8)
+            {
+                matmul_jit_emit_byte(pCode, 0x44);
+            }
+            matmul_jit_emit_byte(pCode, 0x0F);
+            matmul_jit_emit_byte(pCode, uiOpcode);
+            // mod = 10: [base + disp32]
+            matmul_jit_emit_byte(pCode, (uint8_t)(0x80 | ((uiReg & 7) << 3) | uiBase));
+            matmul_jit_emit_u32(pCode, (uint32_t)iDisp);
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Loads the element at [uiBase + iDisp] into all lanes of xmm<uiReg>.
+        //-----------------------------------------------------------------------------
+        void matmul_jit_emit_broadcast(
+            SMatMulJitCode * const pCode,
+            uint8_t const uiReg,
+            uint8_t const uiBase,
+            int32_t const iDisp)
+        {
+            matmul_jit_emit_sse_rm(pCode, MATMUL_JIT_PREFIX_SCALAR, MATMUL_JIT_OP_LOAD, uiReg, uiBase, iDisp);
+        #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+            // unpcklpd xmm, xmm
+            matmul_jit_emit_sse_rr(pCode, MATMUL_JIT_PREFIX_PACKED, MATMUL_JIT_OP_UNPCKL, uiReg, uiReg);
+        #else
+            // shufps xmm, xmm, 0
+            matmul_jit_emit_sse_rr(pCode, 0x00, 0xC6, uiReg, uiReg);
+            matmul_jit_emit_byte(pCode, 0x00);
+        #endif
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Emits the complete kernel for the given key.
+        //!
+        //! For each row of C the columns are processed in chunks of up to MATMUL_JIT_NUM_ACCUMULATORS registers.
+        //! Full vectors use the packed instructions, the remaining columns the scalar ones, so there is no remainder handling at runtime.
+        //-----------------------------------------------------------------------------
+        void matmul_jit_emit_kernel(
+            SMatMulJitCode * const pCode,
+            SMatMulJitEntry const * const pKey)
+        {
+            TIdx const uiVecWidth = (TIdx)(16 / sizeof(TElem));
+            int32_t const iElemSize = (int32_t)sizeof(TElem);
+
+            if(pKey->eAlpha == EMatMulJitScalarAny)
+            {
+                matmul_jit_emit_broadcast(pCode, MATMUL_JIT_XMM_ALPHA, MATMUL_JIT_RCX, 0);
+            }
+            if(pKey->eBeta == EMatMulJitScalarAny)
+            {
+                matmul_jit_emit_broadcast(pCode, MATMUL_JIT_XMM_BETA, MATMUL_JIT_RCX, iElemSize);
+            }
+
+            size_t const uiLoopBegin = pCode->uiSize;
+
+            TIdx const uiNumVecs = pKey->n / uiVecWidth;
+            TIdx const uiNumSlots = uiNumVecs + (pKey->n - uiNumVecs * uiVecWidth);
+
+            for(TIdx uiChunk = 0; uiChunk < uiNumSlots; uiChunk += MATMUL_JIT_NUM_ACCUMULATORS)
+            {
+                TIdx const uiChunkSlots = ((uiNumSlots-uiChunk)<MATMUL_JIT_NUM_ACCUMULATORS) ? (uiNumSlots-uiChunk) : MATMUL_JIT_NUM_ACCUMULATORS;
+
+                // xorps acc, acc
+                for(TIdx s = 0; s < uiChunkSlots; ++s)
+                {
+                    matmul_jit_emit_sse_rr(pCode, 0x00, MATMUL_JIT_OP_XOR, (uint8_t)s, (uint8_t)s);
+                }
+
+                for(TIdx p = 0; p < pKey->k; ++p)
+                {
+                    matmul_jit_emit_broadcast(pCode, MATMUL_JIT_XMM_A, MATMUL_JIT_RDI, (int32_t)p * iElemSize);
+
+                    for(TIdx s = 0; s < uiChunkSlots; ++s)
+                    {
+                        TIdx const uiSlot = uiChunk + s;
+                        bool const bPacked = (uiSlot < uiNumVecs);
+                        TIdx const j = bPacked ? uiSlot * uiVecWidth : uiNumVecs * uiVecWidth + (uiSlot - uiNumVecs);
+                        uint8_t const uiPrefix = bPacked ? MATMUL_JIT_PREFIX_PACKED : MATMUL_JIT_PREFIX_SCALAR;
+
+                        matmul_jit_emit_sse_rm(pCode, uiPrefix, MATMUL_JIT_OP_LOAD, MATMUL_JIT_XMM_B, MATMUL_JIT_RSI, (int32_t)(p * pKey->ldb + j) * iElemSize);
+                        matmul_jit_emit_sse_rr(pCode, uiPrefix, MATMUL_JIT_OP_MUL, MATMUL_JIT_XMM_B, MATMUL_JIT_XMM_A);
+                        matmul_jit_emit_sse_rr(pCode, uiPrefix, MATMUL_JIT_OP_ADD, (uint8_t)s, MATMUL_JIT_XMM_B);
+                    }
+                }
+
+                for(TIdx s = 0; s < uiChunkSlots; ++s)
+                {
+                    TIdx const uiSlot = uiChunk + s;
+                    bool const bPacked = (uiSlot < uiNumVecs);
+                    TIdx const j = bPacked ? uiSlot * uiVecWidth : uiNumVecs * uiVecWidth + (uiSlot - uiNumVecs);
+                    uint8_t const uiPrefix = bPacked ? MATMUL_JIT_PREFIX_PACKED : MATMUL_JIT_PREFIX_SCALAR;
+                    int32_t const iDispC = (int32_t)j * iElemSize;
+
+                    if(pKey->eAlpha == EMatMulJitScalarAny)
+                    {
+                        matmul_jit_emit_sse_rr(pCode, uiPrefix, MATMUL_JIT_OP_MUL, (uint8_t)s, MATMUL_JIT_XMM_ALPHA);
+                    }
+                    if(pKey->eBeta != EMatMulJitScalarZero)
+                    {
+                        matmul_jit_emit_sse_rm(pCode, uiPrefix, MATMUL_JIT_OP_LOAD, MATMUL_JIT_XMM_B, MATMUL_JIT_RDX, iDispC);
+                        if(pKey->eBeta == EMatMulJitScalarAny)
+                        {
+                            matmul_jit_emit_sse_rr(pCode, uiPrefix, MATMUL_JIT_OP_MUL, MATMUL_JIT_XMM_B, MATMUL_JIT_XMM_BETA);
+                        }
+                        matmul_jit_emit_sse_rr(pCode, uiPrefix, MATMUL_JIT_OP_ADD, (uint8_t)s, MATMUL_JIT_XMM_B);
+                    }
+                    matmul_jit_emit_sse_rm(pCode, uiPrefix, MATMUL_JIT_OP_STORE, (uint8_t)s, MATMUL_JIT_RDX, iDispC);
+                }
+            }
+
+            // add rdi, lda * sizeof(TElem)
+            matmul_jit_emit_byte(pCode, 0x48);
+            matmul_jit_emit_byte(pCode, 0x81);
+            matmul_jit_emit_byte(pCode, 0xC0 | MATMUL_JIT_RDI);
+            matmul_jit_emit_u32(pCode, (uint32_t)((int32_t)pKey->lda * iElemSize));
+            // add rdx, ldc * sizeof(TElem)
+            matmul_jit_emit_byte(pCode, 0x48);
+            matmul_jit_emit_byte(pCode, 0x81);
+            matmul_jit_emit_byte(pCode, 0xC0 | MATMUL_JIT_RDX);
+            matmul_jit_emit_u32(pCode, (uint32_t)((int32_t)pKey->ldc * iElemSize));
+            // dec r8
+            matmul_jit_emit_byte(pCode, 0x49);
+            matmul_jit_emit_byte(pCode, 0xFF);
+            matmul_jit_emit_byte(pCode, 0xC8);
+            // jnz loop
+            matmul_jit_emit_byte(pCode, 0x0F);
+            matmul_jit_emit_byte(pCode, 0x85);
+            matmul_jit_emit_u32(pCode, (uint32_t)(int32_t)((long long)uiLoopBegin - (long long)(pCode->uiSize + 4)));
+            // ret
+            matmul_jit_emit_byte(pCode, 0xC3);
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Maps a new executable page and generates the kernel for the given key into it.
+        //!
+        //! \return The kernel or null if the memory could not be mapped.
+        //-----------------------------------------------------------------------------
+        TMatMulJitKernel matmul_jit_compile(
+            SMatMulJitEntry const * const pKey)
+        {
+            // The first pass only counts the bytes.
+            SMatMulJitCode code = {0, 0};
+            matmul_jit_emit_kernel(&code, pKey);
+
+            size_t const uiSize = code.uiSize;
+            // The memory is writable while the code is emitted and executable afterwards but never both.
+            void * const pMemory = mmap(0, uiSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(pMemory == MAP_FAILED)
+            {
+                printf("[GEMM JIT] mmap of %lu bytes failed!\n", (unsigned long)uiSize);
+                return 0;
+            }
+
+            code.pBuffer = (uint8_t *)pMemory;
+            code.uiSize = 0;
+            matmul_jit_emit_kernel(&code, pKey);
+
+            if(mprotect(pMemory, uiSize, PROT_READ | PROT_EXEC) != 0)
+            {
+                printf("[GEMM JIT] mprotect failed!\n");
+                munmap(pMemory, uiSize);
+                return 0;
+            }
+
+            return (TMatMulJitKernel)pMemory;
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Returns the cached kernel for the key or generates and caches a new one.
+        //!
+        //! \return The kernel or null if the shape can not be compiled or the cache is full.
+        //-----------------------------------------------------------------------------
+        TMatMulJitKernel matmul_jit_get_kernel(
+            SMatMulJitEntry const * const pKey)
+        {
+            static SMatMulJitEntry aCache[MATMUL_JIT_CACHE_SIZE];
+            static int volatile iLock = 0;
+
+            // The entries are never changed after the kernel has been published so they can be read without locking.
+            for(TIdx i = 0; i < MATMUL_JIT_CACHE_SIZE; ++i)
+            {
+                SMatMulJitEntry const * const pEntry = &aCache[i];
+                TMatMulJitKernel const pKernel = pEntry->pKernel;
+                if(!pKernel)
+                {
+                    break;
+                }
+                __sync_synchronize();
+                if((pEntry->n == pKey->n) && (pEntry->k == pKey->k)
+                    && (pEntry->lda == pKey->lda) && (pEntry->ldb == pKey->ldb) && (pEntry->ldc == pKey->ldc)
+                    && (pEntry->eAlpha == pKey->eAlpha) && (pEntry->eBeta == pKey->eBeta))
+                {
+                    return pKernel;
+                }
+            }
+
+            TMatMulJitKernel pKernel = 0;
+
+            while(__sync_lock_test_and_set(&iLock, 1))
+            {
+            }
+
+            // Another thread may have inserted the kernel in the meantime.
+            TIdx i = 0;
+            for(; i < MATMUL_JIT_CACHE_SIZE; ++i)
+            {
+                SMatMulJitEntry * const pEntry = &aCache[i];
+                if(!pEntry->pKernel)
+                {
+                    break;
+                }
+                if((pEntry->n == pKey->n) && (pEntry->k == pKey->k)
+                    && (pEntry->lda == pKey->lda) && (pEntry->ldb == pKey->ldb) && (pEntry->ldc == pKey->ldc)
+                    && (pEntry->eAlpha == pKey->eAlpha) && (pEntry->eBeta == pKey->eBeta))
+                {
+                    pKernel = pEntry->pKernel;
+                    break;
+                }
+            }
+
+            if(!pKernel && (i < MATMUL_JIT_CACHE_SIZE))
+            {
+                pKernel = matmul_jit_compile(pKey);
+                if(pKernel)
+                {
+                    SMatMulJitEntry * const pEntry = &aCache[i];
+                    pEntry->n = pKey->n;
+                    pEntry->k = pKey->k;
+                    pEntry->lda = pKey->lda;
+                    pEntry->ldb = pKey->ldb;
+                    pEntry->ldc = pKey->ldc;
+                    pEntry->eAlpha = pKey->eAlpha;
+                    pEntry->eBeta = pKey->eBeta;
+                    __sync_synchronize();
+                    pEntry->pKernel = pKernel;
+                }
+            }
+
+            __sync_lock_release(&iLock);
+
+            return pKernel;
+        }
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_jit(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        {
+            return;
+        }
+
+    #ifdef MATMUL_JIT_X86_64
+        // If there is no product to add, only the scaling of C remains.
+        if((k == 0) || (alpha == (TElem)0))
+        {
+            for(TIdx i = 0; i < m; ++i)
+            {
+                for(TIdx j = 0; j < n; ++j)
+                {
+                    C[i*ldc + j] = (beta == (TElem)0) ? (TElem)0 : beta * C[i*ldc + j];
+                }
+            }
+            return;
+        }
+
+        // The code size grows with n*k and all offsets have to fit into the 32 bit displacements.
+        if((n <= MATMUL_JIT_MAX_SIZE) && (k <= MATMUL_JIT_MAX_SIZE)
+            && ((double)(k * ldb + lda + ldc) * (double)sizeof(TElem) < (double)INT32_MAX))
+        {
+            SMatMulJitEntry key;
+            key.n = n;
+            key.k = k;
+            key.lda = lda;
+            key.ldb = ldb;
+            key.ldc = ldc;
+            key.eAlpha = (alpha == (TElem)1) ? EMatMulJitScalarOne : EMatMulJitScalarAny;
+            key.eBeta = (beta == (TElem)0) ? EMatMulJitScalarZero : ((beta == (TElem)1) ? EMatMulJitScalarOne : EMatMulJitScalarAny);
+            key.pKernel = 0;
+
+            TMatMulJitKernel const pKernel = matmul_jit_get_kernel(&key);
+            if(pKernel)
+            {
+                TElem const aAlphaBeta[2] = {alpha, beta};
+                pKernel(A, B, C, aAlphaBeta, (size_t)m);
+                return;
+            }
+        }
+    #endif
+
+        matmul_gemm_seq_multiple_opts(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+#endif
@@ -0,0 +1,235 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_PACKED
+
+    #include <matmul/seq/MicroKernel.h>
+
+    #include <matmul/common/Cpu.h>      // matmul_cpu_get_features
+    #include <matmul/common/Once.h>     // matmul_once, SMatMulOnce
+
+    #include <stdbool.h>                // bool
+    #include <stdlib.h>                 // getenv
+    #include <string.h>                 // strcmp
+    #include <stdio.h>                  // printf
+
+    #if (MATMUL_PACKED_MR > MATMUL_MICRO_KERNEL_MAX_MR) || (MATMUL_PACKED_NR > MATMUL_MICRO_KERNEL_MAX_NR)
+        #error MATMUL_PACKED_MR and MATMUL_PACKED_NR must not exceed MATMUL_MICRO_KERNEL_MAX_MR and MATMUL_MICRO_KERNEL_MAX_NR!
+    #endif
+
+    //-----------------------------------------------------------------------------
+    // The portable micro-kernel for the element type T.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_MICRO_KERNEL_GENERIC(T, SUFFIX)\
+    void matmul_micro_kernel_generic_##SUFFIX(\
+        TIdx const kc,\
+        T const alpha,\
+        T const * const MATMUL_RESTRICT pPackedA,\
+        T const * const MATMUL_RESTRICT pPackedB,\
+        T const beta,\
+        T * const MATMUL_RESTRICT C, TIdx const ldc)\
+    {\
+        /* The sizes are compile time constants so that the accumulators can be kept in registers and the inner loop can be vectorized. */\
+        T AB[MATMUL_PACKED_MR*MATMUL_PACKED_NR];\
+        for(TIdx i = 0; i < MATMUL_PACKED_MR*MATMUL_PACKED_NR; ++i)\
+        {\
+            AB[i] = (T)0;\
+        }\
+\
+        T const * MATMUL_RESTRICT pA = pPackedA;\
+        T const * MATMUL_RESTRICT pB = pPackedB;\
+        for(TIdx p = 0; p < kc; ++p)\
+        {\
+            for(TIdx i = 0; i < MATMUL_PACKED_MR; ++i)\
+            {\
+                T const a = pA[i];\
+                for(TIdx j = 0; j < MATMUL_PACKED_NR; ++j)\
+                {\
+                    AB[i*MATMUL_PACKED_NR + j] += a * pB[j];\
+                }\
+            }\
+            pA += MATMUL_PACKED_MR;\
+            pB += MATMUL_PACKED_NR;\
+        }\
+\
+        if(beta == (T)0)\
+        {\
+            for(TIdx i = 0; i < MATMUL_PACKED_MR; ++i)\
+            {\
+                for(TIdx j = 0; j < MATMUL_PACKED_NR; ++j)\
+                {\
+                    C[i*ldc + j] = alpha * AB[i*MATMUL_PACKED_NR + j];\
+                }\
+            }\
+        }\
+        else\
+        {\
+            for(TIdx i = 0; i < MATMUL_PACKED_MR; ++i)\
+            {\
+                for(TIdx j = 0; j < MATMUL_PACKED_NR; ++j)\
+                {\
+                    C[i*ldc + j] = beta * C[i*ldc + j] + alpha * AB[i*MATMUL_PACKED_NR + j];\
+                }\
+            }\
+        }\
+    }
+
+    MATMUL_MICRO_KERNEL_GENERIC(float, s)
+    MATMUL_MICRO_KERNEL_GENERIC(double, d)
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    bool matmul_micro_kernel_is_supported(
+        char const * const pszName)
+    {
+        SMatMulCpuFeatures const * const pFeatures = matmul_cpu_get_features();
+
+        return (strcmp(pszName, "generic") == 0)
+            || ((strcmp(pszName, "sse42") == 0) && pFeatures->bSse42)
+            || ((strcmp(pszName, "avx2") == 0) && pFeatures->bAvx2 && pFeatures->bFma)
+            || ((strcmp(pszName, "avx512") == 0) && pFeatures->bAvx512f)
+            || ((strcmp(pszName, "avx512vnni") == 0) && pFeatures->bAvx512bw && pFeatures->bAvx512Vnni);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    TIdx matmul_micro_kernel_select(
+        char const * const * const apszNames,
+        TIdx const uiNumMicroKernels)
+    {
+        char const * const pszRequested = getenv("MATMUL_MICRO_KERNEL");
+        bool bRequestedFound = false;
+
+        TIdx uiSelectedIdx = 0;
+        for(TIdx i = 0; i < uiNumMicroKernels; ++i)
+        {
+            char const * const pszName = apszNames[i];
+            if(matmul_micro_kernel_is_supported(pszName))
+            {
+                if(pszRequested && (strcmp(pszName, pszRequested) == 0))
+                {
+                    uiSelectedIdx = i;
+                    bRequestedFound = true;
+                    break;
+                }
+                uiSelectedIdx = i;
+            }
+        }
+
+        if(pszRequested && !bRequestedFound)
+        {
+            printf("[GEMM Packed] The micro-kernel '%s' requested by MATMUL_MICRO_KERNEL is not available on this CPU! Using '%s' instead.\n", pszRequested, apszNames[uiSelectedIdx]);
+        }
+
+        return uiSelectedIdx;
+    }
+
+    //-----------------------------------------------------------------------------
+    // The micro-kernels explicitly vectorized with intrinsics for each element type suffix.
+    //-----------------------------------------------------------------------------
+#ifdef MATMUL_ARCH_X86
+    #define MATMUL_MICRO_KERNELS_s\
+        {matmul_micro_kernel_sse42_s, 4, 8, "sse42"},\
+        {matmul_micro_kernel_avx2_s, 6, 16, "avx2"},\
+        {matmul_micro_kernel_avx512_s, 12, 32, "avx512"},
+    #define MATMUL_MICRO_KERNELS_d\
+        {matmul_micro_kernel_sse42_d, 4, 4, "sse42"},\
+        {matmul_micro_kernel_avx2_d, 6, 8, "avx2"},\
+        {matmul_micro_kernel_avx512_d, 12, 16, "avx512"},
+#else
+    #define MATMUL_MICRO_KERNELS_s
+    #define MATMUL_MICRO_KERNELS_d
+#endif
+
+    //-----------------------------------------------------------------------------
+    // The micro-kernel table, selection and lookup by name for the element type suffix SUFFIX.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_MICRO_KERNEL_GET(SUFFIX, DESC)\
+    DESC const * matmul_micro_kernel_table_##SUFFIX(TIdx * const puiNumMicroKernels)\
+    {\
+        /* Sorted from the least to the most preferable one. */\
+        static DESC const aMicroKernels[] = {\
+            {matmul_micro_kernel_generic_##SUFFIX, MATMUL_PACKED_MR, MATMUL_PACKED_NR, "generic"},\
+            MATMUL_MICRO_KERNELS_##SUFFIX\
+        };\
+        *puiNumMicroKernels = (TIdx)(sizeof(aMicroKernels)/sizeof(aMicroKernels[0]));\
+        return aMicroKernels;\
+    }\
+\
+    void matmul_micro_kernel_init_##SUFFIX(void * const ppSelected)\
+    {\
+        TIdx uiNumMicroKernels;\
+        DESC const * const aMicroKernels = matmul_micro_kernel_table_##SUFFIX(&uiNumMicroKernels);\
+        char const * apszNames[MATMUL_MICRO_KERNEL_MAX_NUM];\
+        for(TIdx i = 0; i < uiNumMicroKernels; ++i)\
+        {\
+            apszNames[i] = aMicroKernels[i].pszName;\
+        }\
+        *(DESC const **)ppSelected = &aMicroKernels[matmul_micro_kernel_select(apszNames, uiNumMicroKernels)];\
+    }\
+\
+    DESC const * matmul_micro_kernel_get_##SUFFIX(void)\
+    {\
+        static DESC const * pSelected = 0;\
+        static SMatMulOnce once = MATMUL_ONCE_INIT;\
+\
+        matmul_once(&once, 1, matmul_micro_kernel_init_##SUFFIX, (void *)&pSelected);\
+\
+        return pSelected;\
+    }\
+\
+    DESC const * matmul_micro_kernel_find_##SUFFIX(char const * const pszName)\
+    {\
+        TIdx uiNumMicroKernels;\
+        DESC const * const aMicroKernels = matmul_micro_kernel_table_##SUFFIX(&uiNumMicroKernels);\
+        for(TIdx i = 0; i < uiNumMicroKernels; ++i)\
+        {\
+            if((strcmp(aMicroKernels[i].pszName, pszName) == 0) && matmul_micro_kernel_is_supported(pszName))\
+            {\
+                return &aMicroKernels[i];\
+            }\
+        }\
+        return 0;\
+    }
+
+    MATMUL_MICRO_KERNEL_GET(s, SMatMulMicroKernelS)
+    MATMUL_MICRO_KERNEL_GET(d, SMatMulMicroKernelD)
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    SMatMulMicroKernel const * matmul_micro_kernel_get(void)
+    {
+#ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        return matmul_micro_kernel_get_d();
+#else
+        return matmul_micro_kernel_get_s();
+#endif
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    SMatMulMicroKernel const * matmul_micro_kernel_find(
+        char const * const pszName)
+    {
+#ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        return matmul_micro_kernel_find_d(pszName);
+#else
+        return matmul_micro_kernel_find_s(pszName);
+#endif
+    }
+#endif
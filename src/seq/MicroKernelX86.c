@@ -0,0 +1,286 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#if defined(MATMUL_BUILD_SEQ_PACKED)
+
+    #include <matmul/seq/MicroKernel.h>
+
+    #ifdef MATMUL_ARCH_X86
+
+        #include <immintrin.h>              // _mm*
+
+        // Each micro-kernel is compiled for its own instruction set. The other translation units are not affected so the library still runs on CPUs without those extensions.
+        #if defined(_MSC_VER) && !defined(__clang__)
+            #define MATMUL_TARGET(x)
+        #else
+            #define MATMUL_TARGET(x) __attribute__((target(x)))
+        #endif
+
+        #define MATMUL_ROWS_4(X) X(0) X(1) X(2) X(3)
+        #define MATMUL_ROWS_6(X) MATMUL_ROWS_4(X) X(4) X(5)
+        #define MATMUL_ROWS_12(X) MATMUL_ROWS_6(X) X(6) X(7) X(8) X(9) X(10) X(11)
+
+        // All micro-kernels hold two vectors per row of the tile in registers.
+        #define MATMUL_ROW_DECL(i)\
+            MATMUL_VEC c##i##_0 = MATMUL_VEC_ZERO();\
+            MATMUL_VEC c##i##_1 = MATMUL_VEC_ZERO();
+        #define MATMUL_ROW_FMA(i)\
+            {\
+                MATMUL_VEC const a = MATMUL_VEC_SET1(pA[i]);\
+                c##i##_0 = MATMUL_VEC_FMA(a, b0, c##i##_0);\
+                c##i##_1 = MATMUL_VEC_FMA(a, b1, c##i##_1);\
+            }
+        #define MATMUL_ROW_STORE(i)\
+            MATMUL_VEC_STOREU(&C[i*ldc], MATMUL_VEC_MUL(vAlpha, c##i##_0));\
+            MATMUL_VEC_STOREU(&C[i*ldc + MATMUL_VEC_WIDTH], MATMUL_VEC_MUL(vAlpha, c##i##_1));
+        #define MATMUL_ROW_STORE_BETA(i)\
+            MATMUL_VEC_STOREU(&C[i*ldc], MATMUL_VEC_FMA(vAlpha, c##i##_0, MATMUL_VEC_MUL(vBeta, MATMUL_VEC_LOADU(&C[i*ldc]))));\
+            MATMUL_VEC_STOREU(&C[i*ldc + MATMUL_VEC_WIDTH], MATMUL_VEC_FMA(vAlpha, c##i##_1, MATMUL_VEC_MUL(vBeta, MATMUL_VEC_LOADU(&C[i*ldc + MATMUL_VEC_WIDTH]))));
+
+        #define MATMUL_MICRO_KERNEL_BODY(MR, ROWS)\
+            ROWS(MATMUL_ROW_DECL)\
+            MATMUL_SCALAR const * MATMUL_RESTRICT pA = pPackedA;\
+            MATMUL_SCALAR const * MATMUL_RESTRICT pB = pPackedB;\
+            for(TIdx p = 0; p < kc; ++p)\
+            {\
+                MATMUL_VEC const b0 = MATMUL_VEC_LOADU(pB);\
+                MATMUL_VEC const b1 = MATMUL_VEC_LOADU(pB + MATMUL_VEC_WIDTH);\
+                ROWS(MATMUL_ROW_FMA)\
+                pA += MR;\
+                pB += 2*MATMUL_VEC_WIDTH;\
+            }\
+            MATMUL_VEC const vAlpha = MATMUL_VEC_SET1(alpha);\
+            if(beta == (MATMUL_SCALAR)0)\
+            {\
+                ROWS(MATMUL_ROW_STORE)\
+            }\
+            else\
+            {\
+                MATMUL_VEC const vBeta = MATMUL_VEC_SET1(beta);\
+                ROWS(MATMUL_ROW_STORE_BETA)\
+            }
+
+        //-----------------------------------------------------------------------------
+        // SSE4.2
+        // There are no new floating point instructions in SSE4.2 compared to SSE2 which are useful here and there is no FMA.
+        //-----------------------------------------------------------------------------
+        #define MATMUL_VEC_FMA(a, b, c) MATMUL_VEC_ADD(MATMUL_VEC_MUL(a, b), c)
+
+        #define MATMUL_SCALAR double
+        #define MATMUL_VEC __m128d
+        #define MATMUL_VEC_WIDTH 2
+        #define MATMUL_VEC_ZERO _mm_setzero_pd
+        #define MATMUL_VEC_SET1 _mm_set1_pd
+        #define MATMUL_VEC_LOADU _mm_loadu_pd
+        #define MATMUL_VEC_STOREU _mm_storeu_pd
+        #define MATMUL_VEC_MUL _mm_mul_pd
+        #define MATMUL_VEC_ADD _mm_add_pd
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        MATMUL_TARGET("sse4.2")
+        void matmul_micro_kernel_sse42_d(
+            TIdx const kc,
+            double const alpha,
+            double const * const MATMUL_RESTRICT pPackedA,
+            double const * const MATMUL_RESTRICT pPackedB,
+            double const beta,
+            double * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            MATMUL_MICRO_KERNEL_BODY(4, MATMUL_ROWS_4)
+        }
+        #undef MATMUL_SCALAR
+        #undef MATMUL_VEC
+        #undef MATMUL_VEC_WIDTH
+        #undef MATMUL_VEC_ZERO
+        #undef MATMUL_VEC_SET1
+        #undef MATMUL_VEC_LOADU
+        #undef MATMUL_VEC_STOREU
+        #undef MATMUL_VEC_MUL
+        #undef MATMUL_VEC_ADD
+
+        #define MATMUL_SCALAR float
+        #define MATMUL_VEC __m128
+        #define MATMUL_VEC_WIDTH 4
+        #define MATMUL_VEC_ZERO _mm_setzero_ps
+        #define MATMUL_VEC_SET1 _mm_set1_ps
+        #define MATMUL_VEC_LOADU _mm_loadu_ps
+        #define MATMUL_VEC_STOREU _mm_storeu_ps
+        #define MATMUL_VEC_MUL _mm_mul_ps
+        #define MATMUL_VEC_ADD _mm_add_ps
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        MATMUL_TARGET("sse4.2")
+        void matmul_micro_kernel_sse42_s(
+            TIdx const kc,
+            float const alpha,
+            float const * const MATMUL_RESTRICT pPackedA,
+            float const * const MATMUL_RESTRICT pPackedB,
+            float const beta,
+            float * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            MATMUL_MICRO_KERNEL_BODY(4, MATMUL_ROWS_4)
+        }
+        #undef MATMUL_SCALAR
+        #undef MATMUL_VEC
+        #undef MATMUL_VEC_WIDTH
+        #undef MATMUL_VEC_ZERO
+        #undef MATMUL_VEC_SET1
+        #undef MATMUL_VEC_LOADU
+        #undef MATMUL_VEC_STOREU
+        #undef MATMUL_VEC_MUL
+        #undef MATMUL_VEC_ADD
+
+        #undef MATMUL_VEC_FMA
+
+        //-----------------------------------------------------------------------------
+        // AVX2 + FMA
+        //-----------------------------------------------------------------------------
+        #define MATMUL_SCALAR double
+        #define MATMUL_VEC __m256d
+        #define MATMUL_VEC_WIDTH 4
+        #define MATMUL_VEC_ZERO _mm256_setzero_pd
+        #define MATMUL_VEC_SET1 _mm256_set1_pd
+        #define MATMUL_VEC_LOADU _mm256_loadu_pd
+        #define MATMUL_VEC_STOREU _mm256_storeu_pd
+        #define MATMUL_VEC_MUL _mm256_mul_pd
+        #define MATMUL_VEC_FMA _mm256_fmadd_pd
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        MATMUL_TARGET("avx2,fma")
+        void matmul_micro_kernel_avx2_d(
+            TIdx const kc,
+            double const alpha,
+            double const * const MATMUL_RESTRICT pPackedA,
+            double const * const MATMUL_RESTRICT pPackedB,
+            double const beta,
+            double * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            MATMUL_MICRO_KERNEL_BODY(6, MATMUL_ROWS_6)
+        }
+        #undef MATMUL_SCALAR
+        #undef MATMUL_VEC
+        #undef MATMUL_VEC_WIDTH
+        #undef MATMUL_VEC_ZERO
+        #undef MATMUL_VEC_SET1
+        #undef MATMUL_VEC_LOADU
+        #undef MATMUL_VEC_STOREU
+        #undef MATMUL_VEC_MUL
+        #undef MATMUL_VEC_FMA
+
+        #define MATMUL_SCALAR float
+        #define MATMUL_VEC __m256
+        #define MATMUL_VEC_WIDTH 8
+        #define MATMUL_VEC_ZERO _mm256_setzero_ps
+        #define MATMUL_VEC_SET1 _mm256_set1_ps
+        #define MATMUL_VEC_LOADU _mm256_loadu_ps
+        #define MATMUL_VEC_STOREU _mm256_storeu_ps
+        #define MATMUL_VEC_MUL _mm256_mul_ps
+        #define MATMUL_VEC_FMA _mm256_fmadd_ps
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        MATMUL_TARGET("avx2,fma")
+        void matmul_micro_kernel_avx2_s(
+            TIdx const kc,
+            float const alpha,
+            float const * const MATMUL_RESTRICT pPackedA,
+            float const * const MATMUL_RESTRICT pPackedB,
+            float const beta,
+            float * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            MATMUL_MICRO_KERNEL_BODY(6, MATMUL_ROWS_6)
+        }
+        #undef MATMUL_SCALAR
+        #undef MATMUL_VEC
+        #undef MATMUL_VEC_WIDTH
+        #undef MATMUL_VEC_ZERO
+        #undef MATMUL_VEC_SET1
+        #undef MATMUL_VEC_LOADU
+        #undef MATMUL_VEC_STOREU
+        #undef MATMUL_VEC_MUL
+        #undef MATMUL_VEC_FMA
+
+        //-----------------------------------------------------------------------------
+        // AVX-512
+        //-----------------------------------------------------------------------------
+        #define MATMUL_SCALAR double
+        #define MATMUL_VEC __m512d
+        #define MATMUL_VEC_WIDTH 8
+        #define MATMUL_VEC_ZERO _mm512_setzero_pd
+        #define MATMUL_VEC_SET1 _mm512_set1_pd
+        #define MATMUL_VEC_LOADU _mm512_loadu_pd
+        #define MATMUL_VEC_STOREU _mm512_storeu_pd
+        #define MATMUL_VEC_MUL _mm512_mul_pd
+        #define MATMUL_VEC_FMA _mm512_fmadd_pd
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        MATMUL_TARGET("avx512f")
+        void matmul_micro_kernel_avx512_d(
+            TIdx const kc,
+            double const alpha,
+            double const * const MATMUL_RESTRICT pPackedA,
+            double const * const MATMUL_RESTRICT pPackedB,
+            double const beta,
+            double * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            MATMUL_MICRO_KERNEL_BODY(12, MATMUL_ROWS_12)
+        }
+        #undef MATMUL_SCALAR
+        #undef MATMUL_VEC
+        #undef MATMUL_VEC_WIDTH
+        #undef MATMUL_VEC_ZERO
+        #undef MATMUL_VEC_SET1
+        #undef MATMUL_VEC_LOADU
+        #undef MATMUL_VEC_STOREU
+        #undef MATMUL_VEC_MUL
+        #undef MATMUL_VEC_FMA
+
+        #define MATMUL_SCALAR float
+        #define MATMUL_VEC __m512
+        #define MATMUL_VEC_WIDTH 16
+        #define MATMUL_VEC_ZERO _mm512_setzero_ps
+        #define MATMUL_VEC_SET1 _mm512_set1_ps
+        #define MATMUL_VEC_LOADU _mm512_loadu_ps
+        #define MATMUL_VEC_STOREU _mm512_storeu_ps
+        #define MATMUL_VEC_MUL _mm512_mul_ps
+        #define MATMUL_VEC_FMA _mm512_fmadd_ps
+        //-----------------------------------------------------------------------------
+        //
+        //-----------------------------------------------------------------------------
+        MATMUL_TARGET("avx512f")
+        void matmul_micro_kernel_avx512_s(
+            TIdx const kc,
+            float const alpha,
+            float const * const MATMUL_RESTRICT pPackedA,
+            float const * const MATMUL_RESTRICT pPackedB,
+            float const beta,
+            float * const MATMUL_RESTRICT C, TIdx const ldc)
+        {
+            MATMUL_MICRO_KERNEL_BODY(12, MATMUL_ROWS_12)
+        }
+        #undef MATMUL_SCALAR
+        #undef MATMUL_VEC
+        #undef MATMUL_VEC_WIDTH
+        #undef MATMUL_VEC_ZERO
+        #undef MATMUL_VEC_SET1
+        #undef MATMUL_VEC_LOADU
+        #undef MATMUL_VEC_STOREU
+        #undef MATMUL_VEC_MUL
+        #undef MATMUL_VEC_FMA
+    #endif
+#endif
@@ -18,6 +18,7 @@
     #include <matmul/seq/MultipleOpts.h>
 
     #include <matmul/common/Mat.h>  // matmul_mat_gemm_early_out
+    #include <matmul/common/Tune.h> // matmul_tune_get
 
     #ifdef MATMUL_BUILD_SEQ_MULTIPLE_OPTS
         //-----------------------------------------------------------------------------
@@ -102,30 +103,33 @@
                 }
             }
 
-            TIdx const S = MATMUL_SEQ_BLOCK_FACTOR;
+            SMatMulTuneParams const * const pTune = matmul_tune_get(m, n, k);
+            TIdx const MC = pTune->uiSeqBlockMC;
+            TIdx const KC = pTune->uiSeqBlockKC;
+            TIdx const NC = pTune->uiSeqBlockNC;
 
-            //for(TIdx ii = 0; ii<m; ii += S)    // Blocking of outermost loop is not necessary, we only need blocks in 2 dimensions.
+            // The NC columns of a row of C stay in the level 1 cache, the KC x NC block of B in the level 2 cache and the MC rows of A and C in the level 3 cache.
+            for(TIdx jj = 0; jj<n; jj += NC)
             {
-                //TIdx const iiS = ii+S;
-                for(TIdx kk = 0; kk<k; kk += S)
+                TIdx const jjNC = jj+NC;
+                TIdx const uiUpperBoundj = (jjNC>n ? n : jjNC);
+                for(TIdx ii = 0; ii<m; ii += MC)
                 {
-                    TIdx const kkS = kk+S;
-                    for(TIdx jj = 0; jj<n; jj += S)
+                    TIdx const iiMC = ii+MC;
+                    TIdx const uiUpperBoundi = (iiMC>m ? m : iiMC);
+                    for(TIdx kk = 0; kk<k; kk += KC)
                     {
-                        TIdx const jjS = jj+S;
-                        //TIdx const uiUpperBoundi = (iiS>m ? m : iiS);
-                        //for(TIdx i = ii; i < uiUpperBoundi; ++i)
+                        TIdx const kkKC = kk+KC;
+                        TIdx const uiUpperBoundk = (kkKC>k ? k : kkKC);
 
-                        TIdx uiRowBeginIdxC = 0;
-                        TIdx uiRowBeginIdxA = 0;
-                        for(TIdx i = 0; i<m; ++i)
+                        TIdx uiRowBeginIdxC = ii*ldc;
+                        TIdx uiRowBeginIdxA = ii*lda;
+                        for(TIdx i = ii; i<uiUpperBoundi; ++i)
                         {
                             TIdx uiRowBeginIdxB = kk*ldb;
-                            TIdx const uiUpperBoundk = (kkS>k ? k : kkS);
                             for(TIdx k2 = kk; k2<uiUpperBoundk; ++k2)
                             {
                                 TElem const a = alpha * A[uiRowBeginIdxA + k2];
-                                TIdx const uiUpperBoundj = (jjS>n ? n : jjS);
                                 for(TIdx j = jj; j<uiUpperBoundj; ++j)
                                 {
                                     TIdx uiIdxC = uiRowBeginIdxC + j;
@@ -0,0 +1,625 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_PACKED
+
+    #include <matmul/seq/Packed.h>
+
+    #include <matmul/seq/MicroKernel.h> // matmul_micro_kernel_get_s, matmul_micro_kernel_get_d, matmul_micro_kernel_find_s, matmul_micro_kernel_find_d, SMatMulMicroKernel
+    #include <matmul/seq/Epilogue.h>    // matmul_epilogue_apply_tile_s, matmul_epilogue_apply_tile_d, SMatMulEpilogue
+    #include <matmul/seq/Prologue.h>    // matmul_prologue_apply_micro_panel_s, matmul_prologue_apply_micro_panel_d, SMatMulPrologue
+    #include <matmul/seq/Small.h>       // matmul_gemm_seq_small_get
+    #include <matmul/common/Alloc.h>    // matmul_arr_aligned_alloc_internal, matmul_arr_aligned_free_internal
+    #include <matmul/common/Mat.h>      // matmul_mat_parse_op
+    #include <matmul/common/Tune.h>     // matmul_tune_get_s, matmul_tune_get_d, matmul_tune_get
+    #include <matmul/common/Half.h>     // matmul_bf16_to_float, matmul_fp16_to_float, matmul_arr_bf16_to_float, matmul_arr_float_to_bf16
+
+    #include <stdbool.h>                // bool
+    #include <stdio.h>                  // printf
+    #include <stdlib.h>                 // malloc, free
+
+    //-----------------------------------------------------------------------------
+    // The instantiations for float, double, the mixed float operands with double accumulation and the 16 bit operands with float accumulation.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_PACKED_T_IN float
+    #define MATMUL_PACKED_T float
+    #define MATMUL_PACKED_SUFFIX s
+    #define MATMUL_PACKED_KERNEL_SUFFIX s
+    #define MATMUL_PACKED_MICRO_KERNEL SMatMulMicroKernelS
+    #define MATMUL_PACKED_EPILOGUE SMatMulEpilogueS
+    #define MATMUL_PACKED_PROLOGUE SMatMulPrologueS
+    #include <matmul/seq/PackedTemplate.h>
+
+    #define MATMUL_PACKED_T_IN double
+    #define MATMUL_PACKED_T double
+    #define MATMUL_PACKED_SUFFIX d
+    #define MATMUL_PACKED_KERNEL_SUFFIX d
+    #define MATMUL_PACKED_MICRO_KERNEL SMatMulMicroKernelD
+    #define MATMUL_PACKED_EPILOGUE SMatMulEpilogueD
+    #define MATMUL_PACKED_PROLOGUE SMatMulPrologueD
+    #include <matmul/seq/PackedTemplate.h>
+
+    // The float operands are widened while packing so the double micro-kernels accumulate in double precision.
+    #define MATMUL_PACKED_T_IN float
+    #define MATMUL_PACKED_T double
+    #define MATMUL_PACKED_SUFFIX ds
+    #define MATMUL_PACKED_KERNEL_SUFFIX d
+    #define MATMUL_PACKED_MICRO_KERNEL SMatMulMicroKernelD
+    #define MATMUL_PACKED_EPILOGUE SMatMulEpilogueD
+    #define MATMUL_PACKED_PROLOGUE SMatMulPrologueD
+    #include <matmul/seq/PackedTemplate.h>
+
+    // The 16 bit operands are converted to float while packing so the float micro-kernels accumulate in single precision.
+    #define MATMUL_PACKED_T_IN TMatMulBf16
+    #define MATMUL_PACKED_T float
+    #define MATMUL_PACKED_SUFFIX sb
+    #define MATMUL_PACKED_KERNEL_SUFFIX s
+    #define MATMUL_PACKED_MICRO_KERNEL SMatMulMicroKernelS
+    #define MATMUL_PACKED_EPILOGUE SMatMulEpilogueS
+    #define MATMUL_PACKED_PROLOGUE SMatMulPrologueS
+    #define MATMUL_PACKED_LOAD(x) matmul_bf16_to_float(x)
+    #include <matmul/seq/PackedTemplate.h>
+
+    #define MATMUL_PACKED_T_IN TMatMulFp16
+    #define MATMUL_PACKED_T float
+    #define MATMUL_PACKED_SUFFIX sh
+    #define MATMUL_PACKED_KERNEL_SUFFIX s
+    #define MATMUL_PACKED_MICRO_KERNEL SMatMulMicroKernelS
+    #define MATMUL_PACKED_EPILOGUE SMatMulEpilogueS
+    #define MATMUL_PACKED_PROLOGUE SMatMulPrologueS
+    #define MATMUL_PACKED_LOAD(x) matmul_fp16_to_float(x)
+    #include <matmul/seq/PackedTemplate.h>
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_bgemm_seq_packed(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        float const alpha,
+        TMatMulBf16 const * const MATMUL_RESTRICT A, TIdx const lda,
+        TMatMulBf16 const * const MATMUL_RESTRICT B, TIdx const ldb,
+        float const beta,
+        TMatMulBf16 * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        bool bTransA, bTransB;
+        if(!matmul_mat_parse_op(transA, &bTransA) || !matmul_mat_parse_op(transB, &bTransB))
+        {
+            printf("[GEMM Packed] Invalid transposition '%c' '%c'! Only 'N', 'T' and 'C' are supported.\n", transA, transB);
+            return;
+        }
+        if((m == 0) || (n == 0))
+        {
+            return;
+        }
+
+        // Rounding C to bfloat16 after each panel along k would lose precision.
+        // Each column block of C is therefore computed in float and rounded once.
+        // The blocks have the width of the packed panels of B so that no operand is packed more often than by matmul_sbgemm_seq_packed.
+        TIdx const NC = matmul_tune_get_s(m, n, k)->uiPackedNC;
+        TIdx const uiMaxNc = (n<NC) ? n : NC;
+        float * const pBlockC = (float *)matmul_arr_aligned_alloc_internal(m*uiMaxNc*sizeof(float));
+        if(!pBlockC)
+        {
+            printf("[GEMM Packed] The packing buffers could not be allocated!\n");
+            return;
+        }
+
+        for(TIdx jc = 0; jc < n; jc += NC)
+        {
+            TIdx const nc = ((n-jc)<NC) ? (n-jc) : NC;
+
+            // If beta is zero, C is not read.
+            if(beta != 0.0f)
+            {
+                for(TIdx i = 0; i < m; ++i)
+                {
+                    matmul_arr_bf16_to_float(nc, &C[i*ldc + jc], &pBlockC[i*nc]);
+                }
+            }
+
+            matmul_sbgemm_seq_packed(
+                transA, transB,
+                m, nc, k,
+                alpha,
+                A, lda,
+                bTransB ? &B[jc*ldb] : &B[jc], ldb,
+                beta,
+                pBlockC, nc);
+
+            for(TIdx i = 0; i < m; ++i)
+            {
+                matmul_arr_float_to_bf16(nc, &pBlockC[i*nc], &C[i*ldc + jc]);
+            }
+        }
+
+        matmul_arr_aligned_free_internal(pBlockC);
+    }
+
+    //-----------------------------------------------------------------------------
+    // The TElem versions forward to the instantiation of the configured element type.
+    //-----------------------------------------------------------------------------
+    #ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        #define MATMUL_PACKED_TELEM(name) name##_d
+    #else
+        #define MATMUL_PACKED_TELEM(name) name##_s
+    #endif
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_pack_a_seq(
+        TIdx const mc, TIdx const kc, TIdx const MR,
+        TElem const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+        TElem * const MATMUL_RESTRICT pPackedA)
+    {
+        MATMUL_PACKED_TELEM(matmul_pack_a_seq)(mc, kc, MR, A, rsa, csa, 0, 0, 0, pPackedA);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_pack_a_seq_prologue(
+        TIdx const mc, TIdx const kc, TIdx const MR,
+        TElem const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+        SMatMulPrologue const * const pPrologue, TIdx const row, TIdx const col,
+        TElem * const MATMUL_RESTRICT pPackedA)
+    {
+        MATMUL_PACKED_TELEM(matmul_pack_a_seq)(mc, kc, MR, A, rsa, csa, pPrologue, row, col, pPackedA);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_pack_b_seq(
+        TIdx const kc, TIdx const nc, TIdx const NR,
+        TElem const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+        TElem * const MATMUL_RESTRICT pPackedB)
+    {
+        MATMUL_PACKED_TELEM(matmul_pack_b_seq)(kc, nc, NR, B, rsb, csb, 0, 0, 0, pPackedB);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_pack_b_seq_prologue(
+        TIdx const kc, TIdx const nc, TIdx const NR,
+        TElem const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+        SMatMulPrologue const * const pPrologue, TIdx const row, TIdx const col,
+        TElem * const MATMUL_RESTRICT pPackedB)
+    {
+        MATMUL_PACKED_TELEM(matmul_pack_b_seq)(kc, nc, NR, B, rsb, csb, pPrologue, row, col, pPackedB);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_strided(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const rsa, TIdx const csa,
+        TElem const * const MATMUL_RESTRICT B, TIdx const rsb, TIdx const csb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        MATMUL_PACKED_TELEM(matmul_gemm_seq_packed_strided)(m, n, k, alpha, A, rsa, csa, B, rsb, csb, beta, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        // Packing does not pay off for tiny problems.
+        TMatMulSmallKernel const pSmallKernel = matmul_gemm_seq_small_get(m, n, k, alpha);
+        if(pSmallKernel)
+        {
+            pSmallKernel(alpha, A, lda, B, ldb, beta, C, ldc);
+            return;
+        }
+
+        matmul_gemm_seq_packed_strided(m, n, k, alpha, A, lda, 1, B, ldb, 1, beta, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_epilogue(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        SMatMulEpilogue const * const pEpilogue)
+    {
+        MATMUL_PACKED_TELEM(matmul_gemm_seq_packed_strided_fused)(m, n, k, alpha, A, lda, 1, 0, B, ldb, 1, 0, beta, C, ldc, pEpilogue);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_fused(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        SMatMulPrologue const * const pPrologueA,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        SMatMulPrologue const * const pPrologueB,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        SMatMulEpilogue const * const pEpilogue)
+    {
+        MATMUL_PACKED_TELEM(matmul_gemm_seq_packed_strided_fused)(m, n, k, alpha, A, lda, 1, pPrologueA, B, ldb, 1, pPrologueB, beta, C, ldc, pEpilogue);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_layout(
+        EMatMulLayout const eLayoutA, char const transA,
+        EMatMulLayout const eLayoutB, char const transB,
+        EMatMulLayout const eLayoutC,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        bool bTransA, bTransB;
+        if(!matmul_mat_parse_op(transA, &bTransA) || !matmul_mat_parse_op(transB, &bTransB))
+        {
+            printf("[GEMM Packed] Invalid transposition '%c' '%c'! Only 'N', 'T' and 'C' are supported.\n", transA, transB);
+            return;
+        }
+
+        // Both the transposition and the column major layout only swap the row and column strides of the operand.
+        // They are resolved while packing so neither the transpose nor a row major copy is ever formed.
+        bool const bSwapA = (bTransA != (eLayoutA == EMatMulLayoutColMajor));
+        bool const bSwapB = (bTransB != (eLayoutB == EMatMulLayoutColMajor));
+        TIdx const rsa = bSwapA ? 1 : lda;
+        TIdx const csa = bSwapA ? lda : 1;
+        TIdx const rsb = bSwapB ? 1 : ldb;
+        TIdx const csb = bSwapB ? ldb : 1;
+
+        if(eLayoutC == EMatMulLayoutRowMajor)
+        {
+            if(!bSwapA && !bSwapB)
+            {
+                matmul_gemm_seq_packed(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+            }
+            else
+            {
+                matmul_gemm_seq_packed_strided(m, n, k, alpha, A, rsa, csa, B, rsb, csb, beta, C, ldc);
+            }
+        }
+        else
+        {
+            // A column major C is the row major C^T = op(B)^T * op(A)^T.
+            // The micro-kernel therefore still writes contiguous rows of the row major view.
+            matmul_gemm_seq_packed_strided(n, m, k, alpha, B, csb, rsb, A, csa, rsa, beta, C, ldc);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_trans(
+        char const transA, char const transB,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        matmul_gemm_seq_packed_layout(
+            EMatMulLayoutRowMajor, transA,
+            EMatMulLayoutRowMajor, transB,
+            EMatMulLayoutRowMajor,
+            m, n, k,
+            alpha,
+            A, lda,
+            B, ldb,
+            beta,
+            C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //! The packed B behind the opaque handle.
+    //!
+    //! The panels are stored column block by column block. Inside a column block the panels along k follow each other.
+    //! Because NC is a multiple of NR, the column block starting at column jc begins at element jc*k and its panel starting at row pc at jc*k + ncp*pc, where ncp is the block width rounded up to NR.
+    //-----------------------------------------------------------------------------
+    struct SMatMulPackedB
+    {
+        TIdx k;                                     //!< The number of rows.
+        TIdx n;                                     //!< The number of columns.
+        TIdx KC;                                    //!< The depth of the panels.
+        TIdx NC;                                    //!< The width of the column blocks.
+        SMatMulMicroKernel const * pMicroKernel;    //!< The micro-kernel the panels are packed for.
+        TElem * pData;                              //!< The panels.
+    };
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    SMatMulPackedB * matmul_pack_b(
+        char const transB,
+        TIdx const k, TIdx const n,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb)
+    {
+        bool bTransB;
+        if(!matmul_mat_parse_op(transB, &bTransB))
+        {
+            printf("[GEMM Packed] Invalid transposition '%c'! Only 'N', 'T' and 'C' are supported.\n", transB);
+            return 0;
+        }
+
+        SMatMulTuneParams const * const pTune = matmul_tune_get(n, n, k);
+        SMatMulMicroKernel const * pMicroKernel = (pTune->szMicroKernel[0] != '\0') ? matmul_micro_kernel_find(pTune->szMicroKernel) : 0;
+        if(!pMicroKernel)
+        {
+            pMicroKernel = matmul_micro_kernel_get();
+        }
+        TIdx const NR = pMicroKernel->uiNR;
+
+        SMatMulPackedB * const pPackedB = (SMatMulPackedB *)malloc(sizeof(SMatMulPackedB));
+        if(!pPackedB)
+        {
+            return 0;
+        }
+        pPackedB->k = k;
+        pPackedB->n = n;
+        pPackedB->KC = pTune->uiPackedKC;
+        pPackedB->NC = (pTune->uiPackedNC<NR) ? NR : (pTune->uiPackedNC/NR)*NR;
+        pPackedB->pMicroKernel = pMicroKernel;
+        TIdx const uiNumElements = ((n+NR-1)/NR)*NR*k;
+        pPackedB->pData = (uiNumElements > 0) ? (TElem *)matmul_arr_aligned_alloc_internal(uiNumElements*sizeof(TElem)) : 0;
+        if((uiNumElements > 0) && !pPackedB->pData)
+        {
+            free(pPackedB);
+            return 0;
+        }
+
+        TIdx const rsb = bTransB ? 1 : ldb;
+        TIdx const csb = bTransB ? ldb : 1;
+        for(TIdx jc = 0; jc < n; jc += pPackedB->NC)
+        {
+            TIdx const nc = ((n-jc)<pPackedB->NC) ? (n-jc) : pPackedB->NC;
+            TIdx const ncp = ((nc+NR-1)/NR)*NR;
+            for(TIdx pc = 0; pc < k; pc += pPackedB->KC)
+            {
+                TIdx const kc = ((k-pc)<pPackedB->KC) ? (k-pc) : pPackedB->KC;
+                matmul_pack_b_seq(kc, nc, NR, &B[pc*rsb + jc*csb], rsb, csb, &pPackedB->pData[jc*k + ncp*pc]);
+            }
+        }
+
+        return pPackedB;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_packed_b_free(
+        SMatMulPackedB * const pPackedB)
+    {
+        if(pPackedB)
+        {
+            matmul_arr_aligned_free_internal(pPackedB->pData);
+            free(pPackedB);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_b(
+        char const transA,
+        TIdx const m,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        SMatMulPackedB const * const pPackedB,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        bool bTransA;
+        if(!matmul_mat_parse_op(transA, &bTransA))
+        {
+            printf("[GEMM Packed] Invalid transposition '%c'! Only 'N', 'T' and 'C' are supported.\n", transA);
+            return;
+        }
+
+        TIdx const n = pPackedB->n;
+        TIdx const k = pPackedB->k;
+        if(MATMUL_PACKED_TELEM(matmul_gemm_seq_packed_without_product)(m, n, k, alpha, beta, C, ldc))
+        {
+            return;
+        }
+
+        // The row blocks of A can follow the shape class of the actual problem, the rest is fixed by the packed B.
+        TIdx const MR = pPackedB->pMicroKernel->uiMR;
+        TIdx const NR = pPackedB->pMicroKernel->uiNR;
+        TIdx const uiPackedMC = matmul_tune_get(m, n, k)->uiPackedMC;
+        TIdx const MC = (uiPackedMC<MR) ? MR : (uiPackedMC/MR)*MR;
+        TIdx const KC = pPackedB->KC;
+        TIdx const NC = pPackedB->NC;
+
+        TIdx const uiMaxMc = (m<MC) ? m : MC;
+        TIdx const uiMaxKc = (k<KC) ? k : KC;
+        TElem * const pPackedA = (TElem *)matmul_arr_aligned_alloc_internal(((uiMaxMc+MR-1)/MR)*MR*uiMaxKc*sizeof(TElem));
+        if(!pPackedA)
+        {
+            printf("[GEMM Packed] The packing buffers could not be allocated!\n");
+            return;
+        }
+
+        TIdx const rsa = bTransA ? 1 : lda;
+        TIdx const csa = bTransA ? lda : 1;
+        for(TIdx jc = 0; jc < n; jc += NC)
+        {
+            TIdx const nc = ((n-jc)<NC) ? (n-jc) : NC;
+            TIdx const ncp = ((nc+NR-1)/NR)*NR;
+            for(TIdx pc = 0; pc < k; pc += KC)
+            {
+                TIdx const kc = ((k-pc)<KC) ? (k-pc) : KC;
+
+                // C is only scaled by beta when adding the first panel.
+                MATMUL_PACKED_TELEM(matmul_gemm_seq_packed_panel)(
+                    m, nc, kc,
+                    MC,
+                    pPackedB->pMicroKernel,
+                    alpha,
+                    &A[pc*csa], rsa, csa,
+                    &pPackedB->pData[jc*k + ncp*pc],
+                    (pc == 0) ? beta : (TElem)1,
+                    &C[jc], ldc,
+                    pPackedA,
+                    0,
+                    0,
+                    0,
+                    0,
+                    jc);
+            }
+        }
+
+        matmul_arr_aligned_free_internal(pPackedA);
+    }
+
+    //-----------------------------------------------------------------------------
+    //! The plan behind the opaque handle.
+    //-----------------------------------------------------------------------------
+    struct SMatMulPackedPlan
+    {
+        TIdx m;                                     //!< The number of rows of A and C.
+        TIdx n;                                     //!< The number of columns of B and C.
+        TIdx k;                                     //!< The number of columns of A and rows of B.
+        TMatMulSmallKernel pSmallKernel;            //!< The fixed-size kernel for the shape or 0 if there is none.
+        TIdx MC;                                    //!< The number of rows of the packed blocks of A.
+        TIdx KC;                                    //!< The depth of the packed panels.
+        TIdx NC;                                    //!< The number of columns of the packed panels of B.
+        SMatMulMicroKernel const * pMicroKernel;    //!< The micro-kernel.
+        TElem * pPackedA;                           //!< The buffer for packing A.
+        TElem * pPackedB;                           //!< The buffer for packing B.
+    };
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    SMatMulPackedPlan * matmul_gemm_seq_packed_plan_create(
+        TIdx const m, TIdx const n, TIdx const k)
+    {
+        SMatMulPackedPlan * const pPlan = (SMatMulPackedPlan *)malloc(sizeof(SMatMulPackedPlan));
+        if(!pPlan)
+        {
+            return 0;
+        }
+        pPlan->m = m;
+        pPlan->n = n;
+        pPlan->k = k;
+        pPlan->pPackedA = 0;
+        pPlan->pPackedB = 0;
+
+        // Packing does not pay off for tiny problems. The kernels only depend on alpha being unequal zero which is checked when executing.
+        pPlan->pSmallKernel = matmul_gemm_seq_small_get(m, n, k, (TElem)1);
+
+        SMatMulTuneParams const * const pTune = matmul_tune_get(m, n, k);
+        pPlan->pMicroKernel = (pTune->szMicroKernel[0] != '\0') ? matmul_micro_kernel_find(pTune->szMicroKernel) : 0;
+        if(!pPlan->pMicroKernel)
+        {
+            pPlan->pMicroKernel = matmul_micro_kernel_get();
+        }
+
+        TIdx const MR = pPlan->pMicroKernel->uiMR;
+        TIdx const NR = pPlan->pMicroKernel->uiNR;
+        pPlan->MC = (pTune->uiPackedMC<MR) ? MR : (pTune->uiPackedMC/MR)*MR;
+        pPlan->KC = pTune->uiPackedKC;
+        pPlan->NC = (pTune->uiPackedNC<NR) ? NR : (pTune->uiPackedNC/NR)*NR;
+
+        if(!pPlan->pSmallKernel && (m > 0) && (n > 0) && (k > 0))
+        {
+            TIdx const uiMaxMc = (m<pPlan->MC) ? m : pPlan->MC;
+            TIdx const uiMaxKc = (k<pPlan->KC) ? k : pPlan->KC;
+            TIdx const uiMaxNc = (n<pPlan->NC) ? n : pPlan->NC;
+            pPlan->pPackedA = (TElem *)matmul_arr_aligned_alloc_internal(((uiMaxMc+MR-1)/MR)*MR*uiMaxKc*sizeof(TElem));
+            pPlan->pPackedB = (TElem *)matmul_arr_aligned_alloc_internal(((uiMaxNc+NR-1)/NR)*NR*uiMaxKc*sizeof(TElem));
+            if(!pPlan->pPackedA || !pPlan->pPackedB)
+            {
+                matmul_gemm_seq_packed_plan_destroy(pPlan);
+                return 0;
+            }
+        }
+
+        return pPlan;
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_plan_destroy(
+        SMatMulPackedPlan * const pPlan)
+    {
+        if(pPlan)
+        {
+            matmul_arr_aligned_free_internal(pPlan->pPackedA);
+            matmul_arr_aligned_free_internal(pPlan->pPackedB);
+            free(pPlan);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_packed_plan_execute(
+        SMatMulPackedPlan * const pPlan,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if(pPlan->pSmallKernel && (alpha != (TElem)0))
+        {
+            pPlan->pSmallKernel(alpha, A, lda, B, ldb, beta, C, ldc);
+            return;
+        }
+
+        if(MATMUL_PACKED_TELEM(matmul_gemm_seq_packed_without_product)(pPlan->m, pPlan->n, pPlan->k, alpha, beta, C, ldc))
+        {
+            return;
+        }
+
+        MATMUL_PACKED_TELEM(matmul_gemm_seq_packed_blocked)(
+            pPlan->m, pPlan->n, pPlan->k,
+            pPlan->MC, pPlan->KC, pPlan->NC,
+            pPlan->pMicroKernel,
+            alpha,
+            A, lda, 1,
+            B, ldb, 1,
+            beta,
+            C, ldc,
+            pPlan->pPackedA,
+            pPlan->pPackedB,
+            0,
+            0,
+            0);
+    }
+#endif
@@ -0,0 +1,103 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_PACKED
+
+    #include <matmul/seq/Prologue.h>
+
+    #include <matmul/seq/MicroKernel.h> // MATMUL_MICRO_KERNEL_MAX_NR
+
+    //-----------------------------------------------------------------------------
+    // Transforms the values of one step along k of a micro-panel with the element-wise operation OP(x).
+    //-----------------------------------------------------------------------------
+    #define MATMUL_PROLOGUE_STEP(T, OP)\
+    for(TIdx q = 0; q < r; ++q)\
+    {\
+        T const x = pValues[q];\
+        pValues[q] = fScale * aScales[q] * ((OP) - fOffset - aOffsets[q]);\
+    }
+
+    //-----------------------------------------------------------------------------
+    // The initialization and the micro-panel function for the element type T.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_PROLOGUE(T, SUFFIX, DESC)\
+    void matmul_prologue_init_##SUFFIX(\
+        DESC * const pPrologue)\
+    {\
+        pPrologue->eOp = EMatMulPrologueOpNone;\
+        pPrologue->pRowScale = 0;\
+        pPrologue->pColScale = 0;\
+        pPrologue->pRowOffset = 0;\
+        pPrologue->pColOffset = 0;\
+    }\
+\
+    void matmul_prologue_apply_micro_panel_##SUFFIX(\
+        DESC const * const pPrologue,\
+        bool const bRegisterRows,\
+        TIdx const row, TIdx const col,\
+        TIdx const kc, TIdx const r, TIdx const R,\
+        T * const MATMUL_RESTRICT pMicroPanel)\
+    {\
+        /* The vectors along the register dimension are gathered once per micro-panel. */\
+        T const * const pRegisterScales = bRegisterRows ? pPrologue->pRowScale : pPrologue->pColScale;\
+        T const * const pRegisterOffsets = bRegisterRows ? pPrologue->pRowOffset : pPrologue->pColOffset;\
+        TIdx const uiRegisterIdx = bRegisterRows ? row : col;\
+        T aScales[MATMUL_MICRO_KERNEL_MAX_NR];\
+        T aOffsets[MATMUL_MICRO_KERNEL_MAX_NR];\
+        for(TIdx q = 0; q < r; ++q)\
+        {\
+            aScales[q] = pRegisterScales ? pRegisterScales[uiRegisterIdx + q] : (T)1;\
+            aOffsets[q] = pRegisterOffsets ? pRegisterOffsets[uiRegisterIdx + q] : (T)0;\
+        }\
+\
+        T const * const pDepthScales = bRegisterRows ? pPrologue->pColScale : pPrologue->pRowScale;\
+        T const * const pDepthOffsets = bRegisterRows ? pPrologue->pColOffset : pPrologue->pRowOffset;\
+        TIdx const uiDepthIdx = bRegisterRows ? col : row;\
+        for(TIdx p = 0; p < kc; ++p)\
+        {\
+            T const fScale = pDepthScales ? pDepthScales[uiDepthIdx + p] : (T)1;\
+            T const fOffset = pDepthOffsets ? pDepthOffsets[uiDepthIdx + p] : (T)0;\
+            T * const MATMUL_RESTRICT pValues = &pMicroPanel[p*R];\
+\
+            switch(pPrologue->eOp)\
+            {\
+            case EMatMulPrologueOpNegate:\
+                MATMUL_PROLOGUE_STEP(T, -x)\
+                break;\
+            case EMatMulPrologueOpAbs:\
+                MATMUL_PROLOGUE_STEP(T, (x < (T)0) ? -x : x)\
+                break;\
+            default:\
+                MATMUL_PROLOGUE_STEP(T, x)\
+                break;\
+            }\
+        }\
+    }
+
+    MATMUL_PROLOGUE(float, s, SMatMulPrologueS)
+    MATMUL_PROLOGUE(double, d, SMatMulPrologueD)
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_prologue_init(
+        SMatMulPrologue * const pPrologue)
+    {
+#ifdef MATMUL_ELEMENT_TYPE_DOUBLE
+        matmul_prologue_init_d(pPrologue);
+#else
+        matmul_prologue_init_s(pPrologue);
+#endif
+    }
+#endif
@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_RECURSIVE
+
+    #include <matmul/seq/Recursive.h>
+
+    #include <matmul/common/Mat.h>  // matmul_mat_gemm_early_out
+
+    //-----------------------------------------------------------------------------
+    //! C += alpha * A * B for a base case of the recursion.
+    //! Four rows of C are updated at once so that each loaded element of B is used four times.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_recursive_leaf(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        TIdx i = 0;
+        for(; i + 4 <= m; i += 4)
+        {
+            TElem * const MATMUL_RESTRICT C0 = C + i*ldc;
+            TElem * const MATMUL_RESTRICT C1 = C0 + ldc;
+            TElem * const MATMUL_RESTRICT C2 = C1 + ldc;
+            TElem * const MATMUL_RESTRICT C3 = C2 + ldc;
+            for(TIdx k2 = 0; k2 < k; ++k2)
+            {
+                TElem const a0 = alpha * A[i*lda + k2];
+                TElem const a1 = alpha * A[(i+1)*lda + k2];
+                TElem const a2 = alpha * A[(i+2)*lda + k2];
+                TElem const a3 = alpha * A[(i+3)*lda + k2];
+                TElem const * const MATMUL_RESTRICT pB = B + k2*ldb;
+                for(TIdx j = 0; j < n; ++j)
+                {
+                    TElem const b = pB[j];
+                    C0[j] += a0 * b;
+                    C1[j] += a1 * b;
+                    C2[j] += a2 * b;
+                    C3[j] += a3 * b;
+                }
+            }
+        }
+        for(; i < m; ++i)
+        {
+            TElem * const MATMUL_RESTRICT C0 = C + i*ldc;
+            for(TIdx k2 = 0; k2 < k; ++k2)
+            {
+                TElem const a0 = alpha * A[i*lda + k2];
+                TElem const * const MATMUL_RESTRICT pB = B + k2*ldb;
+                for(TIdx j = 0; j < n; ++j)
+                {
+                    C0[j] += a0 * pB[j];
+                }
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //! C += alpha * A * B by halving the largest dimension until the base case is reached.
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_recursive_split(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if((m <= MATMUL_RECURSIVE_CUT_OFF) && (n <= MATMUL_RECURSIVE_CUT_OFF) && (k <= MATMUL_RECURSIVE_CUT_OFF))
+        {
+            matmul_gemm_seq_recursive_leaf(m, n, k, alpha, A, lda, B, ldb, C, ldc);
+        }
+        else if((m >= n) && (m >= k))
+        {
+            // C_0 = A_0 * B, C_1 = A_1 * B
+            TIdx const h = m/2;
+            matmul_gemm_seq_recursive_split(h, n, k, alpha, A, lda, B, ldb, C, ldc);
+            matmul_gemm_seq_recursive_split(m-h, n, k, alpha, A + h*lda, lda, B, ldb, C + h*ldc, ldc);
+        }
+        else if(n >= k)
+        {
+            // C_0 = A * B_0, C_1 = A * B_1
+            TIdx const h = n/2;
+            matmul_gemm_seq_recursive_split(m, h, k, alpha, A, lda, B, ldb, C, ldc);
+            matmul_gemm_seq_recursive_split(m, n-h, k, alpha, A, lda, B + h, ldb, C + h, ldc);
+        }
+        else
+        {
+            // C = A_0 * B_0 + A_1 * B_1
+            TIdx const h = k/2;
+            matmul_gemm_seq_recursive_split(m, n, h, alpha, A, lda, B, ldb, C, ldc);
+            matmul_gemm_seq_recursive_split(m, n, k-h, alpha, A + h, lda, B + h*ldb, ldb, C, ldc);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_recursive(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        {
+            return;
+        }
+
+        // Apply beta once so that the recursion only accumulates. With beta == 0 the old values of C are ignored, even NaN.
+        if(beta != (TElem)1)
+        {
+            for(TIdx i = 0; i < m; ++i)
+            {
+                for(TIdx j = 0; j < n; ++j)
+                {
+                    C[i*ldc + j] = (beta == (TElem)0) ? (TElem)0 : beta * C[i*ldc + j];
+                }
+            }
+        }
+
+        matmul_gemm_seq_recursive_split(m, n, k, alpha, A, lda, B, ldb, C, ldc);
+    }
+#endif
@@ -17,6 +17,7 @@
     #include <matmul/seq/SingleOpts.h>
 
     #include <matmul/common/Mat.h>  // matmul_mat_gemm_early_out
+    #include <matmul/common/Tune.h> // matmul_tune_get
 
     //-----------------------------------------------------------------------------
     // Use explicit pointer access instead of index access that requires multiplication.
@@ -316,24 +317,27 @@
             }
         }
 
-        TIdx const S = MATMUL_SEQ_BLOCK_FACTOR;
+        SMatMulTuneParams const * const pTune = matmul_tune_get(m, n, k);
+        TIdx const MC = pTune->uiSeqBlockMC;
+        TIdx const KC = pTune->uiSeqBlockKC;
+        TIdx const NC = pTune->uiSeqBlockNC;
 
-        for(TIdx ii = 0; ii<m; ii += S)
+        for(TIdx jj = 0; jj<n; jj += NC)
         {
-            TIdx const iiS = ii+S;
-            for(TIdx jj = 0; jj<n; jj += S)
+            TIdx const jjNC = jj+NC;
+            TIdx const uiUpperBoundj = (jjNC>n ? n : jjNC);
+            for(TIdx ii = 0; ii<m; ii += MC)
             {
-                TIdx const jjS = jj+S;
-                for(TIdx kk = 0; kk<k; kk += S)
+                TIdx const iiMC = ii+MC;
+                TIdx const uiUpperBoundi = (iiMC>m ? m : iiMC);
+                for(TIdx kk = 0; kk<k; kk += KC)
                 {
-                    TIdx const kkS = kk+S;
-                    TIdx const uiUpperBoundi = (iiS>m ? m : iiS);
+                    TIdx const kkKC = kk+KC;
+                    TIdx const uiUpperBoundk = (kkKC>k ? k : kkKC);
                     for(TIdx i = ii; i<uiUpperBoundi; ++i)
                     {
-                        TIdx const uiUpperBoundj = (jjS>n ? n : jjS);
                         for(TIdx j = jj; j<uiUpperBoundj; ++j)
                         {
-                            TIdx const uiUpperBoundk = (kkS>k ? k : kkS);
                             for(TIdx k2 = kk; k2<uiUpperBoundk; ++k2)
                             {
                                 C[i*ldc + j] += alpha * A[i*lda + k2] * B[k2*ldb + j];
@@ -0,0 +1,197 @@
+//-----------------------------------------------------------------------------
+//! Copyright (c) 2014-2015, Benjamin Worpitz
+//! All rights reserved.
+//!
+//! Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met :
+//! * Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+//! * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//! * Neither the name of the TU Dresden nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+//!
+//! THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//! IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//! HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//-----------------------------------------------------------------------------
+
+#ifdef MATMUL_BUILD_SEQ_SMALL
+
+    #include <matmul/seq/Small.h>
+
+    #include <matmul/seq/MultipleOpts.h>    // matmul_gemm_seq_multiple_opts
+
+    //-----------------------------------------------------------------------------
+    // Stores one row of a tile: C = alpha * AB + beta * C or C = alpha * AB if beta is zero.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_SMALL_STORE_ROW_4(pC, c0, c1, c2, c3)\
+        if(beta == (TElem)0)\
+        {\
+            (pC)[0] = alpha * (c0);\
+            (pC)[1] = alpha * (c1);\
+            (pC)[2] = alpha * (c2);\
+            (pC)[3] = alpha * (c3);\
+        }\
+        else\
+        {\
+            (pC)[0] = beta * (pC)[0] + alpha * (c0);\
+            (pC)[1] = beta * (pC)[1] + alpha * (c1);\
+            (pC)[2] = beta * (pC)[2] + alpha * (c2);\
+            (pC)[3] = beta * (pC)[3] + alpha * (c3);\
+        }
+
+    //-----------------------------------------------------------------------------
+    // The fixed-size kernels up to 16.
+    // C is computed in 2x4 tiles held in scalar accumulators which the compilers reliably keep in registers.
+    // Because N is a constant, the loop over k and the remainder handling are resolved at compile time.
+    // For odd N the last tile row is computed twice but only stored once.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_SMALL_KERNEL_TILED_DEF(N)\
+        void matmul_gemm_seq_small_##N(\
+            TElem const alpha,\
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,\
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,\
+            TElem const beta,\
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc)\
+        {\
+            for(TIdx i = 0; i < N; i += 2)\
+            {\
+                TIdx const i1 = ((i+1) < N) ? (i+1) : i;\
+                TIdx j = 0;\
+                for(; j + 4 <= N; j += 4)\
+                {\
+                    TElem c00 = (TElem)0, c01 = (TElem)0, c02 = (TElem)0, c03 = (TElem)0;\
+                    TElem c10 = (TElem)0, c11 = (TElem)0, c12 = (TElem)0, c13 = (TElem)0;\
+                    TElem const * MATMUL_RESTRICT pA0 = &A[i*lda];\
+                    TElem const * MATMUL_RESTRICT pA1 = &A[i1*lda];\
+                    TElem const * MATMUL_RESTRICT pB = &B[j];\
+                    for(TIdx p = 0; p < N; ++p)\
+                    {\
+                        TElem const a0 = *pA0++;\
+                        TElem const a1 = *pA1++;\
+                        c00 += a0 * pB[0]; c01 += a0 * pB[1]; c02 += a0 * pB[2]; c03 += a0 * pB[3];\
+                        c10 += a1 * pB[0]; c11 += a1 * pB[1]; c12 += a1 * pB[2]; c13 += a1 * pB[3];\
+                        pB += ldb;\
+                    }\
+                    MATMUL_SMALL_STORE_ROW_4(&C[i*ldc + j], c00, c01, c02, c03)\
+                    if(i1 != i)\
+                    {\
+                        MATMUL_SMALL_STORE_ROW_4(&C[i1*ldc + j], c10, c11, c12, c13)\
+                    }\
+                }\
+                for(; j < N; ++j)\
+                {\
+                    TElem c0 = (TElem)0, c1 = (TElem)0;\
+                    for(TIdx p = 0; p < N; ++p)\
+                    {\
+                        TElem const b = B[p*ldb + j];\
+                        c0 += A[i*lda + p] * b;\
+                        c1 += A[i1*lda + p] * b;\
+                    }\
+                    C[i*ldc + j] = (beta == (TElem)0) ? alpha * c0 : beta * C[i*ldc + j] + alpha * c0;\
+                    if(i1 != i)\
+                    {\
+                        C[i1*ldc + j] = (beta == (TElem)0) ? alpha * c1 : beta * C[i1*ldc + j] + alpha * c1;\
+                    }\
+                }\
+            }\
+        }
+    MATMUL_SMALL_SIZES_TILED(MATMUL_SMALL_KERNEL_TILED_DEF)
+    #undef MATMUL_SMALL_KERNEL_TILED_DEF
+
+    //-----------------------------------------------------------------------------
+    // The fixed-size kernels above 16.
+    // One row of C is accumulated in a local array of constant size and the loop over its columns is vectorized.
+    //-----------------------------------------------------------------------------
+    #define MATMUL_SMALL_KERNEL_DEF(N)\
+        void matmul_gemm_seq_small_##N(\
+            TElem const alpha,\
+            TElem const * const MATMUL_RESTRICT A, TIdx const lda,\
+            TElem const * const MATMUL_RESTRICT B, TIdx const ldb,\
+            TElem const beta,\
+            TElem * const MATMUL_RESTRICT C, TIdx const ldc)\
+        {\
+            for(TIdx i = 0; i < N; ++i)\
+            {\
+                TElem AB[N];\
+                for(TIdx j = 0; j < N; ++j)\
+                {\
+                    AB[j] = (TElem)0;\
+                }\
+                TElem const * MATMUL_RESTRICT pA = &A[i*lda];\
+                TElem const * MATMUL_RESTRICT pB = B;\
+                for(TIdx p = 0; p < N; ++p)\
+                {\
+                    TElem const a = *pA++;\
+                    for(TIdx j = 0; j < N; ++j)\
+                    {\
+                        AB[j] += a * pB[j];\
+                    }\
+                    pB += ldb;\
+                }\
+                TElem * const MATMUL_RESTRICT pC = &C[i*ldc];\
+                if(beta == (TElem)0)\
+                {\
+                    for(TIdx j = 0; j < N; ++j)\
+                    {\
+                        pC[j] = alpha * AB[j];\
+                    }\
+                }\
+                else\
+                {\
+                    for(TIdx j = 0; j < N; ++j)\
+                    {\
+                        pC[j] = beta * pC[j] + alpha * AB[j];\
+                    }\
+                }\
+            }\
+        }
+    MATMUL_SMALL_SIZES_ROWS(MATMUL_SMALL_KERNEL_DEF)
+    #undef MATMUL_SMALL_KERNEL_DEF
+    #undef MATMUL_SMALL_STORE_ROW_4
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    TMatMulSmallKernel matmul_gemm_seq_small_get(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha)
+    {
+        #define MATMUL_SMALL_KERNEL_PTR(N) matmul_gemm_seq_small_##N,
+        static TMatMulSmallKernel const apKernels[] = {
+            MATMUL_SMALL_SIZES(MATMUL_SMALL_KERNEL_PTR)
+        };
+        #undef MATMUL_SMALL_KERNEL_PTR
+
+        if((m == n) && (n == k)
+            && (m >= MATMUL_SMALL_MIN_SIZE) && (m <= MATMUL_SMALL_MAX_SIZE)
+            && (alpha != (TElem)0))
+        {
+            return apKernels[m - MATMUL_SMALL_MIN_SIZE];
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_small(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        // The size check is done before the early out so that the tiny calls pay as little as possible.
+        TMatMulSmallKernel const pKernel = matmul_gemm_seq_small_get(m, n, k, alpha);
+        if(pKernel)
+        {
+            pKernel(alpha, A, lda, B, ldb, beta, C, ldc);
+        }
+        else
+        {
+            matmul_gemm_seq_multiple_opts(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+        }
+    }
+#endif
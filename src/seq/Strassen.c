@@ -18,12 +18,12 @@
 
     #include <matmul/seq/MultipleOpts.h>    // matmul_gemm_seq_multiple_opts
 
-    #include <matmul/common/Alloc.h>        // matmul_arr_alloc
-    #include <matmul/common/Array.h>        // matmul_arr_alloc_fill_zero
+    #include <matmul/common/Alloc.h>        // matmul_arr_alloc, matmul_arr_free
     #include <matmul/common/Mat.h>          // matmul_mat_gemm_early_out
+    #include <matmul/common/Tune.h>         // matmul_tune_get
 
     #include <assert.h>                     // assert
-    #include <stdio.h>                      // printf
+    #include <stdbool.h>                    // bool
 
     //-----------------------------------------------------------------------------
     //! Adapted from http://ezekiel.vancouver.wsu.edu/~cs330/lectures/linear_algebra/mm/mm.c W. Cochran  wcochran@vancouver.wsu.edu
@@ -62,19 +62,21 @@
     //-----------------------------------------------------------------------------
     //
     //-----------------------------------------------------------------------------
-    void matmul_mat_add2_pitch_seq(
+    void matmul_mat_sub_pitch_seq(
         TIdx const m, TIdx const n,
         TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
         TElem * const MATMUL_RESTRICT C, TIdx const ldc)
     {
 #ifdef MATMUL_MSVC
         for(TIdx i = 0; i < m; ++i)
         {
             TIdx const uiRowBeginIdxA = i*lda;
+            TIdx const uiRowBeginIdxB = i*ldb;
             TIdx const uiRowBeginIdxC = i*ldc;
             for(TIdx j = 0; j < n; ++j)
             {
-                C[uiRowBeginIdxC + j] += A[uiRowBeginIdxA + j];
+                C[uiRowBeginIdxC + j] = A[uiRowBeginIdxA + j] - B[uiRowBeginIdxB + j];
             }
         }
 #else
@@ -82,7 +84,7 @@
         {
             for(TIdx j = 0; j < n; ++j)
             {
-                C[i*ldc + j] += A[i*lda + j];
+                C[i*ldc + j] = A[i*lda + j] - B[i*ldb + j];
             }
         }
 #endif
@@ -90,24 +92,29 @@
     //-----------------------------------------------------------------------------
     //
     //-----------------------------------------------------------------------------
-    void matmul_mat_sub_pitch_seq(
+    void matmul_mat_add_pitch_inplace_seq(
         TIdx const m, TIdx const n,
-        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
-        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
-        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+        TElem const * const A, TIdx const lda,
+        TElem const * const B, TIdx const ldb,
+        TElem * const C, TIdx const ldc)
     {
-#ifdef MATMUL_MSVC
         for(TIdx i = 0; i < m; ++i)
         {
-            TIdx const uiRowBeginIdxA = i*lda;
-            TIdx const uiRowBeginIdxB = i*ldb;
-            TIdx const uiRowBeginIdxC = i*ldc;
             for(TIdx j = 0; j < n; ++j)
             {
-                C[uiRowBeginIdxC + j] = A[uiRowBeginIdxA + j] - B[uiRowBeginIdxB + j];
+                C[i*ldc + j] = A[i*lda + j] + B[i*ldb + j];
             }
         }
-#else
+    }
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_mat_sub_pitch_inplace_seq(
+        TIdx const m, TIdx const n,
+        TElem const * const A, TIdx const lda,
+        TElem const * const B, TIdx const ldb,
+        TElem * const C, TIdx const ldc)
+    {
         for(TIdx i = 0; i < m; ++i)
         {
             for(TIdx j = 0; j < n; ++j)
@@ -115,133 +122,483 @@
                 C[i*ldc + j] = A[i*lda + j] - B[i*ldb + j];
             }
         }
-#endif
     }
 
     //-----------------------------------------------------------------------------
     //
     //-----------------------------------------------------------------------------
-    void matmul_gemm_seq_strassen(
+    void matmul_mat_add_sum_pitch_seq(
+        TIdx const m, TIdx const n,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const fSign,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        bool const bOverwrite,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if(bOverwrite)
+        {
+            for(TIdx i = 0; i < m; ++i)
+            {
+                for(TIdx j = 0; j < n; ++j)
+                {
+                    C[i*ldc + j] = A[i*lda + j] + fSign * B[i*ldb + j];
+                }
+            }
+        }
+        else
+        {
+            for(TIdx i = 0; i < m; ++i)
+            {
+                for(TIdx j = 0; j < n; ++j)
+                {
+                    C[i*ldc + j] += A[i*lda + j] + fSign * B[i*ldb + j];
+                }
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    bool matmul_gemm_seq_strassen_is_leaf(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k)
+    {
+        TIdx const uiMinSize = (m<n) ? ((m<k) ? m : k) : ((n<k) ? n : k);
+        return (uiMinSize <= uiCutOff) || (uiMinSize < 2);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_leaf(
         TIdx const m, TIdx const n, TIdx const k,
         TElem const alpha,
-        TElem const * const MATMUL_RESTRICT X, TIdx const lda,
-        TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
         TElem const beta,
-        TElem * const MATMUL_RESTRICT Z, TIdx const ldc)
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
     {
-        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        if(beta != (TElem)1)
         {
-            return;
+            for(TIdx i = 0; i < m; ++i)
+            {
+                for(TIdx j = 0; j < n; ++j)
+                {
+                    C[i*ldc + j] = (beta == (TElem)0) ? (TElem)0 : beta * C[i*ldc + j];
+                }
+            }
         }
+        matmul_gemm_seq_multiple_opts(m, n, k, alpha, A, lda, B, ldb, (TElem)1, C, ldc);
+    }
 
-        // Apply beta multiplication to C.
-        if(beta != (TElem)1)
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_peel(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        TIdx const m2 = m - (m % 2);
+        TIdx const n2 = n - (n % 2);
+        TIdx const k2 = k - (k % 2);
+
+        if(k2 < k)
+        {
+            matmul_gemm_seq_multiple_opts(m2, n2, k-k2, alpha, A + k2, lda, B + k2*ldb, ldb, (TElem)1, C, ldc);
+        }
+        if(n2 < n)
+        {
+            matmul_gemm_seq_strassen_leaf(m2, n-n2, k, alpha, A, lda, B + n2, ldb, beta, C + n2, ldc);
+        }
+        if(m2 < m)
+        {
+            matmul_gemm_seq_strassen_leaf(m-m2, n, k, alpha, A + m2*lda, lda, B, ldb, beta, C + m2*ldc, ldc);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_scale(
+        TIdx const m, TIdx const n,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        if((beta != (TElem)1) && (beta != (TElem)0))
         {
             for(TIdx i = 0; i < m; ++i)
             {
                 for(TIdx j = 0; j < n; ++j)
                 {
-                    Z[i*ldc + j] *= beta;
+                    C[i*ldc + j] *= beta;
                 }
             }
         }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    TIdx matmul_gemm_seq_strassen_workspace_size(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k)
+    {
+        // The recursion ends at the same sizes as in matmul_gemm_seq_strassen_workspace.
+        if(matmul_gemm_seq_strassen_is_leaf(uiCutOff, m, n, k))
+        {
+            return 0;
+        }
+
+        TIdx const hm = m/2;
+        TIdx const hn = n/2;
+        TIdx const hk = k/2;
+        return 7*hm*hn + hm*hk + hk*hn + matmul_gemm_seq_strassen_workspace_size(uiCutOff, hm, hn, hk);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_workspace(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT Z, TIdx const ldc,
+        TElem * const MATMUL_RESTRICT pWorkspace)
+    {
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        {
+            return;
+        }
+
+        // Recursive base case.
+        // If the matrices are smaller then the cutoff size we just use the conventional algorithm.
+        if((alpha == (TElem)0) || matmul_gemm_seq_strassen_is_leaf(uiCutOff, m, n, k))
+        {
+            matmul_gemm_seq_strassen_leaf(m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc);
+            return;
+        }
+
+        TIdx const hm = m/2;            // size of sub-matrices
+        TIdx const hn = n/2;
+        TIdx const hk = k/2;
+
+        // Apply beta multiplication to the even sized part of C. For beta == 0 its quadrants are written directly without reading them.
+        matmul_gemm_seq_strassen_scale(2*hm, 2*hn, beta, Z, ldc);
+
+        TElem const * const A = X;      // A-D matrices embedded in X
+        TElem const * const B = X + hk;
+        TElem const * const C = X + hm*lda;
+        TElem const * const D = C + hk;
+
+        TElem const * const E = Y;      // E-H matrices embeded in Y
+        TElem const * const F = Y + hn;
+        TElem const * const G = Y + hk*ldb;
+        TElem const * const H = G + hn;
+
+        // Take the temporary matrices from the workspace. The rest of it is used by the recursive calls.
+        // T holds the sums of the quadrants of X, U the ones of Y.
+        TIdx const uiNumElements = hm * hn;
+        TElem * P[7];
+        for(TIdx i = 0; i < 7; ++i)
+        {
+            P[i] = pWorkspace + i*uiNumElements;
+        }
+        TElem * const T = pWorkspace + 7*uiNumElements;
+        TElem * const U = T + hm*hk;
+        TElem * const pWorkspaceRec = U + hk*hn;
+
+        // P0 = A*(F - H);
+        matmul_mat_sub_pitch_seq(hk, hn, F, ldb, H, ldb, U, hn);
+        matmul_gemm_seq_strassen_workspace(uiCutOff, hm, hn, hk, alpha, A, lda, U, hn, (TElem)0, P[0], hn, pWorkspaceRec);
+
+        // P1 = (A + B)*H
+        matmul_mat_add_pitch_seq(hm, hk, A, lda, B, lda, T, hk);
+        matmul_gemm_seq_strassen_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, H, ldb, (TElem)0, P[1], hn, pWorkspaceRec);
+
+        // P2 = (C + D)*E
+        matmul_mat_add_pitch_seq(hm, hk, C, lda, D, lda, T, hk);
+        matmul_gemm_seq_strassen_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, E, ldb, (TElem)0, P[2], hn, pWorkspaceRec);
+
+        // P3 = D*(G - E);
+        matmul_mat_sub_pitch_seq(hk, hn, G, ldb, E, ldb, U, hn);
+        matmul_gemm_seq_strassen_workspace(uiCutOff, hm, hn, hk, alpha, D, lda, U, hn, (TElem)0, P[3], hn, pWorkspaceRec);
+
+        // P4 = (A + D)*(E + H)
+        matmul_mat_add_pitch_seq(hm, hk, A, lda, D, lda, T, hk);
+        matmul_mat_add_pitch_seq(hk, hn, E, ldb, H, ldb, U, hn);
+        matmul_gemm_seq_strassen_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, U, hn, (TElem)0, P[4], hn, pWorkspaceRec);
+
+        // P5 = (B - D)*(G + H)
+        matmul_mat_sub_pitch_seq(hm, hk, B, lda, D, lda, T, hk);
+        matmul_mat_add_pitch_seq(hk, hn, G, ldb, H, ldb, U, hn);
+        matmul_gemm_seq_strassen_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, U, hn, (TElem)0, P[5], hn, pWorkspaceRec);
+
+        // P6 = (A - C)*(E + F)
+        matmul_mat_sub_pitch_seq(hm, hk, A, lda, C, lda, T, hk);
+        matmul_mat_add_pitch_seq(hk, hn, E, ldb, F, ldb, U, hn);
+        matmul_gemm_seq_strassen_workspace(uiCutOff, hm, hn, hk, alpha, T, hk, U, hn, (TElem)0, P[6], hn, pWorkspaceRec);
+
+        bool const bOverwrite = (beta == (TElem)0);
+
+        // Z upper left = (P3 + P4) + (P5 - P1)
+        matmul_mat_add_sum_pitch_seq(hm, hn, P[4], hn, (TElem)1, P[3], hn, bOverwrite, Z, ldc);
+        matmul_mat_add_sum_pitch_seq(hm, hn, P[5], hn, (TElem)-1, P[1], hn, false, Z, ldc);
+
+        // Z lower left = P2 + P3
+        matmul_mat_add_sum_pitch_seq(hm, hn, P[2], hn, (TElem)1, P[3], hn, bOverwrite, Z + hm*ldc, ldc);
+
+        // Z upper right = P0 + P1
+        matmul_mat_add_sum_pitch_seq(hm, hn, P[0], hn, (TElem)1, P[1], hn, bOverwrite, Z + hn, ldc);
+
+        // Z lower right = (P0 - P2) + (P4 - P6)
+        matmul_mat_add_sum_pitch_seq(hm, hn, P[0], hn, (TElem)-1, P[2], hn, bOverwrite, Z + hm*ldc + hn, ldc);
+        matmul_mat_add_sum_pitch_seq(hm, hn, P[4], hn, (TElem)-1, P[6], hn, false, Z + hm*ldc + hn, ldc);
+
+        matmul_gemm_seq_strassen_peel(m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    TIdx matmul_gemm_seq_strassen_winograd_workspace_size(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k)
+    {
+        // The recursion ends at the same sizes as in matmul_gemm_seq_strassen_winograd_workspace.
+        if(matmul_gemm_seq_strassen_is_leaf(uiCutOff, m, n, k))
+        {
+            return 0;
+        }
+
+        // Accumulating into C needs three temporaries, overwriting it only two. The levels below may accumulate.
+        // X holds a sum of quadrants of A or a product.
+        TIdx const hm = m/2;
+        TIdx const hn = n/2;
+        TIdx const hk = k/2;
+        return ((hk<hn) ? hm*hn : hm*hk) + hk*hn + hm*hn + matmul_gemm_seq_strassen_winograd_workspace_size(uiCutOff, hm, hn, hk);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_winograd_workspace(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc,
+        TElem * const MATMUL_RESTRICT pWorkspace)
+    {
+        if(matmul_mat_gemm_early_out(m, n, k, alpha, beta))
+        {
+            return;
+        }
 
         // Recursive base case.
         // If the matrices are smaller then the cutoff size we just use the conventional algorithm.
-        if((n % 2 == 1) || (n <= MATMUL_STRASSEN_CUT_OFF))
+        if((alpha == (TElem)0) || matmul_gemm_seq_strassen_is_leaf(uiCutOff, m, n, k))
+        {
+            matmul_gemm_seq_strassen_leaf(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+            return;
+        }
+
+        TIdx const hm = m/2;            // size of sub-matrices
+        TIdx const hn = n/2;
+        TIdx const hk = k/2;
+
+        TElem const * const A11 = A;
+        TElem const * const A12 = A + hk;
+        TElem const * const A21 = A + hm*lda;
+        TElem const * const A22 = A21 + hk;
+
+        TElem const * const B11 = B;
+        TElem const * const B12 = B + hn;
+        TElem const * const B21 = B + hk*ldb;
+        TElem const * const B22 = B21 + hn;
+
+        TElem * const C11 = C;
+        TElem * const C12 = C + hn;
+        TElem * const C21 = C + hm*ldc;
+        TElem * const C22 = C21 + hn;
+
+        // X holds the sums of quadrants of A, Y the ones of B and Z products. The rest of the workspace is used by the recursive calls.
+        TElem * const X = pWorkspace;
+        TElem * const Y = X + ((hk<hn) ? hm*hn : hm*hk);
+        TElem * const Z = Y + hk*hn;
+        TElem * const pWorkspaceRec = Z + hm*hn;
+
+        if(beta == (TElem)0)
         {
-            matmul_gemm_seq_multiple_opts(m, n, k, alpha, X, lda, Y, ldb, (TElem)1, Z, ldc);
+            // C := alpha*A*B with two temporaries. Each quadrant of C holds a product or partial result as soon as it is written.
+
+            // C21 = P7 = S3*T3
+            matmul_mat_sub_pitch_inplace_seq(hm, hk, A11, lda, A21, lda, X, hk);
+            matmul_mat_sub_pitch_inplace_seq(hk, hn, B22, ldb, B12, ldb, Y, hn);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, X, hk, Y, hn, (TElem)0, C21, ldc, pWorkspaceRec);
+
+            // C22 = P5 = S1*T1
+            matmul_mat_add_pitch_inplace_seq(hm, hk, A21, lda, A22, lda, X, hk);
+            matmul_mat_sub_pitch_inplace_seq(hk, hn, B12, ldb, B11, ldb, Y, hn);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, X, hk, Y, hn, (TElem)0, C22, ldc, pWorkspaceRec);
+
+            // C12 = P6 = S2*T2
+            matmul_mat_sub_pitch_inplace_seq(hm, hk, X, hk, A11, lda, X, hk);
+            matmul_mat_sub_pitch_inplace_seq(hk, hn, B22, ldb, Y, hn, Y, hn);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, X, hk, Y, hn, (TElem)0, C12, ldc, pWorkspaceRec);
+
+            // C11 = P3 = S4*B22
+            matmul_mat_sub_pitch_inplace_seq(hm, hk, A12, lda, X, hk, X, hk);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, X, hk, B22, ldb, (TElem)0, C11, ldc, pWorkspaceRec);
+
+            // X = P1 = A11*B11
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, A11, lda, B11, ldb, (TElem)0, X, hn, pWorkspaceRec);
+
+            // C12 = U2 = P1 + P6, C21 = U3 = U2 + P7, C12 = U4 = U2 + P5, C22 = U7 = U3 + P5, C12 = U5 = U4 + P3
+            matmul_mat_add_pitch_inplace_seq(hm, hn, X, hn, C12, ldc, C12, ldc);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C12, ldc, C21, ldc, C21, ldc);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C12, ldc, C22, ldc, C12, ldc);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C21, ldc, C22, ldc, C22, ldc);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C12, ldc, C11, ldc, C12, ldc);
+
+            // C11 = P4 = A22*T4, C21 = U6 = U3 - P4
+            matmul_mat_sub_pitch_inplace_seq(hk, hn, Y, hn, B21, ldb, Y, hn);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, A22, lda, Y, hn, (TElem)0, C11, ldc, pWorkspaceRec);
+            matmul_mat_sub_pitch_inplace_seq(hm, hn, C21, ldc, C11, ldc, C21, ldc);
+
+            // C11 = P2 = A12*B21, C11 = U1 = P1 + P2
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, A12, lda, B21, ldb, (TElem)0, C11, ldc, pWorkspaceRec);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, X, hn, C11, ldc, C11, ldc);
         }
         else
         {
-            // \TODO: Implement for non square matrices?
-            if(m!=n || m!=k)
-            {
-                printf("[GEMM Strassen] Invalid matrix size! The matrices have to be square for the Strassen GEMM.\n");
-                return;
-            }
+            // C := alpha*A*B + C with three temporaries. Products used only once are accumulated into C by the recursive calls directly.
+            matmul_gemm_seq_strassen_scale(2*hm, 2*hn, beta, C, ldc);
 
-            TIdx const h = n/2;           // size of sub-matrices
+            // Z = P5 = S1*T1, C12 += P5, C22 += P5
+            matmul_mat_add_pitch_inplace_seq(hm, hk, A21, lda, A22, lda, X, hk);
+            matmul_mat_sub_pitch_inplace_seq(hk, hn, B12, ldb, B11, ldb, Y, hn);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, X, hk, Y, hn, (TElem)0, Z, hn, pWorkspaceRec);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C12, ldc, Z, hn, C12, ldc);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C22, ldc, Z, hn, C22, ldc);
 
-            TElem const * const A = X;      // A-D matrices embedded in X
-            TElem const * const B = X + h;
-            TElem const * const C = X + h*lda;
-            TElem const * const D = C + h;
+            // Z = P1 = A11*B11, C11 += P1
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, A11, lda, B11, ldb, (TElem)0, Z, hn, pWorkspaceRec);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C11, ldc, Z, hn, C11, ldc);
 
-            TElem const * const E = Y;      // E-H matrices embeded in Y
-            TElem const * const F = Y + h;
-            TElem const * const G = Y + h*ldb;
-            TElem const * const H = G + h;
+            // Z = U2 = P1 + S2*T2, C12 += U2, C21 += U2, C22 += U2
+            matmul_mat_sub_pitch_inplace_seq(hm, hk, X, hk, A11, lda, X, hk);
+            matmul_mat_sub_pitch_inplace_seq(hk, hn, B22, ldb, Y, hn, Y, hn);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, X, hk, Y, hn, (TElem)1, Z, hn, pWorkspaceRec);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C12, ldc, Z, hn, C12, ldc);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C21, ldc, Z, hn, C21, ldc);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C22, ldc, Z, hn, C22, ldc);
 
-            // Allocate temporary matrices.
-            TIdx const uiNumElements = h * h;
-            TElem * P[7];
-            for(TIdx i = 0; i < 7; ++i)
-            {
-                P[i] = matmul_arr_alloc_fill_zero(uiNumElements);
-            }
-            TElem * const T = matmul_arr_alloc(uiNumElements);
-            TElem * const U = matmul_arr_alloc(uiNumElements);
-
-            // P0 = A*(F - H);
-            matmul_mat_sub_pitch_seq(h, h, F, ldb, H, ldb, T, h);
-            matmul_gemm_seq_strassen(h, h, h, alpha, A, lda, T, h, (TElem)1, P[0], h);
-
-            // P1 = (A + B)*H
-            matmul_mat_add_pitch_seq(h, h, A, lda, B, lda, T, h);
-            matmul_gemm_seq_strassen(h, h, h, alpha, T, h, H, ldb, (TElem)1, P[1], h);
-
-            // P2 = (C + D)*E
-            matmul_mat_add_pitch_seq(h, h, C, lda, D, lda, T, h);
-            matmul_gemm_seq_strassen(h, h, h, alpha, T, h, E, ldb, (TElem)1, P[2], h);
-
-            // P3 = D*(G - E);
-            matmul_mat_sub_pitch_seq(h, h, G, ldb, E, ldb, T, h);
-            matmul_gemm_seq_strassen(h, h, h, alpha, D, lda, T, h, (TElem)1, P[3], h);
-
-            // P4 = (A + D)*(E + H)
-            matmul_mat_add_pitch_seq(h, h, A, lda, D, lda, T, h);
-            matmul_mat_add_pitch_seq(h, h, E, ldb, H, ldb, U, h);
-            matmul_gemm_seq_strassen(h, h, h, alpha, T, h, U, h, (TElem)1, P[4], h);
-
-            // P5 = (B - D)*(G + H)
-            matmul_mat_sub_pitch_seq(h, h, B, lda, D, lda, T, h);
-            matmul_mat_add_pitch_seq(h, h, G, ldb, H, ldb, U, h);
-            matmul_gemm_seq_strassen(h, h, h, alpha, T, h, U, h, (TElem)1, P[5], h);
-
-            // P6 = (A - C)*(E + F)
-            matmul_mat_sub_pitch_seq(h, h, A, lda, C, lda, T, h);
-            matmul_mat_add_pitch_seq(h, h, E, ldb, F, ldb, U, h);
-            matmul_gemm_seq_strassen(h, h, h, alpha, T, h, U, h, (TElem)1, P[6], h);
-
-            // Z upper left = (P3 + P4) + (P5 - P1)
-            matmul_mat_add_pitch_seq(h, h, P[4], h, P[3], h, T, h);
-            matmul_mat_sub_pitch_seq(h, h, P[5], h, P[1], h, U, h);
-            TElem * const V = P[5];    // P[5] is only used once, so we reuse it as temporary buffer.
-            matmul_mat_add_pitch_seq(h, h, T, h, U, h, V, h);
-            matmul_mat_add2_pitch_seq(h, h, V, h, Z, ldc);
-
-            // Z lower left = P2 + P3
-            matmul_mat_add_pitch_seq(h, h, P[2], h, P[3], h, V, h);
-            matmul_mat_add2_pitch_seq(h, h, V, h, Z + h*ldc, ldc);
-
-            // Z upper right = P0 + P1
-            matmul_mat_add_pitch_seq(h, h, P[0], h, P[1], h, V, h);
-            matmul_mat_add2_pitch_seq(h, h, V, h, Z + h, ldc);
-
-            // Z lower right = (P0 + P4) - (P2 + P6)
-            matmul_mat_add_pitch_seq(h, h, P[0], h, P[4], h, T, h);
-            matmul_mat_add_pitch_seq(h, h, P[2], h, P[6], h, U, h);
-            matmul_mat_sub_pitch_seq(h, h, T, h, U, h, V, h);
-            matmul_mat_add2_pitch_seq(h, h, V, h, Z + h*(ldc + 1), ldc);
-
-            // Deallocate temporary matrices.
-            matmul_arr_free(U);
-            matmul_arr_free(T);
-            for(TIdx i = 0; i < 7; ++i)
-            {
-                matmul_arr_free(P[i]);
-            }
+            // C12 += P3 = S4*B22
+            matmul_mat_sub_pitch_inplace_seq(hm, hk, A12, lda, X, hk, X, hk);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, X, hk, B22, ldb, (TElem)1, C12, ldc, pWorkspaceRec);
+
+            // C21 -= P4 = A22*T4
+            matmul_mat_sub_pitch_inplace_seq(hk, hn, Y, hn, B21, ldb, Y, hn);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, -alpha, A22, lda, Y, hn, (TElem)1, C21, ldc, pWorkspaceRec);
+
+            // Z = P7 = S3*T3, C21 += P7, C22 += P7
+            matmul_mat_sub_pitch_inplace_seq(hm, hk, A11, lda, A21, lda, X, hk);
+            matmul_mat_sub_pitch_inplace_seq(hk, hn, B22, ldb, B12, ldb, Y, hn);
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, X, hk, Y, hn, (TElem)0, Z, hn, pWorkspaceRec);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C21, ldc, Z, hn, C21, ldc);
+            matmul_mat_add_pitch_inplace_seq(hm, hn, C22, ldc, Z, hn, C22, ldc);
+
+            // C11 += P2 = A12*B21
+            matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, hm, hn, hk, alpha, A12, lda, B21, ldb, (TElem)1, C11, ldc, pWorkspaceRec);
+        }
+
+        matmul_gemm_seq_strassen_peel(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_winograd_cut_off(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        // The workspace for all recursion levels is allocated at once.
+        TIdx const uiNumElementsWorkspace = matmul_gemm_seq_strassen_winograd_workspace_size(uiCutOff, m, n, k);
+        TElem * const pWorkspace = (uiNumElementsWorkspace > 0) ? matmul_arr_alloc(uiNumElementsWorkspace) : 0;
+
+        matmul_gemm_seq_strassen_winograd_workspace(uiCutOff, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, pWorkspace);
+
+        if(pWorkspace)
+        {
+            matmul_arr_free(pWorkspace);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_winograd(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT A, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT B, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT C, TIdx const ldc)
+    {
+        matmul_gemm_seq_strassen_winograd_cut_off(matmul_tune_get(m, n, k)->uiStrassenCutOff, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen_cut_off(
+        TIdx const uiCutOff,
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT Z, TIdx const ldc)
+    {
+        // The workspace for all recursion levels is allocated at once.
+        TIdx const uiNumElementsWorkspace = matmul_gemm_seq_strassen_workspace_size(uiCutOff, m, n, k);
+        TElem * const pWorkspace = (uiNumElementsWorkspace > 0) ? matmul_arr_alloc(uiNumElementsWorkspace) : 0;
+
+        matmul_gemm_seq_strassen_workspace(uiCutOff, m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc, pWorkspace);
+
+        if(pWorkspace)
+        {
+            matmul_arr_free(pWorkspace);
         }
     }
+
+    //-----------------------------------------------------------------------------
+    //
+    //-----------------------------------------------------------------------------
+    void matmul_gemm_seq_strassen(
+        TIdx const m, TIdx const n, TIdx const k,
+        TElem const alpha,
+        TElem const * const MATMUL_RESTRICT X, TIdx const lda,
+        TElem const * const MATMUL_RESTRICT Y, TIdx const ldb,
+        TElem const beta,
+        TElem * const MATMUL_RESTRICT Z, TIdx const ldc)
+    {
+        // The cut-off is looked up once for the whole problem so that all recursion levels use the one tuned for its shape class.
+        matmul_gemm_seq_strassen_cut_off(matmul_tune_get(m, n, k)->uiStrassenCutOff, m, n, k, alpha, X, lda, Y, ldb, beta, Z, ldc);
+    }
 #endif